@@ -0,0 +1,121 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef ARCGEOMETRYSTORE_H
+#define ARCGEOMETRYSTORE_H
+
+#include <memory>
+#include <vector>
+#include "data.hpp"
+#include "netsnapshot.hpp"
+#include "externalidtable.hpp"
+
+namespace netxpert {
+
+    namespace data {
+
+    /**
+    * \brief View on the coordinates of one arc geometry in the netxpert::data::ArcGeometryStore.
+    *
+    * Valid as long as the store is not rebuilt or destroyed.
+    **/
+    struct ArcGeometrySpan
+    {
+        ///\brief x and y of the coordinates one after another
+        const double* xy;
+        ///\brief Count of coordinates
+        uint32_t      size;
+        ///\brief Index of the span in the store
+        uint32_t      id;
+    };
+
+    /**
+    * \brief In-memory store of the geometries of the original arcs, keyed by the internal arc ID.
+    *
+    * All coordinates are kept in one flat array; every arc with a geometry points to its span of coordinates.
+    * Both directions of an undirected arc share the same span. Loaded once per network and read only afterwards;
+    * replaces the lookup of comma separated external arc IDs in a string map for the result geometries.
+    * A store built from a network snapshot reads the arrays from the mapped file and keeps the snapshot open.
+    */
+    class ArcGeometryStore
+    {
+        public:
+            ///\brief Constructor
+            ArcGeometryStore() : spanOfArc(nullptr), reversedArc(nullptr), spanOffsets(nullptr), coords(nullptr),
+                                 arcCount(0), spanCount(0) {}
+            ArcGeometryStore(const ArcGeometryStore&) = delete;
+            ArcGeometryStore& operator=(const ArcGeometryStore&) = delete;
+            ///\brief Builds the store for all arcs of the graph from the given arcs with geometries
+            ///
+            /// Arcs are matched by their external arc ID. Only (single part) line geometries are stored.
+            /// The external node IDs give the direction of every arc relative to its geometry.
+            void Build(const std::vector<netxpert::data::ExtArcWithGeom>& arcs,
+                       const netxpert::data::graph_t& g,
+                       const netxpert::data::ExternalIDTable& arcIDs,
+                       const netxpert::data::ExternalIDTable& nodeIDs);
+            ///\brief Uses the geometries of a network snapshot in place
+            ///
+            /// Nothing is copied; the store keeps a reference to the snapshot, so its mapping stays valid.
+            void Build(const std::shared_ptr<const netxpert::io::NetworkSnapshot>& snapshot);
+            ///\brief Copies the store into the given snapshot content for the first arcCount arcs
+            void Export(const uint32_t arcCount, netxpert::io::NetworkSnapshotData& data) const;
+            ///\brief Gets the coordinates of the given arc
+            ///\return false if the arc has no geometry in the store (e.g. new or eliminated arcs)
+            bool GetSpan(const netxpert::data::arc_t& arc, netxpert::data::ArcGeometrySpan& span) const;
+            ///\brief True if the given arc runs from the end to the start of its geometry
+            ///
+            /// E.g. the backward arc of an undirected arc.
+            bool IsReversed(const netxpert::data::arc_t& arc) const {
+                const int arcID = netxpert::data::graph_t::id(arc);
+                return arcID >= 0 && (uint32_t) arcID < arcCount && reversedArc[arcID] != 0;
+            }
+            ///\brief Gets the coordinates of all arcs of the path with a geometry in the store in the order of the path
+            std::vector<netxpert::data::ArcGeometrySpan> GetSpans(const std::vector<netxpert::data::arc_t>& path) const;
+            ///\brief Gets the external arc ID of the given span
+            netxpert::data::extarcid_t GetExtArcID(const netxpert::data::ArcGeometrySpan& span) const {
+                return snapshot ? snapshot->SpanArcIDs().Get(span.id) : extArcIDs[span.id];
+            }
+            ///\brief Count of stored geometries
+            size_t SpanCount() const {
+                return spanCount;
+            }
+            ///\brief Heap memory of the store in bytes (without the external arc IDs and the mapped snapshot)
+            size_t MemoryUsage() const;
+
+        private:
+            //arrays of the store: point into the vectors below or into the mapped snapshot
+            //span per internal arc ID; -1 without geometry
+            const int32_t*  spanOfArc;
+            //arc runs against the direction of its geometry per internal arc ID (0 or 1)
+            const uint8_t*  reversedArc;
+            //first coordinate of every span; one more than spans
+            const uint32_t* spanOffsets;
+            //x, y of all spans
+            const double*   coords;
+            uint32_t arcCount;
+            uint32_t spanCount;
+
+            std::vector<int32_t> spanOfArcData;
+            std::vector<uint8_t> reversedArcData;
+            std::vector<uint32_t> spanOffsetData;
+            std::vector<double> coordData;
+            std::vector<netxpert::data::extarcid_t> extArcIDs;
+            std::shared_ptr<const netxpert::io::NetworkSnapshot> snapshot;
+    };
+} //namespace data
+} //namespace netxpert
+
+#endif // ARCGEOMETRYSTORE_H
@@ -0,0 +1,121 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <utility>
+
+namespace netxpert {
+
+    namespace utils {
+
+    /**
+    * \brief Bounded lock free queue for many producers and consumers (ring buffer with a sequence number per cell).
+    *
+    * TryPush() and TryPop() never block; they fail if the queue is full or empty. The capacity is rounded up
+    * to a power of two.
+    **/
+    template <typename T>
+    class BoundedQueue
+    {
+        public:
+            ///\brief Constructor
+            explicit BoundedQueue(const size_t capacity)
+                : enqueuePos(0), dequeuePos(0) {
+
+                size_t size = 2;
+                while (size < capacity)
+                    size *= 2;
+                this->mask = size - 1;
+                this->cells = std::unique_ptr<Cell[]>(new Cell[size]);
+                for (size_t i = 0; i < size; i++)
+                    this->cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+
+            BoundedQueue(const BoundedQueue&) = delete;
+            BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+            ///\brief Appends the value (moved from only on success, so a failed push can be retried)
+            ///\return false if the queue is full
+            bool TryPush(T&& value) {
+
+                size_t pos = this->enqueuePos.load(std::memory_order_relaxed);
+                Cell* cell;
+                for (;;) {
+                    cell = &this->cells[pos & this->mask];
+                    const size_t seq = cell->sequence.load(std::memory_order_acquire);
+                    const std::ptrdiff_t diff = (std::ptrdiff_t) seq - (std::ptrdiff_t) pos;
+                    if (diff == 0) {
+                        if (this->enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                            break;
+                    }
+                    else if (diff < 0)
+                        return false;
+                    else
+                        pos = this->enqueuePos.load(std::memory_order_relaxed);
+                }
+                cell->value = std::move(value);
+                cell->sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+
+            ///\brief Removes the oldest value
+            ///\return false if the queue is empty
+            bool TryPop(T& value) {
+
+                size_t pos = this->dequeuePos.load(std::memory_order_relaxed);
+                Cell* cell;
+                for (;;) {
+                    cell = &this->cells[pos & this->mask];
+                    const size_t seq = cell->sequence.load(std::memory_order_acquire);
+                    const std::ptrdiff_t diff = (std::ptrdiff_t) seq - (std::ptrdiff_t) (pos + 1);
+                    if (diff == 0) {
+                        if (this->dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                            break;
+                    }
+                    else if (diff < 0)
+                        return false;
+                    else
+                        pos = this->dequeuePos.load(std::memory_order_relaxed);
+                }
+                value = std::move(cell->value);
+                cell->sequence.store(pos + this->mask + 1, std::memory_order_release);
+                return true;
+            }
+
+        private:
+            struct Cell
+            {
+                std::atomic<size_t> sequence;
+                T value;
+            };
+
+            std::unique_ptr<Cell[]> cells;
+            size_t mask;
+            //producers and consumer on different cache lines (padding: operator new ignores alignas before C++17)
+            char pad0[64];
+            std::atomic<size_t> enqueuePos;
+            char pad1[64];
+            std::atomic<size_t> dequeuePos;
+    };
+} //namespace utils
+} //namespace netxpert
+
+#endif // BOUNDEDQUEUE_H
@@ -89,7 +89,9 @@ namespace netxpert {
         TestCreateRouteGeometries = 11,
         MCFCOM = 12,
         TransportationCOMExt = 13,
-        ODMatrixCOM2 = 14
+        ODMatrixCOM2 = 14,
+        BenchMCFAlgorithms = 15,
+        TransportationDegenerate = 16
     };
 
     /**
@@ -115,18 +117,41 @@ namespace netxpert {
        LogQuiet = 5   //!< No logging at all.
     };
     /**
+    * \brief Order of the internal node IDs on building the network.
+    **/
+    enum NODE_ORDER : int16_t {
+        SortedNodeIDs = 0, //!< Internal node IDs follow the sorted original node IDs.
+        BreadthFirst = 1   //!< Internal node IDs follow a breadth first search over the arcs; adjacent nodes get close IDs.
+    };
+    /**
     * \brief Type of the Shortest Path Tree algorithms.
     **/
     enum SPTAlgorithm : int16_t {
         Dijkstra_2Heap_LEMON = 4, //!< Dijkstra of LEMON with binary heap
         Bijkstra_2Heap_LEMON = 5, //!< Bidirectional Dijkstra of LEMON with binary heap
-        Dijkstra_dheap_BOOST = 6 //!< Dijkstra of Boost Graph Library with d-ary heap
+        Dijkstra_dheap_BOOST = 6, //!< Dijkstra of Boost Graph Library with d-ary heap
+        Dijkstra_2Heap_CSR = 7, //!< Dijkstra with binary heap on an immutable CSR snapshot of the network
+        ContractionHierarchies = 8, //!< Bidirectional search on contraction hierarchies of the network (1:1 and 1:n queries)
+        ContractionHierarchies_ManyToMany = 9 //!< Bucket based many-to-many search on contraction hierarchies (n:m costs of the ODMatrix)
     };
     /**
     * \brief Type of the Minimum Cost Flow algorithms.
     **/
     enum MCFAlgorithm : int16_t {
-        NetworkSimplex_LEMON = 1  //!< NetworkSimplex algorithm of LEMON
+        MCFAutomatic = 0,          //!< Chosen from the shape of the instance \sa netxpert::MinCostFlow::SelectAlgorithm()
+        NetworkSimplex_LEMON = 1,  //!< NetworkSimplex algorithm of LEMON
+        CostScaling_LEMON = 2,     //!< CostScaling algorithm of LEMON (push relabel with partial augmentation); integral values only
+        CapacityScaling_LEMON = 3  //!< CapacityScaling algorithm of LEMON (successive shortest paths with scaling); integral supplies and capacities only
+    };
+    /**
+    * \brief Pivot rule of the NetworkSimplex algorithm (same order as in LEMON).
+    **/
+    enum MCFPivotRule : int16_t {
+        FirstEligible = 0, //!< Next eligible arc in cyclic order
+        BestEligible = 1,  //!< Most violating arc of all arcs
+        BlockSearch = 2,   //!< Most violating arc of the next block of arcs (LEMON default)
+        CandidateList = 3, //!< Most violating arc of a list of candidate arcs that is rebuilt from time to time
+        AlteringList = 4   //!< Like CandidateList, but keeps the best candidates of the list
     };
     /**
     * \brief Type of the Minimum Spanning Tree algorithms.
@@ -135,6 +160,22 @@ namespace netxpert {
         Kruskal_LEMON = 2 //!< Kruskal's Minimum Spanning Tree algorithm of LEMON.
     };
 
+    /**
+    * \brief Serializes an optional config entry.
+    *
+    * On loading, a missing entry in the JSON input keeps the default value of the member, so that
+    * config files written for older versions of netXpert still can be read.
+    **/
+    template <class Archive, class T>
+    void OptionalNVP(Archive& ar, const char* name, T& value) {
+        try {
+            ar( cereal::make_nvp(name, value) );
+        }
+        catch (cereal::Exception&) {
+            //entry not found: keep default
+        }
+    }
+
     /**
     * \brief Storage for the configuration of NetXpert
     **/
@@ -179,6 +220,17 @@ namespace netxpert {
         netxpert::cnfg::LOG_LEVEL LogLevel;//!< Application log level.
         bool CleanNetwork;//!< Clean input network on load.
         std::string LogFileFullPath; //!< Path to log file.
+        bool ODMCostsOnly = false;//!< Origin destination matrix stores costs only; paths are rebuilt on demand. Optional, default: false
+        bool CSRSinglePrecision = false;//!< CSR snapshot (SPTAlgorithm Dijkstra_2Heap_CSR) stores arc costs as 32-bit floats. Optional, default: false
+        netxpert::cnfg::NODE_ORDER NodeOrder = netxpert::cnfg::NODE_ORDER::SortedNodeIDs;//!< Order of the internal node IDs. Optional, default: SortedNodeIDs
+        bool IsolinesTreeBased = false;//!< Isolines solver keeps the distance labels of the shortest path tree only and saves every reached arc once per cut off. Optional, default: false
+        bool IsolinesBands = false;//!< Isolines solver saves one row per origin and band between two cut offs (cost: lower cut off, cutoff: upper cut off); only arcs that cross a cut off are split. Optional, default: false
+        bool IsolinesPolygons = false;//!< Isolines solver saves one polygon (alpha shape of the reached arcs) per origin and cut off instead of lines. Optional, default: false
+        double IsolinesPolygonAlpha = 0;//!< Maximum edge length of the triangles of the isoline polygons in units of the geometry; 0: twice the mean length of the reached arcs. Optional, default: 0
+        netxpert::cnfg::MCFPivotRule McfPivotRule = netxpert::cnfg::MCFPivotRule::BlockSearch;//!< Pivot rule of the NetworkSimplex algorithm. Optional, default: BlockSearch
+        int McfIntegerPrecision = -1;//!< NetworkSimplex algorithm solves on 64 bit integers: costs, capacities and supplies are scaled with 10^McfIntegerPrecision and rounded; falls back to double values if the scaled values could overflow. CapacityScaling and CostScaling solve on the scaled values, which must be integral (else NetworkSimplex is used). -1: off (integer values for CapacityScaling and CostScaling). Optional, default: -1
+        bool TransportationDense = false;//!< Transportation solver on a network solves the dense OD cost matrix with the transportation simplex instead of a Minimum Cost Flow network built from the OD matrix. Optional, default: false
+        int TransportationCandidates = 0;//!< Transportation solver on a network starts with the given number of nearest destinations per origin and adds OD pairs only if they improve the solution (column generation); no full OD matrix is computed. 0: off. Optional, default: 0
 
         ///\brief Serialize struct members to JSON
         template <class Archive>
@@ -223,6 +275,18 @@ namespace netxpert {
                 CEREAL_NVP(GeometryHandling),
                 CEREAL_NVP(LogLevel),
                 CEREAL_NVP(LogFileFullPath) );
+            //optional entries
+            OptionalNVP(ar, "ODMCostsOnly", ODMCostsOnly);
+            OptionalNVP(ar, "CSRSinglePrecision", CSRSinglePrecision);
+            OptionalNVP(ar, "NodeOrder", NodeOrder);
+            OptionalNVP(ar, "IsolinesTreeBased", IsolinesTreeBased);
+            OptionalNVP(ar, "IsolinesBands", IsolinesBands);
+            OptionalNVP(ar, "IsolinesPolygons", IsolinesPolygons);
+            OptionalNVP(ar, "IsolinesPolygonAlpha", IsolinesPolygonAlpha);
+            OptionalNVP(ar, "McfPivotRule", McfPivotRule);
+            OptionalNVP(ar, "McfIntegerPrecision", McfIntegerPrecision);
+            OptionalNVP(ar, "TransportationDense", TransportationDense);
+            OptionalNVP(ar, "TransportationCandidates", TransportationCandidates);
         }
     };
 
@@ -0,0 +1,149 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include "data.hpp"
+
+namespace netxpert {
+
+    namespace core {
+
+    /**
+    * \brief Contraction hierarchy of a network.
+    *
+    * Preprocessing contracts the nodes one after another (node ordering by edge difference and count of
+    * contracted neighbours) and inserts shortcut arcs wherever a shortest path would get lost otherwise.
+    * Nodes with no neighbour of lower priority in between are contracted together in parallel.
+    *
+    * The result is stored as two compact search graphs in CSR layout:
+    * \li upward graph: for every node the arcs to nodes of higher rank (forward search from the origin)
+    * \li downward graph: for every node the arcs coming from nodes of higher rank (backward search from the destination)
+    *
+    * A shortest path query is a bidirectional search which only goes up in the hierarchy.
+    * Shortcuts are unpacked into the original arcs of the graph with UnpackArc().
+    *
+    * Node indices are the node IDs of the internal graph the hierarchy was built from.
+    */
+    class ContractionHierarchy
+    {
+        public:
+            ///\brief Arc of the search graphs
+            ///
+            /// In the upward graph node is the target of the arc, in the downward graph it is the source.
+            struct Edge
+            {
+                uint32_t node;
+                netxpert::data::cost_t cost;
+                int32_t middle; //!< contracted node of a shortcut; -1 for an original arc
+                int32_t arcID;  //!< internal arc ID of an original arc; -1 for a shortcut
+            };
+
+            ///\brief Label of a local search from or to a node outside the hierarchy
+            struct LocalLabel
+            {
+                netxpert::data::cost_t dist;
+                netxpert::data::arc_t pred;
+            };
+
+            ///\brief Constructor
+            ContractionHierarchy() {}
+            ///\brief Builds the hierarchy from the given snapshot of the network
+            ///\param base: snapshot of the network, e.g. of netxpert::data::InternalNet::FreezeToCSR()
+            void Build(const netxpert::data::CSRGraph& base);
+
+            ///\brief Count of node indices of the hierarchy
+            uint32_t NodeCount() const {
+                return rank.size();
+            }
+            ///\brief Count of shortcuts inserted in the preprocessing
+            size_t ShortcutCount() const {
+                return shortcuts;
+            }
+            ///\brief Node is part of the hierarchy (i.e. has arcs in the network the hierarchy was built from)
+            inline bool Contains(const int nodeID) const {
+                return nodeID >= 0 && (uint32_t) nodeID < rank.size() && core[nodeID];
+            }
+            ///\brief Rank of the node in the contraction order
+            inline uint32_t Rank(const int nodeID) const {
+                return rank[nodeID];
+            }
+            ///\brief First position of the upward arcs of the node
+            inline uint32_t UpBegin(const int nodeID) const {
+                return upOffsets[nodeID];
+            }
+            ///\brief Position after the last upward arc of the node
+            inline uint32_t UpEnd(const int nodeID) const {
+                return upOffsets[nodeID + 1];
+            }
+            ///\brief Upward arc at the given position
+            inline const Edge& UpEdge(const uint32_t pos) const {
+                return up[pos];
+            }
+            ///\brief Node the upward arc at the given position starts from
+            uint32_t UpOwner(const uint32_t pos) const {
+                return std::upper_bound(upOffsets.begin(), upOffsets.end(), pos) - upOffsets.begin() - 1;
+            }
+            ///\brief First position of the downward arcs of the node
+            inline uint32_t DownBegin(const int nodeID) const {
+                return downOffsets[nodeID];
+            }
+            ///\brief Position after the last downward arc of the node
+            inline uint32_t DownEnd(const int nodeID) const {
+                return downOffsets[nodeID + 1];
+            }
+            ///\brief Downward arc at the given position
+            inline const Edge& DownEdge(const uint32_t pos) const {
+                return down[pos];
+            }
+            ///\brief Node the downward arc at the given position ends in
+            uint32_t DownOwner(const uint32_t pos) const {
+                return std::upper_bound(downOffsets.begin(), downOffsets.end(), pos) - downOffsets.begin() - 1;
+            }
+            ///\brief Appends the original arcs of the hierarchy arc from -> to to the given path
+            void UnpackArc(const uint32_t from, const uint32_t to, const int32_t middle, const int32_t arcID,
+                           std::vector<netxpert::data::arc_t>& path) const;
+            ///\brief Dijkstra on the given (current) network from (forward) or to (backward) a node that is not part of the hierarchy
+            ///
+            /// Nodes of the hierarchy are not expanded; they are returned as seeds (node ID, distance) for the search
+            /// in the hierarchy. Labels hold the distance and the predecessor arc (forward) or successor arc (backward).
+            void LocalSearch(const netxpert::data::filtered_graph_t& g,
+                             const netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>& costMap,
+                             const netxpert::data::node_t start, const bool forward, const netxpert::data::cost_t threshold,
+                             std::unordered_map<int, LocalLabel>& labels,
+                             std::vector<std::pair<int, netxpert::data::cost_t> >& seeds) const;
+            ///\brief Memory footprint of the hierarchy in bytes
+            size_t MemoryUsage() const;
+
+        private:
+            std::vector<uint32_t> rank;
+            std::vector<char> core;
+            std::vector<uint32_t> upOffsets;
+            std::vector<Edge> up;
+            std::vector<uint32_t> downOffsets;
+            std::vector<Edge> down;
+            size_t shortcuts = 0;
+
+            const Edge* findDown(const uint32_t nodeID, const uint32_t source) const;
+            const Edge* findUp(const uint32_t nodeID, const uint32_t target) const;
+    };
+} //namespace core
+} //namespace netxpert
+#endif // CONTRACTION_HIERARCHY_H
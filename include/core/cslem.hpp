@@ -0,0 +1,102 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef COSTSCALINGLEM_H
+#define COSTSCALINGLEM_H
+
+#include "imcflow.hpp"
+#include "mcfscaling.hpp"
+#include "lemon/smart_graph.h"
+#include "lemon/cost_scaling.h"
+#include "lemon/adaptors.h"
+
+using namespace lemon;
+using namespace netxpert::data;
+
+namespace netxpert {
+
+    namespace core {
+    /**
+    *  \brief Core Solver for the Minimum Cost Flow Problem with the Cost Scaling algorithm of LEMON.
+    *
+    *  The epsilon scaling of the algorithm stops at epsilon < 1, so the result is optimal for integer costs only
+    *  (and approximate for real costs). Costs, capacities and supplies are scaled with 10^precision
+    *  (see netxpert::core::MCFScaling) and solved as 64 bit integers; flows, potentials and the optimum are scaled
+    *  back. If a value is not integral after scaling, the instance is not solved and GetMCFStatus() gives MCFError.
+    */
+    class CS_LEM : public netxpert::core::IMinCostFlow
+    {
+        ///\brief Type defintion for the CostScaling algorithm of LEMON that is used in this class
+        typedef lemon::CostScaling<netxpert::data::filtered_graph_t,
+                                      int64_t,
+                                      int64_t> costscaling_t;
+
+        public:
+            ///\brief Constructor with the precision (decimal places) of costs, capacities and supplies;
+            /// -1: integer values
+            CS_LEM(const int integerPrecision = -1) : integerPrecision(integerPrecision) {}
+            ///\brief Destructor
+            ~CS_LEM() {}
+            /* LEMON friendly interface */
+            ///\brief Loads the network into the core solver
+            void LoadNet(const uint32_t nmax,  const uint32_t mmax,
+                      lemon::FilterArcs<netxpert::data::graph_t,
+                                              netxpert::data::graph_t::ArcMap<bool>>* sg,
+                      netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>* _costMap,
+                      netxpert::data::graph_t::ArcMap<netxpert::data::capacity_t>* _capMap,
+                      netxpert::data::graph_t::NodeMap<supply_t>* _supplyMap);
+            ///\brief Gets the count of the arcs of the internal graph
+            const uint32_t GetArcCount();
+            ///\brief Gets the count of the nodes of the internal graph
+            const uint32_t GetNodeCount();
+            ///\brief Solves the MCF problem
+            void SolveMCF();
+            ///\brief Gets the overall optimum of the problem
+            const double GetOptimum() const;
+            ///\brief Gets the result set of arcs
+            std::vector<netxpert::data::arc_t> GetMCFArcs();
+            ///\brief Gets a arc map with the resulting flow for each arc
+            netxpert::data::graph_t::ArcMap<netxpert::data::flow_t>* GetMCFFlow();
+            ///\brief Gets a arc map with the resulting cost for each arc
+            netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>* GetMCFCost();
+            ///\brief Gets a node map with the resulting potential (dual value) for each node
+            netxpert::data::graph_t::NodeMap<netxpert::data::cost_t>* GetMCFPotential();
+            /* end of LEMON friendly interface */
+            ///\brief Gets the status of the internal MCF solver
+            const int GetMCFStatus();
+
+        protected:
+            uint32_t nmax; //max count nodes
+            uint32_t mmax; //max count arcs
+
+        private:
+            netxpert::data::filtered_graph_t* g;
+            netxpert::data::graph_t::ArcMap<capacity_t>* capacityMap;
+            netxpert::data::graph_t::ArcMap<cost_t>* costMap;
+            std::unique_ptr<netxpert::data::filtered_graph_t::ArcMap<flow_t>> flowMap;
+            std::unique_ptr<netxpert::data::filtered_graph_t::NodeMap<cost_t>> potentialMap;
+            netxpert::data::graph_t::NodeMap<supply_t>* supplyMap;
+            std::unique_ptr<costscaling_t> solver;
+            costscaling_t::ProblemType status;
+            int integerPrecision;
+            double scale = 1;
+            bool integralInput = false;
+            double optimum = 0;
+    };
+} //namespace core
+} //namespace netxpert
+
+#endif // COSTSCALINGLEM_H
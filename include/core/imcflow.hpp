@@ -56,6 +56,8 @@ namespace netxpert {
             virtual netxpert::data::graph_t::ArcMap<netxpert::data::flow_t>* GetMCFFlow()=0;
             ///\brief Gets a arc map with the resulting cost for each arc
             virtual netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>* GetMCFCost()=0;
+            ///\brief Gets a node map with the resulting potential (dual value) for each node
+            virtual netxpert::data::graph_t::NodeMap<netxpert::data::cost_t>* GetMCFPotential()=0;
             /* end of LEMON friendly interface */
             ///\brief Gets the status of the internal MCF solver
             virtual const int GetMCFStatus()=0;
@@ -49,6 +49,15 @@ namespace netxpert {
             virtual void SetOrigin( netxpert::data::node_t NewOrg )=0;
             ///\brief Solves the destination
             virtual void SetDest( netxpert::data::node_t NewDst )=0;
+            ///\brief Sets the destinations for a one-to-many search
+            ///
+            /// The search stops as soon as all given destinations are settled (or the threshold of SolveSPT() is exceeded).
+            /// An empty vector switches back to a regular search.
+            virtual void SetDests( const std::vector<netxpert::data::node_t>& NewDsts )=0;
+            ///\brief Limits the one-to-many search to the given count of nearest destinations
+            ///
+            /// Only the nearest destinations of SetDests() are reached; 0 (default) reaches all of them.
+            virtual void SetDestLimit( const size_t limit )=0;
             ///\brief Checks if the given node has been reached in the calculation
             virtual bool Reached( netxpert::data::node_t NodeID )=0;
             ///\brief Gets the predecessor nodes of the given node
@@ -57,6 +66,10 @@ namespace netxpert {
             virtual const std::vector<netxpert::data::arc_t> GetPath(netxpert::data::node_t _dest)=0;
             ///\brief Gets the distance from the origin node to the given destination node
             virtual const netxpert::data::cost_t GetDist(netxpert::data::node_t _dest)=0;
+            ///\brief Gets the nodes settled in the last search in the order of their distances
+            ///
+            /// Without destinations these are the nodes of the shortest path tree (within the threshold).
+            virtual const std::vector<netxpert::data::node_t> GetSettledNodes()=0;
             /* end of LEMON friendly interface */
 
     };
@@ -0,0 +1,98 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef MCF_REOPT_H
+#define MCF_REOPT_H
+
+#include <vector>
+#include <stdint.h>
+
+#include "data.hpp"
+
+namespace netxpert {
+
+    namespace core {
+
+    /**
+    *  \brief Re-optimization of a solved Minimum Cost Flow Problem after changes of node supplies and arc costs.
+    *
+    *   \b Notes on the current implementation
+    *
+    *   The LEMON algorithms build their initial solution from scratch on every run, so a solved instance cannot
+    *   be continued with them. This class takes the optimal flow and the node potentials (dual solution) of a core
+    *   solver instead and keeps them up to date:
+    *   \li a changed arc cost only breaks the optimality conditions of that arc; the arc is saturated or emptied,
+    *       which moves the imbalance to its end nodes
+    *   \li a changed supply becomes an excess or deficit of the node
+    *   \li the excesses are sent to the deficits along shortest paths of the residual network with the reduced
+    *       costs (successive shortest paths). The potentials keep the reduced costs non negative, so Dijkstra's
+    *       algorithm can be used, and every search stops at the first deficit that it reaches.
+    *
+    *   For a handful of changes only a few short searches are needed instead of a complete solve.
+    *   Input maps (cost, supply) are updated in place; the graph must not change between the solve and the
+    *   re-optimization.
+    */
+    class MCFReoptimizer
+    {
+        public:
+            ///\brief Constructor
+            MCFReoptimizer(netxpert::data::filtered_graph_t& g,
+                           netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>& costMap,
+                           netxpert::data::graph_t::ArcMap<netxpert::data::capacity_t>& capMap,
+                           netxpert::data::graph_t::NodeMap<netxpert::data::supply_t>& supplyMap);
+            ///\brief Loads the optimal flow and node potentials of a solved instance
+            void LoadSolution(netxpert::data::graph_t::ArcMap<netxpert::data::flow_t>& flowMap,
+                              netxpert::data::graph_t::NodeMap<netxpert::data::cost_t>& potentialMap);
+            ///\brief Sets the new supply (positive) or demand (negative) of the given node
+            void SetNodeSupply(const netxpert::data::node_t& node, const netxpert::data::supply_t supply);
+            ///\brief Sets the new cost of the given arc
+            void SetArcCost(const netxpert::data::arc_t& arc, const netxpert::data::cost_t cost);
+            ///\brief Restores an optimal flow after the changes
+            ///\return false, if the excesses cannot be sent to the deficits (infeasible or unbalanced instance)
+            bool Reoptimize();
+            ///\brief Gets the flow of the given arc
+            netxpert::data::flow_t GetFlow(const netxpert::data::arc_t& arc) const;
+            ///\brief Gets the overall optimum
+            double GetOptimum() const;
+            ///\brief Gets the count of augmenting paths of the last Reoptimize()
+            uint32_t GetAugmentationCount() const {
+                return augmentations;
+            }
+
+        private:
+            bool augment();
+            netxpert::data::cost_t reducedCost(const netxpert::data::arc_t& arc) const;
+
+            netxpert::data::filtered_graph_t& g;
+            netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>& costMap;
+            netxpert::data::graph_t::ArcMap<netxpert::data::capacity_t>& capMap;
+            netxpert::data::graph_t::NodeMap<netxpert::data::supply_t>& supplyMap;
+            //indexed by the IDs of the graph
+            std::vector<netxpert::data::flow_t> flow;
+            std::vector<netxpert::data::cost_t> potential;
+            std::vector<netxpert::data::flow_t> excess;
+            std::vector<netxpert::data::arc_t> changedArcs;
+            //Dijkstra labels; only the touched entries are reset after a search
+            std::vector<netxpert::data::cost_t> dist;
+            std::vector<netxpert::data::arc_t> pred;
+            std::vector<char> predForward;
+            std::vector<char> settled;
+            uint32_t augmentations;
+    };
+} //namespace core
+} //namespace netxpert
+
+#endif // MCF_REOPT_H
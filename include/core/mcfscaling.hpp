@@ -0,0 +1,67 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef MCFSCALING_H
+#define MCFSCALING_H
+
+#include <stdint.h>
+#include "data.hpp"
+
+namespace netxpert {
+
+    namespace core {
+
+    /**
+    * \brief Scaling of Minimum Cost Flow instances to 64 bit integers.
+    *
+    * The CapacityScaling and CostScaling algorithms of LEMON are exact on integer values only: CapacityScaling
+    * ignores residual capacities and excesses below 1 in its last phase, CostScaling stops at epsilon < 1 on the
+    * costs multiplied by n * alpha. Both solve on the values scaled with 10^precision, which must be integral.
+    */
+    class MCFScaling
+    {
+        public:
+            ///\brief Scale for the given precision (decimal places); precision < 0 gives 1 (integer values)
+            static double GetScale(const int precision);
+            ///\brief True, if every supply and finite capacity is integral after scaling and fits into 64 bit integers
+            static bool HasIntegralFlows(const netxpert::data::filtered_graph_t& g,
+                                         const netxpert::data::graph_t::ArcMap<netxpert::data::capacity_t>& capMap,
+                                         const netxpert::data::graph_t::NodeMap<netxpert::data::supply_t>& supplyMap,
+                                         const double scale);
+            ///\brief True, if every cost is integral after scaling and costFactor * (nodes + 1) * cost fits into
+            /// 64 bit integers
+            static bool HasIntegralCosts(const netxpert::data::filtered_graph_t& g,
+                                         const netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>& costMap,
+                                         const double scale, const double costFactor = 1);
+            ///\brief Scales supplies and capacities; infinite capacities get the max of int64_t
+            ///\warning Only exact if HasIntegralFlows()
+            static void ScaleFlows(const netxpert::data::filtered_graph_t& g,
+                                   const netxpert::data::graph_t::ArcMap<netxpert::data::capacity_t>& capMap,
+                                   const netxpert::data::graph_t::NodeMap<netxpert::data::supply_t>& supplyMap,
+                                   const double scale,
+                                   netxpert::data::filtered_graph_t::ArcMap<int64_t>& capInt,
+                                   netxpert::data::filtered_graph_t::NodeMap<int64_t>& supplyInt);
+            ///\brief Scales the costs
+            ///\warning Only exact if HasIntegralCosts()
+            static void ScaleCosts(const netxpert::data::filtered_graph_t& g,
+                                   const netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>& costMap,
+                                   const double scale,
+                                   netxpert::data::filtered_graph_t::ArcMap<int64_t>& costInt);
+    };
+} //namespace core
+} //namespace netxpert
+
+#endif // MCFSCALING_H
@@ -32,6 +32,11 @@ namespace netxpert {
     namespace core {
     /**
     *  \brief Core Solver for the Minimum Cost Flow Problem with the Network Simplex algorithm of LEMON.
+    *
+    *  With an integer precision p >= 0 costs, capacities and supplies are scaled with 10^p, rounded and solved
+    *  with a NetworkSimplex on 64 bit integers (faster and exact for the scaled values); flows and potentials
+    *  are scaled back. If the scaled values could overflow in the algorithm, the instance is solved with
+    *  double values as usual.
     *  \todo Check for input data types; At the moment only integer values are safe in the MCF algorithms in LEMON!
     */
     class NS_LEM : public netxpert::core::IMinCostFlow
@@ -40,12 +45,20 @@ namespace netxpert {
         typedef lemon::NetworkSimplex<netxpert::data::filtered_graph_t,
                                       netxpert::data::flow_t,
                                       netxpert::data::cost_t> netsimplex_t;
+        ///\brief Type defintion for the NetworkSimplex algorithm of LEMON on scaled integer values
+        typedef lemon::NetworkSimplex<netxpert::data::filtered_graph_t,
+                                      int64_t,
+                                      int64_t> netsimplex_int_t;
 
         public:
-            ///\brief Empty Constructor
-            NS_LEM() {}
+            ///\brief Constructor with the pivot rule of the NetworkSimplex algorithm and the precision
+            /// (decimal places) of the integer mode; -1: no integer mode
+            NS_LEM(const netxpert::cnfg::MCFPivotRule pivotRule = netxpert::cnfg::MCFPivotRule::BlockSearch,
+                   const int integerPrecision = -1)
+                : flowMap(nullptr), pivotRule(pivotRule), integerPrecision(integerPrecision) {}
             ///\brief Copy Constructor
-            NS_LEM (NS_LEM const &) {}
+            NS_LEM (NS_LEM const & other) : flowMap(nullptr), pivotRule(other.pivotRule),
+                                            integerPrecision(other.integerPrecision) {}
             ///\brief Destructor
             ~NS_LEM();
             /* LEMON friendly interface */
@@ -70,11 +83,17 @@ namespace netxpert {
             netxpert::data::graph_t::ArcMap<netxpert::data::flow_t>* GetMCFFlow();
             ///\brief Gets a arc map with the resulting cost for each arc
             netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>* GetMCFCost();
+            ///\brief Gets a node map with the resulting potential (dual value) for each node
+            netxpert::data::graph_t::NodeMap<netxpert::data::cost_t>* GetMCFPotential();
             /* end of LEMON friendly interface */
             ///\brief Gets the status of the internal MCF solver
             const int GetMCFStatus();
             ///\brief Prints the result to std::cout
             void PrintResult();
+            ///\brief True, if the last SolveMCF() was solved on scaled integer values
+            const bool IsIntegerSolved() const {
+                return integerSolved;
+            }
 
         protected:
             uint32_t nmax; //max count nodes
@@ -85,9 +104,19 @@ namespace netxpert {
             netxpert::data::graph_t::ArcMap<capacity_t>* capacityMap;
             netxpert::data::graph_t::ArcMap<cost_t>* costMap;
             netxpert::data::filtered_graph_t::ArcMap<flow_t>* flowMap;
+            std::unique_ptr<netxpert::data::filtered_graph_t::NodeMap<cost_t>> potentialMap;
             netxpert::data::graph_t::NodeMap<supply_t>* supplyMap;
             std::unique_ptr<netsimplex_t> nsimplex;
             netsimplex_t::ProblemType status;
+            netxpert::cnfg::MCFPivotRule pivotRule;
+            netsimplex_t::PivotRule getPivotRule() const;
+            //integer mode
+            int integerPrecision;
+            bool integerSolved = false;
+            double integerScale = 1;
+            double integerOptimum = 0;
+            std::unique_ptr<netsimplex_int_t> nsimplexInt;
+            bool solveInteger();
     };
 } //namespace core
 } //namespace netxpert
@@ -0,0 +1,93 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef ODM_CH_H
+#define ODM_CH_H
+
+#include <vector>
+#include <memory>
+
+#include "data.hpp"
+#include "contractionhierarchy.hpp"
+
+namespace netxpert {
+
+    namespace core {
+
+    /**
+    *  \brief Core Solver for the costs of a many-to-many origin destination matrix on a contraction hierarchy.
+    *
+    *   \b Notes on the current implementation
+    *
+    *   Bucket based many-to-many search:
+    *   \li a backward search in the downward graph from every destination puts (destination, distance)
+    *       into the bucket of every node it settles
+    *   \li a forward search in the upward graph from every origin scans the buckets of the nodes it settles;
+    *       the minimum of the sums is the distance of the od pair
+    *
+    *   Both phases run in parallel (one search per destination and origin). The cost is about |O| + |D|
+    *   searches in the hierarchy instead of |O| Dijkstra searches on the whole network.
+    *
+    *   Start and end nodes that are not part of the hierarchy are handled with local searches like in
+    *   netxpert::core::SPT_CH. Only the costs are computed; paths can be rebuilt with SPT_CH.
+    */
+    class ODM_CH
+    {
+        public:
+            ///\brief Constructor
+            ODM_CH() {}
+            ///\brief Empty destructor
+            ~ODM_CH() {}
+            ///\brief Loads the current network into the core solver
+            ///
+            /// Needed for the added start and end nodes.
+            void LoadNet(netxpert::data::filtered_graph_t* sg,
+                         netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>* cm);
+            ///\brief Loads the (shared) contraction hierarchy of the base network into the core solver
+            void LoadCH(std::shared_ptr<const netxpert::core::ContractionHierarchy> _ch);
+            ///\brief Computes the costs of all od pairs
+            ///
+            /// Writes the cost of every reached pair into the given result store, which must have been
+            /// initialized with the same origins and destinations. Pairs with identical nodes are skipped.
+            ///\param threads: count of threads for the searches of both phases
+            void Solve(const std::vector<netxpert::data::node_t>& origs,
+                       const std::vector<netxpert::data::node_t>& dests,
+                       netxpert::data::ODResultStore& result,
+                       const int threads = 1);
+            ///\brief Count of bucket entries of the last Solve() call
+            size_t GetBucketEntryCount() const { return this->bucketEntries.size(); }
+
+        private:
+            //entry of the bucket of a node: reached destination and its distance to the node
+            struct BucketEntry
+            {
+                uint32_t destIdx;
+                netxpert::data::cost_t dist;
+            };
+
+            std::shared_ptr<const netxpert::core::ContractionHierarchy> ch;
+            netxpert::data::filtered_graph_t* g = nullptr;
+            netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>* costMap = nullptr;
+
+            std::vector<uint32_t> bucketOffsets;
+            std::vector<BucketEntry> bucketEntries;
+
+            void fillBuckets(const std::vector<netxpert::data::node_t>& dests, const int threads);
+    };
+} //namespace core
+} //namespace netxpert
+
+#endif // ODM_CH_H
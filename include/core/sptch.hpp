@@ -0,0 +1,140 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef SPT_CH_H
+#define SPT_CH_H
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+#include "isptree.hpp"
+#include "sptlem.hpp"
+#include "sptworkspace.hpp"
+#include "contractionhierarchy.hpp"
+
+namespace netxpert {
+
+    namespace core {
+
+    /**
+    *  \brief Core Solver for shortest path queries on a contraction hierarchy.
+    *
+    *   \b Notes on the current implementation
+    *
+    *   The hierarchy is built once on the base network (see netxpert::data::InternalNet::GetContractionHierarchy()).
+    *   Start and end nodes added later are not part of the hierarchy: a small Dijkstra search on the current
+    *   network goes from such a node over the added arcs to the next nodes of the hierarchy, which are then the
+    *   sources of the search in the hierarchy. The original arc of a splitted arc stays in the hierarchy
+    *   (it has the same cost as its parts), so the hierarchy keeps valid and needs no update.
+    *
+    *   A query is a complete upward search from the origin and a backward search from each destination, which
+    *   stops as soon as it cannot improve the best meeting node any more. With SetDests() the upward search
+    *   is shared by all destinations.
+    *
+    *   The contraction hierarchy answers queries with given destinations only. A search for the whole
+    *   shortest path tree (lemon::INVALID as destination) is done with Dijkstra on the current network.
+    */
+    class SPT_CH : public netxpert::core::ISPTree
+    {
+        public:
+            ///\brief Constructor
+            ///\param directed: directed network (default) or unidirectional network (=doubled arcs)
+            SPT_CH(bool directed = true);
+            ///\brief Destructor
+            ~SPT_CH();
+            /* LEMON friendly interface */
+            ///\brief Loads the current network into the core solver
+            ///
+            /// Needed for the added start and end nodes and for the search of the whole shortest path tree.
+            void LoadNet(const uint32_t nmax,  const uint32_t mmax,
+                      netxpert::data::filtered_graph_t* sg,
+                      netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>* cm);
+            ///\brief Loads the (shared) contraction hierarchy of the base network into the core solver
+            void LoadCH(std::shared_ptr<const netxpert::core::ContractionHierarchy> _ch);
+            ///\brief Gets the count of the arcs of the internal graph
+            const uint32_t GetArcCount();
+            ///\brief Gets the count of the nodes of the internal graph
+            const uint32_t GetNodeCount();
+            ///\brief Solves the SPT Problem
+            ///\param threshold: destinations with a greater distance are not reached
+            ///\param bidirectional: ignored; the query in the hierarchy is always bidirectional
+            void SolveSPT(netxpert::data::cost_t threshold = -1, bool bidirectional = false);
+            ///\brief Sets the origin for the spt search
+            void SetOrigin( netxpert::data::node_t _origin );
+            ///\brief Sets the destionation node for the spt search
+            ///
+            /// lemon::INVALID as destination computes the whole shortest path tree (without the hierarchy).
+            void SetDest( netxpert::data::node_t _dest );
+            ///\brief Sets the destination nodes for a one-to-many spt search
+            ///
+            /// An empty vector computes the whole shortest path tree (without the hierarchy).
+            void SetDests( const std::vector<netxpert::data::node_t>& _dests );
+            ///\brief Limits the one-to-many spt search to the given count of nearest destinations
+            ///
+            /// All destinations are queried in the hierarchy, only the nearest ones are kept; 0 keeps all of them.
+            void SetDestLimit( const size_t limit );
+            ///\brief Tells if the given destination node has been reached from the origin node
+            ///\return true if reached, false if not reachable from the origin
+            bool Reached( netxpert::data::node_t _node );
+            ///\brief Gets all predecessor nodes from the destination node to the origin node
+            ///\return the reverse path with nodes from destination to origin if found in the spt solver
+            const std::vector<netxpert::data::node_t> GetPredecessors(netxpert::data::node_t _dest);
+            ///\brief Gets the path represented as arcs from origin node to the destination node for the spt search
+            const std::vector<netxpert::data::arc_t> GetPath(netxpert::data::node_t _dest);
+            ///\brief Gets the distance from the origin node to the given destination node
+            const netxpert::data::cost_t GetDist(netxpert::data::node_t _dest);
+            ///\brief Gets the nodes settled in the last search
+            ///
+            /// The nodes of the whole shortest path tree without destinations, else the reached destinations.
+            const std::vector<netxpert::data::node_t> GetSettledNodes();
+            /* end of LEMON friendly interface */
+
+        private:
+            //result of a query for one destination
+            struct Result
+            {
+                netxpert::data::cost_t dist;
+                int meet;                                 //meeting node in the hierarchy; -1 if the path is local only
+                std::vector<uint32_t> downChain;          //downward arcs from the meeting node to the backward source
+                std::vector<netxpert::data::arc_t> suffix;//arcs from the backward source to the destination
+            };
+
+            bool isDrctd;
+            bool allDests;
+            bool useDijkstra = false;
+            std::vector<netxpert::data::node_t> dests;
+            size_t destLimit = 0;
+            netxpert::data::node_t orig;
+            netxpert::data::node_t dest;
+
+            std::shared_ptr<const netxpert::core::ContractionHierarchy> ch;
+            netxpert::data::filtered_graph_t* g;
+            netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>* costMap;
+            //whole shortest path tree
+            netxpert::core::SPT_LEM dijkstra;
+
+            netxpert::core::SPTWorkspace fwd;
+            netxpert::core::SPTWorkspace bwd;
+            std::unordered_map<int, netxpert::core::ContractionHierarchy::LocalLabel> fwdLocal;
+            std::unordered_map<int, Result> results;
+
+            void solveTarget(netxpert::data::node_t target, netxpert::data::cost_t threshold);
+    };
+} //namespace core
+} //namespace netxpert
+
+#endif // SPT_CH_H
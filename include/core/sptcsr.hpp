@@ -0,0 +1,130 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef SPT_CSR_H
+#define SPT_CSR_H
+
+#include <vector>
+#include <memory>
+
+#include "isptree.hpp"
+#include "sptworkspace.hpp"
+
+namespace netxpert {
+
+    namespace core {
+
+    /**
+    *  \brief Core Solver for the Shortest Path Tree Problem
+    *   with Dijkstra's algorithm on an immutable CSR snapshot of the network.
+    *
+    *   \b Notes on the current implementation
+    *
+    *   The LEMON graph must stay mutable for adding start and end nodes and for filtering arcs.
+    *   At query time however the graph does not change any more, so the network is frozen into
+    *   contiguous offset, target and cost arrays (netxpert::data::CSRGraph) without the filtered arcs.
+    *   The scan of the outgoing arcs of a node is then a linear walk over memory instead of following
+    *   the linked arc lists of the smart graph and checking the arc filter for every arc.
+    *
+    *   The snapshot is read only and can be shared between all threads (see LoadCSR()); each instance
+    *   keeps its own SPTWorkspace. Results are returned as nodes and arcs of the LEMON graph
+    *   the snapshot was taken from.
+    *
+    *   There is no bidirectional search on the snapshot; a 1:1 search stops as soon as the
+    *   destination has been settled.
+    */
+    class SPT_CSR : public netxpert::core::ISPTree
+    {
+        public:
+            ///\brief Constructor
+            ///\param directed: directed network (default) or unidirectional network (=doubled arcs)
+            ///\param singlePrecision: snapshots taken in LoadNet() store the arc costs as 32-bit floats
+            SPT_CSR(bool directed = true, bool singlePrecision = false);
+            ///\brief Destructor
+            ~SPT_CSR();
+            /* LEMON friendly interface */
+            ///\brief Loads the network into the core solver
+            ///
+            /// Takes a private CSR snapshot of the given filtered graph.
+            void LoadNet(const uint32_t nmax,  const uint32_t mmax,
+                      netxpert::data::filtered_graph_t* sg,
+                      netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>* cm);
+            ///\brief Loads a (shared) CSR snapshot into the core solver
+            ///\see netxpert::InternalNet::FreezeToCSR()
+            void LoadCSR(std::shared_ptr<const netxpert::data::CSRGraph> _csr);
+            ///\brief Gets the count of the arcs of the internal graph
+            const uint32_t GetArcCount();
+            ///\brief Gets the count of the nodes of the internal graph
+            const uint32_t GetNodeCount();
+            ///\brief Solves the SPT Problem
+            ///\param threshold: if that distance value has been exceeded, the Dijkstra search will stop
+            ///\param bidirectional: not supported on the CSR snapshot; ignored
+            void SolveSPT(netxpert::data::cost_t threshold = -1, bool bidirectional = false);
+            ///\brief Sets the origin for the spt search
+            void SetOrigin( netxpert::data::node_t _origin );
+            ///\brief Sets the destionation node for the spt search
+            ///
+            /// lemon::INVALID as destination computes the whole shortest path tree.
+            void SetDest( netxpert::data::node_t _dest );
+            ///\brief Sets the destination nodes for a one-to-many spt search
+            ///
+            /// The search stops as soon as all destinations are settled or the threshold is exceeded.
+            /// An empty vector computes the whole shortest path tree.
+            void SetDests( const std::vector<netxpert::data::node_t>& _dests );
+            ///\brief Limits the one-to-many spt search to the given count of nearest destinations
+            ///
+            /// The search stops as soon as that many destinations are settled; 0 settles all of them.
+            void SetDestLimit( const size_t limit );
+            ///\brief Tells if the given node has been reached from the origin node in the spt search
+            ///
+            /// In the one-to-many search only settled nodes count as reached, because the distances
+            /// of the other nodes are not final.
+            ///\return true if reached, false if not reachable from the origin
+            bool Reached( netxpert::data::node_t _node );
+            ///\brief Gets all predecessor nodes from the destination node to the origin node
+            ///\return the reverse path with nodes from destination to origin if found in the spt solver
+            const std::vector<netxpert::data::node_t> GetPredecessors(netxpert::data::node_t _dest);
+            ///\brief Gets the path represented as arcs from origin node to the destination node for the spt search
+            const std::vector<netxpert::data::arc_t> GetPath(netxpert::data::node_t _dest);
+            ///\brief Gets the distance from the origin node to the given destination node
+            const netxpert::data::cost_t GetDist(netxpert::data::node_t _dest);
+            ///\brief Gets the nodes settled in the last search in the order of their distances
+            const std::vector<netxpert::data::node_t> GetSettledNodes();
+            /* end of LEMON friendly interface */
+
+        private:
+            bool isDrctd;
+            bool singlePrecision;
+            bool allDests;
+            bool multiTarget = false;
+            std::vector<netxpert::data::node_t> dests;
+            std::vector<char> destMarks; //indexed by node index
+            size_t destLimit = 0;
+
+            std::shared_ptr<const netxpert::data::CSRGraph> csr;
+            netxpert::core::SPTWorkspace workspace; //predecessors are arc positions in the snapshot
+
+            netxpert::data::node_t orig;
+            netxpert::data::node_t dest;
+
+            void runDijkstra(netxpert::data::cost_t threshold, int stopNode, size_t destsLeft);
+            template <typename CostVector>
+            void runDijkstra(const CostVector& costs, netxpert::data::cost_t threshold, int stopNode, size_t destsLeft);
+    };
+} //namespace core
+} //namespace netxpert
+
+#endif // SPT_CSR_H
@@ -47,6 +47,7 @@
 #include "lemon/adaptors.h"
 
 #include "isptree.hpp"
+#include "sptworkspace.hpp"
 
 using namespace lemon;
 using namespace netxpert::data;
@@ -130,8 +131,22 @@ namespace netxpert {
             ///\brief Sets the origin for the spt search
             void SetOrigin( netxpert::data::node_t _origin );
             ///\brief Sets the destionation node for the spt search
+            ///
+            /// lemon::INVALID as destination computes the whole shortest path tree.
             void SetDest( netxpert::data::node_t _dest );
+            ///\brief Sets the destination nodes for a one-to-many spt search
+            ///
+            /// The search stops as soon as all destinations are settled or the threshold is exceeded.
+            /// An empty vector computes the whole shortest path tree.
+            void SetDests( const std::vector<netxpert::data::node_t>& _dests );
+            ///\brief Limits the one-to-many spt search to the given count of nearest destinations
+            ///
+            /// The search stops as soon as that many destinations are settled; 0 settles all of them.
+            void SetDestLimit( const size_t limit );
             ///\brief Tells if the given node has been reached from the origin node in the spt search
+            ///
+            /// In the one-to-many search only settled nodes count as reached, because the distances
+            /// of the other nodes are not final.
             ///\return true if reached, false if not reachable from the origin
             bool Reached( netxpert::data::node_t _node );
             ///\brief Gets all predecessor nodes from the destination node to the origin node
@@ -141,6 +156,10 @@ namespace netxpert {
             const std::vector<netxpert::data::arc_t> GetPath(netxpert::data::node_t _dest);
             ///\brief Gets the distance from the origin node to the given destination node
             const netxpert::data::cost_t GetDist(netxpert::data::node_t _dest);
+            ///\brief Gets the nodes settled in the last search in the order of their distances
+            ///
+            /// Empty after a bidirectional search.
+            const std::vector<netxpert::data::node_t> GetSettledNodes();
             /* end of LEMON friendly interface */
 
             /* Contraction Hierarchies */
@@ -182,6 +201,15 @@ namespace netxpert {
             bool isDrctd;
             bool allDests;
             bool bidirectional = false;
+            //one-to-many search
+            bool multiTarget = false;
+            std::vector<netxpert::data::node_t> dests;
+            std::vector<char> destMarks; //indexed by node id
+            size_t destLimit = 0;
+            void solveMultiTarget(netxpert::data::cost_t threshold);
+            //persistent search space of the (unidirectional) Dijkstra; kept across searches
+            netxpert::core::SPTWorkspace workspace;
+            void runDijkstra(netxpert::data::cost_t threshold, netxpert::data::node_t stopNode, size_t destsLeft);
 
             //DijkstraInternal* dijk;
             /*lemon::Dijkstra<netxpert::data::graph_t, netxpert::data::graph_t::ArcMap<cost_t>>* dijk;
@@ -192,7 +220,6 @@ namespace netxpert {
             netxpert::data::node_t dest;
             std::vector<netxpert::data::node_t> nodes;*/
 
-            std::unique_ptr<dijkstra_t> dijk;
             std::unique_ptr<bijkstra_t> bijk;
 
             netxpert::data::filtered_graph_t* g;
@@ -0,0 +1,150 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef SPT_WORKSPACE_H
+#define SPT_WORKSPACE_H
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include "data.hpp"
+
+namespace netxpert {
+
+    namespace core {
+
+    /**
+    * \brief Persistent workspace for Dijkstra searches.
+    *
+    * Holds the node sized distance, predecessor and state arrays and the heap of a shortest path search.
+    * The arrays are allocated once and kept across searches, e.g. one workspace per thread for all origins.
+    *
+    * Resetting is lazy: every node carries the version stamp of the search that touched it last.
+    * A new search only increments the version, so a search costs O(visited nodes) and not O(n).
+    *
+    * The heap is a binary heap with lazy deletion (outdated entries are skipped on pop), so no
+    * node sized cross reference map is needed.
+    */
+    class SPTWorkspace
+    {
+        typedef std::pair<netxpert::data::cost_t, int> heap_entry_t;
+
+        public:
+            ///\brief Constructor
+            SPTWorkspace() {}
+            ///\brief Grows the workspace to the given count of node IDs (max node id + 1); never shrinks
+            void Resize(const size_t nodeIDCount) {
+                if (dist.size() < nodeIDCount) {
+                    dist.resize(nodeIDCount, 0);
+                    predArc.resize(nodeIDCount, -1);
+                    reachedStamp.resize(nodeIDCount, 0);
+                    settledStamp.resize(nodeIDCount, 0);
+                }
+            }
+            ///\brief Count of node IDs the workspace can hold
+            size_t Size() const {
+                return dist.size();
+            }
+            ///\brief Starts a new search: all nodes are unreached again
+            void NewSearch() {
+                heap.clear();
+                settledNodes.clear();
+                version += 1;
+                //overflow of the version: clear stamps once
+                if (version == 0) {
+                    std::fill(reachedStamp.begin(), reachedStamp.end(), 0);
+                    std::fill(settledStamp.begin(), settledStamp.end(), 0);
+                    version = 1;
+                }
+            }
+            ///\brief Node has been reached (settled or in the queue) in the current search
+            inline bool Reached(const int nodeID) const {
+                return reachedStamp[nodeID] == version;
+            }
+            ///\brief Node has been settled (distance is final) in the current search
+            inline bool Settled(const int nodeID) const {
+                return settledStamp[nodeID] == version;
+            }
+            ///\brief Distance of the node; tentative if not settled. Only valid if the node has been reached.
+            inline netxpert::data::cost_t Dist(const int nodeID) const {
+                return dist[nodeID];
+            }
+            ///\brief ID of the predecessor arc of the node; -1 for the origin. Only valid if the node has been reached.
+            inline int PredArc(const int nodeID) const {
+                return predArc[nodeID];
+            }
+            ///\brief Relaxes the node with the given distance and predecessor arc
+            ///\return true if the distance of the node has been improved
+            inline bool Relax(const int nodeID, const netxpert::data::cost_t d, const int pred) {
+                if (Reached(nodeID) && d >= dist[nodeID])
+                    return false;
+
+                reachedStamp[nodeID] = version;
+                dist[nodeID] = d;
+                predArc[nodeID] = pred;
+                heap.push_back( heap_entry_t(d, nodeID) );
+                std::push_heap(heap.begin(), heap.end(), std::greater<heap_entry_t>());
+                return true;
+            }
+            ///\brief True if there is no node left to settle
+            inline bool EmptyQueue() {
+                skipOutdated();
+                return heap.empty();
+            }
+            ///\brief Distance of the next node to settle
+            ///\warning Call EmptyQueue() first
+            inline netxpert::data::cost_t NextDist() const {
+                return heap.front().first;
+            }
+            ///\brief Settles the next node and returns its ID
+            ///\warning Call EmptyQueue() first
+            inline int SettleNext() {
+                std::pop_heap(heap.begin(), heap.end(), std::greater<heap_entry_t>());
+                const int nodeID = heap.back().second;
+                heap.pop_back();
+                settledStamp[nodeID] = version;
+                settledNodes.push_back(nodeID);
+                return nodeID;
+            }
+            ///\brief IDs of the nodes settled in the current search in the order of their distances
+            inline const std::vector<int>& SettledNodes() const {
+                return settledNodes;
+            }
+
+        private:
+            std::vector<netxpert::data::cost_t> dist;
+            std::vector<int> predArc;
+            std::vector<uint32_t> reachedStamp;
+            std::vector<uint32_t> settledStamp;
+            uint32_t version = 0;
+            std::vector<heap_entry_t> heap;
+            std::vector<int> settledNodes;
+
+            //removes entries of settled nodes or with outdated distances from the top of the heap
+            inline void skipOutdated() {
+                while (!heap.empty()) {
+                    const heap_entry_t& top = heap.front();
+                    if (!Settled(top.second) && top.first <= dist[top.second])
+                        return;
+                    std::pop_heap(heap.begin(), heap.end(), std::greater<heap_entry_t>());
+                    heap.pop_back();
+                }
+            }
+    };
+} //namespace core
+} //namespace netxpert
+#endif // SPT_WORKSPACE_H
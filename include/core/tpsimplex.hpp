@@ -0,0 +1,135 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef TP_SIMPLEX_H
+#define TP_SIMPLEX_H
+
+#include <vector>
+#include <stdint.h>
+
+#include "data.hpp"
+
+namespace netxpert {
+
+    namespace core {
+
+    /**
+    *  \brief Core Solver for the Transportation Problem with the transportation simplex method
+    *   on a dense cost matrix (origins x destinations).
+    *
+    *   \b Notes on the current implementation
+    *
+    *   The solver works on the row-major cost array of the origin destination matrix directly; there is no
+    *   network with node IDs in between. The initial basis is built with Vogel's approximation method
+    *   (rows and columns are sorted by cost once, so the penalties can be updated cheaply). The basis is
+    *   improved with the MODI method (row and column potentials u, v) and block search pricing like in the
+    *   NetworkSimplex of LEMON: a block of cells is scanned and the cell with the most negative reduced cost
+    *   c(i,j) - u(i) - v(j) enters the basis. Of several blocking cells the one met last on the cycle from its
+    *   apex leaves (like in LEMON's strongly feasible trees); as the Vogel basis is not strongly feasible, long
+    *   runs of degenerate pivots switch to Bland's rule until flow moves again, so the basis cannot cycle.
+    *
+    *   Unbalanced instances are handled with an implicit slack row (extra demand) or slack column (extra supply)
+    *   with zero costs that is never stored. Cells that are not allowed (e.g. not reached by the OD matrix
+    *   solver) never enter the basis; if the initial basis needs one, it gets a prohibitive cost and the
+    *   instance is infeasible if it still carries flow at the end.
+    *
+    *   Status codes are the same as of the Minimum Cost Flow solvers (netxpert::data::MCFSolverStatus).
+    */
+    class TransportationSimplex
+    {
+        public:
+            ///\brief Constructor
+            TransportationSimplex();
+            ///\brief Loads the instance
+            ///
+            /// The arrays are not copied and must be valid until Solve() has returned.
+            ///\param costs: row-major cost matrix of size supplies.size() x demands.size()
+            ///\param supplies: supply of each origin (row)
+            ///\param demands: demand of each destination (column); positive values
+            ///\param allowed: optional mask of the same size as costs; cells with 0 are not allowed
+            void LoadMatrix(const std::vector<netxpert::data::cost_t>& costs,
+                            const std::vector<netxpert::data::supply_t>& supplies,
+                            const std::vector<netxpert::data::supply_t>& demands,
+                            const std::vector<char>* allowed = nullptr);
+            ///\brief Solves the Transportation Problem
+            void Solve();
+            ///\brief Gets the status of the solver (see netxpert::data::MCFSolverStatus)
+            const int GetStatus() const {
+                return status;
+            }
+            ///\brief Gets the overall optimum of the problem
+            const double GetOptimum() const {
+                return optimum;
+            }
+            ///\brief Gets the cells with flow (slack excluded)
+            std::vector<netxpert::data::TransportationCell> GetFlows() const;
+            ///\brief Gets the count of the pivots of the last Solve()
+            const uint32_t GetIterationCount() const {
+                return iterations;
+            }
+
+        private:
+            struct BasicCell
+            {
+                uint32_t row;
+                uint32_t col;
+                netxpert::data::flow_t flow;
+            };
+
+            inline bool isAllowed(const uint32_t row, const uint32_t col) const;
+            inline netxpert::data::cost_t cellCost(const uint32_t row, const uint32_t col) const;
+            void buildVogelBasis();
+            void computePotentials();
+            void updateSubtree(const uint32_t subRoot, const netxpert::data::cost_t deltaU, const netxpert::data::cost_t deltaV);
+            inline uint32_t otherNode(const uint32_t cellIdx, const uint32_t node) const;
+            bool findEnteringCell(uint32_t& row, uint32_t& col);
+            bool findEnteringCellBland(uint32_t& row, uint32_t& col) const;
+            bool pivot(const uint32_t row, const uint32_t col, const bool bland);
+            void addBasicCell(const uint32_t row, const uint32_t col, const netxpert::data::flow_t flow);
+
+            const std::vector<netxpert::data::cost_t>* costs;
+            const std::vector<netxpert::data::supply_t>* supplies;
+            const std::vector<netxpert::data::supply_t>* demands;
+            const std::vector<char>* allowed;
+            uint32_t origCount;
+            uint32_t destCount;
+            //with slack row or column
+            uint32_t rowCount;
+            uint32_t colCount;
+            netxpert::data::supply_t slackAmount;
+            netxpert::data::cost_t prohibitiveCost;
+
+            //basis: spanning tree on rows (0..rowCount-1) and columns (rowCount..rowCount+colCount-1)
+            //rooted at the first row
+            std::vector<BasicCell> basis;
+            std::vector<std::vector<uint32_t> > incidentCells;
+            std::vector<int64_t> parentCell;
+            std::vector<uint32_t> depth;
+            std::vector<netxpert::data::cost_t> u;
+            std::vector<netxpert::data::cost_t> v;
+            std::vector<uint32_t> stack;
+            //pricing
+            uint64_t nextCell;
+            uint64_t blockSize;
+
+            int status;
+            double optimum;
+            uint32_t iterations;
+    };
+} //namespace core
+} //namespace netxpert
+
+#endif // TP_SIMPLEX_H
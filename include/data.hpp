@@ -24,6 +24,8 @@
 #include "geos/geom/LineString.h"
 #include <unordered_map>
 #include <vector>
+#include <map>
+#include <algorithm>
 #include <cereal/cereal.hpp>
 #include <cereal/archives/json.hpp>
 #include <cereal/types/unordered_map.hpp>
@@ -97,7 +99,8 @@ namespace netxpert {
         MinSpanningTreeSolver = 4,    //!< \brief Minimum Spanning Tree solver type
         TransshipmentSolver = 5,      //!< \brief Transshipment solver type
         NetworkBuilderResult = 6,     //!< \brief NetworkBuilder solver type
-        IsolinesSolver = 7            //!< \brief Isolines solver type \warning experimental!
+        IsolinesSolver = 7,           //!< \brief Isolines solver type \warning experimental!
+        IsolinesPolygonSolver = 8     //!< \brief Isolines solver type with polygon output \warning experimental!
     };
 
     /**
@@ -163,6 +166,19 @@ namespace netxpert {
         std::shared_ptr<geos::geom::Geometry> arcGeom;
     };
 
+    /**
+    * \brief Original arc with its attributes and geometry (e.g. for the in-memory spatial index of the arcs)
+    **/
+    struct ExtArcWithGeom
+    {
+        std::string extArcID;
+        std::string extFromNode;
+        std::string extToNode;
+        cost_t      cost;
+        capacity_t  capacity;
+        std::shared_ptr<geos::geom::Geometry> arcGeom;
+    };
+
     /**
     * \brief Custom data type for storing external nodes tuple <fromNode,toNode> as simple type variant
     **/
@@ -383,10 +399,53 @@ namespace netxpert {
         cost_t       cost;
     };
 
+    /**
+    * \brief Changed supply (positive) or demand (negative) of a node for a re-solve of the Minimum Cost Flow solver
+    **/
+    struct NodeSupplyChange
+    {
+        netxpert::data::node_t node;
+        supply_t               supply;
+    };
+    /**
+    * \brief Changed cost of an arc for a re-solve of the Minimum Cost Flow solver
+    **/
+    struct ArcCostChange
+    {
+        netxpert::data::arc_t arc;
+        cost_t                cost;
+    };
+
+    /**
+    * \brief Shape of a Minimum Cost Flow instance that decides on the algorithm in automatic mode
+    **/
+    struct MCFInstanceShape
+    {
+        uint32_t     NodeCount;
+        uint32_t     ArcCount;
+        uint32_t     SourceCount;
+        uint32_t     SinkCount;
+        uint32_t     TightArcCount; //!< arcs with a capacity below the largest supply or demand of a node
+        bool         IntegralFlows; //!< supplies and finite capacities are integral (scaled with the integer precision)
+        bool         IntegralCosts; //!< costs are integral (scaled with the integer precision)
+    };
+
     ///\brief Data type for storing tuple <CompressedPath,cost>
     /*typedef std::pair<std::vector<uint32_t>,double> CompressedPath;*/
     typedef std::pair<std::vector<netxpert::data::arc_t>, netxpert::data::cost_t> CompressedPath;
 
+    ///\brief Data type for storing the distance labels <node,cost> of the reached nodes of a shortest path tree
+    typedef std::vector<std::pair<netxpert::data::node_t, netxpert::data::cost_t> > DistLabels;
+
+    ///\brief Arc that leaves a reached node of a shortest path tree with the distance labels of both ends
+    struct IsoTreeArc
+    {
+        netxpert::data::arc_t  arc;
+        netxpert::data::cost_t cost;
+        netxpert::data::cost_t sourceDist;
+        netxpert::data::cost_t targetDist; //!< max cost_t if the arc is not reached from its target
+    };
+
     ///\brief Data type for storing tuple <CompressedPath,flow>
     struct DistributionArc
     {
@@ -394,6 +453,206 @@ namespace netxpert {
         flow_t          flow;
     };
 
+    ///\brief Cost of a cell (origin index, destination index) of a sparse origin destination matrix
+    struct ODCell
+    {
+        uint32_t origIdx;
+        uint32_t destIdx;
+        cost_t   cost;
+    };
+
+    ///\brief Flow of a cell (origin index, destination index) of a dense transportation problem
+    struct TransportationCell
+    {
+        uint32_t origIdx;
+        uint32_t destIdx;
+        flow_t   flow;
+    };
+
+    /**
+    * \brief Dense result store of an origin destination matrix computation.
+    *
+    * Costs (and optionally paths) are stored row-major in flat arrays of size origins x destinations.
+    * Every row belongs to exactly one origin, so a thread that solves an origin can write its row
+    * without locking. The std::map views are only built on demand.
+    **/
+    struct ODResultStore
+    {
+        std::vector<netxpert::data::node_t> origins;
+        std::vector<netxpert::data::node_t> dests;
+        std::vector<netxpert::data::cost_t> costs;
+        // char instead of bool: std::vector<bool> is not safe for concurrent writes to neighbouring cells
+        std::vector<char> reached;
+        std::vector<std::vector<netxpert::data::arc_t> > paths;
+        // paths that were rebuilt on demand for single cells if paths are not stored (costs only)
+        std::unordered_map<size_t, std::vector<netxpert::data::arc_t> > lazyPaths;
+        bool storePaths = true;
+
+        ///\brief Allocates the store for the given origins and destinations; resets all values
+        void Init(const std::vector<netxpert::data::node_t>& origs,
+                  const std::vector<netxpert::data::node_t>& dsts,
+                  const bool withPaths) {
+            origins = origs;
+            dests = dsts;
+            storePaths = withPaths;
+            const size_t cells = origins.size() * dests.size();
+            costs.assign(cells, DOUBLE_INFINITY);
+            reached.assign(cells, 0);
+            paths.clear();
+            lazyPaths.clear();
+            if (storePaths)
+                paths.resize(cells);
+        }
+        ///\brief Clears the store
+        void Clear() {
+            origins.clear(); dests.clear(); costs.clear(); reached.clear(); paths.clear(); lazyPaths.clear();
+        }
+        ///\brief Flat index of the cell (origin index, destination index)
+        inline size_t Index(const size_t origIdx, const size_t destIdx) const {
+            return origIdx * dests.size() + destIdx;
+        }
+        ///\brief Writes the cost of a reached cell
+        inline void Set(const size_t origIdx, const size_t destIdx, const netxpert::data::cost_t cost) {
+            const size_t i = Index(origIdx, destIdx);
+            costs[i] = cost;
+            reached[i] = 1;
+        }
+        ///\brief Writes the cost and the path of a reached cell; the path is only kept if paths are stored
+        inline void Set(const size_t origIdx, const size_t destIdx, const netxpert::data::cost_t cost,
+                        std::vector<netxpert::data::arc_t> path) {
+            Set(origIdx, destIdx, cost);
+            if (storePaths)
+                paths[Index(origIdx, destIdx)] = std::move(path);
+        }
+        ///\brief True if the path of the given cell is available (stored or rebuilt on demand)
+        inline bool HasPath(const size_t cell) const {
+            return storePaths || lazyPaths.count(cell) > 0;
+        }
+        ///\brief Gets the path of the given cell; empty if the path is not available
+        const std::vector<netxpert::data::arc_t>& GetPath(const size_t cell) const {
+            static const std::vector<netxpert::data::arc_t> emptyPath;
+            if (storePaths)
+                return paths[cell];
+            auto it = lazyPaths.find(cell);
+            return it != lazyPaths.end() ? it->second : emptyPath;
+        }
+        ///\brief True if the cell (origin index, destination index) was reached
+        inline bool IsReached(const size_t origIdx, const size_t destIdx) const {
+            return reached[Index(origIdx, destIdx)] != 0;
+        }
+        ///\brief Number of reached cells
+        size_t CountReached() const {
+            size_t count = 0;
+            for (const char r : reached)
+                count += (r != 0);
+            return count;
+        }
+        ///\brief Sum of the costs of all reached cells
+        netxpert::data::cost_t SumCosts() const {
+            netxpert::data::cost_t sum = 0;
+            for (size_t i = 0; i < costs.size(); i++)
+                if (reached[i])
+                    sum += costs[i];
+            return sum;
+        }
+        ///\brief Builds the ordered map view <ODPair, cost> of all reached cells
+        std::map<netxpert::data::ODPair, netxpert::data::cost_t> ToODMatrix() const {
+            std::map<netxpert::data::ODPair, netxpert::data::cost_t> result;
+            for (size_t o = 0; o < origins.size(); o++)
+                for (size_t d = 0; d < dests.size(); d++)
+                    if (IsReached(o, d))
+                        result.insert( std::make_pair( ODPair {origins[o], dests[d]}, costs[Index(o, d)] ) );
+            return result;
+        }
+        ///\brief Builds the ordered map view <ODPair, CompressedPath> of all reached cells
+        ///
+        /// Paths are empty if the store was initialized without paths and they were not rebuilt on demand.
+        std::map<netxpert::data::ODPair, netxpert::data::CompressedPath> ToShortestPaths() const {
+            std::map<netxpert::data::ODPair, netxpert::data::CompressedPath> result;
+            for (size_t o = 0; o < origins.size(); o++)
+                for (size_t d = 0; d < dests.size(); d++)
+                    if (IsReached(o, d)) {
+                        const size_t i = Index(o, d);
+                        result.insert( std::make_pair( ODPair {origins[o], dests[d]},
+                                                       std::make_pair( GetPath(i), costs[i] ) ) );
+                    }
+            return result;
+        }
+    };
+
+    /**
+    * \brief Immutable compressed sparse row (CSR) snapshot of the internal graph.
+    *
+    * The outgoing arcs of the node with index v are stored at the positions offsets[v] .. offsets[v+1]-1
+    * of the arc arrays. Filtered arcs are not part of the snapshot. Node indices are the node IDs of
+    * the internal graph; arcIDs holds the internal arc ID of each position.
+    * The costs are stored either in double (costs) or in single precision (costs32).
+    **/
+    struct CSRGraph
+    {
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> targets;
+        std::vector<int32_t>  arcIDs;
+        std::vector<netxpert::data::cost_t> costs;
+        std::vector<float>    costs32;
+        bool singlePrecision = false;
+
+        ///\brief Count of nodes (node indices) of the snapshot
+        uint32_t NodeCount() const {
+            return offsets.size() > 0 ? offsets.size() - 1 : 0;
+        }
+        ///\brief Count of arcs of the snapshot
+        uint32_t ArcCount() const {
+            return targets.size();
+        }
+        ///\brief Cost of the arc at the given position
+        inline netxpert::data::cost_t Cost(const uint32_t pos) const {
+            return singlePrecision ? costs32[pos] : costs[pos];
+        }
+        ///\brief Source node index of the arc at the given position (binary search on the offsets)
+        uint32_t Source(const uint32_t pos) const {
+            return std::upper_bound(offsets.begin(), offsets.end(), pos) - offsets.begin() - 1;
+        }
+        ///\brief Builds the snapshot from the given (filtered) LEMON graph and its cost map
+        template <typename Graph, typename CostMap>
+        void Build(const Graph& g, const CostMap& cm, const bool _singlePrecision = false) {
+            singlePrecision = _singlePrecision;
+            const uint32_t nodeIDCount = g.maxNodeId() + 1;
+            const uint32_t arcCount = lemon::countArcs(g);
+
+            offsets.assign(nodeIDCount + 1, 0);
+            targets.clear();
+            targets.reserve(arcCount);
+            arcIDs.clear();
+            arcIDs.reserve(arcCount);
+            costs.clear();
+            costs32.clear();
+            if (singlePrecision)
+                costs32.reserve(arcCount);
+            else
+                costs.reserve(arcCount);
+
+            for (uint32_t v = 0; v < nodeIDCount; v++) {
+                offsets[v] = targets.size();
+                for (typename Graph::OutArcIt a(g, g.nodeFromId(v)); a != lemon::INVALID; ++a) {
+                    targets.push_back( g.id(g.target(a)) );
+                    arcIDs.push_back( g.id(a) );
+                    if (singlePrecision)
+                        costs32.push_back( static_cast<float>(cm[a]) );
+                    else
+                        costs.push_back( cm[a] );
+                }
+            }
+            offsets[nodeIDCount] = targets.size();
+        }
+        ///\brief Memory footprint of the snapshot in bytes
+        size_t MemoryUsage() const {
+            return offsets.capacity() * sizeof(uint32_t) + targets.capacity() * sizeof(uint32_t)
+                    + arcIDs.capacity() * sizeof(int32_t) + costs.capacity() * sizeof(netxpert::data::cost_t)
+                    + costs32.capacity() * sizeof(float);
+        }
+    };
+
     ///\brief Data type for storing tuple <extArcID,extArc,cost,flow>
     struct ExtDistributionArc
     {
@@ -478,20 +737,25 @@ namespace netxpert {
         supply_t                supply;
     };
 
-    ///\brief Data type for storing tuple <arcGeom,nodeType,cost,capacity>
+    ///\brief Data type for storing tuple <arcGeom,nodeType,cost,capacity,reversed>
+    ///
+    /// reversed: the arc runs from the end to the start of arcGeom
     struct NewArc
     {
-        NewArc(geos::geom::LineString& _arcGeom, netxpert::data::AddedNodeType _nodeType, cost_t _cost, capacity_t _capacity ) {
+        NewArc(geos::geom::LineString& _arcGeom, netxpert::data::AddedNodeType _nodeType, cost_t _cost, capacity_t _capacity,
+               bool _reversed = false ) {
             arcGeom     = std::shared_ptr<geos::geom::LineString>(dynamic_cast<geos::geom::LineString*>( _arcGeom.clone()) );
             nodeType    = _nodeType;
             cost        = _cost;
             capacity    = _capacity;
+            reversed    = _reversed;
         }
 
         std::shared_ptr<geos::geom::LineString> arcGeom;
         netxpert::data::AddedNodeType           nodeType;
         cost_t                                  cost;
         capacity_t                              capacity;
+        bool                                    reversed;
     };
 
     struct SwappedOldArc
@@ -521,6 +785,38 @@ namespace netxpert {
         std::string oneway;
     };
 
+    /**
+    * \brief Columnar form of the input arcs (see netxpert::io::DBHELPER::LoadNetworkColumnsFromDB())
+    *
+    * Index i of the arc columns is the i-th arc. The original node IDs are stored once in nodeIDs;
+    * fromNodes and toNodes hold indices into nodeIDs.
+    **/
+    struct InputArcColumns
+    {
+        std::vector<std::string> nodeIDs;      //!< distinct original node IDs
+        std::vector<int64_t>     intNodeIDs;   //!< distinct original node IDs if all of them are integers (nodeIDs is empty then)
+        std::vector<uint32_t>    fromNodes;    //!< from node per arc (index into nodeIDs or intNodeIDs)
+        std::vector<uint32_t>    toNodes;      //!< to node per arc (index into nodeIDs or intNodeIDs)
+        std::vector<extarcid_t>  arcIDs;       //!< original arc ID per arc
+        std::vector<int64_t>     intArcIDs;    //!< original arc ID per arc if all of them are integers (arcIDs is empty then)
+        std::vector<cost_t>      costs;        //!< cost per arc
+        std::vector<capacity_t>  capacities;   //!< capacity per arc (DOUBLE_INFINITY without capacity column)
+        std::vector<uint8_t>     oneway;       //!< 1 if the oneway column of the arc is "Y"
+
+        ///\brief Count of arcs
+        size_t Size() const {
+            return costs.size();
+        }
+        ///\brief Count of distinct nodes
+        size_t NodeCount() const {
+            return intNodeIDs.empty() ? nodeIDs.size() : intNodeIDs.size();
+        }
+        ///\brief Original node ID of the given node index
+        std::string NodeID(const uint32_t node) const {
+            return intNodeIDs.empty() ? nodeIDs[node] : std::to_string(intNodeIDs[node]);
+        }
+    };
+
     ///\brief Data type for storing tuple <extNodeID,nodeSupply>
     struct InputNode
     {
@@ -20,6 +20,7 @@
 #include <string>
 //determination of type
 #include <typeinfo>
+#include <mutex>
 
 #include "data.hpp"
 #include "logger.hpp"
@@ -38,124 +39,165 @@ namespace netxpert {
     **/
     namespace io {
     /**
-    * \brief Static class that controls the SpatiaLite DB processing access
+    * \brief Data context of one network or job that controls the SpatiaLite DB processing access
 
+    * Every instance owns its connection, its current transaction, its config and the set of eliminated arcs.
+    * Solver jobs that run in the same process therefore do not share any database state; every job
+    * (or every netxpert::data::InternalNet) creates its own DBHELPER.
+    *
+    * Besides the main connection a DBHELPER holds a pool of read-only connections to the netXpert DB
+    * (AcquireReadConnection()). Bulk reads like LoadArcsWithGeomFromDB() take a connection from the pool,
+    * so that parallel snapping and geometry loading do not compete for the main connection.
+    *
     * Notes on precision model of the central Geometry Factory
     *
     * GEOS uses an internal precision model. This must fit to the model in SpatiaLite (which is also defined by GEOS internally).
     * Because splitting of the arcs happens in the SpatiaLite DB, we must have a common precision model of the geometries.
     * So we are tied here to FLOATING (precision of 16 floating point numbers).
+    * The Geometry Factory is immutable and therefore the only member that is shared by all instances.
 
     **/
     class DBHELPER
     {
-        protected:
-            ///\brief Empty Constructor is protected because it is a static class
-            DBHELPER(){}
         public:
-            ///\brief Initializes the static DBHELPER and also the GEO_FACTORY and the Precision Model for all geometries.
-            static void Initialize(const netxpert::cnfg::Config& cnfg);
+            /**
+            * \brief Read-only connection borrowed from the pool of a DBHELPER
+            *
+            * Returns the connection to the pool on destruction. Must not outlive the DBHELPER it was acquired from.
+            **/
+            class ReadConnection
+            {
+                public:
+                    ReadConnection(DBHELPER& owner, std::unique_ptr<SQLite::Database> db);
+                    ReadConnection(ReadConnection&& other);
+                    ReadConnection(const ReadConnection&) = delete;
+                    ReadConnection& operator=(const ReadConnection&) = delete;
+                    ~ReadConnection();
+                    SQLite::Database& operator*() { return *db; }
+                    SQLite::Database* operator->() { return db.get(); }
+                private:
+                    DBHELPER* owner;
+                    std::unique_ptr<SQLite::Database> db;
+            };
+
+            ///\brief Creates the data context for the given config.
+            /// No connection is opened here; the main connection is opened on first use.
+            explicit DBHELPER(const netxpert::cnfg::Config& cnfg);
+            DBHELPER(const DBHELPER&) = delete;
+            DBHELPER& operator=(const DBHELPER&) = delete;
+            ///\brief Closes the main connection and all pooled connections
+            ~DBHELPER();
+
+            ///\brief Gets the config of the data context
+            const netxpert::cnfg::Config& GetConfig() const;
+            ///\brief Gets a read-only connection from the pool (or opens a new one if the pool is empty).
+            /// Thread safe.
+            ReadConnection AcquireReadConnection();
             ///\brief Commits the current transaction
-            static void CommitCurrentTransaction();
+            void CommitCurrentTransaction();
             ///\brief Opens a new database transaction
-            static void OpenNewTransaction();
+            void OpenNewTransaction();
             ///\brief Loads arcs that form a network from the database
-            static netxpert::data::InputArcs LoadNetworkFromDB(const std::string& _tableName,
-                                                               const netxpert::data::ColumnMap& _map);
+            netxpert::data::InputArcs LoadNetworkFromDB(const std::string& _tableName,
+                                                        const netxpert::data::ColumnMap& _map);
+            ///\brief Loads arcs that form a network from the database in columnar form
+            ///
+            /// Reads ROWID ranges of the table in parallel over pooled read-only connections and interns the
+            /// node IDs on the fly; the arcs are not sorted.
+            netxpert::data::InputArcColumns LoadNetworkColumnsFromDB(const std::string& _tableName,
+                                                                     const netxpert::data::ColumnMap& _map);
             ///\brief Loads arcs that shall be built (from and to nodes will be calculated) from the database
-            static netxpert::data::NetworkBuilderInputArcs LoadNetworkToBuildFromDB(const std::string& _tableName,
-                                                                                    const netxpert::data::ColumnMap& _map);
+            netxpert::data::NetworkBuilderInputArcs LoadNetworkToBuildFromDB(const std::string& _tableName,
+                                                                             const netxpert::data::ColumnMap& _map);
             ///\brief Loads all nodes from the database
-            static std::vector<netxpert::data::NewNode> LoadNodesFromDB(const std::string& _tableName, const std::string& geomColName,
-                                                                  const netxpert::data::ColumnMap& _map);
+            std::vector<netxpert::data::NewNode> LoadNodesFromDB(const std::string& _tableName, const std::string& geomColName,
+                                                           const netxpert::data::ColumnMap& _map);
             ///\brief Prepares query for GetClosestArcQuery()
-            static std::unique_ptr<SQLite::Statement> PrepareGetClosestArcQuery(const std::string& tableName,
+            std::unique_ptr<SQLite::Statement> PrepareGetClosestArcQuery(const std::string& tableName,
                                         const std::string& geomColumnName, const netxpert::data::ColumnMap& cmap,
                                         const netxpert::data::ArcIDColumnDataType arcIDColDataType,
                                         const bool withCapacity);
             ///\brief Gets closest arc to given coordinate within the given threshold
-            static netxpert::data::ExtClosestArcAndPoint GetClosestArcFromPoint(const geos::geom::Coordinate& coord,
-                                                                          const int threshold, SQLite::Statement& qry,
-                                                                          const bool withCapacity);
+            netxpert::data::ExtClosestArcAndPoint GetClosestArcFromPoint(const geos::geom::Coordinate& coord,
+                                                                   const int threshold, SQLite::Statement& qry,
+                                                                   const bool withCapacity);
+            ///\brief Loads all arcs (except the eliminated arcs) with their attributes and geometries from the database
+            ///
+            /// Used for building the in-memory spatial index (netxpert::data::ArcSpatialIndex) and the geometry store
+            /// (netxpert::data::ArcGeometryStore) of the arcs. Reads through a pooled read-only connection.
+            std::vector<netxpert::data::ExtArcWithGeom> LoadArcsWithGeomFromDB(const std::string& tableName,
+                                                                   const std::string& geomColName,
+                                                                   const netxpert::data::ColumnMap& cmap,
+                                                                   const bool withCapacity);
             ///\brief Gets single arc geometry from database per ID
-            static std::unique_ptr<geos::geom::MultiLineString> GetArcGeometryFromDB(const std::string& tableName,
+            std::unique_ptr<geos::geom::MultiLineString> GetArcGeometryFromDB(const std::string& tableName,
                                                              const std::string& arcIDColumnName,
                                                              const std::string& geomColumnName,
                                                              const netxpert::data::ArcIDColumnDataType arcIDColDataType,
                                                              const netxpert::data::extarcid_t& arcID);
             ///\brief Gets arc geometries from database per IDs
-            static std::unique_ptr<geos::geom::MultiLineString> GetArcGeometriesFromDB(const std::string& tableName,
-                                                                           const std::string& arcIDColumnName,
-                                                                           const std::string& geomColumnName,
-                                                                           const netxpert::data::ArcIDColumnDataType arcIDColDataType,
-                                                                           const std::string& arcIDs);
+            std::unique_ptr<geos::geom::MultiLineString> GetArcGeometriesFromDB(const std::string& tableName,
+                                                                    const std::string& arcIDColumnName,
+                                                                    const std::string& geomColumnName,
+                                                                    const netxpert::data::ArcIDColumnDataType arcIDColDataType,
+                                                                    const std::string& arcIDs);
             ///\brief Gets arc geometries that intersect with barrier geometries from database
-            static std::unordered_set<netxpert::data::extarcid_t> GetIntersectingArcs(const std::string& barrierTableName,
-                                                                       const std::string& barrierGeomColName,
-                                                                       const std::string& arcsTableName,
-                                                                       const std::string& arcIDColName,
-                                                                       const std::string& arcGeomColName);
+            std::unordered_set<netxpert::data::extarcid_t> GetIntersectingArcs(const std::string& barrierTableName,
+                                                                const std::string& barrierGeomColName,
+                                                                const std::string& arcsTableName,
+                                                                const std::string& arcIDColName,
+                                                                const std::string& arcGeomColName);
             ///\brief Gets barrier geometries from database
-            static std::vector<std::unique_ptr<geos::geom::Geometry>> GetBarrierGeometriesFromDB(const std::string& barrierTableName,
-                                                                       const std::string& barrierGeomColName);
+            std::vector<std::unique_ptr<geos::geom::Geometry>> GetBarrierGeometriesFromDB(const std::string& barrierTableName,
+                                                                const std::string& barrierGeomColName);
             ///\warning untested, alpha stage!
-            static std::unique_ptr<geos::geom::MultiPoint> GetArcVertexGeometriesByBufferFromDB(const std::string& tableName,
-                                                                           const std::string& geomColumnName,
-                                                                           const netxpert::data::ArcIDColumnDataType arcIDColDataType,
-                                                                           const std::string& arcIDColName,
-                                                                           const double bufferVal,
-                                                                           const geos::geom::Coordinate& p);
+            std::unique_ptr<geos::geom::MultiPoint> GetArcVertexGeometriesByBufferFromDB(const std::string& tableName,
+                                                                    const std::string& geomColumnName,
+                                                                    const netxpert::data::ArcIDColumnDataType arcIDColDataType,
+                                                                    const std::string& arcIDColName,
+                                                                    const double bufferVal,
+                                                                    const geos::geom::Coordinate& p);
 
             /// @cond UNUSED
-            static std::unique_ptr<SQLite::Statement>
+            std::unique_ptr<SQLite::Statement>
             PrepareIsPointOnArcQuery(std::string tableName,
                                      std::string arcIDColumnName,
                                      std::string geomColumnName,
                                      netxpert::data::ArcIDColumnDataType arcIDColDataType );
 
-            static bool IsPointOnArc(geos::geom::Coordinate coords,
-                                     std::string extArcID,
-                                     std::shared_ptr<SQLite::Statement> qry);
+            bool IsPointOnArc(geos::geom::Coordinate coords,
+                              std::string extArcID,
+                              std::shared_ptr<SQLite::Statement> qry);
 
-            static double GetPositionOfClosestPoint(std::string arcsGeomColumnName,
-                                                    std::string arcsTableName,
-                                                    geos::geom::Coordinate coord,
-                                                    std::string extArcID,
-                                                    SQLite::Statement& posOfClosestPointQry);
+            double GetPositionOfClosestPoint(std::string arcsGeomColumnName,
+                                             std::string arcsTableName,
+                                             geos::geom::Coordinate coord,
+                                             std::string extArcID,
+                                             SQLite::Statement& posOfClosestPointQry);
             ///@endcond
 
-            ///\brief Closes the database connection
-            static void CloseConnection();
-            ///\brief Indicated if DBHELPER has been already initialized
-            static bool IsInitialized;
+            ///\brief Closes the main database connection
+            void CloseConnection();
             ///\brief Stores the elmininated arcs, that shall be excluded from the databse queries
-            static std::unordered_set<netxpert::data::extarcid_t> EliminatedArcs;
+            std::unordered_set<netxpert::data::extarcid_t> EliminatedArcs;
             ///\brief Geometry Factory for GEOS.
-            /// A precision model is set in the initialization of DBHELPER.
+            /// Created once with the FLOATING precision model.
             /// Used for WKBReader and every geometry creation in netxpert library.
             static geos::geom::GeometryFactory::unique_ptr GEO_FACTORY;
 
-            /* Methods for loading IDs and geometry into a map in memory for fast access to geometries.
-               Much faster (factor x10) than spatialite lookup per primary key lookup of IDs
-            */
-            ///\brief Fills the key value memory store, that speeds up queries for geometries
-            static void LoadGeometryToMem(const std::string& _tableName, const netxpert::data::ColumnMap& _map,
-                                          const std::string& geomColumnName, const std::string& arcIDs);
-            ///\brief Get the geometries from the key value memory store
-            static std::unique_ptr<geos::geom::MultiLineString> GetArcGeometriesFromMem(const std::string& arcIDs);
-
-            ///\brief Destructor
-            ~DBHELPER();
         private:
-            static std::unordered_map<netxpert::data::extarcid_t, std::shared_ptr<geos::geom::LineString>> KV_Network;
-            static netxpert::cnfg::Config NETXPERT_CNFG;
-            static std::unique_ptr<SQLite::Database> connPtr;
-            static std::unique_ptr<SQLite::Transaction> currentTransactionPtr;
-            static void connect(bool inMemory);
-            static bool isConnected;
-            static bool performInitialCommand();
-            static void initSpatialMetaData();
-            static void optimizeSQLiteCon();
+            netxpert::cnfg::Config NETXPERT_CNFG;
+            std::unique_ptr<SQLite::Database> connPtr;
+            std::unique_ptr<SQLite::Transaction> currentTransactionPtr;
+            bool isConnected;
+            ///pool of idle read-only connections
+            std::vector<std::unique_ptr<SQLite::Database>> readConnPool;
+            std::mutex readConnPoolMutex;
+            void releaseReadConnection(std::unique_ptr<SQLite::Database> db);
+            void connect(bool inMemory);
+            bool performInitialCommand(SQLite::Database& db);
+            void initSpatialMetaData();
+            void optimizeSQLiteCon();
     };
 } //namespace io
 } //namespace netxpert
@@ -0,0 +1,145 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef EXTERNALIDTABLE_H
+#define EXTERNALIDTABLE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace netxpert {
+
+    namespace data {
+
+    /**
+    * \brief Original (external) IDs of the nodes or arcs of a network, indexed by their internal ID.
+    *
+    * In text mode every ID is a string with a hash map as reverse index.
+    * In integer mode the IDs are kept in a flat array of 64 bit integers with a sorted reverse index.
+    * The sentinels of netXpert ("dummy" and node IDs renamed with "@netXpert") are stored as flags, so they need
+    * no strings either. IDs that are not integers at all are kept aside as strings; integer mode therefore never
+    * loses an ID, it only gets slower if there are many of them.
+    *
+    * If an ID is registered for several internal IDs, the reverse index keeps the first one (nodes, like
+    * std::unordered_map::insert()) or the highest one (arcs, like the former lemon::mapFind()).
+    * Lookups are thread safe; Set() and BuildIndex() must not run concurrently with them.
+    **/
+    class ExternalIDTable
+    {
+        public:
+            ///\brief Storage of the IDs
+            enum class Mode { Text, Integer };
+            ///\brief Internal ID kept by the reverse index for duplicate IDs
+            enum class Duplicates { KeepFirst, KeepHighest };
+
+            ///\brief Constructor (text mode)
+            explicit ExternalIDTable(const Duplicates duplicates = Duplicates::KeepFirst);
+
+            ///\brief Removes all IDs and switches to the given mode
+            void Reset(const Mode mode);
+            ///\brief Gets the storage mode
+            Mode GetMode() const {
+                return mode;
+            }
+            ///\brief Reserves memory for the given count of internal IDs
+            void Reserve(const size_t count);
+
+            ///\brief True if the given ID is the canonical decimal form of a 64 bit integer
+            ///
+            /// Canonical means that converting the value back gives the same string (no sign, leading zeros or blanks).
+            static bool IsIntegerID(const std::string& id, int64_t& value);
+            ///\brief Mode for IDs like the given one (IDs of one column have the same type)
+            static Mode ModeOf(const std::string& sampleID) {
+                int64_t value;
+                return IsIntegerID(sampleID, value) ? Mode::Integer : Mode::Text;
+            }
+
+            ///\brief Registers the ID of the given internal ID
+            void Set(const uint32_t index, const std::string& id);
+            ///\brief Registers the integer ID of the given internal ID (integer mode without string conversion)
+            void Set(const uint32_t index, const int64_t id);
+            ///\brief Gets the ID of the given internal ID ("" if there is none)
+            std::string Get(const uint32_t index) const;
+            ///\brief True if the given internal ID has no ID
+            bool IsEmpty(const uint32_t index) const;
+            ///\brief True if the given internal ID has the given ID
+            bool Matches(const uint32_t index, const std::string& id) const;
+            ///\brief Looks up the internal ID of the given ID
+            ///\return false if the ID is unknown
+            bool Find(const std::string& id, uint32_t& index) const;
+            ///\brief True if the given ID is known
+            bool Contains(const std::string& id) const {
+                uint32_t index;
+                return Find(id, index);
+            }
+            ///\brief Sorts the IDs registered since the last call into the reverse index (integer mode)
+            ///
+            /// Called after bulk loading; lookups work without it, but hash the recent IDs.
+            void BuildIndex();
+            ///\brief Copies the IDs of the internal IDs 0..count-1 into plain arrays (integer mode only)
+            ///
+            /// kinds gets the storage kind of every ID; values the integer or, for IDs that are no integers,
+            /// the index into texts. Used for binary snapshots of the network.
+            void Export(const uint32_t count, std::vector<int64_t>& values, std::vector<uint8_t>& kinds,
+                        std::vector<std::string>& texts) const;
+            ///\brief Switches to integer mode and loads the IDs of Export() with their reverse index
+            ///
+            /// No ID is parsed; throws std::runtime_error on invalid kinds or text indexes.
+            void Import(const uint32_t count, const int64_t* values, const uint8_t* kinds,
+                        std::vector<std::string>&& texts);
+            ///\brief Count of distinct IDs
+            size_t Count() const;
+            ///\brief Approximate memory usage in bytes
+            size_t MemoryUsage() const;
+
+        private:
+            enum Kind : uint8_t { Empty = 0, Plain, Renamed, Dummy, Text };
+
+            /// reverse index of integer values: sorted part and IDs registered after the last BuildIndex()
+            struct IntIndex
+            {
+                std::vector<std::pair<int64_t, uint32_t> > sorted;
+                std::unordered_map<int64_t, uint32_t> recent;
+                bool Find(const int64_t value, uint32_t& index) const;
+                void Build();
+                void Assign(std::vector<std::pair<int64_t, uint32_t> >&& entries, const bool keepHighest);
+            };
+
+            bool prefer(const uint32_t candidate, const uint32_t existing) const {
+                return duplicates == Duplicates::KeepHighest && candidate > existing;
+            }
+            Kind parse(const std::string& id, int64_t& value) const;
+            void setInteger(const uint32_t index, const Kind kind, const int64_t value);
+            void grow(const uint32_t index);
+
+            Mode       mode;
+            Duplicates duplicates;
+            //text mode: ID per internal ID; integer mode: IDs that are no integers
+            std::vector<std::string> texts;
+            std::unordered_map<std::string, uint32_t> textIndex;
+            //integer mode
+            std::vector<int64_t> values;
+            std::vector<uint8_t> kinds;
+            IntIndex plainIndex;
+            IntIndex renamedIndex;
+            int64_t  dummyIndex;
+    };
+} //namespace data
+} //namespace netxpert
+
+#endif // EXTERNALIDTABLE_H
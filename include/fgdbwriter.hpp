@@ -25,6 +25,7 @@
 #include <fstream>
 #include "FileGDBAPI.h"
 #include <algorithm>
+#include "geos/geom/MultiPolygon.h"
 
 namespace netxpert {
     /**
@@ -75,6 +76,11 @@ namespace netxpert {
                                const double cutoff,
                                const geos::geom::MultiLineString& route,
                                const std::string& _tableName);
+            ///\brief Save single Isolines result polygon
+            void SaveResultPolygon(const std::string& orig, const double cost,
+                                   const double cutoff,
+                                   const geos::geom::MultiPolygon& polygons,
+                                   const std::string& _tableName);
 
             ///\brief For saving the result arc of a built network into the netXpert result DB
             void SaveNetworkBuilderArc(const std::string& extArcID, const uint32_t fromNode,
@@ -98,6 +104,7 @@ namespace netxpert {
             const std::string resultNetBuilderDefPath    = "FGDB_NETXPERT_NETBUILD_SCHEMA.XML";
             const std::string resultMSTDefPath           = "FGDB_NETXPERT_MST_SCHEMA.XML";
             const std::string resultIsoLinesDefPath      = "FGDB_NETXPERT_ISOLINES_SCHEMA.XML";
+            const std::string resultIsoPolygonsDefPath   = "FGDB_NETXPERT_ISOPOLYGONS_SCHEMA.XML";
             const std::string resultSPTDefPath           = "FGDB_NETXPERT_SPT_SCHEMA.XML";
             netxpert::cnfg::Config NETXPERT_CNFG;
     };
@@ -0,0 +1,85 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef ISOPOLYGON_H
+#define ISOPOLYGON_H
+
+#include <vector>
+#include <memory>
+#include "geos/geom/GeometryFactory.h"
+#include "geos/geom/MultiPolygon.h"
+
+namespace netxpert {
+
+    namespace data {
+
+    /**
+    * \brief Builds the polygon of an isoline (area reachable within a cut off) as alpha shape of points.
+    *
+    * The points are the coordinates of the reached parts of the arcs incl. the interpolated points at the cut off;
+    * every line is densified so that two consecutive points are not farther apart than half of alpha.
+    * The points are triangulated (Delaunay); triangles with an edge longer than alpha are dropped and the boundary
+    * of the remaining triangles is traced into the shells and holes of the polygons. No buffer or union of
+    * geometries is needed.
+    *
+    * Points can be removed from the end with Resize(): the points of one cut off are the points of the
+    * previous cut off plus some more, so several cut offs are built with the same builder one after another.
+    *
+    * One builder per thread; ToMultiPolygon() does not use shared state except the given factory.
+    */
+    class IsoPolygonBuilder
+    {
+        public:
+            ///\brief Constructor
+            IsoPolygonBuilder() {}
+            ///\brief Sets the maximum edge length of the triangles of the polygon (in units of the coordinates)
+            void SetAlpha(const double alpha) {
+                this->alpha = alpha;
+            }
+            ///\brief Gets the maximum edge length of the triangles of the polygon
+            double GetAlpha() const {
+                return alpha;
+            }
+            ///\brief Adds a single point
+            void AddPoint(const double x, const double y);
+            ///\brief Adds the coordinates of a line with additional points every alpha/2 on long segments
+            ///\param xy: x and y of the coordinates one after another
+            ///\param size: count of coordinates
+            void AddLine(const double* xy, const uint32_t size);
+            ///\brief Count of added points
+            size_t Size() const {
+                return xy.size() / 2;
+            }
+            ///\brief Keeps the first count points only
+            void Resize(const size_t count);
+            ///\brief Removes all points
+            void Clear() {
+                xy.clear();
+            }
+            ///\brief Gets the alpha shape of the points as MultiPolygon
+            ///
+            /// Shells are oriented counter clockwise, holes clockwise. Less than three distinct points or no
+            /// triangle with edges up to alpha give an empty MultiPolygon.
+            std::unique_ptr<geos::geom::MultiPolygon> ToMultiPolygon(const geos::geom::GeometryFactory& factory) const;
+
+        private:
+            double alpha = 0;
+            std::vector<double> xy;
+    };
+} //namespace data
+} //namespace netxpert
+
+#endif // ISOPOLYGON_H
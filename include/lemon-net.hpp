@@ -48,7 +48,14 @@
 #include "geos/opDistance.h"
 
 #include "data.hpp"
+#include "contractionhierarchy.hpp"
+#include "spatialindex.hpp"
+#include "arcgeometrystore.hpp"
+#include "externalidtable.hpp"
+#include "routegeometry.hpp"
+#include "isopolygon.hpp"
 #include "dbhelper.hpp"
+#include "netsnapshot.hpp"
 #include "fgdbwriter.hpp"
 #include "slitewriter.hpp"
 
@@ -140,12 +147,37 @@ namespace netxpert {
         /// These nodes will be used for split up arcs if necessary (optional).
         ///\param autoClean: clean the network on reading
         ///\param extIntNodeMap: represents a mapping between external node IDs and internal node IDs.
+        ///\param dbHelper: data context for all database access of the network (optional).
+        /// If empty, the network creates its own data context from cnfg.
         InternalNet(const netxpert::data::InputArcs& arcsTbl,
                     const netxpert::data::ColumnMap& _map = netxpert::data::ColumnMap(),
                     const netxpert::cnfg::Config& cnfg = netxpert::cnfg::Config(),
                     const netxpert::data::InputNodes& nodesTbl = netxpert::data::InputNodes(),
                     const bool autoClean = true,
-                    const std::map<std::string, netxpert::data::IntNodeID>& extIntNodeMap = std::map<std::string, netxpert::data::IntNodeID>() );
+                    const std::map<std::string, netxpert::data::IntNodeID>& extIntNodeMap = std::map<std::string, netxpert::data::IntNodeID>(),
+                    std::shared_ptr<netxpert::io::DBHELPER> dbHelper = nullptr );
+
+        ///\brief Constructor from arcs in columnar form (see netxpert::io::DBHELPER::LoadNetworkColumnsFromDB())
+        ///\param arcCols: arcs with interned node IDs (mandatory); the order of the arcs does not matter.
+        ///\param _map: column names
+        ///\param cnfg: Config for netxpert
+        ///\param nodesTbl: represents nodes read from a database (optional).
+        ///\param autoClean: clean the network on reading
+        ///\param dbHelper: data context for all database access of the network (optional).
+        InternalNet(const netxpert::data::InputArcColumns& arcCols,
+                    const netxpert::data::ColumnMap& _map,
+                    const netxpert::cnfg::Config& cnfg,
+                    const netxpert::data::InputNodes& nodesTbl = netxpert::data::InputNodes(),
+                    const bool autoClean = true,
+                    std::shared_ptr<netxpert::io::DBHELPER> dbHelper = nullptr );
+
+        ///\brief Constructor from a network snapshot (see SaveSnapshot())
+        ///\param snapshotPath: snapshot file; it stays mapped as long as the network uses its arc geometries.
+        ///\param cnfg: Config for netxpert; the column names are taken from it.
+        ///\param dbHelper: data context for all database access of the network (optional).
+        InternalNet(const std::string& snapshotPath,
+                    const netxpert::cnfg::Config& cnfg = netxpert::cnfg::Config(),
+                    std::shared_ptr<netxpert::io::DBHELPER> dbHelper = nullptr );
 
         /// Empty Destructor.
         ~InternalNet() {}
@@ -241,6 +273,12 @@ namespace netxpert {
         const uint32_t
          GetArcCount();
 
+        ///\brief Gets the data context of the network
+        std::shared_ptr<netxpert::io::DBHELPER>
+         GetDataContext() {
+            return this->dbHelper;
+         };
+
         ///\brief Gets a pointer to the internal graph
         netxpert::data::graph_t*
          GetGraph() {
@@ -273,22 +311,26 @@ namespace netxpert {
             return this->nodeSupplyMap.get();
         };
 
-        ///\brief Gets a pointer to the internal node map (internal nodes: original node ID)
-        netxpert::data::graph_t::NodeMap<std::string>*
-         GetNodeMap() {
-            return this->nodeMap.get();
+        ///\brief Gets the original node IDs (per internal node ID) and their reverse index
+        const netxpert::data::ExternalIDTable&
+         GetNodeIDTable() const {
+            return this->nodeIDTable;
         };
 
-        ///\brief Gets a map of original node IDs to internal nodes
-        const std::unordered_map<std::string, netxpert::data::node_t>
-         GetNodeIDMap() {
-            return this->nodeIDMap;
+        ///\brief Gets the original arc IDs (per internal arc ID) and their reverse index
+        const netxpert::data::ExternalIDTable&
+         GetArcIDTable() const {
+            return this->arcIDTable;
         };
 
         ///\brief Registers the original node ID to the internal node
         void
          RegisterNodeID(const std::string& nodeID, const netxpert::data::node_t& node);
 
+        ///\brief Registers the original integer node ID to the internal node
+        void
+         RegisterNodeID(const int64_t nodeID, const netxpert::data::node_t& node);
+
         //--|Region Getters
 
         //-->Region Add Points
@@ -308,6 +350,16 @@ namespace netxpert {
                                    const bool withCapacity,
                                    const netxpert::data::AddedNodeType startOrEnd);
 
+        ///\brief Adds a new node in the network; the nearest arc is searched in the given in-memory spatial index
+        ///
+        /// Same processing as AddNode() with the SpatiaLite query.
+        ///\return internal node ID
+        const uint32_t
+         AddNode(const netxpert::data::NewNode& newNode,
+                                   const int threshold,
+                                   const netxpert::data::ArcSpatialIndex& arcIndex,
+                                   const netxpert::data::AddedNodeType startOrEnd);
+
         ///\brief Method for adding start nodes
         ///\return internal node ID
         const uint32_t
@@ -327,6 +379,9 @@ namespace netxpert {
                                 bool withCapacity);
 
         ///\brief Simple Method for adding multiple start nodes
+        ///
+        /// The points are snapped to the network and the arcs are split in parallel; points on the same
+        /// original arc split it once into several pieces. The network is changed in one serial step afterwards.
         ///\return A vector of pairs with internal node ID and the original node ID
         std::vector< std::pair<uint32_t, std::string> >
          LoadStartNodes(std::vector<netxpert::data::NewNode> newNodes, const int threshold,
@@ -334,6 +389,9 @@ namespace netxpert {
                         const netxpert::data::ColumnMap& cmap, const bool withCapacity);
 
         ///\brief Simple Method for adding multiple end nodes
+        ///
+        /// The points are snapped to the network and the arcs are split in parallel; points on the same
+        /// original arc split it once into several pieces. The network is changed in one serial step afterwards.
         ///\return A vector of pairs with internal node ID and the original node ID
         std::vector< std::pair<uint32_t, std::string> >
          LoadEndNodes(std::vector<netxpert::data::NewNode> newNodes, const int threshold,
@@ -345,12 +403,27 @@ namespace netxpert {
         //--|Region Add Points
 
         //-->Region Save Results
+        ///\brief Saves the network as binary snapshot (netxpert::io::NetworkSnapshot)
+        ///
+        /// Must be called before any start or end nodes are added; with withGeometries the arc geometries
+        /// are stored as well.
+        void
+         SaveSnapshot(const std::string& path, const bool withGeometries = false);
+
+        ///\brief Loads the geometries of all original arcs into the in-memory geometry store
+        ///
+        /// Done once per network; must be called before processing result arcs with real geometries.
+        /// The arcs are read once for the store and the spatial index of the snapping of new nodes.
+        void
+         LoadArcGeometries(const std::string& arcsTableName, const std::string& geomColumnName,
+                           const netxpert::data::ColumnMap& cmap);
+
         /**\brief Main method for processing and saving result arcs (preloading geometry into memory).
             Writes results to a database (SpatiaLite or ESRI File Geodatabase).
             Solver: SPT, ODM */
         void
          ProcessSPTResultArcsMem(const std::string& orig, const std::string& dest, const netxpert::data::cost_t cost,
-                                     const std::string& arcIDs, const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
+                                     const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
                                      const std::string& resultTableName, netxpert::io::DBWriter& writer,
                                      SQLite::Statement& qry //can be null in case of ESRI FileGDB
                                     );
@@ -359,7 +432,7 @@ namespace netxpert {
             Solver: SPT, ODM */
         void
          ProcessSPTResultArcsMemS(const std::string& orig, const std::string& dest, const netxpert::data::cost_t cost,
-                                       const std::string& arcIDs, const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
+                                       const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
                                        std::ostringstream& output);
         /**\brief Method for processing and saving a subset of original arcs as results
             Solver: MST */
@@ -370,16 +443,52 @@ namespace netxpert {
             Solver: Isolines */
         void
          ProcessIsoResultArcsMem(const std::string& orig, const netxpert::data::cost_t cost,
-                                 const std::string& arcIDs, const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
+                                 const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
                                  const std::string& resultTableName, netxpert::io::DBWriter& writer,
                                  SQLite::Statement& qry,
                                  const std::unordered_map<netxpert::data::ExtNodeID, std::vector<double> > cutOffs);
 
+        /**\brief Main method for processing and saving the arcs of a shortest path tree within the cut offs
+            (preloading geometry into memory)
+            Solver: Isolines (tree based)
+
+            Every reached arc is saved once per cut off: complete or cut at the interpolated position of the cut off.
+            Both directions of an undirected arc are saved as one arc. */
+        void
+         ProcessIsoTreeResultArcsMem(const std::string& orig, const netxpert::data::DistLabels& labels,
+                                     const std::vector<double>& cutOffs,
+                                     const std::string& resultTableName, netxpert::io::DBWriter& writer,
+                                     SQLite::Statement& qry);
+
+        /**\brief Main method for processing and saving the bands of a shortest path tree between the cut offs
+            (preloading geometry into memory)
+            Solver: Isolines (banded)
+
+            One row per band: all parts of the reached arcs with a distance between the lower cut off (cost)
+            and the upper cut off (cutoff). Only arcs that cross a cut off are split. */
+        void
+         ProcessIsoBandResultArcsMem(const std::string& orig, const netxpert::data::DistLabels& labels,
+                                     const std::vector<double>& cutOffs,
+                                     const std::string& resultTableName, netxpert::io::DBWriter& writer,
+                                     SQLite::Statement& qry);
+
+        /**\brief Main method for processing and saving the polygons of a shortest path tree within the cut offs
+            (preloading geometry into memory)
+            Solver: Isolines (polygons)
+
+            One polygon per cut off: alpha shape (netxpert::data::IsoPolygonBuilder) of the covered parts of the
+            reached arcs with netxpert::cnfg::Config::IsolinesPolygonAlpha. */
+        void
+         ProcessIsoPolygonResultsMem(const std::string& orig, const netxpert::data::DistLabels& labels,
+                                     const std::vector<double>& cutOffs,
+                                     const std::string& resultTableName, netxpert::io::DBWriter& writer,
+                                     SQLite::Statement& qry);
+
         /**\brief Main method for processing and saving result arcs (preloading geometry into memory)
             Solver: MCF, TPs */
         void ProcessMCFResultArcsMem(const std::string& orig, const std::string& dest, const netxpert::data::cost_t cost,
                                      const netxpert::data::capacity_t capacity, const netxpert::data::flow_t flow,
-                                     const std::string& arcIDs, std::vector<netxpert::data::arc_t>& routeNodeArcRep,
+                                     const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
                                      const std::string& resultTableName, netxpert::io::DBWriter& writer,
                                      SQLite::Statement& qry //can be null in case of ESRI FileGDB
                                     );
@@ -388,7 +497,7 @@ namespace netxpert {
             Solver: MCF, TPs */
         void ProcessMCFResultArcsMemS(const std::string& orig, const std::string& dest, const netxpert::data::cost_t cost,
                                       const netxpert::data::capacity_t capacity, const netxpert::data::flow_t flow,
-                                      const std::string& arcIDs, std::vector<netxpert::data::arc_t>& routeNodeArcRep,
+                                      const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
                                       std::ostringstream& output);
         //--|Region Save Results
 
@@ -400,6 +509,26 @@ namespace netxpert {
         void
          ExportToDIMACS(const std::string& path);
 
+        ///\brief Freezes the current state of the graph into an immutable CSR snapshot.
+        ///
+        /// Filtered arcs are left out. The snapshot does not change with later changes of the network
+        /// (e.g. added start or end nodes), so it has to be taken after all nodes have been added.
+        ///\param singlePrecision: store the arc costs as 32-bit floats
+        std::shared_ptr<const netxpert::data::CSRGraph>
+         FreezeToCSR(const bool singlePrecision = false);
+
+        ///\brief Builds the contraction hierarchy of the base network.
+        ///
+        /// Added start and end nodes and their arcs are not part of the hierarchy; splitted arcs are taken
+        /// in their original state. So the hierarchy stays valid when nodes are added or the network is reset.
+        void
+         BuildContractionHierarchy();
+
+        ///\brief Gets the contraction hierarchy of the base network; it is built on first use.
+        ///\warning Not thread safe on first use: call it before a parallel region.
+        std::shared_ptr<const netxpert::core::ContractionHierarchy>
+         GetContractionHierarchy();
+
 //      -->Region Contraction Hierarchies
 
         #if (defined NETX_ENABLE_CONTRACTION_HIERARCHIES)
@@ -463,11 +592,25 @@ namespace netxpert {
     private:
 
       //-->Region Network core functions
+      void
+       initialize(const netxpert::data::ColumnMap& _map,
+                  const netxpert::cnfg::Config& cnfg,
+                  std::shared_ptr<netxpert::io::DBHELPER> dbHelper);
+
+      void
+       createMaps();
       void
        readNodes(const netxpert::data::InputArcs& arcsTbl,
                  const netxpert::data::InputNodes& nodesTbl,
                  const std::map<std::string, netxpert::data::IntNodeID>& extIntNodeMap);
 
+      std::vector<netxpert::data::node_t>
+       readNodes(const netxpert::data::InputArcColumns& arcCols,
+                 const netxpert::data::InputNodes& nodesTbl);
+
+      void
+       readNodeSupplies(const netxpert::data::InputNodes& nodesTbl);
+
       void
        processBarriers();
 
@@ -476,14 +619,42 @@ namespace netxpert {
                        const bool autoClean,
                        const bool isDirected);
 
+      void
+       readNetwork(const netxpert::data::InputArcColumns& arcCols,
+                   const std::vector<netxpert::data::node_t>& nodes,
+                   const bool autoClean,
+                   const bool isDirected);
+
       std::vector<std::string>
        getDistinctOrigNodes(const netxpert::data::InputArcs& arcsTbl);
 
+      std::vector<std::string>
+       orderNodesBreadthFirst(const netxpert::data::InputArcs& arcsTbl,
+                              const std::vector<std::string>& distinctNodes);
+
+      std::vector<uint32_t>
+       orderNodesBreadthFirst(const std::vector<uint32_t>& fromNodes,
+                              const std::vector<uint32_t>& toNodes,
+                              const uint32_t nodeCount);
+
       void
        processArc(const netxpert::data::InputArc& arc,
                   const netxpert::data::node_t internalStartNode,
                   const netxpert::data::node_t internalEndNode);
 
+      void
+       processArc(const netxpert::data::extarcid_t& extArcID,
+                  const netxpert::data::cost_t cost,
+                  const netxpert::data::capacity_t capacity,
+                  const netxpert::data::node_t internalStartNode,
+                  const netxpert::data::node_t internalEndNode);
+
+      void
+       processArc(const netxpert::data::InputArcColumns& arcCols,
+                  const size_t arcIdx,
+                  const netxpert::data::node_t internalStartNode,
+                  const netxpert::data::node_t internalEndNode);
+
       //--|Region Network core functions
 
 
@@ -494,6 +665,39 @@ namespace netxpert {
                          const geos::geom::Coordinate& startPoint,
                          const netxpert::data::AddedNodeType startOrEnd);
 
+      const uint32_t
+       addNode(const netxpert::data::NewNode& newNode, const int threshold,
+               const netxpert::data::ExtClosestArcAndPoint& closestArcAndPoint,
+               const netxpert::data::AddedNodeType startOrEnd);
+
+      const netxpert::data::ArcSpatialIndex&
+       getArcIndex(const std::string& arcsTableName, const std::string& geomColumnName,
+                   const netxpert::data::ColumnMap& cmap, const bool withCapacity);
+
+      void
+       buildArcIndex(const std::string& arcsTableName, const std::string& geomColumnName,
+                     const netxpert::data::ColumnMap& cmap, const bool withCapacity, const bool withGeomStore);
+
+      void
+       buildArcGeomStore(const std::vector<netxpert::data::ExtArcWithGeom>& arcs);
+
+      const std::vector<netxpert::data::node_t>
+       insertNewNodes(const netxpert::data::arc_t origArc, const netxpert::data::cost_t cost,
+                      const netxpert::data::capacity_t capacity,
+                      const std::vector<std::vector<geos::geom::Coordinate>>& pieces,
+                      const std::vector<netxpert::data::AddedPoint>& points,
+                      const netxpert::data::AddedNodeType startOrEnd);
+
+      std::vector< std::pair<uint32_t, std::string> >
+       loadNodes(std::vector<netxpert::data::NewNode>& newNodes, const int threshold,
+                 const netxpert::data::ArcSpatialIndex& arcIndex,
+                 const netxpert::data::AddedNodeType startOrEnd);
+
+      std::vector<netxpert::data::ExtClosestArcAndPoint>
+       snapNodes(const std::vector<netxpert::data::NewNode>& newNodes, const int threshold,
+                 const netxpert::data::ArcSpatialIndex& arcIndex,
+                 const netxpert::data::AddedNodeType startOrEnd);
+
       //--|Region Add Point
 
       //-->Region Barriers
@@ -528,6 +732,10 @@ namespace netxpert {
        splitLine(const geos::geom::Coordinate& coord,
                  const geos::geom::Geometry& lineGeom);
 
+      static std::vector<std::vector<geos::geom::Coordinate>>
+       splitLine(const std::vector<double>& positions,
+                 const geos::geom::LineString& line);
+
       std::vector<std::shared_ptr<geos::geom::Geometry>>
        clipLine(const geos::geom::Geometry& polyGeom,
                 const geos::geom::Geometry& lineGeom);
@@ -552,22 +760,40 @@ namespace netxpert {
       std::unique_ptr<geos::geom::LineString>
        getStraightLine(const std::string& orig, const std::string& dest);
 
+      std::vector<netxpert::data::ArcGeometrySpan>
+       getOrigArcSpans(const std::vector<netxpert::data::arc_t>& routeNodeArcRep);
+
+      void
+       getIsoTreeArcs(const netxpert::data::DistLabels& labels, std::vector<netxpert::data::IsoTreeArc>& treeArcs);
+
+      //covered fraction of an arc reached with dist at one end within the cut off
+      static double
+       getCoveredFraction(const netxpert::data::cost_t dist, const netxpert::data::cost_t cost, const double cutOff);
+
+      bool
+       getArcCoordinates(const netxpert::data::arc_t& arc, std::vector<double>& buffer,
+                         const double*& xy, uint32_t& size, bool& reversed);
+
+      void
+       buildRouteGeometry(const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
+                          netxpert::data::RouteGeometryBuilder& route);
+
       std::string
        convertRouteToCoordList(std::unique_ptr<geos::geom::MultiLineString>& route);
 
       void
        saveSPTResultsMem(const std::string orig, const std::string dest, const netxpert::data::cost_t cost,
-                                      const std::string& arcIDs, std::vector<geos::geom::Geometry*> routeParts,
+                                      const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
                                       const std::string& resultTableName, netxpert::io::DBWriter& writer,
                                       SQLite::Statement& qry );
       void
        saveSPTResultsMemS(const std::string orig, const std::string dest, const netxpert::data::cost_t cost,
-                                const std::string& arcIDs, std::vector<geos::geom::Geometry*> routeParts,
+                                const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
                                 std::ostringstream& outfile);
 
       //Isolines
       void saveIsoResultsMem(const std::string orig, const netxpert::data::cost_t cost,
-                              const std::string& arcIDs, std::vector<geos::geom::Geometry*> routeParts,
+                              const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
                               const std::string& resultTableName, netxpert::io::DBWriter& writer,
                               SQLite::Statement& qry,
                               const std::unordered_map<netxpert::data::ExtNodeID, std::vector<double> >& cutOffs);
@@ -575,13 +801,13 @@ namespace netxpert {
       //MCF
       void saveMCFResultsMem(const std::string orig, const std::string dest, const netxpert::data::cost_t cost,
                            const netxpert::data::capacity_t capacity, const netxpert::data::flow_t flow,
-                           const std::string& arcIDs, std::vector<geos::geom::Geometry*> routeParts,
+                           const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
                            const std::string& resultTableName, netxpert::io::DBWriter& writer,
                            SQLite::Statement& qry);
 
       void saveMCFResultsMemS(const std::string orig, const std::string dest, const netxpert::data::cost_t cost,
                                  const netxpert::data::capacity_t capacity, const netxpert::data::flow_t flow,
-                                 const std::string& arcIDs, std::vector<geos::geom::Geometry*> routeParts,
+                                 const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
                                  std::ostringstream& outStream);
       //MST
       void
@@ -623,16 +849,17 @@ namespace netxpert {
       //-->Region data members
       std::unique_ptr<netxpert::data::graph_t> g;
       //std::unique_ptr<netxpert::data::graph_t::ArcMap<uint32_t>> extArcIDMap;
-      std::unique_ptr<netxpert::data::graph_t::ArcMap<netxpert::data::extarcid_t>> extArcIDMap;
+      /// original arc IDs; both arcs of an undirected arc share the ID, lookups give the later one
+      netxpert::data::ExternalIDTable arcIDTable { netxpert::data::ExternalIDTable::Duplicates::KeepHighest };
       std::unique_ptr<netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>> costMap;
       std::unique_ptr<netxpert::data::graph_t::ArcMap<netxpert::data::capacity_t>> capMap;
       // perhaps we need this once
       /*std::unique_ptr<lemon::SourceMap<graph_t> > sourceMap;
       std::unique_ptr<lemon::TargetMap<graph_t> > targetMap;*/
-      std::unique_ptr<netxpert::data::graph_t::NodeMap<std::string>> nodeMap;
       std::unique_ptr<netxpert::data::graph_t::NodeMap<netxpert::data::supply_t>> nodeSupplyMap;
       //std::unordered_map<uint32_t, netxpert::data::arc_t> arcIDMap;
-      std::unordered_map<std::string, netxpert::data::node_t> nodeIDMap;
+      /// original node IDs
+      netxpert::data::ExternalIDTable nodeIDTable { netxpert::data::ExternalIDTable::Duplicates::KeepFirst };
 
       //replacement for other maps
       std::unique_ptr<netxpert::data::ArcDataMap<netxpert::data::graph_t,
@@ -666,6 +893,14 @@ namespace netxpert {
       std::map<netxpert::data::arc_t, netxpert::data::NewArc> newArcsMap;
       /// stores data of new nodes that have been added to the graph
       std::map<netxpert::data::node_t, netxpert::data::NewNode> newNodesMap;
+
+      std::shared_ptr<const netxpert::core::ContractionHierarchy> contractionHierarchy;
+      /// in-memory spatial index of the original arcs for snapping new nodes; built on first use
+      std::unique_ptr<netxpert::data::ArcSpatialIndex> arcIndex;
+      /// arcs table, geometry column and columns the spatial index was built from; rebuilt if they change
+      std::string arcIndexKey;
+      //geometries of the original arcs for the results
+      std::unique_ptr<netxpert::data::ArcGeometryStore> arcGeomStore;
       /// stores the added start nodes that were added to the network
       std::map<netxpert::data::node_t, netxpert::data::AddedPoint> addedStartPoints;
       /// stores the added end nodes that were added to the network
@@ -677,6 +912,8 @@ namespace netxpert {
       std::unique_ptr<netxpert::data::graph_t::ArcMap<bool>> arcFilterMap;
 
       netxpert::cnfg::Config NETXPERT_CNFG;
+      /// data context of the network: connections to the netXpert DB and the eliminated arcs for its queries
+      std::shared_ptr<netxpert::io::DBHELPER> dbHelper;
 
       std::string arcIDColName;
       std::string fromColName;
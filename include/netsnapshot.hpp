@@ -0,0 +1,276 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef NETSNAPSHOT_H
+#define NETSNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "data.hpp"
+#include "externalidtable.hpp"
+
+namespace netxpert {
+
+    namespace io {
+
+    /**
+    * \brief Content of a built network for NetworkSnapshot::Write().
+    *
+    * Index i of the node arrays is the internal node ID i, index j of the arc arrays the internal arc ID j.
+    * Node and arc IDs are stored like in their netxpert::data::ExternalIDTable: in text mode nodeIDs/arcIDs hold
+    * all IDs; in integer mode the values and kinds of ExternalIDTable::Export() hold them and nodeIDs/arcIDs only
+    * the IDs that are no integers.
+    * The geometry arrays have the layout of netxpert::data::ArcGeometryStore and stay empty for a snapshot
+    * without geometries.
+    **/
+    struct NetworkSnapshotData
+    {
+        netxpert::data::ExternalIDTable::Mode nodeIDMode = netxpert::data::ExternalIDTable::Mode::Text;
+        std::vector<std::string> nodeIDs;
+        std::vector<int64_t> nodeIDValues;
+        std::vector<uint8_t> nodeIDKinds;
+        std::vector<netxpert::data::supply_t> nodeSupplies;
+        std::vector<uint32_t> arcSources;
+        std::vector<uint32_t> arcTargets;
+        std::vector<netxpert::data::cost_t> arcCosts;
+        std::vector<netxpert::data::capacity_t> arcCapacities;
+        netxpert::data::ExternalIDTable::Mode arcIDMode = netxpert::data::ExternalIDTable::Mode::Text;
+        std::vector<netxpert::data::extarcid_t> arcIDs;
+        std::vector<int64_t> arcIDValues;
+        std::vector<uint8_t> arcIDKinds;
+        std::vector<netxpert::data::extarcid_t> eliminatedArcIDs;
+        //geometries (optional)
+        std::vector<int32_t> spanOfArc;
+        std::vector<uint8_t> reversedArc;
+        std::vector<uint32_t> spanOffsets;
+        std::vector<double> coords;
+        std::vector<netxpert::data::extarcid_t> spanArcIDs;
+    };
+
+    /**
+    * \brief Read only, memory mapped binary snapshot of a built network (netxpert::data::InternalNet).
+    *
+    * The file starts with a versioned header and a table of sections; every section is a plain array
+    * (8 byte aligned) in the byte order of the machine that wrote it. Strings are stored as a table of
+    * offsets into one character array, integer IDs as plain int64 arrays. Opening the file only maps it and
+    * checks the header; the arrays are read through the mapping without parsing.
+    *
+    * A snapshot is written with netxpert::data::InternalNet::SaveSnapshot() and turned into a network with the
+    * snapshot constructor of netxpert::data::InternalNet. That constructor copies the graph, the cost, capacity
+    * and supply maps and the ID tables into the heap (LEMON needs its own SmartDigraph and maps); only the arc
+    * geometries are used in place, so processes that load the same snapshot share the pages of the coordinates.
+    */
+    class NetworkSnapshot
+    {
+        public:
+            /**
+            * \brief View on a table of strings in the snapshot
+            **/
+            class StringTable
+            {
+                public:
+                    StringTable() : offsets(nullptr), chars(nullptr), count(0) {}
+                    StringTable(const uint64_t* offsets, const char* chars, const uint64_t count)
+                        : offsets(offsets), chars(chars), count(count) {}
+                    ///\brief Count of strings
+                    uint64_t Size() const {
+                        return count;
+                    }
+                    ///\brief Gets the string at the given index
+                    std::string Get(const uint64_t i) const {
+                        return std::string(chars + offsets[i], offsets[i + 1] - offsets[i]);
+                    }
+                    ///\brief Gets all strings
+                    std::vector<std::string> GetAll() const {
+                        std::vector<std::string> result;
+                        result.reserve(count);
+                        for (uint64_t i = 0; i < count; i++)
+                            result.push_back(Get(i));
+                        return result;
+                    }
+                private:
+                    const uint64_t* offsets;
+                    const char*     chars;
+                    uint64_t        count;
+            };
+
+            ///\brief Version of the file format; snapshots of other versions are rejected
+            ///
+            /// 2: integer node and arc IDs are stored as int64 arrays
+            static const uint32_t VERSION = 2;
+
+            ///\brief Writes the given network content as snapshot file
+            static void Write(const std::string& path, const NetworkSnapshotData& data);
+
+            ///\brief Maps the snapshot file at the given path
+            ///
+            /// Throws std::runtime_error if the file cannot be mapped or is not a valid snapshot of this version.
+            explicit NetworkSnapshot(const std::string& path);
+            NetworkSnapshot(const NetworkSnapshot&) = delete;
+            NetworkSnapshot& operator=(const NetworkSnapshot&) = delete;
+            ///\brief Unmaps the file
+            ~NetworkSnapshot();
+
+            ///\brief Count of nodes
+            uint32_t NodeCount() const {
+                return nodeCount;
+            }
+            ///\brief Count of arcs
+            uint32_t ArcCount() const {
+                return arcCount;
+            }
+            ///\brief True if the snapshot holds the arc geometries
+            bool HasGeometries() const {
+                return spanCount > 0;
+            }
+            ///\brief Count of arc geometries
+            uint32_t SpanCount() const {
+                return spanCount;
+            }
+            ///\brief Size of the mapped file in bytes
+            size_t FileSize() const {
+                return size;
+            }
+
+            ///\brief Storage of the node IDs
+            netxpert::data::ExternalIDTable::Mode NodeIDMode() const {
+                return nodeIDMode;
+            }
+            ///\brief All node IDs (text mode) or the node IDs that are no integers (integer mode)
+            const StringTable& NodeIDs() const {
+                return nodeIDs;
+            }
+            ///\brief Values of the node IDs (integer mode); NodeCount() entries
+            const int64_t* NodeIDValues() const {
+                return section<int64_t>(NodeIDValueSection);
+            }
+            ///\brief Kinds of the node IDs (integer mode); NodeCount() entries
+            const uint8_t* NodeIDKinds() const {
+                return section<uint8_t>(NodeIDKindSection);
+            }
+            const netxpert::data::supply_t* NodeSupplies() const {
+                return section<netxpert::data::supply_t>(NodeSupplySection);
+            }
+            const uint32_t* ArcSources() const {
+                return section<uint32_t>(ArcSourceSection);
+            }
+            const uint32_t* ArcTargets() const {
+                return section<uint32_t>(ArcTargetSection);
+            }
+            const netxpert::data::cost_t* ArcCosts() const {
+                return section<netxpert::data::cost_t>(ArcCostSection);
+            }
+            const netxpert::data::capacity_t* ArcCapacities() const {
+                return section<netxpert::data::capacity_t>(ArcCapacitySection);
+            }
+            ///\brief Storage of the arc IDs
+            netxpert::data::ExternalIDTable::Mode ArcIDMode() const {
+                return arcIDMode;
+            }
+            ///\brief All arc IDs (text mode) or the arc IDs that are no integers (integer mode)
+            const StringTable& ArcIDs() const {
+                return arcIDs;
+            }
+            ///\brief Values of the arc IDs (integer mode); ArcCount() entries
+            const int64_t* ArcIDValues() const {
+                return section<int64_t>(ArcIDValueSection);
+            }
+            ///\brief Kinds of the arc IDs (integer mode); ArcCount() entries
+            const uint8_t* ArcIDKinds() const {
+                return section<uint8_t>(ArcIDKindSection);
+            }
+            const StringTable& EliminatedArcIDs() const {
+                return eliminatedArcIDs;
+            }
+            ///\brief Span per arc (-1 without geometry); ArcCount() entries
+            const int32_t* SpanOfArc() const {
+                return section<int32_t>(SpanOfArcSection);
+            }
+            ///\brief Arc runs against its geometry (0 or 1); ArcCount() entries
+            const uint8_t* ReversedArc() const {
+                return section<uint8_t>(ReversedArcSection);
+            }
+            ///\brief First coordinate of every span; SpanCount() + 1 entries
+            const uint32_t* SpanOffsets() const {
+                return section<uint32_t>(SpanOffsetSection);
+            }
+            ///\brief x, y of all spans
+            const double* Coords() const {
+                return section<double>(CoordSection);
+            }
+            const StringTable& SpanArcIDs() const {
+                return spanArcIDs;
+            }
+
+            /// @cond INTERNAL
+            enum Section {
+                NodeIDOffsetSection = 0,
+                NodeIDCharSection,
+                NodeSupplySection,
+                ArcSourceSection,
+                ArcTargetSection,
+                ArcCostSection,
+                ArcCapacitySection,
+                ArcIDOffsetSection,
+                ArcIDCharSection,
+                EliminatedArcIDOffsetSection,
+                EliminatedArcIDCharSection,
+                SpanOfArcSection,
+                ReversedArcSection,
+                SpanOffsetSection,
+                CoordSection,
+                SpanArcIDOffsetSection,
+                SpanArcIDCharSection,
+                NodeIDValueSection,
+                NodeIDKindSection,
+                ArcIDValueSection,
+                ArcIDKindSection,
+                SectionCount
+            };
+            /// @endcond
+
+        private:
+            template<typename T>
+            const T* section(const Section s) const {
+                return reinterpret_cast<const T*>(base + sectionOffsets[s]);
+            }
+            StringTable stringTable(const Section offsetSection, const Section charSection) const;
+            void validate(const std::string& path);
+            void unmap();
+
+            const char* base;
+            size_t      size;
+            #ifdef _WIN32
+            void* fileHandle;
+            void* mappingHandle;
+            #endif
+            uint64_t sectionOffsets[SectionCount];
+            uint64_t sectionSizes[SectionCount];
+            uint32_t nodeCount;
+            uint32_t arcCount;
+            uint32_t spanCount;
+            netxpert::data::ExternalIDTable::Mode nodeIDMode;
+            netxpert::data::ExternalIDTable::Mode arcIDMode;
+            StringTable nodeIDs;
+            StringTable arcIDs;
+            StringTable eliminatedArcIDs;
+            StringTable spanArcIDs;
+    };
+} //namespace io
+} //namespace netxpert
+
+#endif // NETSNAPSHOT_H
@@ -0,0 +1,100 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef ROUTEGEOMETRY_H
+#define ROUTEGEOMETRY_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include "geos/geom/GeometryFactory.h"
+#include "geos/geom/MultiLineString.h"
+
+namespace netxpert {
+
+    namespace data {
+
+    /**
+    * \brief Builds the geometry of one route from the coordinates of its arcs in the order of the path.
+    *
+    * The coordinates of every arc are copied into one contiguous buffer; an arc is reversed if it is traversed
+    * against the direction of its geometry and the shared coordinate of two consecutive arcs is stored once.
+    * The route is written as WKB, Google encoded polyline or JSON coordinate list straight from the buffer;
+    * no GEOS geometries are created and no line merging is needed.
+    *
+    * A route may consist of several lines (e.g. the parts of an arc within the cut off of an isoline):
+    * NewPart() starts the next line.
+    *
+    * One builder per thread; Clear() resets it for the next route.
+    */
+    class RouteGeometryBuilder
+    {
+        public:
+            ///\brief Constructor
+            RouteGeometryBuilder() {}
+            ///\brief Removes all coordinates
+            void Clear();
+            ///\brief Appends the coordinates of the next arc of the route
+            ///\param xy: x and y of the coordinates one after another
+            ///\param size: count of coordinates
+            ///\param reversed: the arc runs from the end to the start of its geometry
+            void Append(const double* xy, const uint32_t size, const bool reversed);
+            ///\brief Starts a new line; the next arc is not joined to the current line
+            void NewPart();
+            ///\brief Appends the section of a line between two fractions of its length as a new line
+            ///
+            /// The coordinates at the fractions are interpolated; the section is reversed if from > to.
+            ///\param from: fraction of the length of the line (0..1) where the section starts
+            ///\param to: fraction of the length of the line (0..1) where the section ends
+            void AppendSection(const double* xy, const uint32_t size, const double from, const double to);
+            ///\brief Count of coordinates of the route
+            size_t Size() const {
+                return xy.size() / 2;
+            }
+            ///\brief Gets the coordinates of the route (x and y one after another)
+            const std::vector<double>& GetCoordinates() const {
+                return xy;
+            }
+            ///\brief Count of lines of the route with at least two coordinates
+            size_t LineCount() const;
+            ///\brief Gets the route as JSON coordinate list [[x,y],..] with the given count of decimals
+            ///
+            /// The coordinates of all lines are listed one after another.
+            std::string ToJSON(const int decimals = 0) const;
+            ///\brief Gets the route as (2D) WKB of a MultiLineString in the byte order of the machine
+            ///
+            /// Same output as geos::io::WKBWriter for the lines of the route; an empty route gives an empty
+            /// MultiLineString.
+            std::string ToWKB() const;
+            ///\brief Gets the route with the Google Encoded Polyline Algorithm (y before x)
+            ///\param precision: count of decimals that are kept (5 for geographic coordinates)
+            std::string ToPolyline(const int precision = 5) const;
+            ///\brief Gets the route as GEOS MultiLineString (for writers that need GEOS geometries)
+            std::unique_ptr<geos::geom::MultiLineString> ToMultiLineString(const geos::geom::GeometryFactory& factory) const;
+
+        private:
+            std::vector<double> xy;
+            //first coordinate of every line but the first one
+            std::vector<size_t> lineOffsets;
+
+            void reverse(const size_t from);
+            //first coordinate of the given line; one more than lines for the end
+            size_t lineBegin(const size_t line) const;
+    };
+} //namespace data
+} //namespace netxpert
+
+#endif // ROUTEGEOMETRY_H
@@ -32,6 +32,8 @@ namespace netxpert {
     * \li call of Solve() method (saves the results to the ResultDB given in the config JSON)
     * \li optional: GetOptimum() returns the overall optimum
     * \li optional: GetODMatrixAsJSON() returns the origin destination matrix as JSON string
+    *
+    * With the config entry "ODMCostsOnly" the solver stores the costs only; paths are rebuilt for the exported pairs.
     **/
     class OriginDestinationMatrix
     {
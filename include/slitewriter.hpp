@@ -18,9 +18,13 @@
 #define SPATIALITEWRITER_H
 
 #include <string>
+#include <thread>
+#include <mutex>
+#include <atomic>
 
 #include "dbwriter.hpp"
 #include "logger.hpp"
+#include "boundedqueue.hpp"
 
 #include "SQLiteCpp/Database.h"
 #include "SQLiteCpp/Transaction.h"
@@ -29,6 +33,23 @@
 namespace netxpert {
 
     namespace io {
+    /**
+    * \brief One row of a solver result table (see SpatiaLiteWriter::SaveResultRow())
+    *
+    * The columns used depend on the solver type of the table: SPT and OD matrix use orig, dest and cost,
+    * isolines orig, cost and cutoff, MCF and transportation orig, dest, cost, capacity and flow.
+    **/
+    struct ResultRow
+    {
+        std::string orig;
+        std::string dest;
+        double      cost = 0;
+        double      capacity = 0;
+        double      flow = 0;
+        double      cutoff = 0;
+        std::string geomWKB;  //!< geometry as WKB
+    };
+
     /**
     * \brief Writes the result of netxpert into a SpatiaLite DB
     **/
@@ -75,6 +96,22 @@ namespace netxpert {
                                      const double cutoff,
                                      const geos::geom::MultiLineString& route,
                                      const std::string& _tableName, SQLite::Statement& query);
+            /**
+            * \brief Starts the writer thread for the rows of the given result table.
+            *
+            * Rows passed to SaveResultRow() are queued and written by one thread in batches of multi-row inserts;
+            * the current transaction is committed every RESULT_COMMIT_ROWS rows.
+            * Requires an open transaction; FinishResultPipeline() must be called before committing it.
+            **/
+            void StartResultPipeline(const std::string& _tableName, const netxpert::data::NetXpertSolver solverType);
+            ///\brief Writes the queued rows and stops the writer thread
+            void FinishResultPipeline();
+            /**
+            * \brief Saves a row of the given result table; thread safe.
+            * The row is queued if the result pipeline runs for the table, else it is written at once.
+            **/
+            void SaveResultRow(ResultRow&& row, const std::string& _tableName,
+                               const netxpert::data::NetXpertSolver solverType);
             ///\brief Save single MST result arc
             void SaveResultArc(const std::string& extArcID, const double cost,
                                      const geos::geom::MultiLineString& route,
@@ -121,6 +158,13 @@ namespace netxpert {
             void CloseConnection();
             //string ConnStr;
         private:
+            ///\brief Rows per multi-row insert (6 parameters per row stay below the SQLite limit of 999)
+            static const size_t RESULT_BATCH_ROWS = 64;
+            ///\brief Rows per transaction of the result pipeline
+            static const size_t RESULT_COMMIT_ROWS = 50000;
+            ///\brief Capacity of the queue of the result pipeline
+            static const size_t RESULT_QUEUE_ROWS = 4096;
+
             std::string dbPath;
             std::unique_ptr<SQLite::Database> connPtr;
             std::unique_ptr<SQLite::Transaction> currentTransactionPtr;
@@ -132,6 +176,30 @@ namespace netxpert {
             void dropTable (const std::string& _tableName);
             void recoverGeometryColumn (std::string _tableName, std::string _geomColName, std::string _geomType);
             netxpert::cnfg::Config NETXPERT_CNFG;
+
+            std::unique_ptr<SQLite::Statement> prepareResultRows(const std::string& _tableName,
+                                                                 const netxpert::data::NetXpertSolver solverType,
+                                                                 const size_t rowCount);
+            void bindResultRow(SQLite::Statement& query, int& index, const ResultRow& row,
+                               const netxpert::data::NetXpertSolver solverType);
+            void writeResultRows(std::vector<ResultRow>& rows, const size_t count);
+            void runResultPipeline();
+
+            //result pipeline
+            std::unique_ptr<netxpert::utils::BoundedQueue<ResultRow> > resultQueue;
+            std::thread resultThread;
+            std::atomic<bool> resultPipelineRuns {false};
+            std::atomic<bool> resultPipelineStops {false};
+            std::string resultTableName;
+            netxpert::data::NetXpertSolver resultSolverType = netxpert::data::NetXpertSolver::UndefinedNetXpertSolver;
+            std::unique_ptr<SQLite::Statement> resultRowQuery;
+            std::unique_ptr<SQLite::Statement> resultBatchQuery;
+            size_t resultRowsInTransaction = 0;
+            //writes without pipeline
+            std::mutex resultMutex;
+            std::unique_ptr<SQLite::Statement> syncRowQuery;
+            std::string syncTableName;
+            netxpert::data::NetXpertSolver syncSolverType = netxpert::data::NetXpertSolver::UndefinedNetXpertSolver;
             //UNUSED
             void mergeAndSaveResultArcs(std::string orig, std::string dest, double cost, double capacity, double flow,
                                         std::string geomColumnName, std::string arcIDColumnName, std::string arcTableName,
@@ -20,6 +20,7 @@
 #include "isolver.hpp"
 #include "isptree.hpp"
 #include "sptlem.hpp"
+#include "sptcsr.hpp"
 #include "data.hpp"
 
 namespace netxpert {
@@ -31,6 +32,18 @@ namespace netxpert {
     *
     * Concept: solve the 1 - all SPT problem and cut off the routes at the defined cut off values;
     *          do this for all origins.
+    *
+    * With netxpert::cnfg::Config::IsolinesTreeBased only the distance labels of the reached nodes are kept
+    * instead of the paths to all reached nodes. Every reached arc is saved once per cut off: complete or
+    * cut at the interpolated position of the cut off (netxpert::data::InternalNet::ProcessIsoTreeResultArcsMem()).
+    * The output is linear in the size of the shortest path tree.
+    *
+    * With netxpert::cnfg::Config::IsolinesBands the reached arcs are saved once per origin and band between two
+    * cut offs (netxpert::data::InternalNet::ProcessIsoBandResultArcsMem()); only arcs that cross a cut off are split.
+    *
+    * With netxpert::cnfg::Config::IsolinesPolygons one polygon per origin and cut off is saved instead: the alpha
+    * shape of the covered parts of the reached arcs (netxpert::data::InternalNet::ProcessIsoPolygonResultsMem()).
+    * All cut offs of an origin are built from one shortest path tree search.
     * \sa netxpert::ShortestPathTree
     *
     */
@@ -87,6 +100,8 @@ namespace netxpert {
             double optimum;
             std::vector<netxpert::data::node_t> originNodes;
             std::map<netxpert::data::ODPair, netxpert::data::CompressedPath> shortestPaths;
+            //distance labels per origin (tree based isolines only)
+            std::vector<std::pair<netxpert::data::node_t, netxpert::data::DistLabels> > treeLabels;
             std::unordered_map<netxpert::data::ExtNodeID, std::vector<double> > cutOffs;
             netxpert::cnfg::GEOMETRY_HANDLING geometryHandling;
             netxpert::cnfg::SPTAlgorithm algorithm;
@@ -20,6 +20,9 @@
 #include "isolver.hpp"
 #include "imcflow.hpp"
 #include "nslem.hpp"
+#include "cslem.hpp"
+#include "caslem.hpp"
+#include "mcfreopt.hpp"
 
 namespace netxpert {
     /**
@@ -46,6 +49,17 @@ namespace netxpert {
             void Solve(std::string net);
             ///\brief Computes the minimum cost flow problem on the given network.
             void Solve(netxpert::data::InternalNet& net);
+            /**
+            * \brief Re-solves the last instance after changes of node supplies and arc costs.
+            *
+            * Starts from the optimal flow and node potentials of the last solve, so only the changes have to be
+            * routed (see netxpert::core::MCFReoptimizer). The supply and cost maps of the network are updated.
+            * Falls back to a complete Solve() if the changes need another balancing of the instance, i.e. the
+            * difference of supply and demand changes its sign or a node gets supply or demand for the first time
+            * while the instance is unbalanced.
+            */
+            void Resolve(const std::vector<netxpert::data::NodeSupplyChange>& supplyChanges,
+                         const std::vector<netxpert::data::ArcCostChange>& costChanges);
             ///\todo Implement Getter/Setter for property
             bool IsDirected;
             ///\brief Gets the arcs with flow and cost of the result of the minimum cost flow solver
@@ -63,6 +77,32 @@ namespace netxpert {
                              const netxpert::data::ColumnMap& cmap);
             ///\brief Gets the MCF results as JSON String
             const std::string GetResultsAsJSON();
+            ///\brief Gets the shape of the given Minimum Cost Flow instance
+            ///
+            /// Integral values are checked after scaling with 10^integerPrecision (see netxpert::core::MCFScaling).
+            static netxpert::data::MCFInstanceShape GetInstanceShape(netxpert::data::filtered_graph_t& sg,
+                                                                     netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>& costMap,
+                                                                     netxpert::data::graph_t::ArcMap<netxpert::data::capacity_t>& capMap,
+                                                                     netxpert::data::graph_t::NodeMap<netxpert::data::supply_t>& supplyMap,
+                                                                     const int integerPrecision = -1);
+            ///\brief Chooses the mcf algorithm for an instance of the given shape (MCFAutomatic)
+            ///
+            /// CapacityScaling for instances with integral supplies and capacities, few sources and sinks
+            /// (at most 2% of the nodes) and hardly any tight arcs (at most 5% of the arcs); NetworkSimplex otherwise.
+            /// CostScaling is never chosen, it was slower than one of the others on all instances of BenchMCFAlgorithms.
+            static netxpert::cnfg::MCFAlgorithm SelectAlgorithm(const netxpert::data::MCFInstanceShape& shape);
+            ///\brief Checks if the given mcf algorithm solves an instance of the given shape exactly
+            ///
+            /// CapacityScaling needs integral supplies and capacities, CostScaling also integral costs.
+            static bool IsExact(const netxpert::cnfg::MCFAlgorithm mcfAlgorithm,
+                                const netxpert::data::MCFInstanceShape& shape);
+            ///\brief Creates the core solver for the given mcf algorithm (not MCFAutomatic)
+            ///
+            /// The integer precision (see Config::McfIntegerPrecision) is the mode of the NetworkSimplex and the
+            /// scale of the values for CapacityScaling and CostScaling.
+            static std::shared_ptr<netxpert::core::IMinCostFlow> CreateCoreSolver(const netxpert::cnfg::MCFAlgorithm mcfAlgorithm,
+                                                                                  const netxpert::cnfg::MCFPivotRule pivotRule,
+                                                                                  const int integerPrecision = -1);
 
         protected:
             //visible also to derived classes
@@ -72,12 +112,15 @@ namespace netxpert {
             netxpert::cnfg::MCFAlgorithm algorithm;
             std::vector<netxpert::data::FlowCost> flowCost;
             std::shared_ptr<netxpert::core::IMinCostFlow> mcf;
+            //kept for Resolve()
+            std::unique_ptr<netxpert::data::filtered_graph_t> mcfGraph;
+            std::unique_ptr<netxpert::core::MCFReoptimizer> reoptimizer;
+            netxpert::data::node_t dummyNode = lemon::INVALID;
             void solve (netxpert::data::InternalNet& net);
             bool validateNetworkData(netxpert::data::InternalNet& net);
             lemon::FilterArcs<netxpert::data::graph_t, netxpert::data::graph_t::ArcMap<bool>>
              convertInternalNetworkToSolverData(netxpert::data::InternalNet& net);
             void getSupplyNodesTypeCount(int& srcNodeCount, int& transshipNodeCount, int& sinkNodeCount );
-            std::string processTotalArcIDs();
 
         private:
             //private is only visible to MCF instance - not to derived classes (like TP)
@@ -87,7 +130,7 @@ namespace netxpert {
             //shall be assigned to the class member this->net
             //with smart pointers there are double frees on clean up -> memory errors
             //raw pointers will not leak int this case even without delete in the deconstructor
-            netxpert::data::InternalNet* net;
+            netxpert::data::InternalNet* net = nullptr;
     };
 }
 #endif // MINCOSTFLOW_H
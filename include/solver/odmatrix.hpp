@@ -20,6 +20,9 @@
 #include "isolver.hpp"
 #include "isptree.hpp"
 #include "sptlem.hpp"
+#include "sptcsr.hpp"
+#include "sptch.hpp"
+#include "odmch.hpp"
 //#include "sptbgl.hpp"
 #include "data.hpp"
 #include "lemon-net.hpp"
@@ -57,6 +60,16 @@ namespace netxpert {
             /// Origins and destinations have to be set with \ref SetOrigins() and \ref SetDestinations()
             /// prior calling this method.
             void Solve(netxpert::data::InternalNet& net);
+            ///\brief Computes a sparse part of the origin destination matrix on the given network.
+            ///
+            /// One bounded one-to-many search per origin: it stops after destLimit settled destinations
+            /// (0: no limit) or at the distance thresholds[origin index] (if given; origins with a threshold <= 0
+            /// are skipped). Nothing is stored in the dense result store; the paths of the returned cells are
+            /// rebuilt with GetShortestPaths(odPairs).
+            ///\return the reached cells (origin index, destination index, cost) ordered by origin and destination
+            std::vector<netxpert::data::ODCell> SolveSparse(netxpert::data::InternalNet& net,
+                                                            const size_t destLimit,
+                                                            const std::vector<netxpert::data::cost_t>& thresholds);
             ///\brief Gets the type of spt algorithm used in the solver
             const netxpert::cnfg::SPTAlgorithm GetAlgorithm() const;
             ///\brief Sets the type of spt algorithm to use in the solver
@@ -113,9 +126,27 @@ namespace netxpert {
             /// Simple Wrapper for SWIG
             std::vector<uint32_t> GetReachedDestIDs() const;
             ///\brief Gets all shortest paths of the odm solver
+            ///
+            /// Ordered view that is built from the dense result store on every call.
             std::map<netxpert::data::ODPair, netxpert::data::CompressedPath> GetShortestPaths() const;
             ///\brief Gets the origin destination matrix of the odm solver
+            ///
+            /// Ordered view that is built from the dense result store on every call.
             std::map<netxpert::data::ODPair, netxpert::data::cost_t> GetODMatrix() const;
+            ///\brief Gets the shortest paths of the given od pairs only
+            ///
+            /// In costs only mode the paths are rebuilt on demand (one shortest path tree per distinct origin);
+            /// after SolveSparse() all paths are computed on demand. Pairs that were not reached are omitted.
+            std::map<netxpert::data::ODPair, netxpert::data::CompressedPath> GetShortestPaths(const std::vector<netxpert::data::ODPair>& odPairs);
+            ///\brief Gets the flag for the costs only mode
+            const bool GetCostsOnly() const;
+            ///\brief Sets the costs only mode: the solver stores no paths at all, only the costs of the od pairs.
+            ///
+            /// Paths are rebuilt on demand for the exported od pairs (SaveResults(), GetResultsAsJSON() with
+            /// GEOMETRY_HANDLING::RealGeometry) or the given pairs of GetShortestPaths(odPairs).
+            void SetCostsOnly(const bool costsOnly);
+            ///\brief Gets the dense result store (origins x destinations) of the odm solver
+            const netxpert::data::ODResultStore& GetODResults() const { return this->odResults; }
             ///\brief Gets the overall optimum of the solver
             const double GetOptimum() const;
             ///\brief Saves the results of the odm solver with the configured RESULT_DB_TYPE (SpatiaLite, FileGDB, or JSON).
@@ -130,16 +161,20 @@ namespace netxpert {
             //shall be assigned to the class member this->net
             //with smart pointers there are double frees on clean up -> memory errors
             //raw pointers will not leak in this case even without delete in the deconstructor
-            netxpert::data::InternalNet* net;
+            netxpert::data::InternalNet* net = nullptr;
             bool isDirected;
+            bool costsOnly;
             int sptHeapCard;
             double optimum;
             netxpert::cnfg::Config NETXPERT_CNFG;
             std::vector<netxpert::data::node_t> destinationNodes;
             std::vector<netxpert::data::node_t> reachedDests;
             std::vector<netxpert::data::node_t> originNodes;
-            std::map<netxpert::data::ODPair, netxpert::data::CompressedPath> shortestPaths;
-            std::map<netxpert::data::ODPair, double> odMatrix;
+            netxpert::data::ODResultStore odResults;
+            //read only snapshot of the network for SPTAlgorithm Dijkstra_2Heap_CSR; shared by all threads
+            std::shared_ptr<const netxpert::data::CSRGraph> csr;
+            //contraction hierarchy for the SPTAlgorithms ContractionHierarchies*; shared by all threads
+            std::shared_ptr<const netxpert::core::ContractionHierarchy> ch;
             netxpert::cnfg::GEOMETRY_HANDLING geometryHandling;
             netxpert::cnfg::SPTAlgorithm algorithm;
             std::shared_ptr<netxpert::core::ISPTree> spt;
@@ -153,7 +188,13 @@ namespace netxpert {
             lemon::FilterArcs<netxpert::data::graph_t, netxpert::data::graph_t::ArcMap<bool>>
              convertInternalNetworkToSolverData(netxpert::data::InternalNet& net);
             void checkSPTHeapCard(uint32_t arcCount, uint32_t nodeCount);
-            std::string processTotalArcIDs();
+            std::vector<size_t> getReachedCells() const;
+            void materializePaths(const std::vector<size_t>& cells);
+            std::map<netxpert::data::ODPair, netxpert::data::CompressedPath>
+             computeShortestPaths(const std::vector<netxpert::data::ODPair>& odPairs);
+            void prepareCoreSolvers(netxpert::data::InternalNet& net);
+            std::shared_ptr<netxpert::core::ISPTree>
+             newCoreSolver(netxpert::data::InternalNet& net, netxpert::data::filtered_graph_t& sg);
     };
 }
 #endif // ODMATRIX_H
@@ -20,6 +20,8 @@
 #include "isolver.hpp"
 #include "isptree.hpp"
 #include "sptlem.hpp"
+#include "sptcsr.hpp"
+#include "sptch.hpp"
 //#include "sptbgl.hpp"
 #include "data.hpp"
 #include "lemon-net.hpp"
@@ -149,9 +151,6 @@ namespace netxpert {
 
             void checkSPTHeapCard(uint32_t arcCount, uint32_t nodeCount);
 
-            std::string
-             processTotalArcIDs();
-
             /*double buildCompressedRoute(std::vector<netxpert::data::node_t>& route, netxpert::data::node_t orig, netxpert::data::node_t dest,
                                             std::unordered_map<netxpert::data::node_t, netxpert::data::node_t>& arcPredescessors);
 
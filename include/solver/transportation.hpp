@@ -19,6 +19,7 @@
 
 #include "mcflow.hpp"
 #include "odmatrix.hpp"
+#include "tpsimplex.hpp"
 
 namespace netxpert {
 
@@ -121,9 +122,37 @@ namespace netxpert {
             * \brief Computes the transportation problem on the given network.
             *
             *  Solves the Transportation Problem with the given network and all origin and destination nodes.
-            *  Uses the netXpert OriginDestinationMatrix Solver internally.
+            *  Uses the netXpert OriginDestinationMatrix Solver internally. With the config option TransportationDense
+            *  the OD cost matrix is solved directly as dense matrix (see Solve(costs, supplies, demands)).
+            *  With the config option TransportationCandidates (k > 0) the full OD matrix is not computed: the solver
+            *  starts with the k nearest destinations of each origin and adds only those OD pairs whose reduced costs
+            *  (dual potentials of the last solution) are negative until none is left (column generation).
+            *  The result is optimal as well.
             */
             void Solve(netxpert::data::InternalNet& net);
+            /**
+            * \brief Computes the transportation problem on a dense cost matrix.
+            *
+            * Solves the Transportation Problem on the row-major cost matrix of size supplies x demands with the
+            * transportation simplex (netxpert::core::TransportationSimplex); there is no network in between.
+            * Total supply and demand may differ. The result are the cells with flow (see GetDenseFlows()).
+            */
+            void Solve(const std::vector<netxpert::data::cost_t>& costs,
+                       const std::vector<netxpert::data::supply_t>& supplies,
+                       const std::vector<netxpert::data::supply_t>& demands);
+            /**
+            * \brief Re-solves the transportation problem after changes of supplies, demands or OD costs.
+            *
+            * Keeps the OD matrix and the network of the last Solve() and re-optimizes from the last distribution
+            * (see MinCostFlow::Resolve()). The changes are given with original node IDs; changed costs replace the
+            * costs of the OD pairs (extArc) without a new computation of the OD matrix.
+            * A dense instance (TransportationDense) is updated and solved again from scratch.
+            * Instances of TransportationCandidates cannot be re-solved (there is no full OD matrix).
+            */
+            void Resolve(const std::vector<netxpert::data::ExtNodeSupply>& supplyChanges,
+                         const std::vector<netxpert::data::ExtSPTreeArc>& costChanges);
+            ///\brief Gets the cells (origin index, destination index, flow) of the last dense solve
+            std::vector<netxpert::data::TransportationCell> GetDenseFlows() const;
 
         private:
             //raw pointer ok, no dynamic allocation (new())
@@ -132,6 +161,9 @@ namespace netxpert {
             //with smart pointers there are double frees on clean up -> memory errors
             //raw pointers will not leak int this case even without delete in the deconstructor
             netxpert::data::InternalNet* net;
+            //kept for Resolve() after Solve(net)
+            std::unique_ptr<netxpert::OriginDestinationMatrix> odSolver;
+            std::unique_ptr<netxpert::data::InternalNet> mcfNet;
 
             std::vector<netxpert::data::node_t> destinationNodes;
             std::vector<netxpert::data::node_t> originNodes;
@@ -140,6 +172,22 @@ namespace netxpert {
             std::map<netxpert::data::ODPair, netxpert::data::DistributionArc> distribution;
             std::map<netxpert::data::ExtNodeID, netxpert::data::supply_t> nodeSupply;
             std::vector<netxpert::data::ExtNodeSupply> extNodeSupply;
+
+            //dense instance (TransportationDense or Solve(costs, supplies, demands))
+            std::vector<netxpert::data::cost_t> denseCosts;
+            std::vector<netxpert::data::supply_t> denseSupplies;
+            std::vector<netxpert::data::supply_t> denseDemands;
+            std::vector<char> denseAllowed;
+            std::vector<netxpert::data::TransportationCell> denseFlows;
+            bool isDense = false;
+            //candidate instance (TransportationCandidates)
+            bool isSparse = false;
+
+            void buildDistribution();
+            void buildExtDistribution();
+            void solveDense();
+            void buildDenseDistribution();
+            void solveCandidates(netxpert::data::InternalNet& net);
     };
 }
 #endif // TRANSPORTATION_H
@@ -0,0 +1,100 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+#include <vector>
+#include <memory>
+#include "geos/geom/Coordinate.h"
+#include "data.hpp"
+
+namespace netxpert {
+
+    namespace data {
+
+    /**
+    * \brief In-memory spatial index on the line segments of the original arcs.
+    *
+    * Packed R-tree built with Sort-Tile-Recursive (STR) once for all arcs; it is read only afterwards.
+    * The nearest arc to a point is found with a best-first search on the squared distances of the bounding
+    * boxes and the exact distance to the segments. Replaces the per point SpatiaLite query
+    * (netxpert::io::DBHELPER::GetClosestArcFromPoint()) for snapping start and end nodes to the network.
+    *
+    * GetClosestArc() does not change the index and can be called from several threads at the same time.
+    */
+    class ArcSpatialIndex
+    {
+        public:
+            ///\brief Constructor
+            ArcSpatialIndex() {}
+            ///\brief Builds the index on the given arcs; arcs without line geometry are skipped
+            void Build(std::vector<netxpert::data::ExtArcWithGeom> arcs);
+            ///\brief Gets the closest arc and the closest point on the arc to the given coordinate
+            ///\param threshold: maximum distance (exclusive) of the arc to the coordinate
+            ///\return false if there is no arc within the threshold
+            bool GetClosestArc(const geos::geom::Coordinate& coord, const double threshold,
+                               netxpert::data::ExtClosestArcAndPoint& result) const;
+            ///\brief Gets the indexed arcs with their geometries
+            const std::vector<netxpert::data::ExtArcWithGeom>& Arcs() const {
+                return arcs;
+            }
+            ///\brief Count of indexed arcs
+            size_t ArcCount() const {
+                return arcs.size();
+            }
+            ///\brief Count of indexed line segments
+            size_t SegmentCount() const {
+                return segments.size();
+            }
+            ///\brief Memory footprint of the index (without the arc geometries) in bytes
+            size_t MemoryUsage() const;
+
+        private:
+            struct Box
+            {
+                double minX;
+                double minY;
+                double maxX;
+                double maxY;
+            };
+            struct Segment
+            {
+                double x1;
+                double y1;
+                double x2;
+                double y2;
+                uint32_t arcIdx;
+            };
+            //children per tree node
+            static const uint32_t NODE_CAPACITY = 16;
+
+            std::vector<netxpert::data::ExtArcWithGeom> arcs;
+            //segments in STR order (leaf level of the tree)
+            std::vector<Segment> segments;
+            //boxes of the tree nodes, level by level from the bottom up; children of node i of level k
+            //are the entries [i * NODE_CAPACITY, (i+1) * NODE_CAPACITY) of level k-1 (level 0: segments)
+            std::vector<Box> boxes;
+            std::vector<uint32_t> levelOffsets;
+
+            uint32_t levelSize(const uint32_t level) const;
+            double distanceToSegment(const Segment& s, const double x, const double y,
+                                     double& closestX, double& closestY) const;
+    };
+} //namespace data
+} //namespace netxpert
+
+#endif // SPATIALINDEX_H
@@ -29,6 +29,9 @@
 #include "lemon-net.hpp"
 #include "dbhelper.hpp"
 #include "sptree.hpp"
+#include "mcflow.hpp"
+#include "tpsimplex.hpp"
+#include "lemon/network_simplex.h"
 
 #include "odmatrix_simple.hpp"
 #include "mstree_simple.hpp"
@@ -53,7 +56,9 @@ namespace netxpert
         void TestODMatrix(netxpert::cnfg::Config& cnfg);
         void TestCreateRouteGeometries(netxpert::cnfg::Config& cnfg);
         void TestMCF(netxpert::cnfg::Config& cnfg);
+        void BenchMCFAlgorithms(netxpert::cnfg::Config& cnfg);
         void TestTransportation(netxpert::cnfg::Config& cnfg);
+        void TestTransportationDegenerate(netxpert::cnfg::Config& cnfg);
 //        void TestTransportationExt(netxpert::cnfg::Config& cnfg);
         void TestNetworkBuilder(netxpert::cnfg::Config& cnfg);
     }
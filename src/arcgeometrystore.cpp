@@ -0,0 +1,152 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include "arcgeometrystore.hpp"
+#include <algorithm>
+#include <unordered_map>
+#include "geos/geom/LineString.h"
+#include "geos/geom/CoordinateSequence.h"
+
+using namespace std;
+using namespace netxpert::data;
+
+void
+ ArcGeometryStore::Build(const std::vector<netxpert::data::ExtArcWithGeom>& arcs,
+                         const netxpert::data::graph_t& g,
+                         const netxpert::data::ExternalIDTable& arcIDs,
+                         const netxpert::data::ExternalIDTable& nodeIDs) {
+
+    using namespace geos::geom;
+
+    this->snapshot.reset();
+    this->spanOffsetData.assign(1, 0);
+    this->coordData.clear();
+    this->extArcIDs.clear();
+
+    unordered_map<extarcid_t, int32_t> spanOfExtArc;
+    spanOfExtArc.reserve(arcs.size());
+    //start node of the geometry per span
+    vector<const std::string*> fromNodeOfSpan;
+
+    for (const auto& arc : arcs) {
+        //single part lines only (like CastToLineString())
+        const Geometry* geom = arc.arcGeom.get();
+        if (!geom || geom->getNumGeometries() != 1)
+            continue;
+        const LineString* line = dynamic_cast<const LineString*>(geom->getGeometryN(0));
+        if (!line || line->isEmpty())
+            continue;
+
+        if (!spanOfExtArc.insert( make_pair(arc.extArcID, (int32_t) this->extArcIDs.size()) ).second)
+            continue;
+
+        const CoordinateSequence* seq = line->getCoordinatesRO();
+        for (size_t i = 0; i < seq->getSize(); i++) {
+            const Coordinate& c = seq->getAt(i);
+            this->coordData.push_back(c.x);
+            this->coordData.push_back(c.y);
+        }
+        this->spanOffsetData.push_back(this->coordData.size() / 2);
+        this->extArcIDs.push_back(arc.extArcID);
+        fromNodeOfSpan.push_back(&arc.extFromNode);
+    }
+
+    this->spanOfArcData.assign(g.maxArcId() + 1, -1);
+    this->reversedArcData.assign(g.maxArcId() + 1, 0);
+    for (graph_t::ArcIt a(g); a != lemon::INVALID; ++a) {
+        auto it = spanOfExtArc.find(arcIDs.Get(g.id(a)));
+        if (it != spanOfExtArc.end()) {
+            this->spanOfArcData[g.id(a)] = it->second;
+            this->reversedArcData[g.id(a)] = nodeIDs.Matches(g.id(g.source(a)), *fromNodeOfSpan[it->second]) ? 0 : 1;
+        }
+    }
+
+    this->spanOfArc   = this->spanOfArcData.data();
+    this->reversedArc = this->reversedArcData.data();
+    this->spanOffsets = this->spanOffsetData.data();
+    this->coords      = this->coordData.data();
+    this->arcCount    = this->spanOfArcData.size();
+    this->spanCount   = this->extArcIDs.size();
+}
+
+void
+ ArcGeometryStore::Build(const std::shared_ptr<const netxpert::io::NetworkSnapshot>& snapshot) {
+
+    this->spanOfArcData.clear();
+    this->reversedArcData.clear();
+    this->spanOffsetData.clear();
+    this->coordData.clear();
+    this->extArcIDs.clear();
+
+    this->snapshot    = snapshot;
+    this->spanOfArc   = snapshot->SpanOfArc();
+    this->reversedArc = snapshot->ReversedArc();
+    this->spanOffsets = snapshot->SpanOffsets();
+    this->coords      = snapshot->Coords();
+    this->arcCount    = snapshot->ArcCount();
+    this->spanCount   = snapshot->SpanCount();
+}
+
+void
+ ArcGeometryStore::Export(const uint32_t arcCount, netxpert::io::NetworkSnapshotData& data) const {
+
+    const uint32_t known = std::min(arcCount, this->arcCount);
+    data.spanOfArc.assign(this->spanOfArc, this->spanOfArc + known);
+    data.spanOfArc.resize(arcCount, -1);
+    data.reversedArc.assign(this->reversedArc, this->reversedArc + known);
+    data.reversedArc.resize(arcCount, 0);
+    data.spanOffsets.assign(this->spanOffsets, this->spanOffsets + this->spanCount + 1);
+    data.coords.assign(this->coords, this->coords + 2 * this->spanOffsets[this->spanCount]);
+    if (this->snapshot)
+        data.spanArcIDs = this->snapshot->SpanArcIDs().GetAll();
+    else
+        data.spanArcIDs = this->extArcIDs;
+}
+
+bool
+ ArcGeometryStore::GetSpan(const netxpert::data::arc_t& arc, netxpert::data::ArcGeometrySpan& span) const {
+
+    const int arcID = graph_t::id(arc);
+    if (arcID < 0 || (uint32_t) arcID >= this->arcCount || this->spanOfArc[arcID] < 0)
+        return false;
+
+    const uint32_t s = this->spanOfArc[arcID];
+    span.xy   = this->coords + 2 * this->spanOffsets[s];
+    span.size = this->spanOffsets[s + 1] - this->spanOffsets[s];
+    span.id   = s;
+    return true;
+}
+
+std::vector<netxpert::data::ArcGeometrySpan>
+ ArcGeometryStore::GetSpans(const std::vector<netxpert::data::arc_t>& path) const {
+
+    vector<ArcGeometrySpan> result;
+    result.reserve(path.size());
+    ArcGeometrySpan span;
+    for (const auto& arc : path) {
+        if (GetSpan(arc, span))
+            result.push_back(span);
+    }
+    return result;
+}
+
+size_t
+ ArcGeometryStore::MemoryUsage() const {
+
+    return this->spanOfArcData.capacity() * sizeof(int32_t) + this->reversedArcData.capacity() +
+           this->spanOffsetData.capacity() * sizeof(uint32_t) +
+           this->coordData.capacity() * sizeof(double) + this->extArcIDs.capacity() * sizeof(extarcid_t);
+}
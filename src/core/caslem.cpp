@@ -0,0 +1,132 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include "caslem.hpp"
+#include "logger.hpp"
+
+using namespace std;
+using namespace lemon;
+using namespace netxpert::core;
+
+void
+ CAS_LEM::SolveMCF() {
+
+    this->solver.reset();
+    this->scale = MCFScaling::GetScale(this->integerPrecision);
+    this->integralInput = MCFScaling::HasIntegralFlows(*this->g, *this->capacityMap, *this->supplyMap, this->scale);
+    if (!this->integralInput) {
+        netxpert::utils::LOGGER::LogError("CAS_LEM: supplies and capacities are not integral with precision " +
+                                          to_string(this->integerPrecision) + " - instance is not solved!");
+        return;
+    }
+
+    filtered_graph_t::ArcMap<int64_t> capInt(*this->g);
+    filtered_graph_t::NodeMap<int64_t> supplyInt(*this->g);
+    MCFScaling::ScaleFlows(*this->g, *this->capacityMap, *this->supplyMap, this->scale, capInt, supplyInt);
+
+    this->solver = std::unique_ptr<capscaling_t>(new capscaling_t(*this->g));
+
+    //set input maps
+    this->solver->upperMap(capInt);
+    this->solver->costMap(*this->costMap);
+    this->solver->supplyMap(supplyInt);
+
+    this->status = this->solver->run(this->factor);
+}
+
+const uint32_t
+ CAS_LEM::GetArcCount() {
+
+    return lemon::countArcs(*this->g);
+}
+
+const uint32_t
+ CAS_LEM::GetNodeCount() {
+
+    return lemon::countNodes(*this->g);
+}
+
+void
+ CAS_LEM::LoadNet(const uint32_t nmax,  const uint32_t mmax,
+                      lemon::FilterArcs<netxpert::data::graph_t,
+                                              netxpert::data::graph_t::ArcMap<bool>>* _sg,
+                      netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>* _costMap,
+                      netxpert::data::graph_t::ArcMap<netxpert::data::capacity_t>* _capMap,
+                      netxpert::data::graph_t::NodeMap<supply_t>* _supplyMap)
+{
+    using namespace netxpert::data;
+
+    this->g             = _sg;
+    this->costMap       = _costMap;
+    this->capacityMap   = _capMap;
+    this->supplyMap     = _supplyMap;
+    //output (must be filtered_graph_t)
+    this->flowMap = std::unique_ptr<filtered_graph_t::ArcMap<flow_t>>(new filtered_graph_t::ArcMap<flow_t>(*this->g));
+}
+
+const double
+ CAS_LEM::GetOptimum() const {
+    return this->solver->totalCost<double>() / this->scale;
+}
+
+netxpert::data::graph_t::ArcMap<netxpert::data::flow_t>*
+ CAS_LEM::GetMCFFlow() {
+    //query flow map after run for returning flow
+    for (filtered_graph_t::ArcIt a(*this->g); a != lemon::INVALID; ++a)
+        (*this->flowMap)[a] = this->solver->flow(a) / this->scale;
+
+    return this->flowMap.get();
+}
+
+std::vector<netxpert::data::arc_t>
+ CAS_LEM::GetMCFArcs() {
+    std::vector<netxpert::data::arc_t> result;
+
+    return result;
+}
+
+netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>*
+ CAS_LEM::GetMCFCost() {
+
+    return this->costMap;
+}
+
+netxpert::data::graph_t::NodeMap<netxpert::data::cost_t>*
+ CAS_LEM::GetMCFPotential() {
+    //query potentials after run (optimal dual solution)
+    this->potentialMap = std::unique_ptr<filtered_graph_t::NodeMap<cost_t>>(new filtered_graph_t::NodeMap<cost_t>(*this->g));
+    this->solver->potentialMap(*this->potentialMap);
+
+    return this->potentialMap.get();
+}
+
+const int
+ CAS_LEM::GetMCFStatus() {
+    if (!this->integralInput)
+        return 4;
+    //same mapping as in NS_LEM
+    switch (status)
+    {
+    case capscaling_t::INFEASIBLE:
+        return 2;
+    case capscaling_t::OPTIMAL:
+        return 0;
+    case capscaling_t::UNBOUNDED:
+        return 3;
+    default:
+        return -1;
+    }
+}
@@ -0,0 +1,466 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include "contractionhierarchy.hpp"
+#include <queue>
+#include <unordered_set>
+#include "sptworkspace.hpp"
+#include "config.hpp"
+#include "logger.hpp"
+
+using namespace std;
+using namespace netxpert::core;
+using namespace netxpert::data;
+using namespace netxpert::utils;
+using netxpert::cnfg::LOCAL_NUM_THREADS;
+
+namespace {
+
+    //Witness searches stop after that many settled nodes; missing a witness only costs an extra shortcut.
+    const size_t MAX_SETTLED_SIMULATION = 100;
+    const size_t MAX_SETTLED_CONTRACTION = 500;
+
+    struct DynEdge
+    {
+        uint32_t node;
+        cost_t cost;
+        int32_t middle;
+        int32_t arcID;
+    };
+
+    struct Shortcut
+    {
+        uint32_t from;
+        uint32_t to;
+        cost_t cost;
+        int32_t middle;
+    };
+
+    /**
+    * Dynamic graph for the preprocessing of the contraction hierarchy.
+    * Edges to contracted nodes are skipped and removed from the lists after every round.
+    */
+    class Contractor
+    {
+        public:
+            Contractor(const CSRGraph& base) {
+                n = base.NodeCount();
+                out.resize(n);
+                in.resize(n);
+                contracted.assign(n, 0);
+                deletedNeighbours.assign(n, 0);
+                depth.assign(n, 0);
+
+                for (uint32_t u = 0; u < n; u++) {
+                    for (uint32_t pos = base.offsets[u]; pos < base.offsets[u + 1]; pos++) {
+                        //loops are never part of a shortest path
+                        if (base.targets[pos] != u)
+                            InsertEdge(u, base.targets[pos], base.Cost(pos), -1, base.arcIDs[pos]);
+                    }
+                }
+            }
+
+            ///inserts the edge u->w or improves the cost of an existing one; parallel arcs are merged
+            bool InsertEdge(const uint32_t u, const uint32_t w, const cost_t cost,
+                            const int32_t middle, const int32_t arcID) {
+                for (auto& e : out[u]) {
+                    if (e.node != w)
+                        continue;
+                    if (e.cost <= cost)
+                        return false;
+                    e = DynEdge {w, cost, middle, arcID};
+                    for (auto& f : in[w]) {
+                        if (f.node == u) {
+                            f = DynEdge {u, cost, middle, arcID};
+                            break;
+                        }
+                    }
+                    return true;
+                }
+                out[u].push_back( DynEdge {w, cost, middle, arcID} );
+                in[w].push_back( DynEdge {u, cost, middle, arcID} );
+                return true;
+            }
+
+            ///shortcuts that are necessary if node v is contracted; only counted if result is a nullptr
+            size_t FindShortcuts(const uint32_t v, SPTWorkspace& ws, const size_t maxSettled,
+                                 vector<Shortcut>* result) {
+                size_t count = 0;
+                vector<uint32_t> targets;
+                for (const auto& ein : in[v]) {
+                    const uint32_t u = ein.node;
+                    if (contracted[u])
+                        continue;
+
+                    cost_t maxOut = 0;
+                    targets.clear();
+                    for (const auto& eout : out[v]) {
+                        if (!contracted[eout.node] && eout.node != u) {
+                            maxOut = std::max(maxOut, eout.cost);
+                            targets.push_back(eout.node);
+                        }
+                    }
+                    if (targets.empty())
+                        continue;
+
+                    witnessSearch(ws, u, v, ein.cost + maxOut, maxSettled, targets);
+
+                    for (const auto& eout : out[v]) {
+                        const uint32_t w = eout.node;
+                        if (contracted[w] || w == u)
+                            continue;
+                        const cost_t viaV = ein.cost + eout.cost;
+                        //any path without v that is not longer is a witness (distance needs not to be final)
+                        if (ws.Reached(w) && ws.Dist(w) <= viaV)
+                            continue;
+                        count += 1;
+                        if (result)
+                            result->push_back( Shortcut {u, w, viaV, (int32_t) v} );
+                    }
+                }
+                return count;
+            }
+
+            ///weighted edge difference + count of contracted neighbours + depth in the hierarchy
+            int Priority(const uint32_t v, SPTWorkspace& ws) {
+                int degree = 0;
+                for (const auto& e : out[v])
+                    if (!contracted[e.node]) degree += 1;
+                for (const auto& e : in[v])
+                    if (!contracted[e.node]) degree += 1;
+
+                const int shortcutCount = FindShortcuts(v, ws, MAX_SETTLED_SIMULATION, nullptr);
+                return 2 * (shortcutCount - degree) + deletedNeighbours[v] + depth[v];
+            }
+
+            ///removes the edges to contracted nodes from the lists of the node
+            void Compact(const uint32_t v) {
+                auto isContracted = [this](const DynEdge& e) { return this->contracted[e.node] != 0; };
+                out[v].erase(std::remove_if(out[v].begin(), out[v].end(), isContracted), out[v].end());
+                in[v].erase(std::remove_if(in[v].begin(), in[v].end(), isContracted), in[v].end());
+            }
+
+            uint32_t n;
+            vector<vector<DynEdge> > out;
+            vector<vector<DynEdge> > in;
+            vector<char> contracted;
+            vector<int> deletedNeighbours;
+            vector<int> depth; //longest chain of contracted nodes below the node
+
+        private:
+            //Dijkstra from u without node excluded and contracted nodes;
+            //bounded by limit and maxSettled, stops if all targets are settled
+            void witnessSearch(SPTWorkspace& ws, const uint32_t u, const uint32_t excluded,
+                               const cost_t limit, const size_t maxSettled,
+                               const vector<uint32_t>& targets) {
+                ws.NewSearch();
+                ws.Relax(u, 0, -1);
+                size_t settled = 0;
+                size_t targetsLeft = targets.size();
+                while (!ws.EmptyQueue()) {
+                    if (ws.NextDist() > limit)
+                        break;
+                    const int x = ws.SettleNext();
+                    settled += 1;
+                    if (settled > maxSettled)
+                        break;
+                    if (std::find(targets.begin(), targets.end(), (uint32_t) x) != targets.end()) {
+                        targetsLeft -= 1;
+                        if (targetsLeft == 0)
+                            break;
+                    }
+                    const cost_t dx = ws.Dist(x);
+                    for (const auto& e : out[x]) {
+                        if (e.node == excluded || contracted[e.node])
+                            continue;
+                        if (!ws.Settled(e.node))
+                            ws.Relax(e.node, dx + e.cost, -1);
+                    }
+                }
+            }
+    };
+}
+
+void
+ ContractionHierarchy::Build(const netxpert::data::CSRGraph& base) {
+
+    LOGGER::LogInfo("Building contraction hierarchy..");
+
+    Contractor c(base);
+    const uint32_t n = c.n;
+
+    this->rank.assign(n, 0);
+    this->core.assign(n, 0);
+    this->shortcuts = 0;
+    for (uint32_t v = 0; v < n; v++)
+        this->core[v] = (c.out[v].size() + c.in[v].size()) > 0;
+
+    vector<vector<Edge> > upEdges(n);
+    vector<vector<Edge> > downEdges(n);
+
+    //one witness search workspace per thread
+    const int numThreads = std::max(1, LOCAL_NUM_THREADS);
+    vector<SPTWorkspace> workspaces(numThreads);
+    for (auto& ws : workspaces)
+        ws.Resize(n);
+
+    vector<int> priority(n, 0);
+
+    #pragma omp parallel for schedule(dynamic, 1024) num_threads(numThreads)
+    for (int64_t v = 0; v < (int64_t) n; v++)
+        priority[v] = c.Priority(v, workspaces[omp_get_thread_num()]);
+
+    vector<uint32_t> remaining(n);
+    for (uint32_t v = 0; v < n; v++)
+        remaining[v] = v;
+
+    uint32_t level = 0;
+    size_t rounds = 0;
+    vector<char> selected;
+    vector<uint32_t> batch;
+    vector<uint32_t> touched;
+    vector<char> isTouched(n, 0);
+
+    while (remaining.size() > 0)
+    {
+        rounds += 1;
+
+        //independent set: nodes with a lower priority than all of their remaining neighbours
+        selected.assign(remaining.size(), 0);
+        #pragma omp parallel for schedule(dynamic, 1024) num_threads(numThreads)
+        for (int64_t i = 0; i < (int64_t) remaining.size(); i++) {
+            const uint32_t v = remaining[i];
+            bool isMin = true;
+            for (int dir = 0; dir < 2 && isMin; dir++) {
+                for (const auto& e : (dir == 0 ? c.out[v] : c.in[v])) {
+                    const uint32_t x = e.node;
+                    if (c.contracted[x])
+                        continue;
+                    if (priority[x] < priority[v] || (priority[x] == priority[v] && x < v)) {
+                        isMin = false;
+                        break;
+                    }
+                }
+            }
+            selected[i] = isMin;
+        }
+
+        batch.clear();
+        for (size_t i = 0; i < remaining.size(); i++)
+            if (selected[i])
+                batch.push_back(remaining[i]);
+
+        //the witness searches of the batch must not use any of the batch nodes
+        for (const uint32_t v : batch)
+            c.contracted[v] = 1;
+
+        vector<vector<Shortcut> > batchShortcuts(batch.size());
+        #pragma omp parallel for schedule(dynamic, 16) num_threads(numThreads)
+        for (int64_t i = 0; i < (int64_t) batch.size(); i++)
+            c.FindShortcuts(batch[i], workspaces[omp_get_thread_num()], MAX_SETTLED_CONTRACTION, &batchShortcuts[i]);
+
+        //all remaining neighbours of a contracted node get a higher rank
+        touched.clear();
+        for (const uint32_t v : batch) {
+            this->rank[v] = level++;
+            for (const auto& e : c.out[v]) {
+                if (c.contracted[e.node])
+                    continue;
+                upEdges[v].push_back( Edge {e.node, e.cost, e.middle, e.arcID} );
+            }
+            for (const auto& e : c.in[v]) {
+                if (c.contracted[e.node])
+                    continue;
+                downEdges[v].push_back( Edge {e.node, e.cost, e.middle, e.arcID} );
+            }
+            for (int dir = 0; dir < 2; dir++) {
+                for (const auto& e : (dir == 0 ? c.out[v] : c.in[v])) {
+                    if (c.contracted[e.node])
+                        continue;
+                    c.deletedNeighbours[e.node] += 1;
+                    c.depth[e.node] = std::max(c.depth[e.node], c.depth[v] + 1);
+                    if (!isTouched[e.node]) {
+                        isTouched[e.node] = 1;
+                        touched.push_back(e.node);
+                    }
+                }
+            }
+            vector<DynEdge>().swap(c.out[v]);
+            vector<DynEdge>().swap(c.in[v]);
+        }
+
+        for (const auto& scList : batchShortcuts)
+            for (const auto& sc : scList)
+                if (c.InsertEdge(sc.from, sc.to, sc.cost, sc.middle, -1))
+                    this->shortcuts += 1;
+
+        //update the neighbours: first drop the edges to the batch, then recompute the priorities
+        #pragma omp parallel for schedule(dynamic, 256) num_threads(numThreads)
+        for (int64_t i = 0; i < (int64_t) touched.size(); i++)
+            c.Compact(touched[i]);
+
+        #pragma omp parallel for schedule(dynamic, 256) num_threads(numThreads)
+        for (int64_t i = 0; i < (int64_t) touched.size(); i++)
+            priority[touched[i]] = c.Priority(touched[i], workspaces[omp_get_thread_num()]);
+
+        for (const uint32_t x : touched)
+            isTouched[x] = 0;
+
+        remaining.erase(std::remove_if(remaining.begin(), remaining.end(),
+                                       [&c](const uint32_t v) { return c.contracted[v] != 0; }),
+                        remaining.end());
+    }
+
+    //compact search graphs
+    this->upOffsets.assign(n + 1, 0);
+    this->downOffsets.assign(n + 1, 0);
+    this->up.clear();
+    this->down.clear();
+    for (uint32_t v = 0; v < n; v++) {
+        this->upOffsets[v] = this->up.size();
+        this->up.insert(this->up.end(), upEdges[v].begin(), upEdges[v].end());
+        vector<Edge>().swap(upEdges[v]);
+        this->downOffsets[v] = this->down.size();
+        this->down.insert(this->down.end(), downEdges[v].begin(), downEdges[v].end());
+        vector<Edge>().swap(downEdges[v]);
+    }
+    this->upOffsets[n] = this->up.size();
+    this->downOffsets[n] = this->down.size();
+
+    LOGGER::LogInfo("Contraction hierarchy built in " + to_string(rounds) + " rounds with " +
+                    to_string(this->shortcuts) + " shortcuts, " + to_string(this->MemoryUsage() / 1024) + " KB.");
+}
+
+const ContractionHierarchy::Edge*
+ ContractionHierarchy::findDown(const uint32_t nodeID, const uint32_t source) const {
+
+    for (uint32_t pos = DownBegin(nodeID); pos < DownEnd(nodeID); pos++)
+        if (this->down[pos].node == source)
+            return &this->down[pos];
+    return nullptr;
+}
+
+const ContractionHierarchy::Edge*
+ ContractionHierarchy::findUp(const uint32_t nodeID, const uint32_t target) const {
+
+    for (uint32_t pos = UpBegin(nodeID); pos < UpEnd(nodeID); pos++)
+        if (this->up[pos].node == target)
+            return &this->up[pos];
+    return nullptr;
+}
+
+/**
+* A shortcut from -> to with the middle node m consists of the arcs from -> m and m -> to.
+* m has been contracted before both, so from -> m is a downward arc of m and m -> to an upward arc of m.
+*/
+void
+ ContractionHierarchy::UnpackArc(const uint32_t from, const uint32_t to, const int32_t middle, const int32_t arcID,
+                                 std::vector<netxpert::data::arc_t>& path) const {
+
+    struct Item { uint32_t from; uint32_t to; int32_t middle; int32_t arcID; };
+
+    vector<Item> stack;
+    stack.push_back( Item {from, to, middle, arcID} );
+
+    while (!stack.empty()) {
+        const Item it = stack.back();
+        stack.pop_back();
+
+        if (it.middle < 0) {
+            path.push_back( graph_t::arcFromId(it.arcID) );
+            continue;
+        }
+        const uint32_t m = it.middle;
+        const Edge* first = findDown(m, it.from);
+        const Edge* second = findUp(m, it.to);
+        if (!first || !second) {
+            LOGGER::LogError("ContractionHierarchy::UnpackArc() - shortcut could not be unpacked!");
+            continue;
+        }
+        //LIFO: second half first
+        stack.push_back( Item {m, it.to, second->middle, second->arcID} );
+        stack.push_back( Item {it.from, m, first->middle, first->arcID} );
+    }
+}
+
+/**
+* Used for start and end nodes added after the hierarchy was built.
+*/
+void
+ ContractionHierarchy::LocalSearch(const netxpert::data::filtered_graph_t& g,
+                                   const netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>& costMap,
+                                   const netxpert::data::node_t start, const bool forward, const netxpert::data::cost_t threshold,
+                                   std::unordered_map<int, LocalLabel>& labels,
+                                   std::vector<std::pair<int, netxpert::data::cost_t> >& seeds) const {
+
+    typedef pair<cost_t, int> entry_t;
+    priority_queue<entry_t, vector<entry_t>, greater<entry_t> > queue;
+    unordered_set<int> settled;
+
+    const int startID = graph_t::id(start);
+    labels[startID] = LocalLabel {0, lemon::INVALID};
+    queue.push( entry_t(0, startID) );
+
+    while (!queue.empty()) {
+        const entry_t top = queue.top();
+        queue.pop();
+        const cost_t d = top.first;
+        const int x = top.second;
+
+        if (settled.count(x) > 0 || d > labels[x].dist)
+            continue;
+        if (threshold > 0 && d > threshold)
+            break;
+        settled.insert(x);
+
+        if (x != startID && Contains(x)) {
+            seeds.push_back( make_pair(x, d) );
+            continue;
+        }
+
+        const node_t xn = graph_t::nodeFromId(x);
+        if (forward) {
+            for (filtered_graph_t::OutArcIt a(g, xn); a != lemon::INVALID; ++a) {
+                const int y = graph_t::id(g.target(a));
+                const cost_t dy = d + costMap[a];
+                auto it = labels.find(y);
+                if (it == labels.end() || dy < it->second.dist) {
+                    labels[y] = LocalLabel {dy, a};
+                    queue.push( entry_t(dy, y) );
+                }
+            }
+        }
+        else {
+            for (filtered_graph_t::InArcIt a(g, xn); a != lemon::INVALID; ++a) {
+                const int y = graph_t::id(g.source(a));
+                const cost_t dy = d + costMap[a];
+                auto it = labels.find(y);
+                if (it == labels.end() || dy < it->second.dist) {
+                    labels[y] = LocalLabel {dy, a};
+                    queue.push( entry_t(dy, y) );
+                }
+            }
+        }
+    }
+}
+
+size_t
+ ContractionHierarchy::MemoryUsage() const {
+
+    return this->rank.capacity() * sizeof(uint32_t) + this->core.capacity() +
+           (this->upOffsets.capacity() + this->downOffsets.capacity()) * sizeof(uint32_t) +
+           (this->up.capacity() + this->down.capacity()) * sizeof(Edge);
+}
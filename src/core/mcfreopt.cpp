@@ -0,0 +1,249 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include "mcfreopt.hpp"
+#include <queue>
+#include <limits>
+#include <algorithm>
+
+using namespace std;
+using namespace netxpert::core;
+using namespace netxpert::data;
+
+namespace {
+    //tolerance for flows and reduced costs of double values
+    const double EPSILON = 1e-9;
+}
+
+MCFReoptimizer::MCFReoptimizer(filtered_graph_t& g,
+                               graph_t::ArcMap<cost_t>& costMap,
+                               graph_t::ArcMap<capacity_t>& capMap,
+                               graph_t::NodeMap<supply_t>& supplyMap)
+    : g(g), costMap(costMap), capMap(capMap), supplyMap(supplyMap), augmentations(0) {
+
+    const size_t nodeCount = g.maxNodeId() + 1;
+    this->flow.assign(g.maxArcId() + 1, 0);
+    this->potential.assign(nodeCount, 0);
+    this->excess.assign(nodeCount, 0);
+    this->dist.assign(nodeCount, numeric_limits<cost_t>::infinity());
+    this->pred.assign(nodeCount, lemon::INVALID);
+    this->predForward.assign(nodeCount, 0);
+    this->settled.assign(nodeCount, 0);
+}
+
+void
+ MCFReoptimizer::LoadSolution(graph_t::ArcMap<flow_t>& flowMap,
+                              graph_t::NodeMap<cost_t>& potentialMap) {
+
+    for (filtered_graph_t::NodeIt n(g); n != lemon::INVALID; ++n) {
+        this->potential[g.id(n)] = potentialMap[n];
+        this->excess[g.id(n)] = supplyMap[n];
+    }
+    //excess = supply - outflow + inflow; zero for the loaded optimal flow (up to rounding)
+    for (filtered_graph_t::ArcIt a(g); a != lemon::INVALID; ++a) {
+        const flow_t f = flowMap[a];
+        this->flow[g.id(a)] = f;
+        this->excess[g.id(g.source(a))] -= f;
+        this->excess[g.id(g.target(a))] += f;
+    }
+    for (auto& e : this->excess) {
+        if (std::abs(e) < EPSILON)
+            e = 0;
+    }
+}
+
+void
+ MCFReoptimizer::SetNodeSupply(const node_t& node, const supply_t supply) {
+
+    this->excess[g.id(node)] += supply - supplyMap[node];
+    supplyMap[node] = supply;
+}
+
+void
+ MCFReoptimizer::SetArcCost(const arc_t& arc, const cost_t cost) {
+
+    costMap[arc] = cost;
+    this->changedArcs.push_back(arc);
+}
+
+inline cost_t
+ MCFReoptimizer::reducedCost(const arc_t& arc) const {
+    //same definition as in LEMON
+    return costMap[arc] + this->potential[g.id(g.source(arc))] - this->potential[g.id(g.target(arc))];
+}
+
+bool
+ MCFReoptimizer::Reoptimize() {
+
+    this->augmentations = 0;
+
+    //restore the optimality conditions of the changed arcs:
+    //negative reduced cost -> full capacity, positive reduced cost -> no flow
+    for (const auto& arc : this->changedArcs) {
+        const int id = g.id(arc);
+        const cost_t rc = reducedCost(arc);
+        flow_t delta = 0;
+        if (rc < -EPSILON && this->flow[id] < capMap[arc])
+            delta = capMap[arc] - this->flow[id];
+        else if (rc > EPSILON && this->flow[id] > 0)
+            delta = -this->flow[id];
+        else
+            continue;
+
+        this->flow[id] += delta;
+        this->excess[g.id(g.source(arc))] -= delta;
+        this->excess[g.id(g.target(arc))] += delta;
+    }
+    this->changedArcs.clear();
+
+    for (;;) {
+        bool hasExcess = false;
+        bool hasDeficit = false;
+        for (const auto& e : this->excess) {
+            hasExcess  = hasExcess  || e > EPSILON;
+            hasDeficit = hasDeficit || e < -EPSILON;
+        }
+        if (!hasExcess)
+            return !hasDeficit;
+        if (!hasDeficit || !augment())
+            return false;
+        this->augmentations += 1;
+    }
+}
+
+bool
+ MCFReoptimizer::augment() {
+
+    typedef pair<cost_t, int> entry_t;
+    priority_queue<entry_t, vector<entry_t>, greater<entry_t> > heap;
+    vector<int> touched;
+
+    //multi source Dijkstra from all nodes with an excess
+    for (filtered_graph_t::NodeIt n(g); n != lemon::INVALID; ++n) {
+        const int id = g.id(n);
+        if (this->excess[id] > EPSILON) {
+            this->dist[id] = 0;
+            touched.push_back(id);
+            heap.push(make_pair(0, id));
+        }
+    }
+
+    auto relax = [&] (const int v, const node_t& w, const arc_t& arc, const bool forward, cost_t rc) {
+        //reduced costs are non negative up to rounding
+        if (rc < 0)
+            rc = 0;
+        const int wid = g.id(w);
+        const cost_t d = this->dist[v] + rc;
+        if (d < this->dist[wid]) {
+            if (this->dist[wid] == numeric_limits<cost_t>::infinity())
+                touched.push_back(wid);
+            this->dist[wid] = d;
+            this->pred[wid] = arc;
+            this->predForward[wid] = forward;
+            heap.push(make_pair(d, wid));
+        }
+    };
+
+    int target = -1;
+    vector<int> settledNodes;
+    while (!heap.empty()) {
+        const entry_t top = heap.top();
+        heap.pop();
+        const int v = top.second;
+        if (this->settled[v] || top.first > this->dist[v])
+            continue;
+        this->settled[v] = 1;
+        settledNodes.push_back(v);
+
+        if (this->excess[v] < -EPSILON) {
+            target = v;
+            break;
+        }
+        const node_t node = g.nodeFromId(v);
+        //residual arcs: forward with free capacity, backward with flow
+        for (filtered_graph_t::OutArcIt a(g, node); a != lemon::INVALID; ++a) {
+            if (capMap[a] - this->flow[g.id(a)] > EPSILON)
+                relax(v, g.target(a), a, true, reducedCost(a));
+        }
+        for (filtered_graph_t::InArcIt a(g, node); a != lemon::INVALID; ++a) {
+            if (this->flow[g.id(a)] > EPSILON)
+                relax(v, g.source(a), a, false, -reducedCost(a));
+        }
+    }
+
+    bool found = target >= 0;
+    if (found) {
+        //new potentials keep the reduced costs of the residual arcs non negative and those of the path zero
+        const cost_t targetDist = this->dist[target];
+        for (const int v : settledNodes)
+            this->potential[v] += this->dist[v] - targetDist;
+
+        //bottleneck of the path
+        flow_t delta = -this->excess[target];
+        int v = target;
+        while (this->pred[v] != lemon::INVALID) {
+            const arc_t& arc = this->pred[v];
+            if (this->predForward[v]) {
+                delta = std::min(delta, capMap[arc] - this->flow[g.id(arc)]);
+                v = g.id(g.source(arc));
+            }
+            else {
+                delta = std::min(delta, this->flow[g.id(arc)]);
+                v = g.id(g.target(arc));
+            }
+        }
+        const int source = v;
+        delta = std::min(delta, this->excess[source]);
+
+        v = target;
+        while (this->pred[v] != lemon::INVALID) {
+            const arc_t& arc = this->pred[v];
+            if (this->predForward[v]) {
+                this->flow[g.id(arc)] += delta;
+                v = g.id(g.source(arc));
+            }
+            else {
+                this->flow[g.id(arc)] -= delta;
+                v = g.id(g.target(arc));
+            }
+        }
+        this->excess[source] -= delta;
+        this->excess[target] += delta;
+    }
+
+    for (const int v : touched) {
+        this->dist[v] = numeric_limits<cost_t>::infinity();
+        this->pred[v] = lemon::INVALID;
+        this->settled[v] = 0;
+    }
+    return found;
+}
+
+flow_t
+ MCFReoptimizer::GetFlow(const arc_t& arc) const {
+
+    const int id = g.id(arc);
+    return id < (int) this->flow.size() ? this->flow[id] : 0;
+}
+
+double
+ MCFReoptimizer::GetOptimum() const {
+
+    double optimum = 0;
+    for (filtered_graph_t::ArcIt a(g); a != lemon::INVALID; ++a)
+        optimum += costMap[a] * this->flow[g.id(a)];
+    return optimum;
+}
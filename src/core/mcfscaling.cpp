@@ -0,0 +1,101 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include "mcfscaling.hpp"
+#include <cmath>
+#include <limits>
+
+using namespace netxpert::core;
+using namespace netxpert::data;
+
+namespace {
+
+    //scaled values must stay well below the int64 limit (see NS_LEM::solveInteger())
+    const double SCALED_LIMIT = std::pow(2.0, 60);
+
+    inline bool isIntegral(const double value) {
+        //tolerance for the representation error of the scaled value, e.g. 0.3 * 10
+        return std::abs(value - std::round(value)) <= 1e-9 * std::max(1.0, std::abs(value));
+    }
+}
+
+double
+ MCFScaling::GetScale(const int precision) {
+
+    return precision > 0 ? std::pow(10.0, precision) : 1.0;
+}
+
+bool
+ MCFScaling::HasIntegralFlows(const filtered_graph_t& g, const graph_t::ArcMap<capacity_t>& capMap,
+                              const graph_t::NodeMap<supply_t>& supplyMap, const double scale) {
+
+    double totalSupply = 0;
+    for (filtered_graph_t::NodeIt n(g); n != lemon::INVALID; ++n) {
+        const double supply = supplyMap[n] * scale;
+        if (!std::isfinite(supply) || !isIntegral(supply))
+            return false;
+        if (supply > 0)
+            totalSupply += supply;
+    }
+    if (totalSupply >= SCALED_LIMIT)
+        return false;
+    for (filtered_graph_t::ArcIt a(g); a != lemon::INVALID; ++a) {
+        const double cap = capMap[a];
+        if (std::isnan(cap))
+            return false;
+        if (cap >= DOUBLE_INFINITY)
+            continue;
+        if (!isIntegral(cap * scale) || std::abs(cap * scale) >= SCALED_LIMIT)
+            return false;
+    }
+    return true;
+}
+
+bool
+ MCFScaling::HasIntegralCosts(const filtered_graph_t& g, const graph_t::ArcMap<cost_t>& costMap,
+                              const double scale, const double costFactor) {
+
+    double maxCost = 0;
+    for (filtered_graph_t::ArcIt a(g); a != lemon::INVALID; ++a) {
+        const double cost = costMap[a] * scale;
+        if (!std::isfinite(cost) || !isIntegral(cost))
+            return false;
+        maxCost = std::max(maxCost, std::abs(cost));
+    }
+    const double nodeCount = lemon::countNodes(g);
+    return (nodeCount + 1) * (maxCost + 1) * costFactor < SCALED_LIMIT;
+}
+
+void
+ MCFScaling::ScaleFlows(const filtered_graph_t& g, const graph_t::ArcMap<capacity_t>& capMap,
+                        const graph_t::NodeMap<supply_t>& supplyMap, const double scale,
+                        filtered_graph_t::ArcMap<int64_t>& capInt, filtered_graph_t::NodeMap<int64_t>& supplyInt) {
+
+    for (filtered_graph_t::NodeIt n(g); n != lemon::INVALID; ++n)
+        supplyInt[n] = std::llround(supplyMap[n] * scale);
+    for (filtered_graph_t::ArcIt a(g); a != lemon::INVALID; ++a) {
+        const double cap = capMap[a];
+        capInt[a] = cap < DOUBLE_INFINITY ? std::llround(cap * scale) : std::numeric_limits<int64_t>::max();
+    }
+}
+
+void
+ MCFScaling::ScaleCosts(const filtered_graph_t& g, const graph_t::ArcMap<cost_t>& costMap,
+                        const double scale, filtered_graph_t::ArcMap<int64_t>& costInt) {
+
+    for (filtered_graph_t::ArcIt a(g); a != lemon::INVALID; ++a)
+        costInt[a] = std::llround(costMap[a] * scale);
+}
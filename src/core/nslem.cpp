@@ -15,6 +15,8 @@
  */
 
 #include "nslem.hpp"
+#include "logger.hpp"
+#include <cmath>
 
 using namespace std;
 using namespace lemon;
@@ -23,14 +25,120 @@ using namespace netxpert::core;
 void
  NS_LEM::SolveMCF() {
 
+    this->integerSolved = false;
+    this->nsimplexInt.reset();
+    if (this->integerPrecision >= 0) {
+        if (solveInteger())
+            return;
+        netxpert::utils::LOGGER::LogWarning("NS_LEM: scaled integer values could overflow with precision " +
+                                            to_string(this->integerPrecision) + " - solving with double values!");
+    }
+
     this->nsimplex = std::unique_ptr<netsimplex_t>(new netsimplex_t(*this->g, false));
 
-	//set input maps
-	this->nsimplex->upperMap(*this->capacityMap);
-	this->nsimplex->costMap(*this->costMap);
-	this->nsimplex->supplyMap(*this->supplyMap);
+    //set input maps
+    this->nsimplex->upperMap(*this->capacityMap);
+    this->nsimplex->costMap(*this->costMap);
+    this->nsimplex->supplyMap(*this->supplyMap);
+
+    this->status = nsimplex->run(getPivotRule());
+}
+
+/**
+* Scales costs, capacities and supplies with 10^precision to int64 and solves the instance.
+* The scaled values are checked first: potentials of LEMON are bounded by ART_COST (max/2) plus the length
+* of a path (nodes x max cost) and the flow of an arc by the total supply or its capacity; both must stay
+* well below the int64 limit. Returns false without solving otherwise.
+*/
+bool
+ NS_LEM::solveInteger() {
+
+    const double scale = std::pow(10.0, this->integerPrecision);
+    const double limit = std::pow(2.0, 60);
+    const auto& g = *this->g;
+
+    double nodeCount = 0;
+    double maxCost = 0;
+    double maxFlow = 0;
+    double totalSupply = 0;
+    double sumSupply = 0;
+    for (filtered_graph_t::NodeIt n(g); n != lemon::INVALID; ++n) {
+        const double supply = (*this->supplyMap)[n] * scale;
+        if (!std::isfinite(supply))
+            return false;
+        nodeCount += 1;
+        sumSupply += supply;
+        if (supply > 0)
+            totalSupply += supply;
+    }
+    maxFlow = totalSupply;
+    for (filtered_graph_t::ArcIt a(g); a != lemon::INVALID; ++a) {
+        const double cost = (*this->costMap)[a] * scale;
+        const double cap = (*this->capacityMap)[a];
+        if (!std::isfinite(cost) || std::isnan(cap))
+            return false;
+        maxCost = std::max(maxCost, std::abs(cost));
+        if (cap < DOUBLE_INFINITY)
+            maxFlow = std::max(maxFlow, std::abs(cap * scale));
+    }
+    if ((nodeCount + 1) * (maxCost + 1) >= limit || maxFlow >= limit)
+        return false;
+
+    filtered_graph_t::ArcMap<int64_t> costInt(g);
+    filtered_graph_t::ArcMap<int64_t> capInt(g);
+    filtered_graph_t::NodeMap<int64_t> supplyInt(g);
+    for (filtered_graph_t::ArcIt a(g); a != lemon::INVALID; ++a) {
+        const double cap = (*this->capacityMap)[a];
+        costInt[a] = std::llround((*this->costMap)[a] * scale);
+        capInt[a] = cap < DOUBLE_INFINITY ? std::llround(cap * scale) : std::numeric_limits<int64_t>::max();
+    }
+    //rounding must not change the balance of the instance: the difference goes to the largest supply or demand
+    int64_t sumSupplyInt = 0;
+    filtered_graph_t::Node largest = lemon::INVALID;
+    for (filtered_graph_t::NodeIt n(g); n != lemon::INVALID; ++n) {
+        supplyInt[n] = std::llround((*this->supplyMap)[n] * scale);
+        sumSupplyInt += supplyInt[n];
+        if (largest == lemon::INVALID || std::abs(supplyInt[n]) > std::abs(supplyInt[largest]))
+            largest = n;
+    }
+    if (largest != lemon::INVALID)
+        supplyInt[largest] += std::llround(sumSupply) - sumSupplyInt;
 
-	this->status = nsimplex->run();
+    this->nsimplexInt = std::unique_ptr<netsimplex_int_t>(new netsimplex_int_t(g, false));
+    this->nsimplexInt->upperMap(capInt);
+    this->nsimplexInt->costMap(costInt);
+    this->nsimplexInt->supplyMap(supplyInt);
+    //same order of the pivot rules and problem types in both instances of the template
+    this->status = static_cast<netsimplex_t::ProblemType>(
+                        this->nsimplexInt->run(static_cast<netsimplex_int_t::PivotRule>(getPivotRule())) );
+
+    this->integerSolved = true;
+    this->integerScale = scale;
+    //optimum on the unscaled costs
+    this->integerOptimum = 0;
+    if (this->status == netsimplex_t::OPTIMAL) {
+        for (filtered_graph_t::ArcIt a(g); a != lemon::INVALID; ++a)
+            this->integerOptimum += (*this->costMap)[a] * (this->nsimplexInt->flow(a) / scale);
+    }
+    return true;
+}
+
+NS_LEM::netsimplex_t::PivotRule
+ NS_LEM::getPivotRule() const {
+
+    switch (this->pivotRule)
+    {
+        case netxpert::cnfg::MCFPivotRule::FirstEligible:
+            return netsimplex_t::FIRST_ELIGIBLE;
+        case netxpert::cnfg::MCFPivotRule::BestEligible:
+            return netsimplex_t::BEST_ELIGIBLE;
+        case netxpert::cnfg::MCFPivotRule::CandidateList:
+            return netsimplex_t::CANDIDATE_LIST;
+        case netxpert::cnfg::MCFPivotRule::AlteringList:
+            return netsimplex_t::ALTERING_LIST;
+        default:
+            return netsimplex_t::BLOCK_SEARCH;
+    }
 }
 
 const uint32_t
@@ -53,28 +161,35 @@ void
                       netxpert::data::graph_t::ArcMap<netxpert::data::capacity_t>* _capMap,
                       netxpert::data::graph_t::NodeMap<supply_t>* _supplyMap)
 {
-  using namespace lemon;
-  using namespace netxpert::data;
+    using namespace lemon;
+    using namespace netxpert::data;
 
-  this->g             = _sg;
-  this->costMap       = _costMap;
-  this->capacityMap   = _capMap;
-	this->supplyMap     = _supplyMap;
+    this->g             = _sg;
+    this->costMap       = _costMap;
+    this->capacityMap   = _capMap;
+    this->supplyMap     = _supplyMap;
     //output (must be filtered_graph_t)
-	this->flowMap = new netxpert::data::filtered_graph_t::ArcMap<flow_t>(*this->g);
+    this->flowMap = new netxpert::data::filtered_graph_t::ArcMap<flow_t>(*this->g);
 }
 
 const double
  NS_LEM::GetOptimum() const {
-	return this->nsimplex->totalCost();
+    if (this->integerSolved)
+        return this->integerOptimum;
+    return this->nsimplex->totalCost();
 }
 
 netxpert::data::graph_t::ArcMap<netxpert::data::flow_t>*
  NS_LEM::GetMCFFlow() {
     //query flow map after run for returning flow
-	this->nsimplex->flowMap(*this->flowMap);
+    if (this->integerSolved) {
+        for (filtered_graph_t::ArcIt a(*this->g); a != lemon::INVALID; ++a)
+            (*this->flowMap)[a] = this->nsimplexInt->flow(a) / this->integerScale;
+        return this->flowMap;
+    }
+    this->nsimplex->flowMap(*this->flowMap);
 
-	return this->flowMap;
+    return this->flowMap;
 }
 
 std::vector<netxpert::data::arc_t>
@@ -90,6 +205,20 @@ netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>*
     return this->costMap;
 }
 
+netxpert::data::graph_t::NodeMap<netxpert::data::cost_t>*
+ NS_LEM::GetMCFPotential() {
+    //query potentials after run (optimal dual solution)
+    this->potentialMap = std::unique_ptr<filtered_graph_t::NodeMap<cost_t>>(new filtered_graph_t::NodeMap<cost_t>(*this->g));
+    if (this->integerSolved) {
+        for (filtered_graph_t::NodeIt n(*this->g); n != lemon::INVALID; ++n)
+            (*this->potentialMap)[n] = this->nsimplexInt->potential(n) / this->integerScale;
+        return this->potentialMap.get();
+    }
+    this->nsimplex->potentialMap(*this->potentialMap);
+
+    return this->potentialMap.get();
+}
+
 void
  NS_LEM::PrintResult() {
  //   SmartDigraph::NodeMap<double>& distMapVal = *distMap;
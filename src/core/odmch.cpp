@@ -0,0 +1,179 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include "odmch.hpp"
+#include "sptworkspace.hpp"
+#include <limits>
+#include <unordered_map>
+#include <omp.h>
+
+using namespace std;
+using namespace netxpert::core;
+using namespace netxpert::data;
+
+void
+ ODM_CH::LoadNet(netxpert::data::filtered_graph_t* sg,
+                 netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>* cm)
+{
+    this->g = sg;
+    this->costMap = cm;
+}
+
+void
+ ODM_CH::LoadCH(std::shared_ptr<const netxpert::core::ContractionHierarchy> _ch)
+{
+    this->ch = _ch;
+}
+
+/**
+* Backward phase: one complete search in the downward graph per destination.
+* Every thread collects (node, entry) pairs; the buckets are then built with a counting sort by node.
+*/
+void
+ ODM_CH::fillBuckets(const std::vector<netxpert::data::node_t>& dests, const int threads) {
+
+    const uint32_t nodeCount = this->ch->NodeCount();
+    vector<vector<pair<uint32_t, BucketEntry> > > collected (threads);
+
+    #pragma omp parallel num_threads(threads)
+    {
+    auto& entries = collected[omp_get_thread_num()];
+    SPTWorkspace ws;
+    ws.Resize(nodeCount);
+    unordered_map<int, ContractionHierarchy::LocalLabel> bwdLocal;
+    vector<pair<int, cost_t> > seeds;
+
+    #pragma omp for schedule(dynamic, 16)
+    for (size_t destIdx = 0; destIdx < dests.size(); destIdx++)
+    {
+        const int tID = graph_t::id(dests[destIdx]);
+        ws.NewSearch();
+        bwdLocal.clear();
+        seeds.clear();
+        if (this->ch->Contains(tID))
+            seeds.push_back( make_pair(tID, 0) );
+        else
+            this->ch->LocalSearch(*this->g, *this->costMap, dests[destIdx], false, -1, bwdLocal, seeds);
+
+        for (const auto& s : seeds)
+            ws.Relax(s.first, s.second, -1);
+
+        while (!ws.EmptyQueue()) {
+            const int v = ws.SettleNext();
+            const cost_t dv = ws.Dist(v);
+            entries.push_back( make_pair(v, BucketEntry {(uint32_t) destIdx, dv}) );
+            for (uint32_t pos = this->ch->DownBegin(v); pos < this->ch->DownEnd(v); pos++) {
+                const auto& e = this->ch->DownEdge(pos);
+                if (!ws.Settled(e.node))
+                    ws.Relax(e.node, dv + e.cost, pos);
+            }
+        }
+    }
+    }//omp parallel
+
+    this->bucketOffsets.assign(nodeCount + 1, 0);
+    for (const auto& entries : collected)
+        for (const auto& e : entries)
+            this->bucketOffsets[e.first + 1]++;
+    for (uint32_t v = 0; v < nodeCount; v++)
+        this->bucketOffsets[v + 1] += this->bucketOffsets[v];
+
+    this->bucketEntries.resize(this->bucketOffsets[nodeCount]);
+    vector<uint32_t> fill (this->bucketOffsets.begin(), this->bucketOffsets.end() - 1);
+    for (auto& entries : collected) {
+        for (const auto& e : entries)
+            this->bucketEntries[fill[e.first]++] = e.second;
+        vector<pair<uint32_t, BucketEntry> >().swap(entries);
+    }
+}
+
+/**
+* Forward phase: one complete search in the upward graph per origin, which scans the buckets.
+* Every origin is one row of the result store --> no concurrent writes.
+*/
+void
+ ODM_CH::Solve(const std::vector<netxpert::data::node_t>& origs,
+               const std::vector<netxpert::data::node_t>& dests,
+               netxpert::data::ODResultStore& result,
+               const int threads) {
+
+    const int numThreads = std::max(1, threads);
+    fillBuckets(dests, numThreads);
+
+    //destinations outside of the hierarchy may be reached by the local search of an origin only
+    unordered_multimap<int, size_t> localDests;
+    for (size_t destIdx = 0; destIdx < dests.size(); destIdx++) {
+        const int tID = graph_t::id(dests[destIdx]);
+        if (!this->ch->Contains(tID))
+            localDests.insert( make_pair(tID, destIdx) );
+    }
+
+    const cost_t infinity = std::numeric_limits<cost_t>::max();
+    const uint32_t nodeCount = this->ch->NodeCount();
+
+    #pragma omp parallel num_threads(numThreads)
+    {
+    SPTWorkspace ws;
+    ws.Resize(nodeCount);
+    unordered_map<int, ContractionHierarchy::LocalLabel> fwdLocal;
+    vector<pair<int, cost_t> > seeds;
+    vector<cost_t> row;
+
+    #pragma omp for schedule(dynamic, 16)
+    for (size_t origIdx = 0; origIdx < origs.size(); origIdx++)
+    {
+        const int sID = graph_t::id(origs[origIdx]);
+        row.assign(dests.size(), infinity);
+        ws.NewSearch();
+        fwdLocal.clear();
+        seeds.clear();
+        if (this->ch->Contains(sID))
+            seeds.push_back( make_pair(sID, 0) );
+        else {
+            this->ch->LocalSearch(*this->g, *this->costMap, origs[origIdx], true, -1, fwdLocal, seeds);
+            //paths over added arcs only
+            for (const auto& l : fwdLocal) {
+                auto range = localDests.equal_range(l.first);
+                for (auto it = range.first; it != range.second; ++it)
+                    row[it->second] = std::min(row[it->second], l.second.dist);
+            }
+        }
+
+        for (const auto& s : seeds)
+            ws.Relax(s.first, s.second, -1);
+
+        while (!ws.EmptyQueue()) {
+            const int v = ws.SettleNext();
+            const cost_t dv = ws.Dist(v);
+            for (uint32_t b = this->bucketOffsets[v]; b < this->bucketOffsets[v + 1]; b++) {
+                const BucketEntry& e = this->bucketEntries[b];
+                if (dv + e.dist < row[e.destIdx])
+                    row[e.destIdx] = dv + e.dist;
+            }
+            for (uint32_t pos = this->ch->UpBegin(v); pos < this->ch->UpEnd(v); pos++) {
+                const auto& e = this->ch->UpEdge(pos);
+                if (!ws.Settled(e.node))
+                    ws.Relax(e.node, dv + e.cost, pos);
+            }
+        }
+
+        for (size_t destIdx = 0; destIdx < dests.size(); destIdx++) {
+            if (row[destIdx] < infinity && origs[origIdx] != dests[destIdx])
+                result.Set(origIdx, destIdx, row[destIdx]);
+        }
+    }
+    }//omp parallel
+}
@@ -0,0 +1,344 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include "sptch.hpp"
+#include <limits>
+
+using namespace std;
+using namespace netxpert::core;
+using namespace netxpert::data;
+
+SPT_CH::SPT_CH(bool Drctd) : dijkstra(Drctd)
+{
+	isDrctd = Drctd;
+	allDests = true; //unless set with SetDest()
+	orig = lemon::INVALID;
+	dest = lemon::INVALID;
+	g = nullptr;
+	costMap = nullptr;
+}
+
+void
+ SPT_CH::LoadNet(const uint32_t nmax,  const uint32_t mmax,
+                      netxpert::data::filtered_graph_t* sg,
+                      netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>* cm)
+{
+    this->g = sg;
+    this->costMap = cm;
+    this->dijkstra.LoadNet(nmax, mmax, sg, cm);
+}
+
+void
+ SPT_CH::LoadCH(std::shared_ptr<const netxpert::core::ContractionHierarchy> _ch)
+{
+    this->ch = _ch;
+}
+
+const uint32_t
+ SPT_CH::GetArcCount() {
+
+    return lemon::countArcs(*this->g);
+}
+
+const uint32_t
+ SPT_CH::GetNodeCount() {
+
+    return lemon::countNodes(*this->g);
+}
+
+void
+ SPT_CH::SolveSPT(netxpert::data::cost_t threshold, bool bidirectional) {
+
+    this->results.clear();
+    this->fwdLocal.clear();
+
+    //whole shortest path tree: no use for the hierarchy
+    this->useDijkstra = this->allDests;
+    if (this->useDijkstra) {
+        this->dijkstra.SetOrigin(this->orig);
+        this->dijkstra.SetDest(lemon::INVALID);
+        this->dijkstra.SolveSPT(threshold, false);
+        return;
+    }
+
+    //complete upward search from the origin; shared by all destinations
+    this->fwd.Resize(this->ch->NodeCount());
+    this->bwd.Resize(this->ch->NodeCount());
+    this->fwd.NewSearch();
+
+    vector<pair<int, cost_t> > seeds;
+    const int origID = graph_t::id(this->orig);
+    if (this->ch->Contains(origID))
+        seeds.push_back( make_pair(origID, 0) );
+    else
+        this->ch->LocalSearch(*this->g, *this->costMap, this->orig, true, threshold, this->fwdLocal, seeds);
+
+    for (const auto& s : seeds)
+        this->fwd.Relax(s.first, s.second, -1);
+
+    while (!this->fwd.EmptyQueue()) {
+        if (threshold > 0 && this->fwd.NextDist() > threshold)
+            break;
+        const int v = this->fwd.SettleNext();
+        const cost_t dv = this->fwd.Dist(v);
+        for (uint32_t pos = this->ch->UpBegin(v); pos < this->ch->UpEnd(v); pos++) {
+            const auto& e = this->ch->UpEdge(pos);
+            if (!this->fwd.Settled(e.node))
+                this->fwd.Relax(e.node, dv + e.cost, pos);
+        }
+    }
+
+    for (const auto& t : this->dests)
+        solveTarget(t, threshold);
+
+    //keep the nearest destinations only
+    if (this->destLimit > 0 && this->results.size() > this->destLimit) {
+        vector<cost_t> dists;
+        for (const auto& r : this->results)
+            dists.push_back(r.second.dist);
+        std::nth_element(dists.begin(), dists.begin() + (this->destLimit - 1), dists.end());
+        const cost_t maxDist = dists[this->destLimit - 1];
+        for (auto it = this->results.begin(); it != this->results.end(); ) {
+            if (it->second.dist > maxDist)
+                it = this->results.erase(it);
+            else
+                ++it;
+        }
+    }
+}
+
+/**
+* Backward search from the target in the downward graph.
+* Stops as soon as the next node is not closer than the best meeting node found so far.
+*/
+void
+ SPT_CH::solveTarget(netxpert::data::node_t target, netxpert::data::cost_t threshold) {
+
+    const int tID = graph_t::id(target);
+    if (this->results.count(tID) > 0)
+        return;
+
+    Result r;
+    r.dist = std::numeric_limits<cost_t>::max();
+    r.meet = -1;
+
+    //path over added arcs only (e.g. origin and destination on the same arc)
+    auto localIt = this->fwdLocal.find(tID);
+    if (localIt != this->fwdLocal.end())
+        r.dist = localIt->second.dist;
+
+    auto& ws = this->bwd;
+    ws.NewSearch();
+
+    unordered_map<int, ContractionHierarchy::LocalLabel> bwdLocal;
+    vector<pair<int, cost_t> > seeds;
+    if (this->ch->Contains(tID))
+        seeds.push_back( make_pair(tID, 0) );
+    else
+        this->ch->LocalSearch(*this->g, *this->costMap, target, false, threshold, bwdLocal, seeds);
+
+    for (const auto& s : seeds)
+        ws.Relax(s.first, s.second, -1);
+
+    while (!ws.EmptyQueue()) {
+        if (ws.NextDist() >= r.dist)
+            break;
+        if (threshold > 0 && ws.NextDist() > threshold)
+            break;
+        const int v = ws.SettleNext();
+        const cost_t dv = ws.Dist(v);
+
+        if (this->fwd.Settled(v) && this->fwd.Dist(v) + dv < r.dist) {
+            r.dist = this->fwd.Dist(v) + dv;
+            r.meet = v;
+        }
+        for (uint32_t pos = this->ch->DownBegin(v); pos < this->ch->DownEnd(v); pos++) {
+            const auto& e = this->ch->DownEdge(pos);
+            if (!ws.Settled(e.node))
+                ws.Relax(e.node, dv + e.cost, pos);
+        }
+    }
+
+    if (r.dist == std::numeric_limits<cost_t>::max() || (threshold > 0 && r.dist > threshold))
+        return;
+
+    if (r.meet >= 0) {
+        //downward arcs from the meeting node to the source of the backward search
+        int v = r.meet;
+        for (int pos = ws.PredArc(v); pos >= 0; pos = ws.PredArc(v)) {
+            r.downChain.push_back(pos);
+            v = this->ch->DownOwner(pos);
+        }
+        //added arcs from there to the target
+        while (v != tID) {
+            const arc_t a = bwdLocal.at(v).pred;
+            r.suffix.push_back(a);
+            v = graph_t::id(this->g->target(a));
+        }
+    }
+    this->results.insert( make_pair(tID, r) );
+}
+
+void SPT_CH::SetOrigin( netxpert::data::node_t _origin )
+{
+	this->orig = _origin;
+}
+
+void SPT_CH::SetDest( netxpert::data::node_t _dest )
+{
+	this->dests.clear();
+
+	if (_dest != lemon::INVALID) {
+		this->dest = _dest;
+		this->dests.push_back(_dest);
+		this->allDests = false;
+	}
+	else {
+		this->allDests = true;
+	}
+}
+
+void SPT_CH::SetDests( const std::vector<netxpert::data::node_t>& _dests )
+{
+	this->dests = _dests;
+	this->allDests = _dests.size() == 0;
+}
+
+void SPT_CH::SetDestLimit( const size_t limit )
+{
+	this->destLimit = limit;
+}
+
+bool
+ SPT_CH::Reached( netxpert::data::node_t _node )
+{
+    if (this->useDijkstra)
+        return this->dijkstra.Reached(_node);
+
+    return this->results.count(graph_t::id(_node)) > 0;
+}
+
+const std::vector<netxpert::data::node_t>
+ SPT_CH::GetPredecessors(netxpert::data::node_t _dest) {
+
+    if (this->useDijkstra)
+        return this->dijkstra.GetPredecessors(_dest);
+
+    std::vector<netxpert::data::node_t> result;
+    const auto path = GetPath(_dest);
+    if (path.size() > 0) {
+        result.push_back(_dest);
+        for (auto it = path.rbegin(); it != path.rend(); ++it) {
+            if (this->g->source(*it) != this->orig)
+                result.push_back(this->g->source(*it));
+        }
+    }
+    result.push_back(this->orig);
+
+    return result;
+}
+
+const netxpert::data::cost_t
+ SPT_CH::GetDist(netxpert::data::node_t _dest) {
+
+    if (this->useDijkstra)
+        return this->dijkstra.GetDist(_dest);
+
+    auto it = this->results.find(graph_t::id(_dest));
+    if (it != this->results.end())
+        return it->second.dist;
+
+    return DOUBLE_INFINITY;
+}
+
+const std::vector<netxpert::data::node_t>
+ SPT_CH::GetSettledNodes() {
+
+    if (this->useDijkstra)
+        return this->dijkstra.GetSettledNodes();
+
+    //reached destinations in the order of their distances
+    std::vector<std::pair<netxpert::data::cost_t, int> > reached;
+    reached.reserve(this->results.size());
+    for (const auto& r : this->results)
+        reached.push_back( std::make_pair(r.second.dist, r.first) );
+    std::sort(reached.begin(), reached.end());
+
+    std::vector<netxpert::data::node_t> result;
+    result.reserve(reached.size());
+    for (const auto& r : reached)
+        result.push_back(graph_t::nodeFromId(r.second));
+
+    return result;
+}
+
+const std::vector<netxpert::data::arc_t>
+ SPT_CH::GetPath(netxpert::data::node_t _dest) {
+
+    if (this->useDijkstra)
+        return this->dijkstra.GetPath(_dest);
+
+    std::vector<netxpert::data::arc_t> path;
+
+    auto it = this->results.find(graph_t::id(_dest));
+    if (it == this->results.end())
+        return path;
+
+    const Result& r = it->second;
+    const int origID = graph_t::id(this->orig);
+
+    //walks the pred arcs of the local forward search back to the origin
+    auto appendLocalPath = [&](int v) {
+        std::vector<netxpert::data::arc_t> prefix;
+        while (v != origID) {
+            const arc_t a = this->fwdLocal.at(v).pred;
+            prefix.push_back(a);
+            v = graph_t::id(this->g->source(a));
+        }
+        path.insert(path.end(), prefix.rbegin(), prefix.rend());
+    };
+
+    if (r.meet < 0) {
+        appendLocalPath(graph_t::id(_dest));
+        return path;
+    }
+
+    //upward arcs from the source of the forward search to the meeting node
+    std::vector<uint32_t> upChain;
+    int v = r.meet;
+    for (int pos = this->fwd.PredArc(v); pos >= 0; pos = this->fwd.PredArc(v)) {
+        upChain.push_back(pos);
+        v = this->ch->UpOwner(pos);
+    }
+    appendLocalPath(v);
+
+    for (auto pos = upChain.rbegin(); pos != upChain.rend(); ++pos) {
+        const auto& e = this->ch->UpEdge(*pos);
+        this->ch->UnpackArc(this->ch->UpOwner(*pos), e.node, e.middle, e.arcID, path);
+    }
+    for (const uint32_t pos : r.downChain) {
+        const auto& e = this->ch->DownEdge(pos);
+        this->ch->UnpackArc(e.node, this->ch->DownOwner(pos), e.middle, e.arcID, path);
+    }
+    path.insert(path.end(), r.suffix.begin(), r.suffix.end());
+
+    return path;
+}
+
+SPT_CH::~SPT_CH()
+{
+    //dtor
+}
@@ -0,0 +1,268 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include "sptcsr.hpp"
+
+using namespace std;
+using namespace netxpert::core;
+using namespace netxpert::data;
+
+SPT_CSR::SPT_CSR(bool Drctd, bool SinglePrecision)
+{
+	isDrctd = Drctd;
+	singlePrecision = SinglePrecision;
+	allDests = true; //unless set with SetDest()
+	orig = lemon::INVALID;
+	dest = lemon::INVALID;
+}
+
+void
+ SPT_CSR::LoadNet(const uint32_t nmax,  const uint32_t mmax,
+                      netxpert::data::filtered_graph_t* sg,
+                      netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>* cm)
+{
+    auto snapshot = std::make_shared<CSRGraph>();
+    snapshot->Build(*sg, *cm, this->singlePrecision);
+    this->csr = snapshot;
+}
+
+void
+ SPT_CSR::LoadCSR(std::shared_ptr<const netxpert::data::CSRGraph> _csr)
+{
+    this->csr = _csr;
+}
+
+const uint32_t
+ SPT_CSR::GetArcCount() {
+
+    return this->csr->ArcCount();
+}
+
+const uint32_t
+ SPT_CSR::GetNodeCount() {
+
+    return this->csr->NodeCount();
+}
+
+void
+ SPT_CSR::SolveSPT(netxpert::data::cost_t threshold, bool bidirectional) {
+
+    const int origID = graph_t::id(this->orig);
+    this->workspace.Resize(this->csr->NodeCount());
+    this->workspace.NewSearch();
+
+    //origin is not part of the snapshot (e.g. added after freezing): nothing is reachable
+    if (origID < 0 || (uint32_t) origID >= this->csr->NodeCount())
+        return;
+
+    if (!this->multiTarget) {
+        runDijkstra(threshold, this->allDests ? -1 : graph_t::id(this->dest), 0);
+        return;
+    }
+
+    //one-to-many: mark the destinations; duplicates count once
+    if (this->destMarks.size() < this->csr->NodeCount())
+        this->destMarks.resize(this->csr->NodeCount(), 0);
+
+    size_t destsLeft = 0;
+    for (const auto& d : this->dests) {
+        const int id = graph_t::id(d);
+        if (id < 0 || (uint32_t) id >= this->csr->NodeCount())
+            continue;
+        if (!this->destMarks[id]) {
+            this->destMarks[id] = 1;
+            destsLeft += 1;
+        }
+    }
+
+    if (this->destLimit > 0)
+        destsLeft = std::min(destsLeft, this->destLimit);
+    if (destsLeft > 0)
+        runDijkstra(threshold, -1, destsLeft);
+
+    for (const auto& d : this->dests) {
+        const int id = graph_t::id(d);
+        if (id >= 0 && (uint32_t) id < this->csr->NodeCount())
+            this->destMarks[id] = 0;
+    }
+}
+
+void
+ SPT_CSR::runDijkstra(netxpert::data::cost_t threshold, int stopNode, size_t destsLeft) {
+
+    if (this->csr->singlePrecision)
+        runDijkstra(this->csr->costs32, threshold, stopNode, destsLeft);
+    else
+        runDijkstra(this->csr->costs, threshold, stopNode, destsLeft);
+}
+
+/**
+* Dijkstra search on the snapshot.
+* Stops if
+* - the queue is empty (shortest path tree) or
+* - the distance of the next node exceeds the threshold (if threshold > 0) or
+* - the stopNode has been settled (s-t search) or
+* - all marked destinations (destsLeft > 0) have been settled (one-to-many search).
+*/
+template <typename CostVector>
+void
+ SPT_CSR::runDijkstra(const CostVector& costs, netxpert::data::cost_t threshold, int stopNode, size_t destsLeft) {
+
+    auto& ws = this->workspace;
+    const auto& offsets = this->csr->offsets;
+    const auto& targets = this->csr->targets;
+    const bool multi = destsLeft > 0;
+
+    ws.Relax(graph_t::id(this->orig), 0, -1);
+
+    while (!ws.EmptyQueue()) {
+        //the distance of the next node is final
+        if (threshold > 0 && ws.NextDist() > threshold)
+            break;
+
+        const int u = ws.SettleNext();
+        const cost_t uDist = ws.Dist(u);
+
+        if (u == stopNode)
+            break;
+        if (multi && this->destMarks[u]) {
+            destsLeft -= 1;
+            if (destsLeft == 0)
+                break;
+        }
+
+        const uint32_t end = offsets[u + 1];
+        for (uint32_t pos = offsets[u]; pos < end; pos++) {
+            const int v = targets[pos];
+            if (!ws.Settled(v))
+                ws.Relax(v, uDist + costs[pos], pos);
+        }
+    }
+}
+
+void SPT_CSR::SetOrigin( netxpert::data::node_t _origin )
+{
+	this->orig = _origin;
+}
+
+void SPT_CSR::SetDest( netxpert::data::node_t _dest )
+{
+	this->multiTarget = false;
+	this->dests.clear();
+
+	if (_dest != lemon::INVALID) {
+		this->dest = _dest;
+		this->allDests = false;
+	}
+	else {
+		this->allDests = true;
+	}
+}
+
+void SPT_CSR::SetDests( const std::vector<netxpert::data::node_t>& _dests )
+{
+	this->dests = _dests;
+	this->multiTarget = _dests.size() > 0;
+	this->allDests = !this->multiTarget;
+}
+
+void SPT_CSR::SetDestLimit( const size_t limit )
+{
+	this->destLimit = limit;
+}
+
+bool
+ SPT_CSR::Reached( netxpert::data::node_t _node )
+{
+    const int id = graph_t::id(_node);
+    if (id < 0 || (size_t) id >= this->workspace.Size())
+        return false;
+
+    if (this->multiTarget)
+        return this->workspace.Settled(id);
+    else
+        return this->workspace.Reached(id);
+}
+
+const std::vector<netxpert::data::node_t>
+ SPT_CSR::GetPredecessors(netxpert::data::node_t _dest) {
+
+    std::vector<netxpert::data::node_t> result;
+
+    if (Reached(_dest)) {
+        for (int v = graph_t::id(_dest); v != graph_t::id(this->orig); ) {
+            result.push_back(graph_t::nodeFromId(v));
+            const int pred = this->workspace.PredArc(v);
+            if (pred < 0)
+                break;
+            v = this->csr->Source(pred);
+        }
+    }
+    result.push_back(this->orig);
+
+    return result;
+}
+
+const netxpert::data::cost_t
+ SPT_CSR::GetDist(netxpert::data::node_t _dest) {
+
+    if (Reached(_dest))
+        return this->workspace.Dist(graph_t::id(_dest));
+
+    return DOUBLE_INFINITY;
+}
+
+const std::vector<netxpert::data::node_t>
+ SPT_CSR::GetSettledNodes() {
+
+    std::vector<netxpert::data::node_t> result;
+
+    const auto& settled = this->workspace.SettledNodes();
+    result.reserve(settled.size());
+    for (const int id : settled)
+        result.push_back(graph_t::nodeFromId(id));
+
+    return result;
+}
+
+const std::vector<netxpert::data::arc_t>
+ SPT_CSR::GetPath(netxpert::data::node_t _dest) {
+
+    std::vector<netxpert::data::arc_t> path;
+
+    if (!Reached(_dest))
+        return path;
+
+    /// walk the path from dest to orig with the arc positions of the snapshot
+    /// and translate them back into arcs of the graph
+    for (int v = graph_t::id(_dest); v != graph_t::id(this->orig); ) {
+        const int pred = this->workspace.PredArc(v);
+        if (pred < 0)
+            break;
+        path.push_back( graph_t::arcFromId(this->csr->arcIDs[pred]) );
+        v = this->csr->Source(pred);
+    }
+
+    //reverse arcs, so path goes from start to dest
+    std::reverse(path.begin(), path.end());
+
+    return path;
+}
+
+SPT_CSR::~SPT_CSR()
+{
+    //dtor
+}
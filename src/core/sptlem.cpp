@@ -79,7 +79,9 @@ void
     if (this->bidirectional) {
         std::cout << "Bidirectional Dijkstra" << std::endl;
         //this->bijk = new bijkstra_t (*this->g, *this->costMap);
-        this->bijk = std::unique_ptr<bijkstra_t> (new bijkstra_t (*this->g, *this->costMap));
+        //keep the instance (and its maps) across searches; it is reset in LoadNet()
+        if (!this->bijk)
+            this->bijk = std::unique_ptr<bijkstra_t> (new bijkstra_t (*this->g, *this->costMap));
 
         this->bijk->init();
         this->bijk->addSource(this->orig);
@@ -109,65 +111,94 @@ void
         this->bijk->run(this->orig, this->dest);
     }
     else {
-        //std::cout << "Regular Dijkstra" << std::endl;
-        //this->dijk = new dijkstra_t (*this->g, *this->costMap);
-        this->dijk = std::unique_ptr<dijkstra_t> (new dijkstra_t (*this->g, *this->costMap));
+        //Dijkstra on the persistent workspace of this solver instance
+        //(no allocation and initialization of node maps per search)
+        if (this->multiTarget)
+            solveMultiTarget(threshold);
+        else
+            runDijkstra(threshold, this->allDests ? lemon::INVALID : this->dest, 0);
+    }
+}
 
-        this->dijk->init();
-        this->dijk->addSource(this->orig);
+/**
+* Dijkstra search on the workspace.
+* Stops if
+* - the queue is empty (shortest path tree) or
+* - the distance of the next node exceeds the threshold (if threshold > 0) or
+* - the stopNode has been settled (s-t search) or
+* - all marked destinations (destsLeft > 0) have been settled (one-to-many search).
+*/
+void
+ SPT_LEM::runDijkstra(netxpert::data::cost_t threshold, netxpert::data::node_t stopNode, size_t destsLeft) {
 
-        auto currentNode = this->dijk->nextNode();
+    using namespace netxpert::data;
 
-        //only if search distance is defined
-        if (threshold > 0) {
-            //s-t search
-            if (!this->allDests) {
-                while (currentNode != INVALID &&
-                        !this->dijk->emptyQueue() &&
-                        this->dijk->dist(currentNode) <= threshold
-                        && !this->dijk->processed(dest) //search only until dest is reached; -30 secs on 2 Mio arcs
-                         ) {
-                    this->dijk->processNextNode();
-                    currentNode = this->dijk->nextNode();
-                }
-            }
-            //shortest path tree
-            else {
-                while (currentNode != INVALID &&
-                        !this->dijk->emptyQueue() &&
-                        this->dijk->dist(currentNode) <= threshold
-                         ) {
-                    this->dijk->processNextNode();
-                    currentNode = this->dijk->nextNode();
-                    //todo: save all processed nodes (that are within the search radius)
-                    //and keep all arcs with processed nodes as end nodes
-                }
-            }
+    auto& ws = this->workspace;
+    ws.Resize(this->g->maxNodeId() + 1);
+    ws.NewSearch();
+    ws.Relax(this->g->id(this->orig), 0, -1);
+
+    const int stopNodeID = stopNode != lemon::INVALID ? this->g->id(stopNode) : -1;
+    const bool multi = destsLeft > 0;
+
+    while (!ws.EmptyQueue()) {
+        //the distance of the next node is final
+        if (threshold > 0 && ws.NextDist() > threshold)
+            break;
+
+        const int uID = ws.SettleNext();
+        const cost_t uDist = ws.Dist(uID);
+        const node_t u = this->g->nodeFromId(uID);
+
+        if (uID == stopNodeID)
+            break;
+        if (multi && this->destMarks[uID]) {
+            destsLeft -= 1;
+            if (destsLeft == 0)
+                break;
         }
-        else {
-            //s-t search
-            if (!this->allDests) {
-                while (currentNode != INVALID &&
-                        !this->dijk->emptyQueue()
-                        && !this->dijk->processed(dest) //search only until dest is reached; -30 secs on 2 Mio arcs
-                        ) {
-                    this->dijk->processNextNode();
-                    currentNode = this->dijk->nextNode();
-                }
-            }
-            //shortest path tree
-            else {
-                while (currentNode != INVALID &&
-                        !this->dijk->emptyQueue()
-                        ) {
-                    this->dijk->processNextNode();
-                    currentNode = this->dijk->nextNode();
-                }
-            }
+
+        for (filtered_graph_t::OutArcIt a(*this->g, u); a != lemon::INVALID; ++a) {
+            const int vID = this->g->id(this->g->target(a));
+            if (!ws.Settled(vID))
+                ws.Relax(vID, uDist + (*this->costMap)[a], this->g->id(a));
         }
     }
 }
 
+/**
+* One-to-many search: stops as soon as all destinations are settled
+* or the distance of the next node exceeds the threshold (if given).
+*/
+void
+ SPT_LEM::solveMultiTarget(netxpert::data::cost_t threshold) {
+
+    using namespace netxpert::data;
+
+    const size_t nodeIDCount = this->g->maxNodeId() + 1;
+    if (this->destMarks.size() < nodeIDCount)
+        this->destMarks.resize(nodeIDCount, 0);
+
+    //mark the destinations; duplicates count once
+    size_t destsLeft = 0;
+    for (const auto& d : this->dests) {
+        auto& mark = this->destMarks[this->g->id(d)];
+        if (!mark) {
+            mark = 1;
+            destsLeft += 1;
+        }
+    }
+
+    if (this->destLimit > 0)
+        destsLeft = std::min(destsLeft, this->destLimit);
+    if (destsLeft > 0)
+        runDijkstra(threshold, lemon::INVALID, destsLeft);
+
+    //reset only the marks that were set
+    for (const auto& d : this->dests)
+        this->destMarks[this->g->id(d)] = 0;
+}
+
 const uint32_t
  SPT_LEM::GetArcCount() {
 
@@ -196,6 +227,8 @@ void
     //this->length  = new SmartDigraph::ArcMap<double> (g);
     this->g = sg;
     this->costMap = cm;
+    //new graph: bidirectional search must be rebuilt, workspace grows on demand
+    this->bijk.reset();
     /*graph_t::NodeMap<node_t> node_ref(this->g);
     graph_t::ArcMap<netxpert::data::cost_t> sg_cost_map(this->g);
     graph_t::ArcMap<arc_t> arc_cross_ref(this->g);
@@ -215,13 +248,30 @@ void SPT_LEM::SetOrigin( netxpert::data::node_t _origin )
 
 void SPT_LEM::SetDest( netxpert::data::node_t _dest )
 {
+	this->multiTarget = false;
+	this->dests.clear();
+
 	if (_dest != lemon::INVALID) {
 		this->dest = _dest;
+		this->allDests = false;
 	}
 	else {
 		this->allDests = true;
 	}
 }
+
+void SPT_LEM::SetDests( const std::vector<netxpert::data::node_t>& _dests )
+{
+	this->dests = _dests;
+	this->multiTarget = _dests.size() > 0;
+	this->allDests = !this->multiTarget;
+}
+
+void SPT_LEM::SetDestLimit( const size_t limit )
+{
+	this->destLimit = limit;
+}
+
 bool
  SPT_LEM::Reached( netxpert::data::node_t _node )
 {
@@ -232,8 +282,15 @@ bool
         //return t1 || t2;
         return t1;
     }
+
+    const int id = this->g->id(_node);
+    if (id < 0 || (size_t) id >= this->workspace.Size())
+        return false;
+
+    if (this->multiTarget)
+        return this->workspace.Settled(id);
     else
-        return this->dijk->reached(_node);
+        return this->workspace.Reached(id);
 }
 
 /* Walk in whole SPT is possible from specified orig and end
@@ -251,10 +308,15 @@ const std::vector<netxpert::data::node_t>
         }
     }
     else {
-        for (netxpert::data::node_t v = _dest; v != this->orig; v = this->dijk->predNode(v)) {
-          if (v != lemon::INVALID && this->dijk->reached(v)) {
-             result.push_back(v);
-          }
+        if (!Reached(_dest))
+            return result;
+
+        for (netxpert::data::node_t v = _dest; v != this->orig; ) {
+          result.push_back(v);
+          const int pred = this->workspace.PredArc(this->g->id(v));
+          if (pred < 0)
+            break;
+          v = this->g->source(this->g->arcFromId(pred));
         }
     }
     result.push_back(this->orig);
@@ -270,9 +332,26 @@ const netxpert::data::cost_t
             return this->bijk->dist(_dest);
     }
     else {
-        if (this->dijk->reached(_dest))
-            return this->dijk->dist(_dest);
+        if (Reached(_dest))
+            return this->workspace.Dist(this->g->id(_dest));
     }
+    return DOUBLE_INFINITY;
+}
+
+const std::vector<netxpert::data::node_t>
+ SPT_LEM::GetSettledNodes() {
+
+    std::vector<netxpert::data::node_t> result;
+
+    if (this->bidirectional)
+        return result;
+
+    const auto& settled = this->workspace.SettledNodes();
+    result.reserve(settled.size());
+    for (const int id : settled)
+        result.push_back(this->g->nodeFromId(id));
+
+    return result;
 }
 
 const std::vector<netxpert::data::arc_t>
@@ -294,12 +373,17 @@ const std::vector<netxpert::data::arc_t>
         }
     }
     else {
-        for (node_t v = _dest; v != this->orig; v = this->dijk->predNode(v)) {
-            auto arc = this->dijk->predArc(v);
-            if (arc != lemon::INVALID) {
-                path.push_back(arc);
-                optimum += (*this->costMap)[arc];
-              }
+        if (!Reached(_dest))
+            return path;
+
+        for (node_t v = _dest; v != this->orig; ) {
+            const int pred = this->workspace.PredArc(this->g->id(v));
+            if (pred < 0)
+                break;
+            auto arc = this->g->arcFromId(pred);
+            path.push_back(arc);
+            optimum += (*this->costMap)[arc];
+            v = this->g->source(arc);
 //            std::cout << g->id(g->source(arc)) << "->" << g->id(g->target(arc)) << " , ";
         }
 //        std::cout << std::endl;
@@ -0,0 +1,555 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include "tpsimplex.hpp"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <cmath>
+#include "config.hpp"
+
+using namespace std;
+using namespace netxpert::core;
+using namespace netxpert::data;
+using netxpert::cnfg::LOCAL_NUM_THREADS;
+
+TransportationSimplex::TransportationSimplex()
+    : costs(nullptr), supplies(nullptr), demands(nullptr), allowed(nullptr),
+      origCount(0), destCount(0), rowCount(0), colCount(0), slackAmount(0), prohibitiveCost(0),
+      nextCell(0), blockSize(1), status(MCFSolverStatus::MCFUnSolved), optimum(0), iterations(0) {
+}
+
+void
+ TransportationSimplex::LoadMatrix(const std::vector<cost_t>& costs,
+                                   const std::vector<supply_t>& supplies,
+                                   const std::vector<supply_t>& demands,
+                                   const std::vector<char>* allowed) {
+
+    if (costs.size() != supplies.size() * demands.size())
+        throw std::runtime_error("Cost matrix of the transportation problem must have origins x destinations cells!");
+    if (allowed && allowed->size() != costs.size())
+        throw std::runtime_error("Mask of the transportation problem must have origins x destinations cells!");
+
+    this->costs     = &costs;
+    this->supplies  = &supplies;
+    this->demands   = &demands;
+    this->allowed   = allowed;
+    this->origCount = supplies.size();
+    this->destCount = demands.size();
+}
+
+inline bool
+ TransportationSimplex::isAllowed(const uint32_t row, const uint32_t col) const {
+
+    if (row >= this->origCount || col >= this->destCount)
+        return true;
+    const size_t idx = (size_t) row * this->destCount + col;
+    return (!this->allowed || (*this->allowed)[idx]) && std::isfinite((*this->costs)[idx]);
+}
+
+inline cost_t
+ TransportationSimplex::cellCost(const uint32_t row, const uint32_t col) const {
+
+    //slack row or column
+    if (row >= this->origCount || col >= this->destCount)
+        return 0;
+    if (!isAllowed(row, col))
+        return this->prohibitiveCost;
+    return (*this->costs)[(size_t) row * this->destCount + col];
+}
+
+void
+ TransportationSimplex::Solve() {
+
+    if (!this->costs)
+        throw std::runtime_error("Transportation problem must be loaded before solving!");
+
+    this->basis.clear();
+    this->iterations = 0;
+    this->optimum = 0;
+
+    supply_t totalSupply = 0;
+    supply_t totalDemand = 0;
+    for (auto s : *this->supplies)
+        totalSupply += std::max(s, 0.0);
+    for (auto d : *this->demands)
+        totalDemand += std::max(d, 0.0);
+    const double tolerance = 1e-9 * std::max(1.0, std::max(totalSupply, totalDemand));
+
+    //implicit slack column (extra supply) or slack row (extra demand)
+    this->rowCount = this->origCount;
+    this->colCount = this->destCount;
+    this->slackAmount = 0;
+    if (totalSupply > totalDemand + tolerance) {
+        this->colCount += 1;
+        this->slackAmount = totalSupply - totalDemand;
+    }
+    else if (totalDemand > totalSupply + tolerance) {
+        this->rowCount += 1;
+        this->slackAmount = totalDemand - totalSupply;
+    }
+    if (this->rowCount == 0 || this->colCount == 0) {
+        this->status = totalSupply + totalDemand > 0 ? MCFSolverStatus::MCFUnfeasible : MCFSolverStatus::MCFOK;
+        return;
+    }
+
+    //cells that are not allowed must never pay off in the initial basis
+    cost_t maxCost = 0;
+    for (uint32_t i = 0; i < this->origCount; i++) {
+        for (uint32_t j = 0; j < this->destCount; j++) {
+            if (isAllowed(i, j))
+                maxCost = std::max(maxCost, std::abs((*this->costs)[(size_t) i * this->destCount + j]));
+        }
+    }
+    this->prohibitiveCost = (maxCost + 1) * (this->rowCount + this->colCount);
+
+    const uint32_t nodeCount = this->rowCount + this->colCount;
+    this->incidentCells.assign(nodeCount, std::vector<uint32_t>());
+    this->parentCell.assign(nodeCount, -1);
+    this->depth.assign(nodeCount, 0);
+
+    buildVogelBasis();
+    computePotentials();
+
+    //block size of the pricing like in LEMON's NetworkSimplex
+    this->blockSize = std::max<uint64_t>(10, (uint64_t) std::sqrt((double) this->rowCount * this->colCount));
+    this->nextCell = 0;
+
+    //degenerate pivots (no flow moves) keep the objective; after a run of nodeCount of them the pivots follow
+    //Bland's rule until flow moves again, so the basis cannot cycle
+    const uint64_t maxIterations = 100ull * nodeCount + 10000;
+    uint32_t degenerateRun = 0;
+    uint32_t row, col;
+    for (;;) {
+        const bool bland = degenerateRun >= nodeCount;
+        if (!(bland ? findEnteringCellBland(row, col) : findEnteringCell(row, col)))
+            break;
+        if (pivot(row, col, bland))
+            degenerateRun += 1;
+        else
+            degenerateRun = 0;
+        this->iterations += 1;
+        if (this->iterations > maxIterations) {
+            this->status = MCFSolverStatus::MCFStopped;
+            return;
+        }
+    }
+
+    this->status = MCFSolverStatus::MCFOK;
+    for (const auto& cell : this->basis) {
+        if (cell.row >= this->origCount || cell.col >= this->destCount)
+            continue;
+        if (!isAllowed(cell.row, cell.col)) {
+            if (cell.flow > tolerance)
+                this->status = MCFSolverStatus::MCFUnfeasible;
+            continue;
+        }
+        this->optimum += cellCost(cell.row, cell.col) * cell.flow;
+    }
+}
+
+void
+ TransportationSimplex::addBasicCell(const uint32_t row, const uint32_t col, const flow_t flow) {
+
+    const uint32_t idx = this->basis.size();
+    this->basis.push_back( BasicCell {row, col, flow} );
+    this->incidentCells[row].push_back(idx);
+    this->incidentCells[this->rowCount + col].push_back(idx);
+}
+
+void
+ TransportationSimplex::buildVogelBasis() {
+
+    const uint32_t R = this->rowCount;
+    const uint32_t C = this->colCount;
+
+    std::vector<supply_t> rs(R, 0);
+    std::vector<supply_t> rd(C, 0);
+    for (uint32_t i = 0; i < this->origCount; i++)
+        rs[i] = std::max((*this->supplies)[i], 0.0);
+    for (uint32_t j = 0; j < this->destCount; j++)
+        rd[j] = std::max((*this->demands)[j], 0.0);
+    if (R > this->origCount)
+        rs[R - 1] = this->slackAmount;
+    if (C > this->destCount)
+        rd[C - 1] = this->slackAmount;
+
+    //rows (columns) are sorted by cost in growing chunks on demand: the two cheapest active cells are found
+    //by moving forward only, and most lines are closed long before they are sorted completely
+    std::vector<uint32_t> rowOrder((size_t) R * C);
+    std::vector<uint32_t> colOrder((size_t) C * R);
+    std::vector<uint32_t> rowSorted(R, 0);
+    std::vector<uint32_t> colSorted(C, 0);
+
+    auto ensureSorted = [] (uint32_t* order, uint32_t& sorted, const uint32_t size, const uint32_t pos, auto cost) {
+        while (pos >= sorted && sorted < size) {
+            const uint32_t chunk = std::min(size - sorted, std::max<uint32_t>(32, sorted));
+            auto less = [&] (uint32_t a, uint32_t b) { return cost(a) < cost(b); };
+            std::nth_element(order + sorted, order + sorted + chunk - 1, order + size, less);
+            std::sort(order + sorted, order + sorted + chunk, less);
+            sorted += chunk;
+        }
+    };
+
+    const int numThreads = std::max(1, LOCAL_NUM_THREADS);
+    #pragma omp parallel num_threads(numThreads)
+    {
+        #pragma omp for schedule(dynamic, 16)
+        for (int64_t i = 0; i < (int64_t) R; i++) {
+            uint32_t* order = &rowOrder[i * C];
+            std::iota(order, order + C, 0);
+            ensureSorted(order, rowSorted[i], C, 1, [&] (uint32_t j) { return cellCost(i, j); });
+        }
+        #pragma omp for schedule(dynamic, 16)
+        for (int64_t j = 0; j < (int64_t) C; j++) {
+            uint32_t* order = &colOrder[j * R];
+            std::iota(order, order + R, 0);
+            ensureSorted(order, colSorted[j], R, 1, [&] (uint32_t i) { return cellCost(i, j); });
+        }
+    }
+
+    std::vector<char> rowActive(R, 1);
+    std::vector<char> colActive(C, 1);
+    std::vector<uint32_t> rowFirst(R, 0), rowSecond(R, 1);
+    std::vector<uint32_t> colFirst(C, 0), colSecond(C, 1);
+    uint32_t activeRows = R;
+    uint32_t activeCols = C;
+
+    //penalty: difference of the two cheapest active cells (the cost of the cell, if only one is left)
+    auto penalty = [&ensureSorted] (uint32_t* order, uint32_t& sorted, const uint32_t size, const std::vector<char>& active,
+                                    uint32_t& first, uint32_t& second, auto cost) -> cost_t {
+        ensureSorted(order, sorted, size, first, cost);
+        while (!active[order[first]]) {
+            first++;
+            ensureSorted(order, sorted, size, first, cost);
+        }
+        second = std::max(second, first + 1);
+        ensureSorted(order, sorted, size, second, cost);
+        while (second < size && !active[order[second]]) {
+            second++;
+            ensureSorted(order, sorted, size, second, cost);
+        }
+        if (second >= size)
+            return cost(order[first]);
+        return cost(order[second]) - cost(order[first]);
+    };
+
+    while (activeRows > 0 && activeCols > 0)
+    {
+        //line with the highest penalty
+        cost_t bestPenalty = -1;
+        bool bestIsRow = true;
+        uint32_t bestLine = 0;
+        for (uint32_t i = 0; i < R; i++) {
+            if (!rowActive[i])
+                continue;
+            const cost_t p = penalty(&rowOrder[(size_t) i * C], rowSorted[i], C, colActive, rowFirst[i], rowSecond[i],
+                                     [&] (uint32_t j) { return cellCost(i, j); });
+            if (p > bestPenalty) {
+                bestPenalty = p;
+                bestIsRow = true;
+                bestLine = i;
+            }
+        }
+        for (uint32_t j = 0; j < C; j++) {
+            if (!colActive[j])
+                continue;
+            const cost_t p = penalty(&colOrder[(size_t) j * R], colSorted[j], R, rowActive, colFirst[j], colSecond[j],
+                                     [&] (uint32_t i) { return cellCost(i, j); });
+            if (p > bestPenalty) {
+                bestPenalty = p;
+                bestIsRow = false;
+                bestLine = j;
+            }
+        }
+        //cheapest active cell of that line
+        const uint32_t i = bestIsRow ? bestLine : colOrder[(size_t) bestLine * R + colFirst[bestLine]];
+        const uint32_t j = bestIsRow ? rowOrder[(size_t) bestLine * C + rowFirst[bestLine]] : bestLine;
+
+        const flow_t x = std::min(rs[i], rd[j]);
+        addBasicCell(i, j, x);
+        rs[i] -= x;
+        rd[j] -= x;
+
+        //exactly one line leaves per cell (the last cell closes both), so the basis is a spanning tree
+        //with rows + columns - 1 cells, also for degenerate instances
+        bool removeRow;
+        if (activeRows == 1)
+            removeRow = false;
+        else if (activeCols == 1)
+            removeRow = true;
+        else
+            removeRow = rs[i] <= rd[j];
+
+        if (removeRow) {
+            rowActive[i] = 0;
+            activeRows -= 1;
+            rs[i] = 0;
+        }
+        else {
+            colActive[j] = 0;
+            activeCols -= 1;
+            rd[j] = 0;
+        }
+    }
+}
+
+inline uint32_t
+ TransportationSimplex::otherNode(const uint32_t cellIdx, const uint32_t node) const {
+
+    const BasicCell& cell = this->basis[cellIdx];
+    return (node == cell.row) ? this->rowCount + cell.col : cell.row;
+}
+
+void
+ TransportationSimplex::computePotentials() {
+
+    //u(i) + v(j) = c(i,j) for every basic cell; the tree is rooted at the first row with u = 0
+    this->u.assign(this->rowCount, 0);
+    this->v.assign(this->colCount, 0);
+    this->parentCell[0] = -1;
+    this->depth[0] = 0;
+
+    this->stack.assign(1, 0);
+    while (!this->stack.empty()) {
+        const uint32_t x = this->stack.back();
+        this->stack.pop_back();
+        for (const uint32_t idx : this->incidentCells[x]) {
+            if ((int64_t) idx == this->parentCell[x])
+                continue;
+            const uint32_t y = otherNode(idx, x);
+            const BasicCell& cell = this->basis[idx];
+            if (y < this->rowCount)
+                this->u[y] = cellCost(cell.row, cell.col) - this->v[cell.col];
+            else
+                this->v[cell.col] = cellCost(cell.row, cell.col) - this->u[cell.row];
+            this->parentCell[y] = idx;
+            this->depth[y] = this->depth[x] + 1;
+            this->stack.push_back(y);
+        }
+    }
+}
+
+void
+ TransportationSimplex::updateSubtree(const uint32_t subRoot, const cost_t deltaU, const cost_t deltaV) {
+
+    //shifts the potentials and sets the depths of the subtree; the parents must already be set
+    this->stack.assign(1, subRoot);
+    while (!this->stack.empty()) {
+        const uint32_t x = this->stack.back();
+        this->stack.pop_back();
+        if (x < this->rowCount)
+            this->u[x] += deltaU;
+        else
+            this->v[x - this->rowCount] += deltaV;
+
+        for (const uint32_t idx : this->incidentCells[x]) {
+            if ((int64_t) idx == this->parentCell[x])
+                continue;
+            const uint32_t y = otherNode(idx, x);
+            this->depth[y] = this->depth[x] + 1;
+            this->stack.push_back(y);
+        }
+    }
+}
+
+bool
+ TransportationSimplex::findEnteringCell(uint32_t& row, uint32_t& col) {
+
+    const uint64_t total = (uint64_t) this->rowCount * this->colCount;
+    const cost_t tolerance = 1e-9 * (this->prohibitiveCost / (this->rowCount + this->colCount));
+    cost_t best = -tolerance;
+    bool found = false;
+
+    uint32_t i = this->nextCell / this->colCount;
+    uint32_t j = this->nextCell % this->colCount;
+    uint64_t scanned = 0;
+    uint64_t blockEnd = this->blockSize;
+    //row segments of the cyclic block search
+    while (scanned < total)
+    {
+        const uint32_t end = (uint32_t) std::min<uint64_t>(this->colCount, j + (blockEnd - scanned));
+        const cost_t ui = this->u[i];
+        if (i < this->origCount) {
+            const size_t rowStart = (size_t) i * this->destCount;
+            const cost_t* c = &(*this->costs)[rowStart];
+            const uint32_t realEnd = std::min(end, this->destCount);
+            for (uint32_t k = j; k < realEnd; k++) {
+                //not finite costs never pass the comparison; the mask is checked only for candidates
+                const cost_t d = c[k] - ui - this->v[k];
+                if (d < best && (!this->allowed || (*this->allowed)[rowStart + k])) {
+                    best = d;
+                    row = i;
+                    col = k;
+                    found = true;
+                }
+            }
+        }
+        //slack cells
+        for (uint32_t k = std::max(j, i < this->origCount ? this->destCount : 0); k < end; k++) {
+            const cost_t d = -ui - this->v[k];
+            if (d < best) {
+                best = d;
+                row = i;
+                col = k;
+                found = true;
+            }
+        }
+        scanned += end - j;
+        j = end;
+        if (j == this->colCount) {
+            j = 0;
+            if (++i == this->rowCount)
+                i = 0;
+        }
+        if (scanned == blockEnd) {
+            if (found)
+                break;
+            blockEnd += this->blockSize;
+        }
+    }
+    this->nextCell = (uint64_t) i * this->colCount + j;
+    return found;
+}
+
+/**
+* Entering cell of Bland's rule: the first cell in row-major order (slack cells included) with a negative
+* reduced cost.
+*/
+bool
+ TransportationSimplex::findEnteringCellBland(uint32_t& row, uint32_t& col) const {
+
+    const cost_t tolerance = 1e-9 * (this->prohibitiveCost / (this->rowCount + this->colCount));
+    for (uint32_t i = 0; i < this->rowCount; i++) {
+        for (uint32_t j = 0; j < this->colCount; j++) {
+            if (!isAllowed(i, j))
+                continue;
+            if (cellCost(i, j) - this->u[i] - this->v[j] < -tolerance) {
+                row = i;
+                col = j;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+* The leaving cell is the blocking cell (minimum flow on the cells that lose flow) met last when the cycle is
+* walked from its apex in the direction of the entering cell, like in the strongly feasible trees of LEMON's
+* NetworkSimplex. With bland, ties are broken by the smallest cell index instead (Bland's rule).
+* Returns true if the pivot is degenerate.
+*/
+bool
+ TransportationSimplex::pivot(const uint32_t row, const uint32_t col, const bool bland) {
+
+    const uint32_t colNode = this->rowCount + col;
+
+    //cycle of the entering cell: tree paths from both ends up to the common ancestor
+    std::vector<uint32_t> rowSide;
+    std::vector<uint32_t> path;
+    uint32_t a = row;
+    uint32_t b = colNode;
+    while (a != b) {
+        if (this->depth[a] >= this->depth[b]) {
+            rowSide.push_back(this->parentCell[a]);
+            a = otherNode(this->parentCell[a], a);
+        }
+        else {
+            path.push_back(this->parentCell[b]);
+            b = otherNode(this->parentCell[b], b);
+        }
+    }
+    //entering cell (+), then alternating (-), (+), .. from the column back to the row
+    path.insert(path.end(), rowSide.rbegin(), rowSide.rend());
+    const size_t colSideCount = path.size() - rowSide.size();
+
+    //cells that lose flow are at even positions; walk from the apex: down the row side, then up the column side
+    auto cellIndex = [&] (const size_t k) {
+        const BasicCell& cell = this->basis[path[k]];
+        return (uint64_t) cell.row * this->colCount + cell.col;
+    };
+    flow_t theta = 0;
+    size_t leaving = 0;
+    bool first = true;
+    for (size_t n = 0; n < path.size(); n++) {
+        const size_t k = n < rowSide.size() ? colSideCount + n : n - rowSide.size();
+        if (k % 2 != 0)
+            continue;
+        const flow_t f = this->basis[path[k]].flow;
+        const bool tie = !first && f == theta;
+        if (first || f < theta || (tie && (!bland || cellIndex(k) < cellIndex(leaving)))) {
+            theta = f;
+            leaving = k;
+            first = false;
+        }
+    }
+    theta = std::max(theta, 0.0);
+    for (size_t k = 0; k < path.size(); k++)
+        this->basis[path[k]].flow += (k % 2 == 0) ? -theta : theta;
+
+    //the leaving cell cuts off the subtree below it, which holds one end of the entering cell
+    const uint32_t leaveIdx = path[leaving];
+    const BasicCell leaveCell = this->basis[leaveIdx];
+    const uint32_t leaveRowNode = leaveCell.row;
+    const uint32_t leaveColNode = this->rowCount + leaveCell.col;
+    const uint32_t subRoot = (this->parentCell[leaveRowNode] == (int64_t) leaveIdx) ? leaveRowNode : leaveColNode;
+    const bool rowCutOff = leaving >= colSideCount;
+    const uint32_t newRoot = rowCutOff ? row : colNode;
+
+    auto& rowCells = this->incidentCells[leaveRowNode];
+    rowCells.erase(std::find(rowCells.begin(), rowCells.end(), leaveIdx));
+    auto& colCells = this->incidentCells[leaveColNode];
+    colCells.erase(std::find(colCells.begin(), colCells.end(), leaveIdx));
+
+    //the entering cell takes the slot of the leaving cell
+    this->basis[leaveIdx] = BasicCell {row, col, theta};
+    this->incidentCells[row].push_back(leaveIdx);
+    this->incidentCells[colNode].push_back(leaveIdx);
+
+    //re-root the cut off subtree at the end of the entering cell: reverse the parents up to the old subtree root
+    int64_t prevCell = leaveIdx;
+    uint32_t x = newRoot;
+    for (;;) {
+        const int64_t next = this->parentCell[x];
+        this->parentCell[x] = prevCell;
+        if (x == subRoot)
+            break;
+        prevCell = next;
+        x = otherNode(next, x);
+    }
+    this->depth[newRoot] = this->depth[rowCutOff ? colNode : row] + 1;
+
+    //potentials: the reduced cost of the entering cell becomes zero
+    const cost_t delta = cellCost(row, col) - this->u[row] - this->v[col];
+    if (rowCutOff)
+        updateSubtree(newRoot, delta, -delta);
+    else
+        updateSubtree(newRoot, -delta, delta);
+
+    return theta == 0;
+}
+
+std::vector<TransportationCell>
+ TransportationSimplex::GetFlows() const {
+
+    std::vector<TransportationCell> result;
+    for (const auto& cell : this->basis) {
+        if (cell.row < this->origCount && cell.col < this->destCount && cell.flow > 0)
+            result.push_back( TransportationCell {cell.row, cell.col, cell.flow} );
+    }
+    return result;
+}
@@ -16,6 +16,7 @@
 
 #include "dbhelper.hpp"
 #include <stdexcept>
+#include <mutex>
 
 using namespace std;
 using namespace geos::io;
@@ -26,16 +27,98 @@ using namespace netxpert::io;
 using namespace netxpert::data;
 using namespace netxpert::utils;
 
-//Init static member variables must be out of class scope!
-std::unique_ptr<SQLite::Database> DBHELPER::connPtr = nullptr;
-std::unique_ptr<SQLite::Transaction> DBHELPER::currentTransactionPtr = nullptr;
-netxpert::cnfg::Config DBHELPER::NETXPERT_CNFG;
-bool DBHELPER::isConnected = false;
-bool DBHELPER::IsInitialized = false;
-std::unordered_set<netxpert::data::extarcid_t> DBHELPER::EliminatedArcs;
-geos::geom::GeometryFactory::unique_ptr DBHELPER::GEO_FACTORY;
-std::unordered_map<netxpert::data::extarcid_t, std::shared_ptr<geos::geom::LineString>> DBHELPER::KV_Network;
+namespace {
+    /*
+    * Notes on precision model
+    *
+    * GEOS uses an internal precision model. This must fit to the model in SpatiaLite (which is also defined by GEOS internally).
+    * Because splitting of the arcs happens in the SpatiaLite DB, we must have a common precision model of the geometries.
+    * So we are tied here to FLOATING (precision of 16 floating point numbers).
+     */
+    geos::geom::GeometryFactory::unique_ptr createGeoFactory()
+    {
+        PrecisionModel pm (geos::geom::PrecisionModel::FLOATING);
+        // SRID of -1 (undefined).
+        return geos::geom::GeometryFactory::create(&pm, -1);
+    }
+    // loading SpatiaLite changes the working directory of the process
+    std::mutex spatiaLiteLoadMutex;
+
+    /*
+    * Arcs of one ROWID range of the arcs table. Node IDs are interned into chunk local indices.
+    * As long as all values of an ID column are integers they are kept as integers (intNodeIDs, intArcIDs);
+    * the first text value converts the IDs read so far into strings.
+    */
+    struct ArcChunk
+    {
+        InputArcColumns arcs;
+        bool hasIntNodeIDs = true;
+        bool hasIntArcIDs = true;
+        std::unordered_map<int64_t, uint32_t> intNodes;
+        std::unordered_map<std::string, uint32_t> textNodes;
+        std::string error;
+
+        uint32_t InternNode(const SQLite::Column& col) {
+            if (col.isInteger() && hasIntNodeIDs) {
+                const int64_t key = col.getInt64();
+                auto it = intNodes.find(key);
+                if (it != intNodes.end())
+                    return it->second;
+                const uint32_t idx = arcs.intNodeIDs.size();
+                intNodes.insert( make_pair(key, idx) );
+                arcs.intNodeIDs.push_back(key);
+                return idx;
+            }
+            SwitchNodesToText();
+            std::string key = col.isInteger() ? to_string(col.getInt64()) : std::string(col.getText(), col.getBytes());
+            auto it = textNodes.find(key);
+            if (it != textNodes.end())
+                return it->second;
+            const uint32_t idx = arcs.nodeIDs.size();
+            arcs.nodeIDs.push_back(key);
+            textNodes.insert( make_pair(std::move(key), idx) );
+            return idx;
+        }
 
+        void AddArcID(const SQLite::Column& col) {
+            if (col.isInteger() && hasIntArcIDs) {
+                arcs.intArcIDs.push_back( col.getInt64() );
+                return;
+            }
+            SwitchArcsToText();
+            if (col.isInteger())
+                arcs.arcIDs.push_back( to_string(col.getInt64()) );
+            else
+                arcs.arcIDs.push_back( string(col.getText(), col.getBytes()) );
+        }
+
+        void SwitchNodesToText() {
+            if (!hasIntNodeIDs)
+                return;
+            hasIntNodeIDs = false;
+            arcs.nodeIDs.reserve(arcs.intNodeIDs.size());
+            for (uint32_t i = 0; i < arcs.intNodeIDs.size(); i++) {
+                arcs.nodeIDs.push_back( to_string(arcs.intNodeIDs[i]) );
+                textNodes.insert( make_pair(arcs.nodeIDs.back(), i) );
+            }
+            vector<int64_t>().swap(arcs.intNodeIDs);
+            unordered_map<int64_t, uint32_t>().swap(intNodes);
+        }
+
+        void SwitchArcsToText() {
+            if (!hasIntArcIDs)
+                return;
+            hasIntArcIDs = false;
+            arcs.arcIDs.reserve(arcs.intArcIDs.capacity());
+            for (const int64_t id : arcs.intArcIDs)
+                arcs.arcIDs.push_back( to_string(id) );
+            vector<int64_t>().swap(arcs.intArcIDs);
+        }
+    };
+}
+
+//Init static member variables must be out of class scope!
+geos::geom::GeometryFactory::unique_ptr DBHELPER::GEO_FACTORY = createGeoFactory();
 
 namespace netxpert {
     namespace io {
@@ -50,28 +133,64 @@ namespace netxpert {
 }
 }
 
-//gets not called, because everything else is static
+DBHELPER::DBHELPER(const Config& cnfg)
+    : NETXPERT_CNFG(cnfg), connPtr(nullptr), currentTransactionPtr(nullptr), isConnected(false)
+{
+}
+
 DBHELPER::~DBHELPER()
 {
+    CloseConnection();
+}
 
+const Config& DBHELPER::GetConfig() const
+{
+    return NETXPERT_CNFG;
 }
 
-void DBHELPER::Initialize(const Config& cnfg)
+DBHELPER::ReadConnection::ReadConnection(DBHELPER& owner, std::unique_ptr<SQLite::Database> db)
+    : owner(&owner), db(std::move(db))
 {
-    /*
-    * Notes on precision model
-    *
-    * GEOS uses an internal precision model. This must fit to the model in SpatiaLite (which is also defined by GEOS internally).
-    * Because splitting of the arcs happens in the SpatiaLite DB, we must have a common precision model of the geometries.
-    * So we are tied here to FLOATING (precision of 16 floating point numbers).
-     */
-	std::shared_ptr<PrecisionModel> pm (new PrecisionModel( geos::geom::PrecisionModel::FLOATING));
-	// Initialize global factory with defined PrecisionModel
-	// and a SRID of -1 (undefined).
-	DBHELPER::GEO_FACTORY = geos::geom::GeometryFactory::create(pm.get(), -1);
+}
 
-    DBHELPER::NETXPERT_CNFG = cnfg;
-    IsInitialized = true;
+DBHELPER::ReadConnection::ReadConnection(ReadConnection&& other)
+    : owner(other.owner), db(std::move(other.db))
+{
+}
+
+DBHELPER::ReadConnection::~ReadConnection()
+{
+    if (db)
+        owner->releaseReadConnection(std::move(db));
+}
+
+/**
+* Pooled connections always read from the netXpert DB on disk, also if the main connection works on an in memory
+* copy (LoadDBIntoMemory): the copy holds the same arcs and nodes, but is private to the main connection.
+*/
+DBHELPER::ReadConnection DBHELPER::AcquireReadConnection()
+{
+    {
+        std::lock_guard<std::mutex> lock(readConnPoolMutex);
+        if (!readConnPool.empty())
+        {
+            auto db = std::move(readConnPool.back());
+            readConnPool.pop_back();
+            return ReadConnection(*this, std::move(db));
+        }
+    }
+    // open outside of the lock; loading SpatiaLite takes a while
+    auto db = unique_ptr<SQLite::Database>(new SQLite::Database (NETXPERT_CNFG.NetXDBPath, SQLITE_OPEN_READONLY));
+    if ( !performInitialCommand(*db) )
+        LOGGER::LogError("Error performing initial spatialite command on read connection!");
+
+    return ReadConnection(*this, std::move(db));
+}
+
+void DBHELPER::releaseReadConnection(std::unique_ptr<SQLite::Database> db)
+{
+    std::lock_guard<std::mutex> lock(readConnPoolMutex);
+    readConnPool.push_back(std::move(db));
 }
 
 /*void DBHELPER::connect( )
@@ -101,7 +220,7 @@ void DBHELPER::Initialize(const Config& cnfg)
         //connPtr = db;
 
         //Depointerize "on-the-fly" to SQLite::Database&
-        if ( performInitialCommand() )
+        if ( performInitialCommand(*connPtr) )
         {
             LOGGER::LogDebug("Successfully performed initial spatialite command.");
         }
@@ -179,14 +298,14 @@ void DBHELPER::connect(bool inMemory )
         {
             LOGGER::LogInfo("Loading database into memory..");
             // Create empty memory db
-            DBHELPER::connPtr = unique_ptr<SQLite::Database>(new SQLite::Database (":memory:",
+            connPtr = unique_ptr<SQLite::Database>(new SQLite::Database (":memory:",
                                         SQLITE_OPEN_READWRITE|SQLITE_OPEN_CREATE));
 
             SQLite::Database& db = *connPtr;
 
             //optimizeSQLiteCon();
 
-            if ( performInitialCommand() )
+            if ( performInitialCommand(*connPtr) )
                 LOGGER::LogDebug("Successfully performed initial spatialite command.");
             else
                 LOGGER::LogError("Error performing initial spatialite command!");
@@ -253,10 +372,10 @@ void DBHELPER::connect(bool inMemory )
         else
         {
             LOGGER::LogInfo("No memory database..");
-            DBHELPER::connPtr = unique_ptr<SQLite::Database>(new SQLite::Database (NETXPERT_CNFG.NetXDBPath, SQLITE_OPEN_READWRITE|SQLITE_OPEN_CREATE));
+            connPtr = unique_ptr<SQLite::Database>(new SQLite::Database (NETXPERT_CNFG.NetXDBPath, SQLITE_OPEN_READWRITE|SQLITE_OPEN_CREATE));
             optimizeSQLiteCon();
 
-            if ( performInitialCommand() )
+            if ( performInitialCommand(*connPtr) )
                 LOGGER::LogDebug("Successfully performed initial spatialite command.");
             else
                 LOGGER::LogError("Error performing initial spatialite command!");
@@ -303,207 +422,258 @@ void DBHELPER::OpenNewTransaction()
     }
 }
 
-void
- DBHELPER::LoadGeometryToMem(const std::string& _tableName, const ColumnMap& _map,
-                                 const std::string& geomColumnName, const std::string& arcIDs)
+InputArcs
+ DBHELPER::LoadNetworkFromDB(const std::string& _tableName, const ColumnMap& _map)
 {
-    using namespace netxpert::data;
-
-    string eliminatedArcIDs = "";
+    InputArcs arcTbl;
     string sqlStr = "";
-
+    bool oneway = false;
+    bool hasCapacity = false;
     try
     {
         if (!isConnected)
             connect(NETXPERT_CNFG.LoadDBIntoMemory);
 
-        for (const extarcid_t& elem: DBHELPER::EliminatedArcs) {
-//            eliminatedArcIDs += ","+ std::to_string(elem);
-            eliminatedArcIDs += ","+ elem;
-        }
-
-        //trim comma on first
-        if (eliminatedArcIDs.length() > 0)
-        {
-            eliminatedArcIDs = eliminatedArcIDs.erase(0,1);
-            sqlStr = "SELECT "+_map.arcIDColName +", AsBinary(CastToLineString(" + geomColumnName + "))"+
-                 " FROM "+_tableName+" WHERE "+_map.arcIDColName+" NOT IN ("+ eliminatedArcIDs+") AND "+
-                        _map.arcIDColName+ " IN("+ arcIDs +")";
-        }
-        else
-        {
-            sqlStr = "SELECT "+_map.arcIDColName +", AsBinary(CastToLineString(" + geomColumnName + "))"+
-                 " FROM "+_tableName+" WHERE "+_map.arcIDColName+" IN("+ arcIDs +")";
-        }
-
         SQLite::Database& db = *connPtr;
-        SQLite::Statement qry (db, sqlStr);
-
-        shared_ptr<MultiLineString> aGeomPtr;
-        WKBReader wkbReader(*DBHELPER::GEO_FACTORY);
-        stringstream is(ios_base::binary|ios_base::in|ios_base::out);
 
-        while(qry.executeStep())
-        {
-            SQLite::Column idCol = qry.getColumn(0);
-            SQLite::Column geoCol = qry.getColumn(1);
-            extarcid_t id;
-            shared_ptr<LineString> aGeomPtr;
-
-            if (!idCol.isNull())
-            {
-                id  = idCol.getText();
-            }
-            if (!geoCol.isNull())
-            {
-                const void* pVoid = geoCol.getBlob();
-                const int sizeOfwkb = geoCol.getBytes();
+        if (!_map.onewayColName.empty())
+            oneway = true;
+        if (!_map.capColName.empty())
+            hasCapacity = true;
 
-                const unsigned char* bytes = static_cast<const unsigned char*>(pVoid);
+        sqlStr = "SELECT "+_map.arcIDColName+","+
+                           _map.fromColName+","+
+                           _map.toColName+","+
+                           _map.costColName;
+        if (hasCapacity)
+            sqlStr += ","+_map.capColName;
+        if (oneway)
+            sqlStr += ","+_map.onewayColName;
+        sqlStr += " FROM "+ _tableName +
+                  " ORDER BY "+_map.fromColName+ ";";
 
-                for (int i = 0; i < sizeOfwkb; i++)
-                    is << bytes[i];
+        netxpert::utils::LOGGER::LogDebug(sqlStr);
 
-                aGeomPtr = shared_ptr<LineString>( dynamic_cast<LineString*>( wkbReader.read(is) ) );
-            }
-            DBHELPER::KV_Network.insert( make_pair(id, move(aGeomPtr)) );
+        SQLite::Statement query(db, sqlStr);
+        //fetch data
+        while (query.executeStep())
+        {
+            const string  id     = query.getColumn(0);
+            const string fNode   = query.getColumn(1);
+            const string tNode   = query.getColumn(2);
+            const double cost    = query.getColumn(3);
+            int col = 4;
+            const double cap     = hasCapacity ? query.getColumn(col++).getDouble() : DOUBLE_INFINITY;
+            const string _oneway = oneway ? query.getColumn(col).getText() : "";
+            arcTbl.push_back(InputArc {id,fNode,tNode,
+                                        cost,cap,_oneway});
         }
+
+        LOGGER::LogDebug("Successfully fetched network table data.");
+        return arcTbl;
     }
     catch (std::exception& ex)
     {
-        LOGGER::LogError( "Error retrieving geometries!" );
+        LOGGER::LogError( "Error preparing query!" );
         LOGGER::LogError( ex.what() );
+        LOGGER::LogError( sqlStr);
+        return arcTbl;
     }
 }
 
-InputArcs
- DBHELPER::LoadNetworkFromDB(const std::string& _tableName, const ColumnMap& _map)
+/**
+* Splits the ROWID range of the arcs table into one range per thread. Every thread reads its range through its own
+* pooled read-only connection and decodes it into a chunk; the chunks are merged in ROWID order afterwards.
+* Tables without usable ROWIDs (e.g. views) are read in a single chunk.
+*
+* There is no ORDER BY: the internal network groups the arcs by their start node itself
+* (see netxpert::data::InternalNet).
+*/
+InputArcColumns
+DBHELPER::LoadNetworkColumnsFromDB(const std::string& _tableName, const ColumnMap& _map)
 {
-    InputArcs arcTbl;
-    string sqlStr = "";
-    bool oneway = false;
-    bool hasCapacity = false;
-    try
-    {
-        if (!isConnected)
-            connect(NETXPERT_CNFG.LoadDBIntoMemory);
+    InputArcColumns result;
+    const bool hasCapacity = !_map.capColName.empty();
+    const bool oneway = !_map.onewayColName.empty();
 
-        SQLite::Database& db = *connPtr;
+    string sqlStr = "SELECT "+ _map.arcIDColName +","+ _map.fromColName +","+ _map.toColName +","+ _map.costColName;
+    if (hasCapacity)
+        sqlStr += ","+ _map.capColName;
+    if (oneway)
+        sqlStr += ","+ _map.onewayColName;
+    sqlStr += " FROM "+ _tableName;
 
-        if (!_map.onewayColName.empty())
-            oneway = true;
-        if (!_map.capColName.empty())
-            hasCapacity = true;
-
-        if (oneway && hasCapacity)
-        {
-            sqlStr = "SELECT "+_map.arcIDColName+","+
-                               _map.fromColName+","+
-                               _map.toColName+","+
-                               _map.costColName+","+
-                               _map.capColName +","+
-                               _map.onewayColName +
-                                " FROM "+ _tableName +
-                                " ORDER BY "+_map.fromColName+ ";";
-
-        }
-        if (!oneway && hasCapacity)
-        {
-            sqlStr = "SELECT "+_map.arcIDColName+","+
-                               _map.fromColName+","+
-                               _map.toColName+","+
-                               _map.costColName+","+
-                               _map.capColName +
-                                " FROM "+ _tableName +
-                                " ORDER BY "+_map.fromColName+ ";";
-        }
-        if (oneway && !hasCapacity)
-        {
-            sqlStr = "SELECT "+_map.arcIDColName+","+
-                               _map.fromColName+","+
-                               _map.toColName+","+
-                               _map.costColName+","+
-                               _map.onewayColName +
-                                " FROM "+ _tableName +
-                                " ORDER BY "+_map.fromColName+ ";";
-        }
-        if (!oneway && !hasCapacity)
+    try
+    {
+        //1. ROWID ranges
+        bool ranged = false;
+        int64_t minRowID = 0;
+        int64_t maxRowID = 0;
         {
-            sqlStr = "SELECT "+_map.arcIDColName+","+
-                               _map.fromColName+","+
-                               _map.toColName+","+
-                               _map.costColName+
-                                " FROM "+ _tableName +
-                                " ORDER BY "+_map.fromColName+ ";";
+            auto conn = AcquireReadConnection();
+            try {
+                SQLite::Statement qry (*conn, "SELECT MIN(ROWID), MAX(ROWID) FROM "+ _tableName +";");
+                if (qry.executeStep() && !qry.getColumn(0).isNull()) {
+                    minRowID = qry.getColumn(0).getInt64();
+                    maxRowID = qry.getColumn(1).getInt64();
+                    ranged = true;
+                }
+            }
+            catch (std::exception& ex) {
+                LOGGER::LogDebug("LoadNetworkColumnsFromDB(): no ROWID on " + _tableName + "; reading in one chunk.");
+            }
         }
+        //at least 50000 ROWIDs per chunk; smaller tables are not worth the extra connections
+        const int64_t rowIDs = maxRowID - minRowID + 1;
+        const int numChunks = ranged ? static_cast<int>( std::max<int64_t>(1,
+                                            std::min<int64_t>(std::max(1, LOCAL_NUM_THREADS), rowIDs / 50000)) )
+                                     : 1;
+        const int64_t chunkSize = rowIDs / numChunks + 1;
+
+        if (ranged)
+            sqlStr += " WHERE ROWID >= ? AND ROWID < ?";
+        sqlStr += ";";
+        LOGGER::LogDebug(sqlStr);
 
-        netxpert::utils::LOGGER::LogDebug(sqlStr);
-
-        SQLite::Statement query(db, sqlStr);
-        //fetch data
+        //2. Decode the ranges in parallel
+        vector<ArcChunk> chunks (numChunks);
 
-        if (oneway && hasCapacity)
+        #pragma omp parallel for schedule(static, 1) num_threads(numChunks)
+        for (int c = 0; c < numChunks; c++)
         {
-            while (query.executeStep())
+            ArcChunk& chunk = chunks[c];
+            try
             {
-                const string  id     = query.getColumn(0);
-                const string fNode   = query.getColumn(1);
-                const string tNode   = query.getColumn(2);
-                const double cost    = query.getColumn(3);
-                const double cap     = query.getColumn(4);
-                const string _oneway = query.getColumn(5);
-                arcTbl.push_back(InputArc {id,fNode,tNode,
-                                            cost,cap,_oneway});
+                auto conn = AcquireReadConnection();
+                SQLite::Statement qry (*conn, sqlStr);
+                if (ranged) {
+                    const sqlite3_int64 from = minRowID + c * chunkSize;
+                    const sqlite3_int64 to = from + chunkSize;
+                    qry.bind(1, from);
+                    qry.bind(2, to);
+                }
+                while (qry.executeStep())
+                {
+                    chunk.AddArcID(qry.getColumn(0));
+                    chunk.arcs.fromNodes.push_back( chunk.InternNode(qry.getColumn(1)) );
+                    chunk.arcs.toNodes.push_back( chunk.InternNode(qry.getColumn(2)) );
+                    chunk.arcs.costs.push_back( qry.getColumn(3).getDouble() );
+                    int col = 4;
+                    if (hasCapacity)
+                        chunk.arcs.capacities.push_back( qry.getColumn(col++).getDouble() );
+                    else
+                        chunk.arcs.capacities.push_back( DOUBLE_INFINITY );
+                    if (oneway) {
+                        const SQLite::Column onewayCol = qry.getColumn(col);
+                        chunk.arcs.oneway.push_back( onewayCol.getBytes() == 1 && onewayCol.getText()[0] == 'Y' );
+                    }
+                    else
+                        chunk.arcs.oneway.push_back(0);
+                }
             }
-        }
-        if (!oneway && hasCapacity)
-        {
-            while (query.executeStep())
+            catch (std::exception& ex)
             {
-                const string  id     = query.getColumn(0);
-                const string fNode   = query.getColumn(1);
-                const string tNode   = query.getColumn(2);
-                const double cost    = query.getColumn(3);
-                const double cap     = query.getColumn(4);
-                arcTbl.push_back(InputArc {id,fNode,tNode,
-                                            cost,cap,""});
+                chunk.error = ex.what();
             }
         }
-        if (oneway && !hasCapacity)
+        for (const auto& chunk : chunks) {
+            if (!chunk.error.empty())
+                throw std::runtime_error(chunk.error);
+        }
+
+        //3. Merge the chunks: global node IDs and the offset of every chunk in the columns
+        //   integer IDs stay integers only if they are integers in every chunk
+        bool intNodeIDs = true;
+        bool intArcIDs = true;
+        for (const auto& chunk : chunks) {
+            intNodeIDs = intNodeIDs && chunk.hasIntNodeIDs;
+            intArcIDs = intArcIDs && chunk.hasIntArcIDs;
+        }
+        if (!intNodeIDs || !intArcIDs) {
+            for (auto& chunk : chunks) {
+                if (!intNodeIDs)
+                    chunk.SwitchNodesToText();
+                if (!intArcIDs)
+                    chunk.SwitchArcsToText();
+            }
+        }
+
+        unordered_map<string, uint32_t> nodeIdx;
+        unordered_map<int64_t, uint32_t> intNodeIdx;
+        vector<vector<uint32_t> > nodeRemaps (numChunks);
+        vector<size_t> arcOffsets (numChunks + 1, 0);
+        for (int c = 0; c < numChunks; c++)
         {
-            while (query.executeStep())
+            if (intNodeIDs)
+            {
+                const auto& nodeIDs = chunks[c].arcs.intNodeIDs;
+                nodeRemaps[c].resize(nodeIDs.size());
+                for (size_t i = 0; i < nodeIDs.size(); i++)
+                {
+                    auto it = intNodeIdx.insert( make_pair(nodeIDs[i], static_cast<uint32_t>(result.intNodeIDs.size())) );
+                    if (it.second)
+                        result.intNodeIDs.push_back(nodeIDs[i]);
+                    nodeRemaps[c][i] = it.first->second;
+                }
+            }
+            else
             {
-                const string  id     = query.getColumn(0);
-                const string fNode   = query.getColumn(1);
-                const string tNode   = query.getColumn(2);
-                const double cost    = query.getColumn(3);
-                const string _oneway = query.getColumn(4);
-                arcTbl.push_back(InputArc {id,fNode,tNode,
-                                            cost,DOUBLE_INFINITY,_oneway});
+                auto& nodeIDs = chunks[c].arcs.nodeIDs;
+                nodeRemaps[c].resize(nodeIDs.size());
+                for (size_t i = 0; i < nodeIDs.size(); i++)
+                {
+                    auto it = nodeIdx.find(nodeIDs[i]);
+                    if (it == nodeIdx.end()) {
+                        it = nodeIdx.insert( make_pair(nodeIDs[i], static_cast<uint32_t>(result.nodeIDs.size())) ).first;
+                        result.nodeIDs.push_back(std::move(nodeIDs[i]));
+                    }
+                    nodeRemaps[c][i] = it->second;
+                }
             }
+            arcOffsets[c + 1] = arcOffsets[c] + chunks[c].arcs.Size();
         }
-        if (!oneway && !hasCapacity)
+
+        const size_t m = arcOffsets[numChunks];
+        if (intArcIDs)
+            result.intArcIDs.resize(m);
+        else
+            result.arcIDs.resize(m);
+        result.fromNodes.resize(m);
+        result.toNodes.resize(m);
+        result.costs.resize(m);
+        result.capacities.resize(m);
+        result.oneway.resize(m);
+
+        #pragma omp parallel for schedule(static, 1) num_threads(numChunks)
+        for (int c = 0; c < numChunks; c++)
         {
-            while (query.executeStep())
+            InputArcColumns& arcs = chunks[c].arcs;
+            const vector<uint32_t>& remap = nodeRemaps[c];
+            const size_t offset = arcOffsets[c];
+            for (size_t i = 0; i < arcs.Size(); i++)
             {
-                const string  id     = query.getColumn(0);
-                const string fNode   = query.getColumn(1);
-                const string tNode   = query.getColumn(2);
-                const double cost    = query.getColumn(3);
-                arcTbl.push_back(InputArc {id,fNode,tNode,
-                                            cost, DOUBLE_INFINITY, ""});
+                if (intArcIDs)
+                    result.intArcIDs[offset + i] = arcs.intArcIDs[i];
+                else
+                    result.arcIDs[offset + i] = std::move(arcs.arcIDs[i]);
+                result.fromNodes[offset + i]  = remap[arcs.fromNodes[i]];
+                result.toNodes[offset + i]    = remap[arcs.toNodes[i]];
+                result.costs[offset + i]      = arcs.costs[i];
+                result.capacities[offset + i] = arcs.capacities[i];
+                result.oneway[offset + i]     = arcs.oneway[i];
             }
         }
 
-        LOGGER::LogDebug("Successfully fetched network table data.");
-        return arcTbl;
+        LOGGER::LogDebug("Successfully fetched network table data ("+ to_string(m) +" arcs, "+
+                          to_string(result.NodeCount()) +" nodes, "+ to_string(numChunks) +" chunks).");
+        return result;
     }
     catch (std::exception& ex)
     {
-        LOGGER::LogError( "Error preparing query!" );
+        LOGGER::LogError( "LoadNetworkColumnsFromDB() - Error loading arcs!" );
         LOGGER::LogError( ex.what() );
-        LOGGER::LogError( sqlStr);
-        return arcTbl;
+        LOGGER::LogError( sqlStr );
+        return InputArcColumns();
     }
 }
 
@@ -759,13 +929,13 @@ std::unique_ptr<SQLite::Statement> DBHELPER::PrepareGetClosestArcQuery(const std
         switch (arcIDColDataType)
         {
             case ArcIDColumnDataType::Std_String:
-                for (const extarcid_t& elem : DBHELPER::EliminatedArcs) {
+                for (const extarcid_t& elem : EliminatedArcs) {
 //                    eliminatedArcIDs += ",'" + std::to_string(elem) + "'";
                     eliminatedArcIDs += ",'" + elem + "'";
                 }
                 break;
             default: //double or int
-                for (const extarcid_t& elem : DBHELPER::EliminatedArcs) {
+                for (const extarcid_t& elem : EliminatedArcs) {
 //                    eliminatedArcIDs += ",'" + std::to_string(elem) + "'";
                     eliminatedArcIDs += ",'" + elem + "'";
                 }
@@ -962,45 +1132,86 @@ ExtClosestArcAndPoint DBHELPER::GetClosestArcFromPoint(const geos::geom::Coordin
     }
 }
 
-std::unique_ptr<geos::geom::MultiLineString> DBHELPER::GetArcGeometriesFromMem(const std::string& arcIDs)
+std::vector<ExtArcWithGeom> DBHELPER::LoadArcsWithGeomFromDB(const std::string& tableName,
+                                                             const std::string& geomColName,
+                                                             const ColumnMap& cmap,
+                                                             const bool withCapacity)
 {
-    #ifdef DEBUG
-    LOGGER::LogDebug("GetArcGeometriesFromMem()");
-    #endif // DEBUG
+    using namespace netxpert::data;
+
+    vector<ExtArcWithGeom> result;
+    string sqlStr = "";
+
     try
     {
-        vector<Geometry*> geoms;
-        vector<string> arcIDList = UTILS::Split(arcIDs, ',');
+        auto conn = AcquireReadConnection();
 
-        for (auto s : arcIDList)
+        sqlStr = "SELECT "+ cmap.arcIDColName +", "+ cmap.fromColName+", "+ cmap.toColName+", "+cmap.costColName;
+        if (withCapacity)
+            sqlStr += ", "+ cmap.capColName;
+        sqlStr += ", AsBinary(" + geomColName + ") FROM "+tableName;
+
+        #ifdef DEBUG
+        LOGGER::LogDebug(sqlStr);
+        #endif // DEBUG
+
+        SQLite::Database& db = *conn;
+        SQLite::Statement qry (db, sqlStr);
+
+        WKBReader wkbReader(*DBHELPER::GEO_FACTORY);
+        stringstream is(ios_base::binary|ios_base::in|ios_base::out);
+
+        while (qry.executeStep())
         {
-//            LOGGER::LogDebug("Querying arcid #" + s +"..");
+            ExtArcWithGeom arc {"", "", "", 0, DOUBLE_INFINITY, nullptr};
+
+            SQLite::Column arcIDcol = qry.getColumn(0);
+            if (!arcIDcol.isNull())
+            {
+                if (arcIDcol.isInteger())
+                    arc.extArcID = to_string(arcIDcol.getInt());
+                if (arcIDcol.isFloat())
+                    arc.extArcID = to_string(arcIDcol.getDouble());
+                if (arcIDcol.isText())
+                    arc.extArcID = arcIDcol.getText();
+            }
+            //filter out eliminated arcs
+            if (EliminatedArcs.count(arc.extArcID) > 0)
+                continue;
+
+            if (!qry.getColumn(1).isNull())
+                arc.extFromNode = static_cast<string>( qry.getColumn(1).getText() );
 
-            if (DBHELPER::EliminatedArcs.count(s) == 0 ) //filter out eliminated arcs
+            if (!qry.getColumn(2).isNull())
+                arc.extToNode = static_cast<string>( qry.getColumn(2).getText() );
+
+            if (!qry.getColumn(3).isNull())
+                arc.cost = qry.getColumn(3).getDouble();
+
+            int indxCount = 4;
+            if (withCapacity)
             {
-                shared_ptr<LineString> g = DBHELPER::KV_Network.at(s);
-                /*Geometry* gPtr = g.get();
-                LineString* lPtr = dynamic_cast<LineString*>(gPtr);
-                cout << lPtr->toString() << endl;
-                cout << gPtr->toString() << endl;*/
-                geoms.push_back( g.get() );
+                if (!qry.getColumn(4).isNull())
+                    arc.capacity = qry.getColumn(4).getDouble();
+                indxCount += 1;
             }
-        }
-        unique_ptr<MultiLineString> route (DBHELPER::GEO_FACTORY->createMultiLineString(geoms));
 
-        return route;
+            SQLite::Column aGeoCol = qry.getColumn(indxCount);
+            if (!aGeoCol.isNull())
+            {
+                is.write(static_cast<const char*>(aGeoCol.getBlob()), aGeoCol.getBytes());
+                arc.arcGeom = shared_ptr<Geometry>( wkbReader.read(is) );
+            }
+            if (arc.arcGeom)
+                result.push_back(arc);
+        }
+        return result;
     }
-    catch (exception& ex)
+    catch (std::exception& ex)
     {
-        LOGGER::LogError( "GetArcGeometriesFromMem() - Error getting arc geometries!" );
+        LOGGER::LogError( "LoadArcsWithGeomFromDB() - Error loading arcs!" );
         LOGGER::LogError( ex.what() );
-
-        cout << "IDs of KV_Network are: " << endl;
-        for (auto& kv : DBHELPER::KV_Network) {
-            cout << kv.first << endl;
-        }
-
-        return nullptr;
+        return result;
     }
 }
 
@@ -1022,13 +1233,13 @@ std::unique_ptr<geos::geom::MultiLineString> DBHELPER::GetArcGeometriesFromDB(co
         switch (arcIDColDataType)
         {
             case ArcIDColumnDataType::Std_String:
-                for (const extarcid_t& elem: DBHELPER::EliminatedArcs) {
+                for (const extarcid_t& elem: EliminatedArcs) {
 //                    eliminatedArcIDs += ",'" + std::to_string(elem) + "'";
                     eliminatedArcIDs += ",'" + elem + "'";
                 }
                 break;
             default: //double or int
-                for (const extarcid_t& elem: DBHELPER::EliminatedArcs) {
+                for (const extarcid_t& elem: EliminatedArcs) {
 //                    eliminatedArcIDs += ",'" + std::to_string(elem) + "'";
                     eliminatedArcIDs += "," + elem;
                 }
@@ -1301,13 +1512,13 @@ std::unique_ptr<geos::geom::MultiPoint> DBHELPER::GetArcVertexGeometriesByBuffer
         switch (arcIDColDataType)
         {
             case ArcIDColumnDataType::Std_String:
-                for (const extarcid_t& elem: DBHELPER::EliminatedArcs) {
+                for (const extarcid_t& elem: EliminatedArcs) {
 //                    eliminatedArcIDs += ",'" + std::to_string(elem) + "'";
                     eliminatedArcIDs += ",'" + elem + "'";
                 }
                 break;
             default: //double or int
-                for (const extarcid_t& elem: DBHELPER::EliminatedArcs) {
+                for (const extarcid_t& elem: EliminatedArcs) {
 //                    eliminatedArcIDs += ",'" + std::to_string(elem) + "'";
                     eliminatedArcIDs += "," + elem;
                 }
@@ -1407,13 +1618,13 @@ std::unique_ptr<SQLite::Statement> DBHELPER::PrepareIsPointOnArcQuery(string tab
         switch (arcIDColDataType)
         {
             case ArcIDColumnDataType::Std_String:
-                for (const extarcid_t& elem: DBHELPER::EliminatedArcs) {
+                for (const extarcid_t& elem: EliminatedArcs) {
 //                    eliminatedArcIDs += ","+ std::to_string(elem);
                     eliminatedArcIDs += ",'"+ elem+ "'";
                 }
                 break;
             default: //double or int
-                for (const extarcid_t& elem: DBHELPER::EliminatedArcs) {
+                for (const extarcid_t& elem: EliminatedArcs) {
 //                    eliminatedArcIDs += ","+ std::to_string(elem);
                     eliminatedArcIDs += ","+ elem;
                 }
@@ -1486,10 +1697,11 @@ void DBHELPER::CloseConnection()
 {
     //DBHELPER::CommitCurrentTransaction();
     //init destrcutor on SQLiteCpp::Database for DB disconnect
-    DBHELPER::connPtr = nullptr;
+    currentTransactionPtr = nullptr;
+    connPtr = nullptr;
     //auto* tmp = connPtr.release();
     //delete tmp;
-    DBHELPER::isConnected = false;
+    isConnected = false;
     /*try
     {
         DBHELPER::cleanupPtr();
@@ -1501,12 +1713,10 @@ void DBHELPER::CloseConnection()
     }*/
 }
 
-bool DBHELPER::performInitialCommand()
+bool DBHELPER::performInitialCommand(SQLite::Database& db)
 {
     try
     {
-        SQLite::Database& db = *connPtr;
-
         const string spatiaLiteHome = NETXPERT_CNFG.SpatiaLiteHome;
         const string spatiaLiteCoreName = NETXPERT_CNFG.SpatiaLiteCoreName;
 
@@ -1530,6 +1740,7 @@ bool DBHELPER::performInitialCommand()
         }
         LOGGER::LogDebug("(Internal) SQLite Version: " + version);
 
+        std::lock_guard<std::mutex> lock(spatiaLiteLoadMutex);
         UTILS::SetCurrentDir(spatiaLiteHome);
 
         /* Old way:
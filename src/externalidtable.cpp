@@ -0,0 +1,402 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include "externalidtable.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+using namespace netxpert::data;
+
+namespace {
+    const string DUMMY_ID = "dummy";
+    const string RENAMED_SUFFIX = "@netXpert";
+}
+
+ExternalIDTable::ExternalIDTable(const Duplicates duplicates)
+    : mode(Mode::Text), duplicates(duplicates), dummyIndex(-1) {
+}
+
+void
+ ExternalIDTable::Reset(const Mode mode) {
+
+    this->mode = mode;
+    texts.clear();
+    textIndex.clear();
+    values.clear();
+    kinds.clear();
+    plainIndex = IntIndex();
+    renamedIndex = IntIndex();
+    dummyIndex = -1;
+}
+
+void
+ ExternalIDTable::Reserve(const size_t count) {
+
+    if (mode == Mode::Text) {
+        texts.reserve(count);
+        textIndex.reserve(count);
+    }
+    else {
+        values.reserve(count);
+        kinds.reserve(count);
+        plainIndex.recent.reserve(count);
+    }
+}
+
+bool
+ ExternalIDTable::IsIntegerID(const std::string& id, int64_t& value) {
+
+    const size_t len = id.size();
+    const bool negative = len > 0 && id[0] == '-';
+    const size_t first = negative ? 1 : 0;
+    //at most 19 digits: the range of int64_t is checked below
+    if (len == first || len - first > 19)
+        return false;
+    //no leading zeros, no "-0"
+    if (id[first] == '0' && (len - first > 1 || negative))
+        return false;
+
+    uint64_t v = 0;
+    for (size_t i = first; i < len; i++) {
+        const char c = id[i];
+        if (c < '0' || c > '9')
+            return false;
+        v = v * 10 + (c - '0');
+    }
+    if (v > static_cast<uint64_t>(INT64_MAX) + (negative ? 1 : 0))
+        return false;
+
+    value = negative ? static_cast<int64_t>(0 - v) : static_cast<int64_t>(v);
+    return true;
+}
+
+ExternalIDTable::Kind
+ ExternalIDTable::parse(const std::string& id, int64_t& value) const {
+
+    if (IsIntegerID(id, value))
+        return Plain;
+    if (id == DUMMY_ID)
+        return Dummy;
+    if (id.size() > RENAMED_SUFFIX.size() &&
+        id.compare(id.size() - RENAMED_SUFFIX.size(), RENAMED_SUFFIX.size(), RENAMED_SUFFIX) == 0 &&
+        IsIntegerID(id.substr(0, id.size() - RENAMED_SUFFIX.size()), value))
+        return Renamed;
+    return Text;
+}
+
+void
+ ExternalIDTable::grow(const uint32_t index) {
+
+    if (mode == Mode::Text) {
+        if (index >= texts.size())
+            texts.resize(index + 1);
+    }
+    else {
+        if (index >= values.size()) {
+            values.resize(index + 1, 0);
+            kinds.resize(index + 1, Empty);
+        }
+    }
+}
+
+void
+ ExternalIDTable::Set(const uint32_t index, const std::string& id) {
+
+    if (mode == Mode::Text) {
+        grow(index);
+        texts[index] = id;
+    }
+    else {
+        int64_t value = 0;
+        const Kind kind = parse(id, value);
+        if (kind != Text) {
+            setInteger(index, kind, value);
+            return;
+        }
+        grow(index);
+        kinds[index] = Text;
+        values[index] = texts.size();
+        texts.push_back(id);
+    }
+
+    auto it = textIndex.find(id);
+    if (it == textIndex.end())
+        textIndex.insert( make_pair(id, index) );
+    else if (prefer(index, it->second))
+        it->second = index;
+}
+
+void
+ ExternalIDTable::Set(const uint32_t index, const int64_t id) {
+
+    if (mode == Mode::Text)
+        Set(index, to_string(id));
+    else
+        setInteger(index, Plain, id);
+}
+
+void
+ ExternalIDTable::setInteger(const uint32_t index, const Kind kind, const int64_t value) {
+
+    grow(index);
+    values[index] = value;
+    kinds[index] = kind;
+
+    if (kind == Dummy) {
+        if (dummyIndex < 0 || prefer(index, static_cast<uint32_t>(dummyIndex)))
+            dummyIndex = index;
+        return;
+    }
+    IntIndex& idx = kind == Plain ? plainIndex : renamedIndex;
+    uint32_t existing;
+    if (idx.Find(value, existing) && !prefer(index, existing))
+        return;
+    idx.recent[value] = index;
+}
+
+std::string
+ ExternalIDTable::Get(const uint32_t index) const {
+
+    if (mode == Mode::Text)
+        return index < texts.size() ? texts[index] : string();
+
+    if (index >= kinds.size())
+        return string();
+    switch (kinds[index])
+    {
+        case Plain:
+            return to_string(values[index]);
+        case Renamed:
+            return to_string(values[index]) + RENAMED_SUFFIX;
+        case Dummy:
+            return DUMMY_ID;
+        case Text:
+            return texts[values[index]];
+        default:
+            return string();
+    }
+}
+
+bool
+ ExternalIDTable::IsEmpty(const uint32_t index) const {
+
+    if (mode == Mode::Text)
+        return index >= texts.size() || texts[index].empty();
+
+    return index >= kinds.size() || kinds[index] == Empty ||
+           (kinds[index] == Text && texts[values[index]].empty());
+}
+
+bool
+ ExternalIDTable::Matches(const uint32_t index, const std::string& id) const {
+
+    if (mode == Mode::Text)
+        return index < texts.size() ? texts[index] == id : id.empty();
+
+    if (index >= kinds.size() || kinds[index] == Empty)
+        return id.empty();
+    int64_t value = 0;
+    const Kind kind = parse(id, value);
+    if (kind != kinds[index])
+        return false;
+    if (kind == Text)
+        return texts[values[index]] == id;
+    return kind == Dummy || values[index] == value;
+}
+
+bool
+ ExternalIDTable::Find(const std::string& id, uint32_t& index) const {
+
+    if (mode == Mode::Integer) {
+        int64_t value = 0;
+        switch (parse(id, value))
+        {
+            case Plain:
+                return plainIndex.Find(value, index);
+            case Renamed:
+                return renamedIndex.Find(value, index);
+            case Dummy:
+                if (dummyIndex < 0)
+                    return false;
+                index = dummyIndex;
+                return true;
+            default:
+                break;
+        }
+    }
+    auto it = textIndex.find(id);
+    if (it == textIndex.end())
+        return false;
+    index = it->second;
+    return true;
+}
+
+bool
+ ExternalIDTable::IntIndex::Find(const int64_t value, uint32_t& index) const {
+
+    //recent entries override the sorted ones (see setInteger())
+    auto it = recent.find(value);
+    if (it != recent.end()) {
+        index = it->second;
+        return true;
+    }
+    auto pos = std::lower_bound(sorted.begin(), sorted.end(), make_pair(value, (uint32_t) 0));
+    if (pos == sorted.end() || pos->first != value)
+        return false;
+    index = pos->second;
+    return true;
+}
+
+void
+ ExternalIDTable::IntIndex::Build() {
+
+    if (recent.empty())
+        return;
+
+    vector<pair<int64_t, uint32_t> > added;
+    added.reserve(recent.size());
+    for (const auto& kv : recent) {
+        auto pos = std::lower_bound(sorted.begin(), sorted.end(), make_pair(kv.first, (uint32_t) 0));
+        if (pos != sorted.end() && pos->first == kv.first)
+            pos->second = kv.second;
+        else
+            added.push_back(kv);
+    }
+    std::sort(added.begin(), added.end());
+    const size_t middle = sorted.size();
+    sorted.insert(sorted.end(), added.begin(), added.end());
+    std::inplace_merge(sorted.begin(), sorted.begin() + middle, sorted.end());
+
+    //release the memory of the hash map
+    unordered_map<int64_t, uint32_t>().swap(recent);
+}
+
+void
+ ExternalIDTable::BuildIndex() {
+
+    plainIndex.Build();
+    renamedIndex.Build();
+}
+
+void
+ ExternalIDTable::Export(const uint32_t count, std::vector<int64_t>& values, std::vector<uint8_t>& kinds,
+                         std::vector<std::string>& texts) const {
+
+    if (mode != Mode::Integer)
+        throw std::logic_error("ExternalIDTable::Export(): the table is not in integer mode!");
+
+    const size_t known = std::min<size_t>(count, this->kinds.size());
+    values.assign(this->values.begin(), this->values.begin() + known);
+    values.resize(count, 0);
+    kinds.assign(this->kinds.begin(), this->kinds.begin() + known);
+    kinds.resize(count, Empty);
+    texts = this->texts;
+}
+
+/**
+* The entries of the reverse indexes are collected per kind and sorted once; there is no hash map and no string
+* conversion for integer IDs. Duplicates resolve like Set() called in the order of the internal IDs.
+*/
+void
+ ExternalIDTable::Import(const uint32_t count, const int64_t* values, const uint8_t* kinds,
+                         std::vector<std::string>&& texts) {
+
+    Reset(Mode::Integer);
+    this->values.assign(values, values + count);
+    this->kinds.assign(kinds, kinds + count);
+    this->texts = std::move(texts);
+
+    vector<pair<int64_t, uint32_t> > plain;
+    vector<pair<int64_t, uint32_t> > renamed;
+    plain.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        switch (this->kinds[i])
+        {
+            case Empty:
+                break;
+            case Plain:
+                plain.push_back( make_pair(this->values[i], i) );
+                break;
+            case Renamed:
+                renamed.push_back( make_pair(this->values[i], i) );
+                break;
+            case Dummy:
+                if (dummyIndex < 0 || prefer(i, static_cast<uint32_t>(dummyIndex)))
+                    dummyIndex = i;
+                break;
+            case Text: {
+                const int64_t t = this->values[i];
+                if (t < 0 || static_cast<uint64_t>(t) >= this->texts.size())
+                    throw std::runtime_error("ExternalIDTable::Import(): invalid text index " + to_string(t) + "!");
+                auto it = textIndex.find(this->texts[t]);
+                if (it == textIndex.end())
+                    textIndex.insert( make_pair(this->texts[t], i) );
+                else if (prefer(i, it->second))
+                    it->second = i;
+                break;
+            }
+            default:
+                throw std::runtime_error("ExternalIDTable::Import(): invalid kind of ID " + to_string(i) + "!");
+        }
+    }
+    const bool keepHighest = duplicates == Duplicates::KeepHighest;
+    plainIndex.Assign(std::move(plain), keepHighest);
+    renamedIndex.Assign(std::move(renamed), keepHighest);
+}
+
+void
+ ExternalIDTable::IntIndex::Assign(std::vector<std::pair<int64_t, uint32_t> >&& entries, const bool keepHighest) {
+
+    std::sort(entries.begin(), entries.end());
+    //one entry per value: the first (lowest internal ID) or the last of every run
+    size_t out = 0;
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (out > 0 && entries[out - 1].first == entries[i].first) {
+            if (keepHighest)
+                entries[out - 1] = entries[i];
+            continue;
+        }
+        entries[out++] = entries[i];
+    }
+    entries.resize(out);
+    entries.shrink_to_fit();
+    sorted = std::move(entries);
+    recent.clear();
+}
+
+size_t
+ ExternalIDTable::Count() const {
+
+    if (mode == Mode::Text)
+        return textIndex.size();
+    return plainIndex.sorted.size() + plainIndex.recent.size() +
+           renamedIndex.sorted.size() + renamedIndex.recent.size() +
+           (dummyIndex >= 0 ? 1 : 0) + textIndex.size();
+}
+
+size_t
+ ExternalIDTable::MemoryUsage() const {
+
+    size_t bytes = values.capacity() * sizeof(int64_t) + kinds.capacity() +
+                   (plainIndex.sorted.capacity() + renamedIndex.sorted.capacity()) * sizeof(pair<int64_t, uint32_t>) +
+                   //node of a hash map: key, value, next pointer and bucket
+                   (plainIndex.recent.size() + renamedIndex.recent.size()) * 4 * sizeof(void*);
+    for (const auto& s : texts)
+        bytes += sizeof(string) + (s.capacity() > 15 ? s.capacity() : 0);
+    bytes += textIndex.size() * (sizeof(string) + 3 * sizeof(void*));
+    return bytes;
+}
@@ -15,6 +15,9 @@
  */
 
 #include "fgdbwriter.hpp"
+#include "geos/geom/Polygon.h"
+#include "geos/geom/LineString.h"
+#include "geos/algorithm/CGAlgorithms.h"
 
 using namespace std;
 using namespace FileGDBAPI;
@@ -169,6 +172,9 @@ void FGDBWriter::createTable (const string& _tableName, const NetXpertSolver sol
         case NetXpertSolver::IsolinesSolver:
             xml_path = this->resultIsoLinesDefPath;
             break;
+        case NetXpertSolver::IsolinesPolygonSolver:
+            xml_path = this->resultIsoPolygonsDefPath;
+            break;
         case NetXpertSolver::MinSpanningTreeSolver:
             xml_path = this->resultMSTDefPath;
             break;
@@ -654,6 +660,99 @@ void FGDBWriter::SaveResultArc(const std::string& orig, const double cost,
 
 }
 
+//Isoline polygons
+void FGDBWriter::SaveResultPolygon(const std::string& orig, const double cost,
+                                   const double cutoff, const geos::geom::MultiPolygon& polygons,
+                                   const std::string& _tableName)
+{
+    try
+    {
+        if (!isConnected)
+            connect( );
+
+        openTable ( _tableName );
+
+        Row row;
+        currentTblPtr->CreateRowObject(row);
+
+        wstring origNew = UTILS::convertStringToWString(orig);
+
+        row.SetString(L"fromNode", origNew);
+        row.SetDouble(L"cost", cost);
+        row.SetDouble(L"cutoff", cutoff);
+
+        if ( !polygons.isEmpty() )
+        {
+            //rings of all polygons one after another
+            std::vector<const geos::geom::LineString*> rings;
+            std::vector<bool> isShell;
+            for (size_t i = 0; i < polygons.getNumGeometries(); i++)
+            {
+                const auto* polygon = dynamic_cast<const geos::geom::Polygon*>(polygons.getGeometryN(i));
+                rings.push_back(polygon->getExteriorRing());
+                isShell.push_back(true);
+                for (size_t h = 0; h < polygon->getNumInteriorRing(); h++)
+                {
+                    rings.push_back(polygon->getInteriorRingN(h));
+                    isShell.push_back(false);
+                }
+            }
+
+            // Geometry
+            int numPts = static_cast<int>(polygons.getNumPoints());
+            int numParts = static_cast<int>(rings.size());
+            MultiPartShapeBuffer polygonGeometry;
+
+            polygonGeometry.Setup(ShapeType::shapePolygon, numParts, numPts);
+
+            FileGDBAPI::Point* points;
+            polygonGeometry.GetPoints(points);
+            int* parts;
+            polygonGeometry.GetParts(parts);
+
+            //ESRI: shells clockwise, holes counter clockwise
+            int pointNumber = 0;
+            for (int i = 0; i < numParts; i++)
+            {
+                parts[i] = pointNumber;
+                const geos::geom::CoordinateSequence* coords = rings[i]->getCoordinatesRO();
+                const bool reverse = isShell[i] == geos::algorithm::CGAlgorithms::isCCW(coords);
+                const size_t length = coords->getSize();
+                for (size_t k = 0; k < length; k++)
+                {
+                    const geos::geom::Coordinate& c = coords->getAt(reverse ? length - 1 - k : k);
+                    points[pointNumber++] = FileGDBAPI::Point {c.x, c.y};
+                }
+            }
+
+            polygonGeometry.CalculateExtent();
+
+            fgdbError hr;
+            wstring errorText;
+
+            hr = row.SetGeometry( polygonGeometry );
+
+            if ((hr = currentTblPtr->Insert(row)) == S_OK)
+            {
+                //LOGGER::LogDebug("Inserted row successfully.");
+            }
+            else {
+                ErrorInfo::GetErrorDescription(hr, errorText);
+                string newErrorText = UTILS::convertWStringToString(errorText);
+                LOGGER::LogError("Error inserting row into Result Table "+ _tableName + "!");
+                LOGGER::LogError(newErrorText + " - Code: " +to_string(hr));
+            }
+        }
+
+    }
+    catch (std::exception& ex)
+    {
+        LOGGER::LogError( "Error saving results to NetXpert FileGDB!" );
+        LOGGER::LogError( ex.what() );
+    }
+
+}
+
 //NetworkBuilder
 void FGDBWriter::SaveNetworkBuilderArc(const std::string& extArcID, const uint32_t fromNode,
                                        const uint32_t toNode, const double cost,
@@ -0,0 +1,326 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include "isopolygon.hpp"
+#include <cmath>
+#include <algorithm>
+#include "geos/geom/Coordinate.h"
+#include "geos/geom/CoordinateArraySequence.h"
+#include "geos/geom/CoordinateSequenceFactory.h"
+#include "geos/geom/LinearRing.h"
+#include "geos/geom/Polygon.h"
+#include "geos/triangulate/DelaunayTriangulationBuilder.h"
+#include "geos/triangulate/quadedge/QuadEdgeSubdivision.h"
+#include "geos/triangulate/quadedge/TriangleVisitor.h"
+#include "geos/util/GEOSException.h"
+
+using namespace std;
+using namespace netxpert::data;
+
+namespace {
+
+    const double PI = 3.14159265358979323846;
+
+    struct Site
+    {
+        double x;
+        double y;
+        bool operator<(const Site& other) const {
+            return x < other.x || (x == other.x && y < other.y);
+        }
+        bool operator==(const Site& other) const {
+            return x == other.x && y == other.y;
+        }
+    };
+
+    struct Ring
+    {
+        std::vector<uint32_t> vertices;
+        double area; //signed: > 0 counter clockwise
+        double minX;
+        double minY;
+        double maxX;
+        double maxY;
+    };
+
+    //indices of the corners of the triangles (into the sorted points)
+    class TriangleIndexVisitor : public geos::triangulate::quadedge::TriangleVisitor
+    {
+        public:
+            TriangleIndexVisitor(const std::vector<Site>& pts, std::vector<uint32_t>& triangles)
+                : pts(pts), triangles(triangles) {}
+            void visit(geos::triangulate::quadedge::QuadEdge* triEdges[3]) {
+                for (int i = 0; i < 3; i++) {
+                    const geos::geom::Coordinate& c = triEdges[i]->orig().getCoordinate();
+                    const Site s {c.x, c.y};
+                    triangles.push_back( static_cast<uint32_t>(std::lower_bound(pts.begin(), pts.end(), s) - pts.begin()) );
+                }
+            }
+        private:
+            const std::vector<Site>& pts;
+            std::vector<uint32_t>& triangles;
+    };
+
+    inline double dist2(const Site& a, const Site& b) {
+        return (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y);
+    }
+
+    bool contains(const Ring& ring, const std::vector<Site>& pts, const double x, const double y) {
+        if (x < ring.minX || x > ring.maxX || y < ring.minY || y > ring.maxY)
+            return false;
+        //crossing number
+        bool inside = false;
+        const size_t n = ring.vertices.size();
+        for (size_t i = 0, j = n - 1; i < n; j = i++) {
+            const Site& a = pts[ring.vertices[i]];
+            const Site& b = pts[ring.vertices[j]];
+            if ((a.y > y) != (b.y > y) && x < (b.x - a.x) * (y - a.y) / (b.y - a.y) + a.x)
+                inside = !inside;
+        }
+        return inside;
+    }
+}
+
+void
+ IsoPolygonBuilder::AddPoint(const double x, const double y) {
+
+    this->xy.push_back(x);
+    this->xy.push_back(y);
+}
+
+void
+ IsoPolygonBuilder::AddLine(const double* coords, const uint32_t size) {
+
+    if (size == 0)
+        return;
+
+    const double step = this->alpha / 2;
+    AddPoint(coords[0], coords[1]);
+    for (uint32_t i = 1; i < size; i++) {
+        const double x1 = coords[2 * i - 2];
+        const double y1 = coords[2 * i - 1];
+        const double x2 = coords[2 * i];
+        const double y2 = coords[2 * i + 1];
+        if (step > 0) {
+            const double length = std::sqrt((x2 - x1) * (x2 - x1) + (y2 - y1) * (y2 - y1));
+            const uint32_t pieces = static_cast<uint32_t>(std::ceil(length / step));
+            for (uint32_t k = 1; k < pieces; k++) {
+                const double t = static_cast<double>(k) / pieces;
+                AddPoint(x1 + t * (x2 - x1), y1 + t * (y2 - y1));
+            }
+        }
+        AddPoint(x2, y2);
+    }
+}
+
+void
+ IsoPolygonBuilder::Resize(const size_t count) {
+
+    if (2 * count < this->xy.size())
+        this->xy.resize(2 * count);
+}
+
+std::unique_ptr<geos::geom::MultiPolygon>
+ IsoPolygonBuilder::ToMultiPolygon(const geos::geom::GeometryFactory& factory) const {
+
+    using namespace geos::geom;
+    using namespace geos::triangulate;
+
+    std::vector<Site> pts;
+    pts.reserve(Size());
+    for (size_t i = 0; i < this->xy.size(); i += 2)
+        pts.push_back( Site {this->xy[i], this->xy[i + 1]} );
+    std::sort(pts.begin(), pts.end());
+    pts.erase(std::unique(pts.begin(), pts.end()), pts.end());
+
+    if (pts.size() < 3)
+        return std::unique_ptr<MultiPolygon>( factory.createMultiPolygon() );
+
+    //Delaunay triangulation; the coordinates of the triangles are the points themselves
+    std::vector<uint32_t> triangles;
+    try {
+        CoordinateArraySequence sites(pts.size());
+        for (size_t i = 0; i < pts.size(); i++)
+            sites.setAt( Coordinate(pts[i].x, pts[i].y), i );
+        DelaunayTriangulationBuilder builder;
+        builder.setSites(sites);
+        TriangleIndexVisitor visitor(pts, triangles);
+        builder.getSubdivision().visitTriangles(&visitor, false);
+    }
+    catch (geos::util::GEOSException& ex) {
+        //e.g. all points on one line
+        return std::unique_ptr<MultiPolygon>( factory.createMultiPolygon() );
+    }
+
+    //directed edges of the kept triangles (counter clockwise)
+    const double maxDist2 = this->alpha * this->alpha;
+    std::vector<std::pair<uint32_t, uint32_t> > edges;
+    edges.reserve(triangles.size());
+    for (size_t t = 0; t + 2 < triangles.size(); t += 3) {
+        const uint32_t a = triangles[t];
+        uint32_t b = triangles[t + 1];
+        uint32_t c = triangles[t + 2];
+
+        if (this->alpha > 0 && (dist2(pts[a], pts[b]) > maxDist2 || dist2(pts[b], pts[c]) > maxDist2 ||
+                                dist2(pts[c], pts[a]) > maxDist2))
+            continue;
+        const double cross = (pts[b].x - pts[a].x) * (pts[c].y - pts[a].y) -
+                             (pts[b].y - pts[a].y) * (pts[c].x - pts[a].x);
+        if (cross == 0)
+            continue;
+        if (cross < 0)
+            std::swap(b, c);
+        edges.push_back( make_pair(a, b) );
+        edges.push_back( make_pair(b, c) );
+        edges.push_back( make_pair(c, a) );
+    }
+    std::sort(edges.begin(), edges.end());
+
+    //boundary: edges without the reverse edge of the neighbouring triangle; the polygon is on the left side
+    std::vector<std::pair<uint32_t, uint32_t> > boundary;
+    for (const auto& e : edges) {
+        if (!std::binary_search(edges.begin(), edges.end(), make_pair(e.second, e.first)))
+            boundary.push_back(e);
+    }
+    if (boundary.empty())
+        return std::unique_ptr<MultiPolygon>( factory.createMultiPolygon() );
+
+    //trace the boundary; at a vertex with several outgoing edges (parts of the polygon touch) the walk turns
+    //to the outgoing edge next to the incoming edge in clockwise order
+    std::vector<bool> used(boundary.size(), false);
+    std::vector<uint32_t> walk;
+    std::vector<uint32_t> loop;
+    std::vector<int64_t> position(pts.size(), -1);
+    std::vector<Ring> shells;
+    std::vector<Ring> holes;
+
+    auto addRing = [&](const uint32_t* vertices, const size_t n) {
+        if (n < 3)
+            return;
+        Ring ring {std::vector<uint32_t>(vertices, vertices + n), 0,
+                   pts[vertices[0]].x, pts[vertices[0]].y, pts[vertices[0]].x, pts[vertices[0]].y};
+        for (size_t i = 0, j = n - 1; i < n; j = i++) {
+            const Site& a = pts[vertices[j]];
+            const Site& b = pts[vertices[i]];
+            ring.area += (a.x * b.y - b.x * a.y) / 2;
+            ring.minX = std::min(ring.minX, b.x);
+            ring.minY = std::min(ring.minY, b.y);
+            ring.maxX = std::max(ring.maxX, b.x);
+            ring.maxY = std::max(ring.maxY, b.y);
+        }
+        if (ring.area > 0)
+            shells.push_back( std::move(ring) );
+        else if (ring.area < 0)
+            holes.push_back( std::move(ring) );
+    };
+
+    for (size_t first = 0; first < boundary.size(); first++) {
+        if (used[first])
+            continue;
+
+        walk.clear();
+        size_t cur = first;
+        bool closed = false;
+        while (!used[cur]) {
+            used[cur] = true;
+            const uint32_t from = boundary[cur].first;
+            const uint32_t to = boundary[cur].second;
+            walk.push_back(from);
+            if (to == boundary[first].first) {
+                closed = true;
+                break;
+            }
+
+            auto range = std::equal_range(boundary.begin(), boundary.end(), make_pair(to, 0u),
+                                          [](const std::pair<uint32_t, uint32_t>& a,
+                                             const std::pair<uint32_t, uint32_t>& b) { return a.first < b.first; });
+            const double inAngle = std::atan2(pts[from].y - pts[to].y, pts[from].x - pts[to].x);
+            double bestTurn = 3 * PI;
+            size_t next = cur;
+            for (auto it = range.first; it != range.second; ++it) {
+                const size_t candidate = it - boundary.begin();
+                if (used[candidate])
+                    continue;
+                double turn = inAngle - std::atan2(pts[it->second].y - pts[to].y, pts[it->second].x - pts[to].x);
+                while (turn <= 0)
+                    turn += 2 * PI;
+                while (turn > 2 * PI)
+                    turn -= 2 * PI;
+                if (turn < bestTurn) {
+                    bestTurn = turn;
+                    next = candidate;
+                }
+            }
+            cur = next;
+        }
+        if (!closed)
+            continue;
+
+        //a walk that passes a vertex twice (e.g. a hole that touches the shell) is split there into simple rings
+        loop.clear();
+        for (const uint32_t v : walk) {
+            if (position[v] >= 0) {
+                const size_t begin = static_cast<size_t>(position[v]);
+                addRing(&loop[begin], loop.size() - begin);
+                for (size_t i = begin + 1; i < loop.size(); i++)
+                    position[loop[i]] = -1;
+                loop.resize(begin + 1);
+                continue;
+            }
+            position[v] = static_cast<int64_t>(loop.size());
+            loop.push_back(v);
+        }
+        addRing(loop.data(), loop.size());
+        for (const uint32_t v : loop)
+            position[v] = -1;
+    }
+
+    //hole --> smallest shell that contains the middle of its first edge (not on any other ring)
+    std::vector<std::vector<size_t> > holesOfShell(shells.size());
+    for (size_t h = 0; h < holes.size(); h++) {
+        const Site& a = pts[holes[h].vertices[0]];
+        const Site& b = pts[holes[h].vertices[1]];
+        const double x = (a.x + b.x) / 2;
+        const double y = (a.y + b.y) / 2;
+        size_t best = shells.size();
+        for (size_t s = 0; s < shells.size(); s++) {
+            if (shells[s].area > -holes[h].area && contains(shells[s], pts, x, y) &&
+                (best == shells.size() || shells[s].area < shells[best].area))
+                best = s;
+        }
+        if (best < shells.size())
+            holesOfShell[best].push_back(h);
+    }
+
+    auto toLinearRing = [&factory, &pts](const Ring& ring) -> LinearRing* {
+        std::vector<Coordinate>* coords = new std::vector<Coordinate>();
+        coords->reserve(ring.vertices.size() + 1);
+        for (const uint32_t v : ring.vertices)
+            coords->push_back( Coordinate(pts[v].x, pts[v].y) );
+        coords->push_back( coords->front() );
+        return factory.createLinearRing( factory.getCoordinateSequenceFactory()->create(coords) );
+    };
+
+    //the rings, the polygons and the multipolygon take the ownership
+    std::vector<Geometry*>* polygons = new std::vector<Geometry*>();
+    for (size_t s = 0; s < shells.size(); s++) {
+        std::vector<Geometry*>* interiors = new std::vector<Geometry*>();
+        for (const size_t h : holesOfShell[s])
+            interiors->push_back( toLinearRing(holes[h]) );
+        polygons->push_back( factory.createPolygon(toLinearRing(shells[s]), interiors) );
+    }
+    return std::unique_ptr<MultiPolygon>( factory.createMultiPolygon(polygons) );
+}
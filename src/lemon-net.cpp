@@ -15,88 +15,98 @@
  */
 
 #include "lemon-net.hpp"
+#include <cstdio>
+#include <cstring>
 
 using namespace netxpert;
 using namespace netxpert::data;
 using namespace netxpert::utils;
 using namespace netxpert::io;
 
+namespace {
+    /// geometry as WKB for the result writer
+    std::string toWKB(const geos::geom::Geometry& geom) {
+        geos::io::WKBWriter wkbWriter;
+        std::stringstream oss (std::ios::out|std::ios::binary);
+        wkbWriter.write(geom, oss);
+        return oss.str();
+    }
+
+    /// order of the decimal strings of two integers (like the order of string node IDs) without allocating strings
+    bool decimalLess(const int64_t a, const int64_t b) {
+        char bufA[24], bufB[24];
+        snprintf(bufA, sizeof(bufA), "%lld", static_cast<long long>(a));
+        snprintf(bufB, sizeof(bufB), "%lld", static_cast<long long>(b));
+        return strcmp(bufA, bufB) < 0;
+    }
+
+    /// identifies the arcs read for the spatial index: table, geometry column, columns and capacity
+    std::string arcSourceKey(const std::string& arcsTableName, const std::string& geomColumnName,
+                             const ColumnMap& cmap, const bool withCapacity) {
+        return arcsTableName + "|" + geomColumnName + "|" + cmap.arcIDColName + "|" + cmap.fromColName + "|" +
+               cmap.toColName + "|" + cmap.costColName + "|" + (withCapacity ? cmap.capColName : "");
+    }
+}
+
  InternalNet::InternalNet(const netxpert::data::InputArcs& arcsTbl,
                           const netxpert::data::ColumnMap& _map,
                           const netxpert::cnfg::Config& cnfg,
                           const netxpert::data::InputNodes& nodesTbl,
                           const bool autoClean,
-                          const std::map<std::string, netxpert::data::IntNodeID>& extIntNodeMap) {
+                          const std::map<std::string, netxpert::data::IntNodeID>& extIntNodeMap,
+                         std::shared_ptr<netxpert::io::DBHELPER> dbHelper) {
 
     try {
-        //populate lemon maps
-        this->g = std::unique_ptr<graph_t> (new graph_t());
-        /*this->extArcIDMap = std::unique_ptr<graph_t::ArcMap<uint32_t>> (
-                    new graph_t::ArcMap<uint32_t>(*g) );*/
-        this->extArcIDMap = std::unique_ptr<graph_t::ArcMap<extarcid_t>> (
-                    new graph_t::ArcMap<extarcid_t>(*g) );
-        this->costMap = std::unique_ptr<graph_t::ArcMap<cost_t>> (
-                    new graph_t::ArcMap<cost_t>(*g) );
-        this->capMap = std::unique_ptr<graph_t::ArcMap<cost_t>> (
-                    new graph_t::ArcMap<cost_t>(*g) );
-        this->nodeMap = std::unique_ptr<graph_t::NodeMap<std::string>> (
-                    new graph_t::NodeMap<std::string>(*g) );
-        this->nodeSupplyMap = std::unique_ptr<graph_t::NodeMap<supply_t>> (
-                    new graph_t::NodeMap<supply_t>(*g) );
-        this->arcChangesMap = std::unique_ptr<graph_t::ArcMap<ArcState>> (
-                    new graph_t::ArcMap<ArcState>(*g, ArcState::original) );
-        this->arcFilterMap = std::unique_ptr<graph_t::ArcMap<bool>> (
-                    new graph_t::ArcMap<bool> (*g, true) );
+        initialize(_map, cnfg, dbHelper);
 
-//        this->arcDataMap = std::unique_ptr<netxpert::data::ArcDataMap<netxpert::data::graph_t,
-//                                           netxpert::data::arc_t,
-//                                           netxpert::data::ArcData2> > (
-//                    new netxpert::data::ArcDataMap<netxpert::data::graph_t,
-//                                        netxpert::data::arc_t,
-//                                        netxpert::data::ArcData2> (*g) );
+        bool isDirected = cnfg.IsDirected;
+
+        readNodes(arcsTbl, nodesTbl, extIntNodeMap);
 
-        /*this->splittedArcsMap = std::unique_ptr<lemon::SmartDigraph::ArcMap<bool>> (
-                    new lemon::SmartDigraph::ArcMap<bool>(*g, false));*
+        processBarriers();
 
-        /*this->sourceMap = std::unique_ptr<lemon::SourceMap<lemon::SmartDigraph> > (
-                    new lemon::SourceMap<lemon::SmartDigraph>(*g) );
-        this->targetMap = std::unique_ptr<lemon::TargetMap<lemon::SmartDigraph> > (
-                    new lemon::TargetMap<lemon::SmartDigraph>(*g) );*/
+        readNetwork(arcsTbl, autoClean, isDirected);
 
-        arcIDColName = _map.arcIDColName;
-        fromColName  = _map.fromColName;
-        toColName    = _map.toColName;
-        costColName  = _map.costColName;
+        //LOGGER::LogDebug("Count of internalArcData: " + std::to_string(this->arcIDMap.size()));
+        LOGGER::LogDebug("Count of arcsTbl: " + std::to_string(arcsTbl.size()));
+        LOGGER::LogDebug("Count of internalDistinctNodes: " + std::to_string(this->nodeIDTable.Count()));
+        LOGGER::LogDebug("Count of eliminatedArcs: " + std::to_string(this->eliminatedArcs.size()));
+//        LOGGER::LogDebug("Count of nodeSupplies: " + to_string(nodeSupplies.size()));
+        LOGGER::LogDebug("Count of nodesTbl: " + std::to_string(nodesTbl.size()));
 
-        if (!_map.capColName.empty())
-            capColName = _map.capColName;
-        else
-            capColName = "";
-        if (!_map.onewayColName.empty())
-            onewayColName = _map.onewayColName;
-        else
-            onewayColName = "";
+    }
+    catch (std::exception& ex) {
+        LOGGER::LogFatal("InternalNet ctor: Error!");
+        LOGGER::LogFatal(ex.what());
+    }
+}
 
-        nodeIDColName = _map.nodeIDColName;
-        supplyColName = _map.supplyColName;
+/**
+* Same network as from the corresponding netxpert::data::InputArcs: the nodes get the same internal IDs
+* and the arcs are grouped by their internal start node (counting sort instead of ORDER BY in SQL).
+*/
+ InternalNet::InternalNet(const netxpert::data::InputArcColumns& arcCols,
+                          const netxpert::data::ColumnMap& _map,
+                          const netxpert::cnfg::Config& cnfg,
+                          const netxpert::data::InputNodes& nodesTbl,
+                          const bool autoClean,
+                          std::shared_ptr<netxpert::io::DBHELPER> dbHelper) {
 
-        NETXPERT_CNFG = cnfg;
+    try {
+        initialize(_map, cnfg, dbHelper);
 
         bool isDirected = cnfg.IsDirected;
 
-        readNodes(arcsTbl, nodesTbl, extIntNodeMap);
+        const auto nodes = readNodes(arcCols, nodesTbl);
 
         processBarriers();
 
-        readNetwork(arcsTbl, autoClean, isDirected);
+        readNetwork(arcCols, nodes, autoClean, isDirected);
 
-        //LOGGER::LogDebug("Count of internalArcData: " + std::to_string(this->arcIDMap.size()));
-        LOGGER::LogDebug("Count of arcsTbl: " + std::to_string(arcsTbl.size()));
-        LOGGER::LogDebug("Count of internalDistinctNodes: " + std::to_string(this->nodeIDMap.size()));
+        LOGGER::LogDebug("Count of arcCols: " + std::to_string(arcCols.Size()));
+        LOGGER::LogDebug("Count of internalDistinctNodes: " + std::to_string(this->nodeIDTable.Count()));
         LOGGER::LogDebug("Count of eliminatedArcs: " + std::to_string(this->eliminatedArcs.size()));
-//        LOGGER::LogDebug("Count of nodeSupplies: " + to_string(nodeSupplies.size()));
         LOGGER::LogDebug("Count of nodesTbl: " + std::to_string(nodesTbl.size()));
-
     }
     catch (std::exception& ex) {
         LOGGER::LogFatal("InternalNet ctor: Error!");
@@ -104,6 +114,222 @@ using namespace netxpert::io;
     }
 }
 
+void
+ InternalNet::initialize(const netxpert::data::ColumnMap& _map,
+                         const netxpert::cnfg::Config& cnfg,
+                         std::shared_ptr<netxpert::io::DBHELPER> dbHelper) {
+
+    //every network without a given data context gets its own one
+    if (dbHelper)
+        this->dbHelper = dbHelper;
+    else
+        this->dbHelper = std::make_shared<netxpert::io::DBHELPER>(cnfg);
+
+    //populate lemon maps
+    this->g = std::unique_ptr<graph_t> (new graph_t());
+    createMaps();
+
+//        this->arcDataMap = std::unique_ptr<netxpert::data::ArcDataMap<netxpert::data::graph_t,
+//                                           netxpert::data::arc_t,
+//                                           netxpert::data::ArcData2> > (
+//                    new netxpert::data::ArcDataMap<netxpert::data::graph_t,
+//                                        netxpert::data::arc_t,
+//                                        netxpert::data::ArcData2> (*g) );
+
+    /*this->splittedArcsMap = std::unique_ptr<lemon::SmartDigraph::ArcMap<bool>> (
+                new lemon::SmartDigraph::ArcMap<bool>(*g, false));*
+
+    /*this->sourceMap = std::unique_ptr<lemon::SourceMap<lemon::SmartDigraph> > (
+                new lemon::SourceMap<lemon::SmartDigraph>(*g) );
+    this->targetMap = std::unique_ptr<lemon::TargetMap<lemon::SmartDigraph> > (
+                new lemon::TargetMap<lemon::SmartDigraph>(*g) );*/
+
+    arcIDColName = _map.arcIDColName;
+    fromColName  = _map.fromColName;
+    toColName    = _map.toColName;
+    costColName  = _map.costColName;
+
+    if (!_map.capColName.empty())
+        capColName = _map.capColName;
+    else
+        capColName = "";
+    if (!_map.onewayColName.empty())
+        onewayColName = _map.onewayColName;
+    else
+        onewayColName = "";
+
+    nodeIDColName = _map.nodeIDColName;
+    supplyColName = _map.supplyColName;
+
+    NETXPERT_CNFG = cnfg;
+}
+
+void
+ InternalNet::createMaps() {
+
+    /*this->extArcIDMap = std::unique_ptr<graph_t::ArcMap<uint32_t>> (
+                new graph_t::ArcMap<uint32_t>(*g) );*/
+    this->costMap = std::unique_ptr<graph_t::ArcMap<cost_t>> (
+                new graph_t::ArcMap<cost_t>(*g) );
+    this->capMap = std::unique_ptr<graph_t::ArcMap<cost_t>> (
+                new graph_t::ArcMap<cost_t>(*g) );
+    this->nodeSupplyMap = std::unique_ptr<graph_t::NodeMap<supply_t>> (
+                new graph_t::NodeMap<supply_t>(*g) );
+    this->arcChangesMap = std::unique_ptr<graph_t::ArcMap<ArcState>> (
+                new graph_t::ArcMap<ArcState>(*g, ArcState::original) );
+    this->arcFilterMap = std::unique_ptr<graph_t::ArcMap<bool>> (
+                new graph_t::ArcMap<bool> (*g, true) );
+}
+
+/**
+* The graph is built first and the maps afterwards, so that every map is allocated once in its final size.
+* Costs, capacities and supplies are copied from the arrays; integer IDs are loaded into the ID tables without
+* parsing, text IDs are registered one by one. The arc geometries are not copied: the geometry store reads them
+* from the mapping and keeps the snapshot open.
+*/
+ InternalNet::InternalNet(const std::string& snapshotPath,
+                          const netxpert::cnfg::Config& cnfg,
+                          std::shared_ptr<netxpert::io::DBHELPER> dbHelper) {
+
+    if (dbHelper)
+        this->dbHelper = dbHelper;
+    else
+        this->dbHelper = std::make_shared<netxpert::io::DBHELPER>(cnfg);
+
+    NETXPERT_CNFG = cnfg;
+
+    arcIDColName  = cnfg.ArcIDColumnName;
+    fromColName   = cnfg.FromNodeColumnName;
+    toColName     = cnfg.ToNodeColumnName;
+    costColName   = cnfg.CostColumnName;
+    capColName    = cnfg.CapColumnName;
+    onewayColName = cnfg.OnewayColumnName;
+    nodeIDColName = cnfg.NodeIDColumnName;
+    supplyColName = cnfg.NodeSupplyColumnName;
+
+    lemon::Timer t;
+    auto snapshotPtr = std::make_shared<const netxpert::io::NetworkSnapshot>(snapshotPath);
+    const auto& snapshot = *snapshotPtr;
+    const uint32_t n = snapshot.NodeCount();
+    const uint32_t m = snapshot.ArcCount();
+
+    this->g = std::unique_ptr<graph_t> (new graph_t());
+    this->g->reserveNode(n);
+    this->g->reserveArc(m);
+    for (uint32_t i = 0; i < n; i++)
+        this->g->addNode();
+
+    const uint32_t* sources = snapshot.ArcSources();
+    const uint32_t* targets = snapshot.ArcTargets();
+    for (uint32_t i = 0; i < m; i++)
+        this->g->addArc(this->g->nodeFromId(sources[i]), this->g->nodeFromId(targets[i]));
+
+    createMaps();
+
+    const supply_t* supplies = snapshot.NodeSupplies();
+    for (uint32_t i = 0; i < n; i++)
+        (*this->nodeSupplyMap)[this->g->nodeFromId(i)] = supplies[i];
+
+    if (snapshot.NodeIDMode() == ExternalIDTable::Mode::Integer)
+        this->nodeIDTable.Import(n, snapshot.NodeIDValues(), snapshot.NodeIDKinds(), snapshot.NodeIDs().GetAll());
+    else {
+        this->nodeIDTable.Reset(ExternalIDTable::Mode::Text);
+        this->nodeIDTable.Reserve(n);
+        for (uint32_t i = 0; i < n; i++)
+            RegisterNodeID(snapshot.NodeIDs().Get(i), this->g->nodeFromId(i));
+    }
+
+    const cost_t* costs = snapshot.ArcCosts();
+    const capacity_t* caps = snapshot.ArcCapacities();
+    for (uint32_t i = 0; i < m; i++) {
+        const arc_t arc = this->g->arcFromId(i);
+        (*this->costMap)[arc] = costs[i];
+        (*this->capMap)[arc]  = caps[i];
+    }
+
+    if (snapshot.ArcIDMode() == ExternalIDTable::Mode::Integer)
+        this->arcIDTable.Import(m, snapshot.ArcIDValues(), snapshot.ArcIDKinds(), snapshot.ArcIDs().GetAll());
+    else {
+        this->arcIDTable.Reset(ExternalIDTable::Mode::Text);
+        this->arcIDTable.Reserve(m);
+        for (uint32_t i = 0; i < m; i++)
+            this->arcIDTable.Set(i, snapshot.ArcIDs().Get(i));
+    }
+
+    for (uint64_t i = 0; i < snapshot.EliminatedArcIDs().Size(); i++)
+        this->eliminatedArcs.insert(snapshot.EliminatedArcIDs().Get(i));
+    this->dbHelper->EliminatedArcs = this->eliminatedArcs;
+
+    if (snapshot.HasGeometries()) {
+        this->arcGeomStore = std::unique_ptr<ArcGeometryStore>(new ArcGeometryStore());
+        this->arcGeomStore->Build(snapshotPtr);
+    }
+
+    LOGGER::LogInfo("Network of " + std::to_string(n) + " nodes and " + std::to_string(m) +
+                    " arcs loaded from snapshot in " + std::to_string(t.realTime()) + " s.");
+}
+
+/**
+* The snapshot holds the network as built from the input tables: the original nodes and arcs with their
+* supplies, costs, capacities and original IDs, and the eliminated arcs. With withGeometries the geometries
+* of the original arcs are added; they are loaded from the database first if necessary.
+*/
+void
+ InternalNet::SaveSnapshot(const std::string& path, const bool withGeometries) {
+
+    if (!this->newArcsMap.empty() || !this->newNodesMap.empty())
+        throw std::runtime_error("SaveSnapshot(): the network must be saved before start or end nodes are added!");
+
+    lemon::Timer t;
+    const uint32_t n = this->g->maxNodeId() + 1;
+    const uint32_t m = this->g->maxArcId() + 1;
+
+    netxpert::io::NetworkSnapshotData data;
+    data.nodeIDMode = this->nodeIDTable.GetMode();
+    if (data.nodeIDMode == ExternalIDTable::Mode::Integer)
+        this->nodeIDTable.Export(n, data.nodeIDValues, data.nodeIDKinds, data.nodeIDs);
+    else {
+        data.nodeIDs.reserve(n);
+        for (uint32_t i = 0; i < n; i++)
+            data.nodeIDs.push_back( this->nodeIDTable.Get(i) );
+    }
+    data.nodeSupplies.reserve(n);
+    for (uint32_t i = 0; i < n; i++)
+        data.nodeSupplies.push_back( (*this->nodeSupplyMap)[this->g->nodeFromId(i)] );
+
+    data.arcSources.reserve(m);
+    data.arcTargets.reserve(m);
+    data.arcCosts.reserve(m);
+    data.arcCapacities.reserve(m);
+    for (uint32_t i = 0; i < m; i++) {
+        const arc_t arc = this->g->arcFromId(i);
+        data.arcSources.push_back( this->g->id(this->g->source(arc)) );
+        data.arcTargets.push_back( this->g->id(this->g->target(arc)) );
+        data.arcCosts.push_back( (*this->costMap)[arc] );
+        data.arcCapacities.push_back( (*this->capMap)[arc] );
+    }
+    data.arcIDMode = this->arcIDTable.GetMode();
+    if (data.arcIDMode == ExternalIDTable::Mode::Integer)
+        this->arcIDTable.Export(m, data.arcIDValues, data.arcIDKinds, data.arcIDs);
+    else {
+        data.arcIDs.reserve(m);
+        for (uint32_t i = 0; i < m; i++)
+            data.arcIDs.push_back( this->arcIDTable.Get(i) );
+    }
+    data.eliminatedArcIDs.assign(this->eliminatedArcs.begin(), this->eliminatedArcs.end());
+
+    if (withGeometries) {
+        ColumnMap cmap { arcIDColName, fromColName, toColName, costColName, capColName, onewayColName,
+                         nodeIDColName, supplyColName };
+        LoadArcGeometries(NETXPERT_CNFG.ArcsTableName, NETXPERT_CNFG.ArcsGeomColumnName, cmap);
+        this->arcGeomStore->Export(m, data);
+    }
+
+    netxpert::io::NetworkSnapshot::Write(path, data);
+
+    LOGGER::LogInfo("Network snapshot " + path + " written in " + std::to_string(t.realTime()) + " s.");
+}
+
 void
  InternalNet::PrintGraph() {
      using namespace lemon;
@@ -170,6 +396,52 @@ void
 
 }
 
+std::shared_ptr<const netxpert::data::CSRGraph>
+ InternalNet::FreezeToCSR(const bool singlePrecision)
+{
+    using namespace netxpert::data;
+
+    filtered_graph_t sg(*this->g, *this->arcFilterMap);
+
+    auto csr = std::make_shared<CSRGraph>();
+    csr->Build(sg, *this->costMap, singlePrecision);
+
+    LOGGER::LogDebug("CSR snapshot: " + std::to_string(csr->NodeCount()) + " nodes, " +
+                     std::to_string(csr->ArcCount()) + " arcs, " +
+                     std::to_string(csr->MemoryUsage() / 1024) + " KB");
+    return csr;
+}
+
+void
+ InternalNet::BuildContractionHierarchy()
+{
+    using namespace netxpert::data;
+
+    //base network: no added arcs, splitted arcs in their original state
+    graph_t::ArcMap<bool> baseArcs(*this->g, false);
+    for (graph_t::ArcIt a(*this->g); a != lemon::INVALID; ++a) {
+        baseArcs[a] = this->newArcsMap.count(a) == 0 &&
+                      ( (*this->arcFilterMap)[a] || (*this->arcChangesMap)[a] == ArcState::originalAndSplit );
+    }
+    filtered_graph_t sg(*this->g, baseArcs);
+
+    CSRGraph base;
+    base.Build(sg, *this->costMap);
+
+    auto hierarchy = std::make_shared<netxpert::core::ContractionHierarchy>();
+    hierarchy->Build(base);
+    this->contractionHierarchy = hierarchy;
+}
+
+std::shared_ptr<const netxpert::core::ContractionHierarchy>
+ InternalNet::GetContractionHierarchy()
+{
+    if (!this->contractionHierarchy)
+        BuildContractionHierarchy();
+
+    return this->contractionHierarchy;
+}
+
 
 //--> Region Contraction Hierarchies
 #if (defined NETX_ENABLE_CONTRACTION_HIERARCHIES)
@@ -211,7 +483,7 @@ void
   graph_t::NodeIt iter(*this->g);
   for (; iter != INVALID; ++iter) {
     auto chNode     = (*this->chNodeRefMap)[iter];
-    auto origNodeID = (*this->nodeMap)[iter];
+    auto origNodeID = this->nodeIDTable.Get(this->g->id(iter));
     this->chNodeIDRefMap.insert( std::make_pair(origNodeID, this->chg->id(chNode) ));
   }
 }
@@ -321,7 +593,7 @@ void
   this->chNodeRefMap = std::unique_ptr<graph_t::NodeMap<graph_ch_t::Node>>(new graph_t::NodeMap<graph_ch_t::Node> (*this->g));
   //populate chNodeRefMap
   for(auto& kv: this->chNodeIDRefMap) {
-    auto origNode = this->nodeIDMap.at(kv.first);
+    auto origNode = this->GetNodeFromOrigID(kv.first);
     auto chNode   = this->chg->nodeFromId(kv.second);
     (*this->chNodeRefMap)[origNode] = chNode;
   }
@@ -339,8 +611,18 @@ const arc_t
 const arc_t
  InternalNet::GetArcFromOrigID(const netxpert::data::extarcid_t arcID) {
     //Ŝauto arc = (*this->extArcIDMap)[arcID];
-    auto arc = lemon::mapFind(*this->g, (*this->extArcIDMap), arcID);
-    return arc;
+    //new arcs have no original ID: the latest of them (like a search over all arcs)
+    if (arcID.empty()) {
+        for (int id = this->g->maxArcId(); id >= 0; id--) {
+            if (this->arcIDTable.IsEmpty(id))
+                return this->g->arcFromId(id);
+        }
+        return lemon::INVALID;
+    }
+    uint32_t id;
+    if (!this->arcIDTable.Find(arcID, id))
+        return lemon::INVALID;
+    return this->g->arcFromId(id);
 }
 
 const netxpert::data::intarcid_t
@@ -372,7 +654,7 @@ const netxpert::data::ArcData
  InternalNet::GetArcData(const arc_t& arc) {
     netxpert::data::ArcData result;
 //    netxpert::data::ArcData2 result;
-    result.extArcID     = (*this->extArcIDMap)[arc];
+    result.extArcID     = this->arcIDTable.Get(this->g->id(arc));
     result.cost         = (*this->costMap)[arc];
     result.capacity     = (*this->capMap)[arc];
 //    result = (*this->arcDataMap)[arc];
@@ -383,7 +665,7 @@ const netxpert::data::ArcData
 void
  InternalNet::SetArcData(const arc_t& arc, const ArcData& arcData) {
 
-    (*this->extArcIDMap)[arc]   = arcData.extArcID; //may be 'dummy' in case of MCF
+    this->arcIDTable.Set(this->g->id(arc), arcData.extArcID); //may be 'dummy' in case of MCF
     (*this->costMap)[arc]       = arcData.cost;
     (*this->capMap)[arc]        = arcData.capacity;
 }
@@ -391,8 +673,13 @@ void
 void
  InternalNet::RegisterNodeID(const std::string& nodeID, const netxpert::data::node_t& node) {
 
-    this->nodeIDMap.insert( std::make_pair(nodeID, node) );
-    (*this->nodeMap)[node] = nodeID;
+    this->nodeIDTable.Set(this->g->id(node), nodeID);
+}
+
+void
+ InternalNet::RegisterNodeID(const int64_t nodeID, const netxpert::data::node_t& node) {
+
+    this->nodeIDTable.Set(this->g->id(node), nodeID);
 }
 
 const std::unordered_set<std::string>
@@ -404,9 +691,9 @@ const std::unordered_set<std::string>
     unordered_set<string> resultIDs;
 
     for (auto arc : path) {
-        auto extArcID = (*this->extArcIDMap)[arc];
-        if (extArcID.size() > 0)
-            resultIDs.insert(extArcID);
+        const int arcID = this->g->id(arc);
+        if (!this->arcIDTable.IsEmpty(arcID))
+            resultIDs.insert(this->arcIDTable.Get(arcID));
     }
 
     return resultIDs;
@@ -426,20 +713,16 @@ const node_t
 
     netxpert::data::node_t node = lemon::INVALID;
 
-    try {
-        node = this->nodeIDMap.at(nodeID);
-    }
-    catch (std::exception& ex) {
-        try {
-            this->nodeIDMap.at(nodeID + "@netXpert");
-        }
-        catch (std::exception& ex) {
-            LOGGER::LogWarning("Could not get node from orig node id: "+ nodeID);
+    uint32_t nodeIdx;
+    if (this->nodeIDTable.Find(nodeID, nodeIdx))
+        node = this->g->nodeFromId(nodeIdx);
+    else if (!this->nodeIDTable.Contains(nodeID + "@netXpert")) {
+        LOGGER::LogWarning("Could not get node from orig node id: "+ nodeID);
 
-            std::cout << "Nodes are: " << std::endl << "ext : int" << std::endl;
-            for (auto& kv : this->nodeIDMap) {
-                std::cout << kv.first << " : " << this->GetNodeID(kv.second) << std::endl;
-            }
+        std::cout << "Nodes are: " << std::endl << "ext : int" << std::endl;
+        for (int id = 0; id <= this->g->maxNodeId(); id++) {
+            if (!this->nodeIDTable.IsEmpty(id))
+                std::cout << this->nodeIDTable.Get(id) << " : " << id << std::endl;
         }
     }
 
@@ -477,7 +760,7 @@ const std::string
 
     std::string nodeID;
 
-    nodeID = (*this->nodeMap)[node];
+    nodeID = this->nodeIDTable.Get(this->g->id(node));
 //    std::cout <<"1. Orig node id from nodeMap is: " << nodeID << std::endl;
 
     if (nodeID.size() > 0) {
@@ -579,6 +862,31 @@ const uint32_t
     #ifdef DEBUG
     std::cout << "entering AddNode().. "<< std::endl;
     #endif
+
+    //1. Search the nearest arc and the nearest point on the line to the given coordinate
+    ExtClosestArcAndPoint closestArcAndPoint = this->dbHelper->GetClosestArcFromPoint(newNode.coord,
+            threshold, closestArcQry, withCapacity);
+
+    return addNode(newNode, threshold, closestArcAndPoint, startOrEnd);
+}
+
+const uint32_t
+ InternalNet::AddNode(const netxpert::data::NewNode& newNode, const int threshold,
+                      const netxpert::data::ArcSpatialIndex& arcIndex,
+                      const AddedNodeType startOrEnd) {
+
+    ExtClosestArcAndPoint closestArcAndPoint;
+    if (!arcIndex.GetClosestArc(newNode.coord, threshold, closestArcAndPoint))
+        throw std::runtime_error("No arc found within the threshold of node " + newNode.extNodeID + "!");
+
+    return addNode(newNode, threshold, closestArcAndPoint, startOrEnd);
+}
+
+const uint32_t
+ InternalNet::addNode(const netxpert::data::NewNode& newNode, const int threshold,
+                      const netxpert::data::ExtClosestArcAndPoint& closestArcAndPoint,
+                      const AddedNodeType startOrEnd) {
+
     using namespace std;
     using namespace geos::geom;
 
@@ -586,10 +894,6 @@ const uint32_t
     const Coordinate point      = newNode.coord;
     const auto nodeSupply       = newNode.supply;
 
-    //1. Search the nearest arc and the nearest point on the line to the given coordinate
-    ExtClosestArcAndPoint closestArcAndPoint = DBHELPER::GetClosestArcFromPoint(point,
-            threshold, closestArcQry, withCapacity);
-
     // extArcID may be set to an empty string if arc has already been splitted
     string extArcID          = closestArcAndPoint.extArcID;
     Geometry& closestArc     = *closestArcAndPoint.arcGeom;
@@ -618,7 +922,7 @@ const uint32_t
                     +" is identical to a start node of the network!");
                 // take fromNode and toNode from above and don't split the arc
 //                std::cout << "extFromNode " << extFromNode << " | " << " extNodeID " << extNodeID<< std::endl;
-                if (this->nodeIDMap.count(extFromNode) > 0)
+                if (this->nodeIDTable.Contains(extFromNode))
                 {
                     resultNode = this->GetNodeFromOrigID(extFromNode);
                     //save closestPoint geom for lookup later on straight lines for ODMatrix
@@ -649,7 +953,7 @@ const uint32_t
                     +" is identical to a end node of the network!");
                 // take fromNode and toNode from above and don't split the arc
 //                std::cout << "extToNode " << extToNode << " | " << " extNodeID " << extNodeID<< std::endl;
-                if (this->nodeIDMap.count(extToNode) > 0)
+                if (this->nodeIDTable.Contains(extToNode))
                 {
                     resultNode = this->GetNodeFromOrigID(extToNode);
                     //save closestPoint geom for lookup later on straight lines for ODMatrix
@@ -883,13 +1187,14 @@ const node_t
 //                   std::endl;
         //std::cout << "revseg2 ID# " << this->g->id(revNewArc2) << std::endl;
 
-        NewArc n1 { *ptr1 , startOrEnd, newArc1Cost, splittedLine.capacity};
+        //segment1 runs from origToNode to newNode, segment2 from newNode to origFromNode
+        NewArc n1 { *ptr1 , startOrEnd, newArc1Cost, splittedLine.capacity, true};
 //        std::cout << "newArc1: " << n1.arcGeom->toString() << std::endl;
-        NewArc n2 { *ptr2 , startOrEnd, newArc2Cost, splittedLine.capacity};
+        NewArc n2 { *ptr2 , startOrEnd, newArc2Cost, splittedLine.capacity, true};
 //        std::cout << "newArc2: " << n2.arcGeom->toString() << std::endl;
-        NewArc rn1 { *ptr1 , startOrEnd, newArc1Cost, splittedLine.capacity};
+        NewArc rn1 { *ptr1 , startOrEnd, newArc1Cost, splittedLine.capacity, false};
 //        std::cout << "revNewArc1: " << rn1.arcGeom->toString() << std::endl;
-        NewArc rn2 { *ptr2 , startOrEnd, newArc2Cost, splittedLine.capacity};
+        NewArc rn2 { *ptr2 , startOrEnd, newArc2Cost, splittedLine.capacity, false};
 //        std::cout << "revNewArc2: " << rn2.arcGeom->toString() << std::endl;
 
         //store new arcs
@@ -991,6 +1296,90 @@ const node_t
 }
 
 // TODO
+/**
+* Inserts all points on one original arc at once as a chain of new nodes. The pieces are the parts of the
+* arc geometry between the points in the order along the line (one more than points); the costs are relative
+* to their lengths. Orientation of the chain like in insertNewNode(): the line starts at the source node of
+* the arc in the directed case and at the target node in the undirected case.
+*/
+const std::vector<netxpert::data::node_t>
+ InternalNet::insertNewNodes(const netxpert::data::arc_t origArc, const netxpert::data::cost_t cost,
+                             const netxpert::data::capacity_t capacity,
+                             const std::vector<std::vector<geos::geom::Coordinate>>& pieces,
+                             const std::vector<netxpert::data::AddedPoint>& points,
+                             const netxpert::data::AddedNodeType startOrEnd) {
+
+    using namespace std;
+    using namespace geos::geom;
+
+    //checked before the graph is changed
+    std::map<node_t, AddedPoint>* addedPoints = nullptr;
+    switch (startOrEnd)
+    {
+        case AddedNodeType::StartArc:
+            addedPoints = &this->addedStartPoints;
+            break;
+        case AddedNodeType::EndArc:
+            addedPoints = &this->addedEndPoints;
+            break;
+        default:
+            throw std::runtime_error("insertNewNodes(): undefined type of the added nodes!");
+    }
+
+    auto origFromNode   = this->g->source(origArc);
+    auto origToNode     = this->g->target(origArc);
+
+    auto revOrigArc = GetArcFromNodes(origToNode, origFromNode);
+    const bool isDirected = revOrigArc == lemon::INVALID;
+
+    vector<unique_ptr<LineString>> segments;
+    double totalLength = 0;
+    for (const auto& piece : pieces) {
+        auto coords = DBHELPER::GEO_FACTORY->getCoordinateSequenceFactory()->create(new vector<Coordinate>(piece));
+        segments.push_back( unique_ptr<LineString>(DBHELPER::GEO_FACTORY->createLineString(coords)) );
+        totalLength += segments.back()->getLength();
+    }
+
+    vector<node_t> newNodes;
+    vector<node_t> chain { isDirected ? origFromNode : origToNode };
+    for (size_t k = 0; k < points.size(); k++) {
+        newNodes.push_back( this->g->addNode() );
+        chain.push_back( newNodes.back() );
+    }
+    chain.push_back( isDirected ? origToNode : origFromNode );
+
+    for (size_t k = 0; k < segments.size(); k++) {
+        //Capacity is not relative!
+        const cost_t newArcCost = ( segments[k]->getLength() / totalLength ) * cost;
+
+        vector<arc_t> newArcs;
+        if (isDirected)
+            newArcs.push_back( this->g->addArc(chain[k], chain[k+1]) );
+        else {
+            newArcs.push_back( this->g->addArc(chain[k+1], chain[k]) );
+            newArcs.push_back( this->g->addArc(chain[k], chain[k+1]) );
+        }
+        for (const auto& newArc : newArcs) {
+            //piece k runs from chain[k] to chain[k+1]
+            const bool reversed = this->g->source(newArc) == chain[k+1];
+            this->newArcsMap.insert( make_pair(newArc, NewArc { *segments[k], startOrEnd, newArcCost, capacity, reversed}) );
+            (*this->costMap)[newArc] = newArcCost;
+            (*this->capMap)[newArc] = capacity;
+            (*this->arcFilterMap)[newArc] = true;
+        }
+    }
+
+    //-->Remove orig arc from internal graph
+    (*this->arcFilterMap)[origArc] = false;
+    if (!isDirected)
+        (*this->arcFilterMap)[revOrigArc] = false;
+
+    for (size_t k = 0; k < newNodes.size(); k++)
+        addedPoints->insert( make_pair(newNodes[k], points[k]) );
+
+    return newNodes;
+}
+
 void
  InternalNet::insertNewBarrierNodes(bool isDirected,
                                     netxpert::data::IntNetSplittedArc2<netxpert::data::arc_t>& clippedLine) {
@@ -1079,7 +1468,7 @@ const uint32_t
     try {
 
       //check extNodeID if already present in nodeIDMap
-      if (this->nodeIDMap.count(extNodeID) != 0) {
+      if (this->nodeIDTable.Contains(extNodeID)) {
           LOGGER::LogWarning("External Node ID "+ extNodeID + " already present! Renaming..");
           extNodeID = extNodeID + "@netXpert";
       }
@@ -1089,9 +1478,8 @@ const uint32_t
       const string arcsTableName  = NETXPERT_CNFG.ArcsTableName;
       const string geomColumnName = NETXPERT_CNFG.ArcsGeomColumnName;
 
-      auto qry = DBHELPER::PrepareGetClosestArcQuery(arcsTableName, geomColumnName,
-                                              cmap, ArcIDColumnDataType::Number, withCapacity);
-      return AddNode(n, threshold, *qry, withCapacity, AddedNodeType::StartArc);
+      return AddNode(n, threshold, getArcIndex(arcsTableName, geomColumnName, cmap, withCapacity),
+                     AddedNodeType::StartArc);
     }
     catch (const std::runtime_error& ex) {
       LOGGER::LogError("RuntimeError in AddStartNode()!");
@@ -1116,7 +1504,7 @@ const uint32_t
 
     try  {
       //check extNodeID if already present in nodeIDMap
-      if (this->nodeIDMap.count(extNodeID) != 0) {
+      if (this->nodeIDTable.Contains(extNodeID)) {
           LOGGER::LogWarning("External Node ID "+ extNodeID + " already present! Renaming..");
           extNodeID = extNodeID + "@netXpert";
       }
@@ -1126,9 +1514,8 @@ const uint32_t
       const string arcsTableName  = NETXPERT_CNFG.ArcsTableName;
       const string geomColumnName = NETXPERT_CNFG.ArcsGeomColumnName;
 
-      auto qry = DBHELPER::PrepareGetClosestArcQuery(arcsTableName, geomColumnName,
-                                              cmap, ArcIDColumnDataType::Number, withCapacity);
-      return AddNode(n, threshold, *qry, withCapacity, AddedNodeType::EndArc);
+      return AddNode(n, threshold, getArcIndex(arcsTableName, geomColumnName, cmap, withCapacity),
+                     AddedNodeType::EndArc);
     }
     catch (const std::runtime_error& ex) {
       LOGGER::LogError("RuntimeError in AddEndNode()!");
@@ -1148,38 +1535,8 @@ std::vector< std::pair<uint32_t, std::string> >
                              const std::string arcsTableName, const std::string geomColumnName,
                              const ColumnMap& cmap, const bool withCapacity) {
 
-    using namespace std;
-
-    auto qry = DBHELPER::PrepareGetClosestArcQuery(arcsTableName, geomColumnName,
-                                            cmap, ArcIDColumnDataType::Number, withCapacity);
-    vector<pair<uint32_t, string>> startNodes;
-
-    for (auto& startNode : newNodes)
-    {
-        if (startNode.supply > 0)
-        {
-            LOGGER::LogDebug("Loading Node "+ startNode.extNodeID + "..");
-
-            //check extNodeID if already present in nodeIDMap
-            if (this->nodeIDMap.count(startNode.extNodeID) != 0) {
-                LOGGER::LogWarning("External Node ID "+ startNode.extNodeID + " already present! Renaming..");
-                startNode.extNodeID = startNode.extNodeID + "@netXpert";
-            }
-
-            try
-            {
-                auto newStartNodeID = AddNode(startNode, threshold, *qry, withCapacity, AddedNodeType::StartArc);
-                startNodes.push_back( make_pair(newStartNodeID, startNode.extNodeID ) );
-                LOGGER::LogDebug("New Start Node ID " + to_string(newStartNodeID)  + " - " + startNode.extNodeID);
-            }
-            catch (exception& ex)
-            {
-                LOGGER::LogError("Error in LoadStartNodes()!");
-                LOGGER::LogError(ex.what());
-            }
-        }
-    }
-    return startNodes;
+    return loadNodes(newNodes, threshold, getArcIndex(arcsTableName, geomColumnName, cmap, withCapacity),
+                     AddedNodeType::StartArc);
 }
 
 std::vector< std::pair<uint32_t, std::string> >
@@ -1187,82 +1544,297 @@ std::vector< std::pair<uint32_t, std::string> >
                            const std::string arcsTableName, const std::string geomColumnName,
                            const ColumnMap& cmap, const bool withCapacity) {
 
-    using namespace std;
-
-    auto qry = DBHELPER::PrepareGetClosestArcQuery(arcsTableName, geomColumnName,
-                                            cmap, ArcIDColumnDataType::Number, withCapacity);
-    vector<pair<uint32_t, string>> endNodes;
-
-    for (auto& endNode : newNodes)
-    {
-        if (endNode.supply < 0)
-        {
-            LOGGER::LogDebug("Loading Node "+ endNode.extNodeID + "..");
-
-            //check extNodeID if already present in nodeIDMap
-            if (this->nodeIDMap.count(endNode.extNodeID) != 0) {
-                LOGGER::LogWarning("External Node ID "+ endNode.extNodeID + " already present! Renaming..");
-                endNode.extNodeID = endNode.extNodeID + "@netXpert";
-            }
-
-            try
-            {
-                auto newEndNodeID = AddNode(endNode, threshold, *qry, withCapacity, AddedNodeType::EndArc);
-                endNodes.push_back( make_pair(newEndNodeID, endNode.extNodeID ) );
-                LOGGER::LogDebug("New End Node ID " + to_string(newEndNodeID) + " - " + endNode.extNodeID);
-            }
-            catch (exception& ex)
-            {
-                LOGGER::LogError("Error in LoadEndNodes()!");
-                LOGGER::LogError(ex.what());
-            }
-            //break;
-        }
-        //}//omp single
-    }
-    //}//omp parallel
-    return endNodes;
+    return loadNodes(newNodes, threshold, getArcIndex(arcsTableName, geomColumnName, cmap, withCapacity),
+                     AddedNodeType::EndArc);
 }
 
-void
- InternalNet::Reset() {
+/**
+* 1. Snapping, position of the points along their arcs and lookup of the arcs in parallel
+* 2. Grouping of the points that lie between start and end of an unchanged original arc (serial, input order)
+* 3. Splitting of every group's arc into all of its pieces at once in parallel (coordinates only, as
+*    the geometry factory is not thread safe)
+* 4. Serial commit of all groups with insertNewNodes(); all other points take the single point path of
+*    addNode(). Points on already split arcs are added last, because they are searched in the new arcs.
+*/
+std::vector< std::pair<uint32_t, std::string> >
+ InternalNet::loadNodes(std::vector<netxpert::data::NewNode>& newNodes, const int threshold,
+                        const netxpert::data::ArcSpatialIndex& arcIndex,
+                        const netxpert::data::AddedNodeType startOrEnd) {
 
-    using namespace lemon;
     using namespace std;
+    using namespace geos::geom;
 
-    LOGGER::LogInfo("Resetting network..");
-
-    //Reset network by resetting the filtered orig arcs (and their reversed ones)
+    const string caller = startOrEnd == AddedNodeType::StartArc ? "LoadStartNodes()" : "LoadEndNodes()";
+    const int numThreads = std::max(1, netxpert::cnfg::LOCAL_NUM_THREADS);
+    const size_t nodeCount = newNodes.size();
 
-    //reset new arcs, arcChanges, remove addedNodes
-    auto iter = GetArcsIter();
-    int arcChangesCnt = 0;
-    int arcFilterOrigCnt = 0;
+    //1.
+    const auto closestArcs = snapNodes(newNodes, threshold, arcIndex, startOrEnd);
 
-    // Iterate over all present arcs in the graph
-    // note: iterator gets also the reversed arcs if present!
-    for (; iter != INVALID; ++iter) {
-        auto arc = iter;
+    vector<double> positions (nodeCount, -1);
+    vector<double> lengths (nodeCount, 0);
+    vector<arc_t> origArcs (nodeCount, lemon::INVALID);
 
-        // first the splitted arcs
-        // set them back to the original state
-        if ( (*this->arcChangesMap)[arc] != netxpert::data::ArcState::original) {
-          (*this->arcChangesMap)[arc] = netxpert::data::ArcState::original;
-          arcChangesCnt += 1;
+    #pragma omp parallel for schedule(dynamic, 256) num_threads(numThreads)
+    for (size_t i = 0; i < nodeCount; i++)
+    {
+        const LineString* line = dynamic_cast<const LineString*>(closestArcs[i].arcGeom.get());
+        if (!line)
+            continue;
+        try {
+            positions[i] = getPositionOfPointAlongLine(newNodes[i].coord, *line);
+            lengths[i]   = line->getLength();
+            origArcs[i]  = GetArcFromOrigID(closestArcs[i].extArcID);
         }
-
-        // then set all original arcs to active again
-        if ( (*this->arcChangesMap)[arc] == netxpert::data::ArcState::original) {
-          (*this->arcFilterMap)[arc] = true; //set the original arcs (unsplitted ones) again to active (true)
-          arcFilterOrigCnt += 1;
+        catch (...) {
+            //single point path reports the error
+            positions[i] = -1;
         }
-
     }
 
-    //"delete" new arcs (=splitted) through arc filter
-    int counter = 0;
-    // map has also the reversed arcs if present!
-    for (auto& kv : this->newArcsMap) {
+    //2.
+    struct ArcSplit
+    {
+        arc_t arc;
+        const LineString* line;
+        vector<size_t> points;
+        vector<vector<Coordinate>> pieces;
+    };
+    vector<ArcSplit> splits;
+    unordered_map<int, size_t> splitOfArc;
+    unordered_set<string> loadedIDs;
+    vector<size_t> requested;
+    vector<size_t> deferred;
+    vector<int64_t> resultIDs (nodeCount, -1);
+
+    auto addSingleNode = [&](const size_t i) {
+        auto& newNode = newNodes[i];
+        try
+        {
+            if (!closestArcs[i].arcGeom)
+                throw std::runtime_error("No arc found within the threshold of node " + newNode.extNodeID + "!");
+            resultIDs[i] = addNode(newNode, threshold, closestArcs[i], startOrEnd);
+        }
+        catch (exception& ex)
+        {
+            LOGGER::LogError("Error in " + caller + "!");
+            LOGGER::LogError(ex.what());
+        }
+    };
+
+    for (size_t i = 0; i < nodeCount; i++)
+    {
+        auto& newNode = newNodes[i];
+        const bool isRequested = startOrEnd == AddedNodeType::StartArc ? newNode.supply > 0
+                                                                      : newNode.supply < 0;
+        if (!isRequested)
+            continue;
+
+        LOGGER::LogDebug("Loading Node "+ newNode.extNodeID + "..");
+        requested.push_back(i);
+
+        //check extNodeID if already present in nodeIDMap or in the current batch
+        if (this->nodeIDTable.Contains(newNode.extNodeID) || loadedIDs.count(newNode.extNodeID) != 0) {
+            LOGGER::LogWarning("External Node ID "+ newNode.extNodeID + " already present! Renaming..");
+            newNode.extNodeID = newNode.extNodeID + "@netXpert";
+        }
+        loadedIDs.insert(newNode.extNodeID);
+
+        if (origArcs[i] == lemon::INVALID) {
+            addSingleNode(i);
+            continue;
+        }
+#if (defined NETX_ENABLE_CONTRACTION_HIERARCHIES)
+        //changes of the contracted graph are done for single points only
+        if (this->hasContractionHierarchies) {
+            addSingleNode(i);
+            continue;
+        }
+#endif
+        if ( (*this->arcChangesMap)[origArcs[i]] != ArcState::original ) {
+            deferred.push_back(i);
+            continue;
+        }
+        //start or end node of the arc: no split
+        if (positions[i] <= 0 || positions[i] >= lengths[i]) {
+            addSingleNode(i);
+            continue;
+        }
+
+        const int arcID = this->g->id(origArcs[i]);
+        auto it = splitOfArc.find(arcID);
+        if (it == splitOfArc.end()) {
+            it = splitOfArc.insert( make_pair(arcID, splits.size()) ).first;
+            const LineString* line = dynamic_cast<const LineString*>(closestArcs[i].arcGeom.get());
+            splits.push_back( ArcSplit {origArcs[i], line, {}, {}} );
+        }
+        splits[it->second].points.push_back(i);
+    }
+
+    //3.
+    #pragma omp parallel for schedule(dynamic, 16) num_threads(numThreads)
+    for (size_t s = 0; s < splits.size(); s++)
+    {
+        auto& split = splits[s];
+        std::stable_sort(split.points.begin(), split.points.end(),
+                         [&](const size_t a, const size_t b) { return positions[a] < positions[b]; });
+        vector<double> cuts;
+        for (const auto i : split.points)
+            cuts.push_back(positions[i]);
+        split.pieces = splitLine(cuts, *split.line);
+    }
+
+    //4.
+    for (const auto& split : splits)
+    {
+        const auto& closest = closestArcs[split.points.front()];
+        try
+        {
+            vector<AddedPoint> points;
+            for (const auto i : split.points)
+                points.push_back( AddedPoint {newNodes[i].extNodeID, newNodes[i].coord} );
+
+            auto nodes = insertNewNodes(split.arc, closest.cost, closest.capacity, split.pieces, points, startOrEnd);
+
+            for (size_t k = 0; k < nodes.size(); k++) {
+                const auto& newNode = newNodes[split.points[k]];
+                (*this->nodeSupplyMap)[nodes[k]] = newNode.supply;
+                this->RegisterNodeID(newNode.extNodeID, nodes[k]);
+                resultIDs[split.points[k]] = this->g->id(nodes[k]);
+            }
+            (*this->arcChangesMap)[split.arc] = ArcState::originalAndSplit;
+        }
+        catch (exception& ex)
+        {
+            LOGGER::LogError("Error in " + caller + " on arc " + closest.extArcID + "!");
+            LOGGER::LogError(ex.what());
+        }
+    }
+    for (const auto i : deferred)
+        addSingleNode(i);
+
+    vector<pair<uint32_t, string>> result;
+    for (const auto i : requested)
+    {
+        if (resultIDs[i] < 0)
+            continue;
+        result.push_back( make_pair( (uint32_t) resultIDs[i], newNodes[i].extNodeID ) );
+        LOGGER::LogDebug("New Node ID " + to_string(resultIDs[i]) + " - " + newNodes[i].extNodeID);
+    }
+    LOGGER::LogDebug(to_string(result.size()) + " of " + to_string(requested.size()) + " nodes added; " +
+                     to_string(splits.size()) + " arcs split at once.");
+    return result;
+}
+
+const netxpert::data::ArcSpatialIndex&
+ InternalNet::getArcIndex(const std::string& arcsTableName, const std::string& geomColumnName,
+                          const ColumnMap& cmap, const bool withCapacity) {
+
+    const std::string key = arcSourceKey(arcsTableName, geomColumnName, cmap, withCapacity);
+    if (this->arcIndex && this->arcIndexKey == key)
+        return *this->arcIndex;
+    if (this->arcIndex)
+        LOGGER::LogWarning("Arcs for snapping changed from " + this->arcIndexKey + " to " + key +
+                           " - rebuilding the spatial index!");
+
+    buildArcIndex(arcsTableName, geomColumnName, cmap, withCapacity, false);
+    return *this->arcIndex;
+}
+
+/**
+* Reads the arcs with their geometries from the database and builds the spatial index on them. With
+* withGeomStore the geometry store is built from the same arcs first, so the geometries are read and parsed once.
+*/
+void
+ InternalNet::buildArcIndex(const std::string& arcsTableName, const std::string& geomColumnName,
+                            const ColumnMap& cmap, const bool withCapacity, const bool withGeomStore) {
+
+    lemon::Timer t;
+    std::vector<ExtArcWithGeom> arcs = this->dbHelper->LoadArcsWithGeomFromDB(arcsTableName, geomColumnName,
+                                                                               cmap, withCapacity);
+    if (withGeomStore)
+        buildArcGeomStore(arcs);
+
+    this->arcIndex = std::unique_ptr<ArcSpatialIndex>(new ArcSpatialIndex());
+    this->arcIndex->Build(std::move(arcs));
+    this->arcIndexKey = arcSourceKey(arcsTableName, geomColumnName, cmap, withCapacity);
+    LOGGER::LogInfo("Spatial index of " + std::to_string(this->arcIndex->ArcCount()) + " arcs (" +
+                    std::to_string(this->arcIndex->SegmentCount()) + " segments) built in " +
+                    std::to_string(t.realTime()) + " s.");
+}
+
+void
+ InternalNet::buildArcGeomStore(const std::vector<netxpert::data::ExtArcWithGeom>& arcs) {
+
+    lemon::Timer t;
+    this->arcGeomStore = std::unique_ptr<ArcGeometryStore>(new ArcGeometryStore());
+    this->arcGeomStore->Build(arcs, *this->g, this->arcIDTable, this->nodeIDTable);
+    LOGGER::LogInfo("Geometries of " + std::to_string(this->arcGeomStore->SpanCount()) + " arcs (" +
+                    std::to_string(this->arcGeomStore->MemoryUsage() / 1024) + " KB) stored in " +
+                    std::to_string(t.realTime()) + " s.");
+}
+
+/**
+* Only the nodes of the given type are snapped (start: supply > 0, end: supply < 0); the arc geometry of
+* the others and of the nodes without an arc within the threshold stays empty.
+*/
+std::vector<netxpert::data::ExtClosestArcAndPoint>
+ InternalNet::snapNodes(const std::vector<netxpert::data::NewNode>& newNodes, const int threshold,
+                        const netxpert::data::ArcSpatialIndex& arcIndex,
+                        const netxpert::data::AddedNodeType startOrEnd) {
+
+    std::vector<ExtClosestArcAndPoint> result (newNodes.size());
+
+    #pragma omp parallel for schedule(dynamic, 256) num_threads(std::max(1, netxpert::cnfg::LOCAL_NUM_THREADS))
+    for (size_t i = 0; i < newNodes.size(); i++)
+    {
+        const bool isRequested = startOrEnd == AddedNodeType::StartArc ? newNodes[i].supply > 0
+                                                                      : newNodes[i].supply < 0;
+        if (isRequested)
+            arcIndex.GetClosestArc(newNodes[i].coord, threshold, result[i]);
+    }
+    return result;
+}
+
+void
+ InternalNet::Reset() {
+
+    using namespace lemon;
+    using namespace std;
+
+    LOGGER::LogInfo("Resetting network..");
+
+    //Reset network by resetting the filtered orig arcs (and their reversed ones)
+
+    //reset new arcs, arcChanges, remove addedNodes
+    auto iter = GetArcsIter();
+    int arcChangesCnt = 0;
+    int arcFilterOrigCnt = 0;
+
+    // Iterate over all present arcs in the graph
+    // note: iterator gets also the reversed arcs if present!
+    for (; iter != INVALID; ++iter) {
+        auto arc = iter;
+
+        // first the splitted arcs
+        // set them back to the original state
+        if ( (*this->arcChangesMap)[arc] != netxpert::data::ArcState::original) {
+          (*this->arcChangesMap)[arc] = netxpert::data::ArcState::original;
+          arcChangesCnt += 1;
+        }
+
+        // then set all original arcs to active again
+        if ( (*this->arcChangesMap)[arc] == netxpert::data::ArcState::original) {
+          (*this->arcFilterMap)[arc] = true; //set the original arcs (unsplitted ones) again to active (true)
+          arcFilterOrigCnt += 1;
+        }
+
+    }
+
+    //"delete" new arcs (=splitted) through arc filter
+    int counter = 0;
+    // map has also the reversed arcs if present!
+    for (auto& kv : this->newArcsMap) {
       auto arc = kv.first;
       (*this->arcFilterMap)[arc] = false;
       counter += 1;
@@ -1286,10 +1858,7 @@ void
     this->addedEndPoints.clear();
     this->eliminatedArcs.clear();
 
-    //TODO CH
-    #if (defined NETX_ENABLE_CONTRACTION_HIERARCHIES)
-    #endif
-
+    //the contraction hierarchy (GetContractionHierarchy()) covers the base network only and stays valid
 
     LOGGER::LogInfo("Done!");
  }
@@ -1315,26 +1884,18 @@ std::unique_ptr<geos::geom::LineString>
 
 void
  InternalNet::ProcessSPTResultArcsMem(const std::string& orig, const std::string& dest, const netxpert::data::cost_t cost,
-                                      const std::string& arcIDs, const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
+                                      const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
                                       const std::string& resultTableName, netxpert::io::DBWriter& writer,
                                       SQLite::Statement& qry //can be null in case of ESRI FileGDB
                                      ){
     using namespace netxpert::cnfg;
     using namespace geos::geom;
-    std::vector<geos::geom::Geometry*> routeParts;
     //for straight lines or no geometry
     std::unique_ptr<MultiLineString> mLine (DBHELPER::GEO_FACTORY->createMultiLineString());
 
     switch (NETXPERT_CNFG.GeometryHandling) {
         case GEOMETRY_HANDLING::RealGeometry: {
-          routeParts = addRoutePartGeoms(routeNodeArcRep);
-//            std::cout << "Route from "<< orig << " to " << dest << std::endl;
-//            for (auto a : routeNodeArcRep)
-////                std::cout << this->g->id(this->g->source(a)) << "->" << this->g->id(this->g->target(a)) << " , ";
-//                std::cout << GetOrigNodeID(this->g->source(a)) << "->" << GetOrigNodeID(this->g->target(a)) << " , ";
-//
-//            std::cout << std::endl;
-          saveSPTResultsMem(orig, dest, cost, arcIDs, routeParts, resultTableName, writer, qry);
+          saveSPTResultsMem(orig, dest, cost, routeNodeArcRep, resultTableName, writer, qry);
         }
         break;
 
@@ -1346,11 +1907,13 @@ void
 
           switch (NETXPERT_CNFG.ResultDBType) {
             case RESULT_DB_TYPE::SpatiaLiteDB: {
-              #pragma omp critical
-              {
+              ResultRow row;
+              row.orig    = orig;
+              row.dest    = dest;
+              row.cost    = cost;
+              row.geomWKB = toWKB(*mLine);
               auto& sldb = dynamic_cast<SpatiaLiteWriter&>(writer);
-              sldb.SaveResultArc(orig, dest, cost, *mLine, resultTableName, qry);
-              }
+              sldb.SaveResultRow(std::move(row), resultTableName, NetXpertSolver::ShortestPathTreeSolver);
             }
             break;
             case RESULT_DB_TYPE::ESRI_FileGDB: {
@@ -1368,11 +1931,13 @@ void
         case GEOMETRY_HANDLING::NoGeometry: {
           switch (NETXPERT_CNFG.ResultDBType) {
             case RESULT_DB_TYPE::SpatiaLiteDB: {
-              #pragma omp critical
-              {
+              ResultRow row;
+              row.orig    = orig;
+              row.dest    = dest;
+              row.cost    = cost;
+              row.geomWKB = toWKB(*mLine);
               auto& sldb = dynamic_cast<SpatiaLiteWriter&>(writer);
-              sldb.SaveResultArc(orig, dest, cost, *mLine, resultTableName, qry);
-              }
+              sldb.SaveResultRow(std::move(row), resultTableName, NetXpertSolver::ShortestPathTreeSolver);
             }
             break;
             case RESULT_DB_TYPE::ESRI_FileGDB: {
@@ -1392,20 +1957,17 @@ void
 
 void
  InternalNet::ProcessSPTResultArcsMemS(const std::string& orig, const std::string& dest, const netxpert::data::cost_t cost,
-                                       const std::string& arcIDs, const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
+                                       const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
                                        std::ostringstream& output) {
     using namespace netxpert::cnfg;
     using namespace geos::geom;
 
-    std::vector<geos::geom::Geometry*> routeParts;
     //for straight lines or no geometry
     std::unique_ptr<MultiLineString> mLine (DBHELPER::GEO_FACTORY->createMultiLineString());
 
     switch (NETXPERT_CNFG.GeometryHandling) {
       case GEOMETRY_HANDLING::RealGeometry: {
-        routeParts = addRoutePartGeoms(routeNodeArcRep);
-
-        saveSPTResultsMemS(orig, dest, cost, arcIDs, routeParts, output);
+        saveSPTResultsMemS(orig, dest, cost, routeNodeArcRep, output);
       }
       break;
 
@@ -1469,31 +2031,416 @@ void
 //Isolines
 void
  InternalNet::ProcessIsoResultArcsMem(const std::string& orig, const netxpert::data::cost_t cost,
-                                      const std::string& arcIDs, const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
+                                      const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
                                       const std::string& resultTableName, netxpert::io::DBWriter& writer,
                                       SQLite::Statement& qry,
                                       const std::unordered_map<ExtNodeID, std::vector<double> > cutOffs)
 {
     using namespace netxpert::cnfg;
-    std::vector<geos::geom::Geometry*> routeParts;
 
     switch (NETXPERT_CNFG.GeometryHandling)
     {
         case GEOMETRY_HANDLING::RealGeometry:
         {
-            routeParts = addRoutePartGeoms(routeNodeArcRep);
-            saveIsoResultsMem(orig, cost, arcIDs, routeParts, resultTableName, writer, qry,
-                            cutOffs);
+            saveIsoResultsMem(orig, cost, routeNodeArcRep, resultTableName, writer, qry, cutOffs);
         }
         break;
     }
 }
 
+/**
+* Tree based isolines: the distance labels of the reached nodes give the covered part of every arc
+* that leaves a reached node --> linear in the size of the shortest path tree.
+*/
+void
+ InternalNet::ProcessIsoTreeResultArcsMem(const std::string& orig, const netxpert::data::DistLabels& labels,
+                                          const std::vector<double>& cutOffs,
+                                          const std::string& resultTableName, netxpert::io::DBWriter& writer,
+                                          SQLite::Statement& qry)
+{
+    using namespace std;
+    using namespace geos::geom;
+    using namespace netxpert::cnfg;
+
+    if (NETXPERT_CNFG.GeometryHandling != GEOMETRY_HANDLING::RealGeometry || cutOffs.empty())
+        return;
+
+    const cost_t infinity = std::numeric_limits<cost_t>::max();
+    vector<IsoTreeArc> treeArcs;
+    getIsoTreeArcs(labels, treeArcs);
+
+    struct IsoRow
+    {
+        cost_t cost;
+        double cutOff;
+        RouteGeometryBuilder geom;
+    };
+    vector<IsoRow> rows;
+    vector<double> buffer;
+    const double* xy;
+    uint32_t size;
+    bool reversed;
+
+    for (const double cutOff : cutOffs) {
+        for (const auto& t : treeArcs) {
+            const double fromSource = getCoveredFraction(t.sourceDist, t.cost, cutOff);
+            const double fromTarget = getCoveredFraction(t.targetDist, t.cost, cutOff);
+            if (fromSource <= 0 && fromTarget <= 0)
+                continue;
+            if (!getArcCoordinates(t.arc, buffer, xy, size, reversed))
+                continue;
+
+            //fraction along the arc --> fraction along the geometry
+            auto pos = [reversed](const double f) { return reversed ? 1 - f : f; };
+
+            rows.push_back( IsoRow {cutOff, cutOff, RouteGeometryBuilder()} );
+            IsoRow& row = rows.back();
+            if (fromSource + fromTarget >= 1) {
+                row.geom.Append(xy, size, reversed);
+                //farthest point of the arc
+                const cost_t farthest = t.targetDist < infinity ? (t.sourceDist + t.targetDist + t.cost) / 2
+                                                                : t.sourceDist + t.cost;
+                row.cost = std::min(farthest, cutOff);
+            }
+            else {
+                if (fromSource > 0)
+                    row.geom.AppendSection(xy, size, pos(0), pos(fromSource));
+                if (fromTarget > 0)
+                    row.geom.AppendSection(xy, size, pos(1), pos(1 - fromTarget));
+            }
+        }
+    }
+
+    switch (NETXPERT_CNFG.ResultDBType)
+    {
+        case RESULT_DB_TYPE::SpatiaLiteDB:
+        {
+            auto& sldb = dynamic_cast<SpatiaLiteWriter&>(writer);
+            for (const auto& row : rows) {
+                ResultRow result;
+                result.orig    = orig;
+                result.cost    = row.cost;
+                result.cutoff  = row.cutOff;
+                result.geomWKB = row.geom.ToWKB();
+                sldb.SaveResultRow(std::move(result), resultTableName, NetXpertSolver::IsolinesSolver);
+            }
+        }
+            break;
+
+        case RESULT_DB_TYPE::ESRI_FileGDB:
+        {
+            #pragma omp critical
+            {
+            auto& fgdb = dynamic_cast<FGDBWriter&>(writer);
+            for (const auto& row : rows) {
+                auto mLine = row.geom.ToMultiLineString(*DBHELPER::GEO_FACTORY);
+                fgdb.SaveResultArc(orig, row.cost, row.cutOff, *mLine, resultTableName);
+            }
+            }
+        }
+            break;
+
+        default:
+            LOGGER::LogError("ProcessIsoTreeResultArcsMem(): result type " +
+                             std::to_string(NETXPERT_CNFG.ResultDBType) + " is not supported!");
+            break;
+    }
+}
+
+
+/**
+* Banded isolines: every reached arc is assigned to the bands (intervals between two cut offs) of the distances
+* along the arc; only arcs that cross a cut off are split --> the cost hardly grows with the count of cut offs.
+*/
+void
+ InternalNet::ProcessIsoBandResultArcsMem(const std::string& orig, const netxpert::data::DistLabels& labels,
+                                          const std::vector<double>& cutOffs,
+                                          const std::string& resultTableName, netxpert::io::DBWriter& writer,
+                                          SQLite::Statement& qry)
+{
+    using namespace std;
+    using namespace geos::geom;
+    using namespace netxpert::cnfg;
+
+    if (NETXPERT_CNFG.GeometryHandling != GEOMETRY_HANDLING::RealGeometry || cutOffs.empty())
+        return;
+
+    const cost_t infinity = std::numeric_limits<cost_t>::max();
+    vector<IsoTreeArc> treeArcs;
+    getIsoTreeArcs(labels, treeArcs);
+
+    //band k: cuts[k-1] < distance <= cuts[k]; the first band starts at the origin
+    vector<double> cuts(cutOffs);
+    std::sort(cuts.begin(), cuts.end());
+    cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+    const double maxCut = cuts.back();
+    auto bandOf = [&cuts](const double d) -> size_t {
+        return std::lower_bound(cuts.begin(), cuts.end(), d) - cuts.begin();
+    };
+    auto lowerCut = [&cuts](const size_t band) -> double {
+        return band == 0 ? 0 : cuts[band - 1];
+    };
+
+    vector<RouteGeometryBuilder> bands(cuts.size());
+    vector<double> buffer;
+    const double* xy;
+    uint32_t size;
+    bool reversed;
+
+    for (const auto& t : treeArcs) {
+        if (!getArcCoordinates(t.arc, buffer, xy, size, reversed))
+            continue;
+
+        //fraction along the arc --> fraction along the geometry
+        auto pos = [reversed](const double f) { return reversed ? 1 - f : f; };
+
+        const cost_t nearest = std::min(t.sourceDist, t.targetDist);
+        if (t.cost <= 0) {
+            if (nearest <= maxCut) {
+                bands[bandOf(nearest)].NewPart();
+                bands[bandOf(nearest)].Append(xy, size, reversed);
+            }
+            continue;
+        }
+
+        //fraction of the arc where the distances from both ends meet
+        double meet = 1;
+        if (t.targetDist < infinity)
+            meet = std::max(0.0, std::min(1.0, (t.targetDist - t.sourceDist + t.cost) / (2 * t.cost)));
+        const cost_t farthest = t.targetDist < infinity ? std::max(t.sourceDist + meet * t.cost,
+                                                                   t.targetDist + (1 - meet) * t.cost)
+                                                        : t.sourceDist + t.cost;
+
+        //complete arc within one band: no split
+        if (farthest <= maxCut && bandOf(nearest) == bandOf(farthest)) {
+            bands[bandOf(nearest)].NewPart();
+            bands[bandOf(nearest)].Append(xy, size, reversed);
+            continue;
+        }
+
+        //from the source up to the meeting point
+        for (size_t k = bandOf(t.sourceDist); k < cuts.size() && lowerCut(k) < t.sourceDist + meet * t.cost; k++) {
+            const double from = std::max(0.0, (lowerCut(k) - t.sourceDist) / t.cost);
+            const double to = std::min(meet, (cuts[k] - t.sourceDist) / t.cost);
+            if (to > from)
+                bands[k].AppendSection(xy, size, pos(from), pos(to));
+        }
+        if (t.targetDist == infinity)
+            continue;
+        //from the target back to the meeting point
+        for (size_t k = bandOf(t.targetDist); k < cuts.size() && lowerCut(k) < t.targetDist + (1 - meet) * t.cost; k++) {
+            const double from = std::max(0.0, (lowerCut(k) - t.targetDist) / t.cost);
+            const double to = std::min(1 - meet, (cuts[k] - t.targetDist) / t.cost);
+            if (to > from)
+                bands[k].AppendSection(xy, size, pos(1 - from), pos(1 - to));
+        }
+    }
+
+    switch (NETXPERT_CNFG.ResultDBType)
+    {
+        case RESULT_DB_TYPE::SpatiaLiteDB:
+        {
+            auto& sldb = dynamic_cast<SpatiaLiteWriter&>(writer);
+            for (size_t k = 0; k < bands.size(); k++) {
+                if (bands[k].LineCount() == 0)
+                    continue;
+                ResultRow result;
+                result.orig    = orig;
+                result.cost    = lowerCut(k);
+                result.cutoff  = cuts[k];
+                result.geomWKB = bands[k].ToWKB();
+                sldb.SaveResultRow(std::move(result), resultTableName, NetXpertSolver::IsolinesSolver);
+            }
+        }
+            break;
+
+        case RESULT_DB_TYPE::ESRI_FileGDB:
+        {
+            #pragma omp critical
+            {
+            auto& fgdb = dynamic_cast<FGDBWriter&>(writer);
+            for (size_t k = 0; k < bands.size(); k++) {
+                if (bands[k].LineCount() == 0)
+                    continue;
+                auto mLine = bands[k].ToMultiLineString(*DBHELPER::GEO_FACTORY);
+                fgdb.SaveResultArc(orig, lowerCut(k), cuts[k], *mLine, resultTableName);
+            }
+            }
+        }
+            break;
+
+        default:
+            LOGGER::LogError("ProcessIsoBandResultArcsMem(): result type " +
+                             std::to_string(NETXPERT_CNFG.ResultDBType) + " is not supported!");
+            break;
+    }
+}
+
+/**
+* Isoline polygons: alpha shape of the covered parts of the arcs per cut off. The cut offs are processed
+* in ascending order; the points of the completely covered arcs are kept for the next cut off and only
+* the arcs at the frontier are cut again.
+*/
+void
+ InternalNet::ProcessIsoPolygonResultsMem(const std::string& orig, const netxpert::data::DistLabels& labels,
+                                          const std::vector<double>& cutOffs,
+                                          const std::string& resultTableName, netxpert::io::DBWriter& writer,
+                                          SQLite::Statement& qry)
+{
+    using namespace std;
+    using namespace geos::geom;
+    using namespace netxpert::cnfg;
+
+    if (NETXPERT_CNFG.GeometryHandling != GEOMETRY_HANDLING::RealGeometry || cutOffs.empty())
+        return;
+
+    const cost_t infinity = std::numeric_limits<cost_t>::max();
+    vector<IsoTreeArc> treeArcs;
+    getIsoTreeArcs(labels, treeArcs);
+
+    //cost where the arc is reached first and where it is covered completely
+    auto reachDist = [](const IsoTreeArc& t) -> cost_t {
+        return std::min(t.sourceDist, t.targetDist);
+    };
+    auto fullDist = [infinity](const IsoTreeArc& t) -> cost_t {
+        if (t.targetDist == infinity)
+            return t.sourceDist + t.cost;
+        return std::min( std::min(t.sourceDist, t.targetDist) + t.cost,
+                         std::max((t.sourceDist + t.targetDist + t.cost) / 2, std::max(t.sourceDist, t.targetDist)) );
+    };
+    std::sort(treeArcs.begin(), treeArcs.end(),
+              [&reachDist](const IsoTreeArc& a, const IsoTreeArc& b) { return reachDist(a) < reachDist(b); });
+
+    vector<double> cuts(cutOffs);
+    std::sort(cuts.begin(), cuts.end());
+
+    vector<double> buffer;
+    const double* xy;
+    uint32_t size;
+    bool reversed;
+
+    //alpha: configured or twice the mean length of the reached arcs
+    double alpha = NETXPERT_CNFG.IsolinesPolygonAlpha;
+    if (alpha <= 0) {
+        double length = 0;
+        size_t count = 0;
+        for (const auto& t : treeArcs) {
+            if (reachDist(t) > cuts.back())
+                break;
+            if (!getArcCoordinates(t.arc, buffer, xy, size, reversed))
+                continue;
+            for (uint32_t i = 1; i < size; i++)
+                length += std::sqrt( (xy[2 * i] - xy[2 * i - 2]) * (xy[2 * i] - xy[2 * i - 2]) +
+                                     (xy[2 * i + 1] - xy[2 * i - 1]) * (xy[2 * i + 1] - xy[2 * i - 1]) );
+            count++;
+        }
+        if (count > 0)
+            alpha = 2 * length / count;
+    }
+    if (alpha <= 0)
+        return;
+
+    struct IsoPolygonRow
+    {
+        double cutOff;
+        std::unique_ptr<MultiPolygon> geom;
+    };
+    vector<IsoPolygonRow> rows;
+    //own factory: the reference counting of the shared factory is not thread safe
+    GeometryFactory::unique_ptr factory = GeometryFactory::create();
+    IsoPolygonBuilder polygon;
+    polygon.SetAlpha(alpha);
+    RouteGeometryBuilder section;
+    //reached arcs that are not covered completely yet
+    vector<IsoTreeArc> frontier;
+    size_t nextArc = 0;
+    size_t keptPoints = 0;
+
+    for (const double cutOff : cuts) {
+        polygon.Resize(keptPoints);
+        while (nextArc < treeArcs.size() && reachDist(treeArcs[nextArc]) <= cutOff)
+            frontier.push_back(treeArcs[nextArc++]);
+
+        //completely covered arcs: points are kept for the next cut offs
+        size_t open = 0;
+        for (size_t i = 0; i < frontier.size(); i++) {
+            if (fullDist(frontier[i]) > cutOff) {
+                frontier[open++] = frontier[i];
+                continue;
+            }
+            if (getArcCoordinates(frontier[i].arc, buffer, xy, size, reversed))
+                polygon.AddLine(xy, size);
+        }
+        frontier.resize(open);
+        keptPoints = polygon.Size();
+
+        //arcs at the frontier: covered parts up to the interpolated position of the cut off
+        for (const auto& t : frontier) {
+            if (!getArcCoordinates(t.arc, buffer, xy, size, reversed))
+                continue;
+
+            //fraction along the arc --> fraction along the geometry
+            auto pos = [reversed](const double f) { return reversed ? 1 - f : f; };
+
+            const double fromSource = getCoveredFraction(t.sourceDist, t.cost, cutOff);
+            const double fromTarget = getCoveredFraction(t.targetDist, t.cost, cutOff);
+            if (fromSource > 0) {
+                section.Clear();
+                section.AppendSection(xy, size, pos(0), pos(fromSource));
+                polygon.AddLine(section.GetCoordinates().data(), static_cast<uint32_t>(section.Size()));
+            }
+            if (fromTarget > 0) {
+                section.Clear();
+                section.AppendSection(xy, size, pos(1), pos(1 - fromTarget));
+                polygon.AddLine(section.GetCoordinates().data(), static_cast<uint32_t>(section.Size()));
+            }
+        }
+
+        auto geom = polygon.ToMultiPolygon(*factory);
+        if (!geom->isEmpty())
+            rows.push_back( IsoPolygonRow {cutOff, std::move(geom)} );
+    }
+
+    switch (NETXPERT_CNFG.ResultDBType)
+    {
+        case RESULT_DB_TYPE::SpatiaLiteDB:
+        {
+            auto& sldb = dynamic_cast<SpatiaLiteWriter&>(writer);
+            for (const auto& row : rows) {
+                ResultRow result;
+                result.orig    = orig;
+                result.cost    = row.cutOff;
+                result.cutoff  = row.cutOff;
+                result.geomWKB = toWKB(*row.geom);
+                sldb.SaveResultRow(std::move(result), resultTableName, NetXpertSolver::IsolinesPolygonSolver);
+            }
+        }
+            break;
+
+        case RESULT_DB_TYPE::ESRI_FileGDB:
+        {
+            #pragma omp critical
+            {
+            auto& fgdb = dynamic_cast<FGDBWriter&>(writer);
+            for (const auto& row : rows)
+                fgdb.SaveResultPolygon(orig, row.cutOff, row.cutOff, *row.geom, resultTableName);
+            }
+        }
+            break;
+
+        default:
+            LOGGER::LogError("ProcessIsoPolygonResultsMem(): result type " +
+                             std::to_string(NETXPERT_CNFG.ResultDBType) + " is not supported!");
+            break;
+    }
+}
+
+
 
 void
  InternalNet::ProcessMCFResultArcsMem(const std::string& orig, const std::string& dest, const netxpert::data::cost_t cost,
                                       const netxpert::data::capacity_t capacity, const netxpert::data::flow_t flow,
-                                      const std::string& arcIDs, std::vector<netxpert::data::arc_t>& routeNodeArcRep,
+                                      const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
                                       const std::string& resultTableName, netxpert::io::DBWriter& writer,
                                       SQLite::Statement& qry //can be null in case of ESRI FileGDB
                                   )
@@ -1502,15 +2449,13 @@ void
     using namespace netxpert::cnfg;
     using namespace geos::geom;
 
-    std::vector<geos::geom::Geometry*> routeParts;
     //for straight lines or no geometry
     std::unique_ptr<MultiLineString> mLine (DBHELPER::GEO_FACTORY->createMultiLineString());
 
     switch (NETXPERT_CNFG.GeometryHandling)
     {
         case GEOMETRY_HANDLING::RealGeometry: {
-          routeParts = addRoutePartGeoms(routeNodeArcRep);
-          saveMCFResultsMem(orig, dest, cost, capacity, flow, arcIDs, routeParts, resultTableName, writer, qry);
+          saveMCFResultsMem(orig, dest, cost, capacity, flow, routeNodeArcRep, resultTableName, writer, qry);
         }
         break;
 
@@ -1522,11 +2467,15 @@ void
 
           switch (NETXPERT_CNFG.ResultDBType) {
             case RESULT_DB_TYPE::SpatiaLiteDB: {
-              #pragma omp critical
-              {
+              ResultRow row;
+              row.orig     = orig;
+              row.dest     = dest;
+              row.cost     = cost;
+              row.capacity = capacity;
+              row.flow     = flow;
+              row.geomWKB  = toWKB(*mLine);
               auto& sldb = dynamic_cast<SpatiaLiteWriter&>(writer);
-              sldb.SaveResultArc(orig, dest, cost, capacity, flow, *mLine, resultTableName, qry);
-              }
+              sldb.SaveResultRow(std::move(row), resultTableName, NetXpertSolver::MinCostFlowSolver);
             }
             break;
             case RESULT_DB_TYPE::ESRI_FileGDB: {
@@ -1544,11 +2493,15 @@ void
         case GEOMETRY_HANDLING::NoGeometry: {
           switch (NETXPERT_CNFG.ResultDBType) {
             case RESULT_DB_TYPE::SpatiaLiteDB: {
-              #pragma omp critical
-              {
+              ResultRow row;
+              row.orig     = orig;
+              row.dest     = dest;
+              row.cost     = cost;
+              row.capacity = capacity;
+              row.flow     = flow;
+              row.geomWKB  = toWKB(*mLine);
               auto& sldb = dynamic_cast<SpatiaLiteWriter&>(writer);
-              sldb.SaveResultArc(orig, dest, cost, capacity, flow, *mLine, resultTableName, qry);
-              }
+              sldb.SaveResultRow(std::move(row), resultTableName, NetXpertSolver::MinCostFlowSolver);
             }
             break;
             case RESULT_DB_TYPE::ESRI_FileGDB: {
@@ -1568,22 +2521,19 @@ void
 void
  InternalNet::ProcessMCFResultArcsMemS(const std::string& orig, const std::string& dest, const netxpert::data::cost_t cost,
                                       const netxpert::data::capacity_t capacity, const netxpert::data::flow_t flow,
-                                      const std::string& arcIDs, std::vector<netxpert::data::arc_t>& routeNodeArcRep,
+                                      const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
                                       std::ostringstream& output)
 {
   using namespace netxpert::cnfg;
   using namespace geos::geom;
 
-  std::vector<geos::geom::Geometry*> routeParts;
   //for straight lines or no geometry
   std::unique_ptr<MultiLineString> mLine (DBHELPER::GEO_FACTORY->createMultiLineString());
 
   switch (NETXPERT_CNFG.GeometryHandling)
   {
     case GEOMETRY_HANDLING::RealGeometry: {
-      routeParts = addRoutePartGeoms(routeNodeArcRep);
-
-      saveMCFResultsMemS(orig, dest, cost, capacity, flow, arcIDs, routeParts, output);
+      saveMCFResultsMemS(orig, dest, cost, capacity, flow, routeNodeArcRep, output);
     }
     break;
 
@@ -1635,6 +2585,32 @@ void
   }
 }
 
+void
+ InternalNet::LoadArcGeometries(const std::string& arcsTableName, const std::string& geomColumnName,
+                                const ColumnMap& cmap) {
+
+    if (this->arcGeomStore)
+        return;
+
+    //same source as the spatial index of the snapping (capacity if there is a capacity column)
+    const bool withCapacity = !cmap.capColName.empty();
+    if (this->arcIndex && this->arcIndexKey == arcSourceKey(arcsTableName, geomColumnName, cmap, withCapacity))
+        buildArcGeomStore(this->arcIndex->Arcs());
+    else if (!this->arcIndex)
+        buildArcIndex(arcsTableName, geomColumnName, cmap, withCapacity, true);
+    else
+        buildArcGeomStore(this->dbHelper->LoadArcsWithGeomFromDB(arcsTableName, geomColumnName, cmap, false));
+}
+
+std::vector<netxpert::data::ArcGeometrySpan>
+ InternalNet::getOrigArcSpans(const std::vector<netxpert::data::arc_t>& routeNodeArcRep) {
+
+    if (!this->arcGeomStore)
+        return std::vector<ArcGeometrySpan>();
+
+    return this->arcGeomStore->GetSpans(routeNodeArcRep);
+}
+
 // Loops through all new arcs and searches in the spt path for them for getting start or end route parts
 std::vector<geos::geom::Geometry*>
  InternalNet::addRoutePartGeoms(const std::vector<netxpert::data::arc_t>& routeNodeArcRep) {
@@ -1701,120 +2677,132 @@ std::vector<geos::geom::Geometry*>
 }
 
 
+void
+ InternalNet::getIsoTreeArcs(const netxpert::data::DistLabels& labels, std::vector<netxpert::data::IsoTreeArc>& treeArcs)
+{
+    using namespace std;
+
+    const cost_t infinity = std::numeric_limits<cost_t>::max();
+    unordered_map<int, cost_t> dist;
+    dist.reserve(labels.size());
+    for (const auto& l : labels)
+        dist[graph_t::id(l.first)] = l.second;
+
+    //arcs that leave a reached node; both directions of an undirected arc only once
+    treeArcs.clear();
+    filtered_graph_t sg (*this->g, *this->arcFilterMap);
+    for (const auto& l : labels) {
+        for (filtered_graph_t::OutArcIt a(sg, l.first); a != lemon::INVALID; ++a) {
+            const node_t target = sg.target(a);
+            cost_t targetDist = infinity;
+            auto distIt = dist.find(graph_t::id(target));
+            if (distIt != dist.end() && lemon::findArc(sg, target, l.first) != lemon::INVALID) {
+                //reached from both ends: taken from the node with the lower ID
+                if (graph_t::id(target) < graph_t::id(l.first))
+                    continue;
+                targetDist = distIt->second;
+            }
+            treeArcs.push_back( IsoTreeArc {a, (*this->costMap)[a], l.second, targetDist} );
+        }
+    }
+}
+
+double
+ InternalNet::getCoveredFraction(const netxpert::data::cost_t dist, const netxpert::data::cost_t cost,
+                                 const double cutOff)
+{
+    if (dist > cutOff)
+        return 0;
+    if (cost <= 0)
+        return 1;
+    return std::min(1.0, (cutOff - dist) / cost);
+}
+
+bool
+ InternalNet::getArcCoordinates(const netxpert::data::arc_t& arc, std::vector<double>& buffer,
+                                const double*& xy, uint32_t& size, bool& reversed) {
+
+    using namespace geos::geom;
+
+    ArcGeometrySpan span;
+    if (this->arcGeomStore && this->arcGeomStore->GetSpan(arc, span)) {
+        xy = span.xy;
+        size = span.size;
+        reversed = this->arcGeomStore->IsReversed(arc);
+        return true;
+    }
+
+    auto newArcIt = this->newArcsMap.find(arc);
+    if (newArcIt == this->newArcsMap.end() || !newArcIt->second.arcGeom)
+        return false;
+
+    const CoordinateSequence* coords = newArcIt->second.arcGeom->getCoordinatesRO();
+    buffer.clear();
+    for (size_t i = 0; i < coords->getSize(); i++) {
+        buffer.push_back(coords->getAt(i).x);
+        buffer.push_back(coords->getAt(i).y);
+    }
+    xy = buffer.data();
+    size = static_cast<uint32_t>(coords->getSize());
+    reversed = newArcIt->second.reversed;
+
+    return true;
+}
+
+void
+ InternalNet::buildRouteGeometry(const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
+                                 netxpert::data::RouteGeometryBuilder& route) {
+
+    route.Clear();
+
+    //original arcs from the geometry store, splitted start or end arcs from the new arcs;
+    //the path runs from source to target of every arc
+    std::vector<double> buffer;
+    const double* xy;
+    uint32_t size;
+    bool reversed;
+    for (const auto& arc : routeNodeArcRep) {
+        if (getArcCoordinates(arc, buffer, xy, size, reversed))
+            route.Append(xy, size, reversed);
+    }
+}
+
 void
  InternalNet::saveSPTResultsMem(const std::string orig, const std::string dest, const netxpert::data::cost_t cost,
-                                const std::string& arcIDs, std::vector<geos::geom::Geometry*> routeParts,
+                                const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
                                 const std::string& resultTableName, netxpert::io::DBWriter& writer,
                                 SQLite::Statement& qry ) {
-   //LOGGER::LogDebug("# "+ to_string(omp_get_thread_num()) +" : saveResults() - enter");
 
     using namespace geos::geom;
-    using namespace geos::operation::linemerge;
     using namespace netxpert::cnfg;
     using namespace netxpert::io;
-    using namespace netxpert::utils;
 
-//    LOGGER::LogDebug("Entering saveSPTResultsMem()..");
+    RouteGeometryBuilder route;
+    buildRouteGeometry(routeNodeArcRep, route);
 
     switch (NETXPERT_CNFG.ResultDBType) {
         case RESULT_DB_TYPE::SpatiaLiteDB: {
-            //put all geometries in routeParts into one (perhaps disconnected) Multilinestring
-            //MultilineString could also contain only one Linestring
-            std::unique_ptr<MultiLineString> mLine ( DBHELPER::GEO_FACTORY->createMultiLineString( routeParts ));
-            std::unique_ptr<MultiLineString> mLineDB;
-            //LOGGER::LogDebug("# "+ to_string(omp_get_thread_num()) +" : saveResults() - load from DB");
-
-            //load geometry from db
-            //TODO: 0,5 bis 1 sec per load from db
-            //Stopwatch<> sw;
-            //sw.start();
-            if (arcIDs.size() > 0) {
-                mLineDB = std::move( DBHELPER::GetArcGeometriesFromMem(arcIDs) );
-            }
-            //sw.stop();
-            //LOGGER::LogDebug("DBHELPER::TEST_GetArcGeometriesFromRAM() took " + to_string(sw.elapsed()/1000)+" ms");
-            //LOGGER::LogDebug("# "+ to_string(omp_get_thread_num()) +" : saveResults() - merge");
-            //merge routeParts with original arcs
-            //sw.start();
-            LineMerger lm;
-            if (! (mLine->isEmpty()) )
-                lm.add(mLine.get());
-
-            if (mLineDB)
-                lm.add(mLineDB.get());
-
-            std::unique_ptr< std::vector<LineString *> > mls ( lm.getMergedLineStrings() );
-            std::vector<Geometry*> mls2;
-            for (auto& l : *mls) {
-                //if (!l->isEmpty())
-                mls2.push_back(dynamic_cast<Geometry*>(l));
-            }
-
-            std::unique_ptr<MultiLineString> route (DBHELPER::GEO_FACTORY->createMultiLineString( mls2 ) );
-
-            //sw.stop();
-            //LOGGER::LogDebug("Merging Geometry with Geos took " + to_string(sw.elapsed())+" mcs");
-            //LOGGER::LogDebug("# "+ to_string(omp_get_thread_num()) +" : saveResults() - save to DB");
-            //sw.start();
-            #pragma omp critical
-            {
+            ResultRow row;
+            row.orig    = orig;
+            row.dest    = dest;
+            row.cost    = cost;
+            row.geomWKB = route.ToWKB();
             auto& sldb = dynamic_cast<SpatiaLiteWriter&>(writer);
-            //save merged route geometry to db
-            sldb.SaveResultArc(orig, dest, cost, *route, resultTableName, qry);
-            //sw.stop();
-            //LOGGER::LogDebug("SaveResultArc() took " + to_string(sw.elapsed())+" mcs");
-            }
+            //save route geometry to db
+            sldb.SaveResultRow(std::move(row), resultTableName, NetXpertSolver::ShortestPathTreeSolver);
         }
         break;
 
         case RESULT_DB_TYPE::ESRI_FileGDB: {
-            /*
-                Get all geometries from Spatialite DB (per arcIDs) of one route and merge them with
-                all the segments of routeParts;
-                Save the geometry with SaveSolveQueryToDB()
-            */
-            std::unique_ptr<MultiLineString> mLine ( DBHELPER::GEO_FACTORY->createMultiLineString( routeParts ));
-            std::unique_ptr<MultiLineString> mLineDB;
-            //Stopwatch<> sw;
-            //sw.start();
-            if (arcIDs.size() > 0) {
-                mLineDB = std::move( DBHELPER::GetArcGeometriesFromMem(arcIDs) );
-            }
-            //sw.stop();
-            //LOGGER::LogDebug("DBHELPER::TEST_GetArcGeometriesFromRAM() took " + to_string(sw.elapsed()/1000)+" ms");
-
-            //merge
-            //sw.start();
-            LineMerger lm;
-            if (! (mLine->isEmpty()) )
-                lm.add(mLine.get());
-
-            if (mLineDB)
-                lm.add(mLineDB.get());
-
-            std::unique_ptr< std::vector<LineString *> > mls ( lm.getMergedLineStrings() );
-            std::vector<Geometry*> mls2;
-            for (auto& l : *mls) {
-                //if (!l->isEmpty())
-                mls2.push_back(dynamic_cast<Geometry*>(l));
-            }
-
-            std::unique_ptr<MultiLineString> route (DBHELPER::GEO_FACTORY->createMultiLineString( mls2 ) );
-            //sw.stop();
-            //LOGGER::LogDebug("Merging Geometry with Geos took " + to_string(sw.elapsed())+" mcs");
+            std::unique_ptr<MultiLineString> mLine = route.ToMultiLineString(*DBHELPER::GEO_FACTORY);
             auto& fgdb = dynamic_cast<FGDBWriter&>(writer);
-            //LOGGER::LogDebug("# "+ to_string(omp_get_thread_num()) +" : saveResults() - save to DB");
             #pragma omp critical
             {
-            //sw.start();
-            fgdb.SaveResultArc(orig, dest, cost, *route, resultTableName);
-            //sw.stop();
-            //LOGGER::LogDebug("SaveResultArc() took " + to_string(sw.elapsed())+" mcs");
+            fgdb.SaveResultArc(orig, dest, cost, *mLine, resultTableName);
             }
         }
             break;
     }
-    //cout << "nexpert::Network - saved" <<endl;
 }
 
 std::string
@@ -1840,54 +2828,33 @@ std::string
 
 void
  InternalNet::saveSPTResultsMemS(const std::string orig, const std::string dest, const netxpert::data::cost_t cost,
-                                const std::string& arcIDs, std::vector<geos::geom::Geometry*> routeParts,
+                                const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
                                 std::ostringstream& outStream) {
 
-    using namespace geos::geom;
-    using namespace geos::operation::linemerge;
     using namespace netxpert::cnfg;
-    using namespace netxpert::io;
     using namespace netxpert::utils;
 
     #if DEBUG
     LOGGER::LogDebug("entering saveSPTResultsMemS()..");
     #endif
 
-    //put all geometries in routeParts into one (perhaps disconnected) Multilinestring
-    //MultilineString could also contain only one Linestring
-    std::unique_ptr<MultiLineString> mLine ( DBHELPER::GEO_FACTORY->createMultiLineString( routeParts ));
-    std::unique_ptr<MultiLineString> mLineDB;
-    //LOGGER::LogDebug("# "+ to_string(omp_get_thread_num()) +" : saveResults() - load from DB");
-
-    //load geometry from db
-    //TODO: 0,5 bis 1 sec per load from db
-    //Stopwatch<> sw;
-    //sw.start();
-    if (arcIDs.size() > 0) {
-        mLineDB = std::move( DBHELPER::GetArcGeometriesFromMem(arcIDs) );
-    }
-    //sw.stop();
-    //LOGGER::LogDebug("DBHELPER::TEST_GetArcGeometriesFromRAM() took " + to_string(sw.elapsed()/1000)+" ms");
-    //LOGGER::LogDebug("# "+ to_string(omp_get_thread_num()) +" : saveResults() - merge");
-    //merge routeParts with original arcs
-    //sw.start();
-    LineMerger lm;
-    if (! (mLine->isEmpty()) )
-        lm.add(mLine.get());
-
-    if (mLineDB)
-        lm.add(mLineDB.get());
-
-    std::unique_ptr< std::vector<LineString *> > mls ( lm.getMergedLineStrings() );
-    std::vector<Geometry*> mls2;
-    for (auto& l : *mls) {
-        //if (!l->isEmpty())
-        mls2.push_back(dynamic_cast<Geometry*>(l));
+    RouteGeometryBuilder route;
+    buildRouteGeometry(routeNodeArcRep, route);
+
+    //JSON coordinate list or encoded polyline as JSON string
+    std::string coordStr;
+    if (NETXPERT_CNFG.ResultDBType == RESULT_DB_TYPE::GooglePolyLine) {
+        coordStr = "\"";
+        for (const char c : route.ToPolyline()) {
+            //backslash is the only character of the encoding that must be escaped
+            if (c == '\\')
+                coordStr += '\\';
+            coordStr += c;
+        }
+        coordStr += "\"";
     }
-
-    std::unique_ptr<MultiLineString> route (DBHELPER::GEO_FACTORY->createMultiLineString( mls2 ) );
-
-    std::string coordStr = convertRouteToCoordList(route);
+    else
+        coordStr = route.ToJSON();
 
     /**
     {"orig" : orig, "dest" : dest, "cost" : cost, "route" : coordinateList }
@@ -1897,13 +2864,9 @@ void
         << orig << "\", \"dest\" : \""<< dest << "\", \"cost\" : " << cost
         << ", \"route\" : " << coordStr << "} " << std::endl;
 
-    //sw.stop();
-    //LOGGER::LogDebug("Merging Geometry with Geos took " + to_string(sw.elapsed())+" mcs");
-    //LOGGER::LogDebug("# "+ to_string(omp_get_thread_num()) +" : saveResults() - save to DB");
-    //sw.start();
     #pragma omp critical
     {
-    //save merged route geometry to stream
+    //save route geometry to stream
     outStream << row.str() << std::endl;
     }
 }
@@ -1911,162 +2874,71 @@ void
 //Isolines
 void
  InternalNet::saveIsoResultsMem(const std::string orig, const netxpert::data::cost_t cost,
-                               const std::string& arcIDs, std::vector<geos::geom::Geometry*> routeParts,
+                               const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
                                const std::string& resultTableName, netxpert::io::DBWriter& writer,
                                SQLite::Statement& qry,
                                const std::unordered_map<ExtNodeID, std::vector<double> >& cutOffs )
 {
-   //LOGGER::LogDebug("# "+ to_string(omp_get_thread_num()) +" : saveResults() - enter");
     using namespace std;
     using namespace geos::geom;
-    using namespace geos::operation::linemerge;
     using namespace netxpert::cnfg;
     using namespace netxpert::io;
-    using namespace netxpert::utils;
-
-    switch (NETXPERT_CNFG.ResultDBType)
-    {
-    case RESULT_DB_TYPE::SpatiaLiteDB:
-    {
-        //put all geometries in routeParts into one (perhaps disconnected) Multilinestring
-        //MultilineString could also contain only one Linestring
-        unique_ptr<MultiLineString> mLine ( DBHELPER::GEO_FACTORY->createMultiLineString( routeParts ));
-
-        unique_ptr<MultiLineString> mLineDB;
-        //LOGGER::LogDebug("# "+ to_string(omp_get_thread_num()) +" : saveResults() - load from DB");
-
-        //Stopwatch<> sw;
-        //sw.start();
-
-        if (arcIDs.size() > 0)
-            mLineDB = move( DBHELPER::GetArcGeometriesFromMem(arcIDs) );
-
-        //sw.stop();
-        //LOGGER::LogDebug("DBHELPER::TEST_GetArcGeometriesFromRAM() took " + to_string(sw.elapsed()/1000)+" ms");
-        //LOGGER::LogDebug("# "+ to_string(omp_get_thread_num()) +" : saveResults() - merge");
-        //merge routeParts with original arcs
-        //sw.start();
-
-        LineMerger lm;
-        if (mLineDB)
-            lm.add(mLineDB.get());
-
-        if (! mLine->isEmpty() )
-            lm.add(mLine.get());
-
-        std::unique_ptr< vector<LineString *> > mls ( lm.getMergedLineStrings() );
-        vector<Geometry*> mls2;
-        for (auto& l : *mls)
-        {
-            //if (!l->isEmpty())
-            mls2.push_back(dynamic_cast<Geometry*>(l));
-        }
-
-        unique_ptr<MultiLineString> route (DBHELPER::GEO_FACTORY->createMultiLineString( mls2 ) );
-
-        // for each cut off value, if matched the origin key create a route cut down to the value
-        std::vector<double>::const_iterator cutOffIt;
-        #pragma omp critical
-        {
-        auto& sldb = dynamic_cast<SpatiaLiteWriter&>(writer);
-        std::vector<double> cutOffValues;
 
-        if (cutOffs.count(orig) > 0)
-            cutOffValues = cutOffs.at(orig);
-
-        for (cutOffIt = cutOffValues.begin(); cutOffIt != cutOffValues.end(); cutOffIt++)
-        {
-            double cutOff = *cutOffIt;
-            auto startCoord = this->GetStartOrEndNodeGeometry(orig);
-            //std::cout << startCoord.toString() << std::endl;
-            double relCost = cost;
-            //relCost as reference
-            auto cuttedLine = cutLine(startCoord, *route, cutOff, relCost);
+    RouteGeometryBuilder routeBuilder;
+    buildRouteGeometry(routeNodeArcRep, routeBuilder);
+    //cutLine() works on GEOS geometries
+    unique_ptr<MultiLineString> route = routeBuilder.ToMultiLineString(*DBHELPER::GEO_FACTORY);
 
-            //LOGGER::LogDebug("# "+ to_string(omp_get_thread_num()) +" : saveResults() - save to DB");
-            //sw.start();
-            //save merged route geometry to db
-            sldb.SaveResultArc(orig, relCost, cutOff, *cuttedLine, resultTableName, qry);
-            //sw.stop();
-            //LOGGER::LogDebug("SaveResultArc() took " + to_string(sw.elapsed())+" mcs");
-        }
-        }
-    }
-        break;
+    std::vector<double> cutOffValues;
+    if (cutOffs.count(orig) > 0)
+        cutOffValues = cutOffs.at(orig);
 
-    case RESULT_DB_TYPE::ESRI_FileGDB:
+    // for each cut off value, if matched the origin key create a route cut down to the value
+    #pragma omp critical
     {
-        /*
-            Get all geometries from Spatialite DB (per arcIDs) of one route and merge them with
-            all the segments of routeParts;
-            Save the geometry with SaveSolveQueryToDB()
-        */
-        unique_ptr<MultiLineString> mLine ( DBHELPER::GEO_FACTORY->createMultiLineString( routeParts ));
-
-        unique_ptr<MultiLineString> mLineDB;
-
-        if (arcIDs.size() > 0)
-            mLineDB = move( DBHELPER::GetArcGeometriesFromMem(arcIDs) );
-
-        LineMerger lm;
-        if (mLineDB)
-            lm.add(mLineDB.get());
-
-        if (! mLine->isEmpty() )
-            lm.add(mLine.get());
+    for (const double cutOff : cutOffValues)
+    {
+        auto startCoord = this->GetStartOrEndNodeGeometry(orig);
+        double relCost = cost;
+        //relCost as reference
+        auto cuttedLine = cutLine(startCoord, *route, cutOff, relCost);
 
-        std::unique_ptr< vector<LineString *> > mls ( lm.getMergedLineStrings() );
-        vector<Geometry*> mls2;
-        for (auto& l : *mls)
+        switch (NETXPERT_CNFG.ResultDBType)
         {
-            //if (!l->isEmpty())
-            mls2.push_back(dynamic_cast<Geometry*>(l));
-        }
-
-        unique_ptr<MultiLineString> route (DBHELPER::GEO_FACTORY->createMultiLineString( mls2 ) );
-
-        // for each cut off value, if matched the origin key create a route cut down to the value
-        std::vector<double>::const_iterator cutOffIt;
-        #pragma omp critical
+        case RESULT_DB_TYPE::SpatiaLiteDB:
         {
-        auto& fgdb = dynamic_cast<FGDBWriter&>(writer);
-        std::vector<double> cutOffValues;
-
-        if (cutOffs.count(orig) > 0)
-            cutOffValues = cutOffs.at(orig);
+            ResultRow row;
+            row.orig    = orig;
+            row.cost    = relCost;
+            row.cutoff  = cutOff;
+            row.geomWKB = toWKB(*cuttedLine);
+            auto& sldb = dynamic_cast<SpatiaLiteWriter&>(writer);
+            sldb.SaveResultRow(std::move(row), resultTableName, NetXpertSolver::IsolinesSolver);
+        }
+            break;
 
-        for (cutOffIt = cutOffValues.begin(); cutOffIt != cutOffValues.end(); cutOffIt++)
+        case RESULT_DB_TYPE::ESRI_FileGDB:
         {
-            double cutOff = *cutOffIt;
-            auto startCoord = this->GetStartOrEndNodeGeometry(orig);
-            //std::cout << startCoord.toString() << std::endl;
-            double relCost = cost;
-            //relCost as reference
-            auto cuttedLine = cutLine(startCoord, *route, cutOff, relCost);
-            fgdb.SaveResultArc(orig, relCost, cutOff,
-                                    *cuttedLine, resultTableName);
-
+            auto& fgdb = dynamic_cast<FGDBWriter&>(writer);
+            fgdb.SaveResultArc(orig, relCost, cutOff, *cuttedLine, resultTableName);
         }
+            break;
         }
     }
-        break;
     }
-
 }
 
 //MCF
 void InternalNet::saveMCFResultsMem(const std::string orig, const std::string dest, const netxpert::data::cost_t cost,
                                  const netxpert::data::capacity_t capacity, const netxpert::data::flow_t flow,
-                                 const std::string& arcIDs, std::vector<geos::geom::Geometry*> routeParts,
+                                 const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
                                  const std::string& resultTableName, netxpert::io::DBWriter& writer,
                                  SQLite::Statement& qry ) {
 
     using namespace std;
     using namespace geos::geom;
-    using namespace geos::operation::linemerge;
     using namespace netxpert::cnfg;
     using namespace netxpert::io;
-    using namespace netxpert::utils;
 
     bool isResultDBequalNetXpertDB = false;
     if (NETXPERT_CNFG.ResultDBPath == NETXPERT_CNFG.NetXDBPath)
@@ -2084,8 +2956,16 @@ void InternalNet::saveMCFResultsMem(const std::string orig, const std::string de
                 auto& sldb = dynamic_cast<SpatiaLiteWriter&>(writer);
                 //put all geometries in routeParts into one (perhaps disconnected) Multilinestring
                 //MultilineString could also contain only one Linestring
+                std::vector<geos::geom::Geometry*> routeParts = addRoutePartGeoms(routeNodeArcRep);
                 unique_ptr<MultiLineString> mLine ( DBHELPER::GEO_FACTORY->createMultiLineString( routeParts ));
 
+                //the original arcs are merged in the db
+                string arcIDs = "";
+                for (const auto& span : getOrigArcSpans(routeNodeArcRep))
+                    arcIDs += this->arcGeomStore->GetExtArcID(span) + ",";
+                if (arcIDs.size() > 0)
+                    arcIDs.pop_back(); //trim last comma
+
                 #pragma omp critical
                 {
                 sldb.MergeAndSaveResultArcs(orig, dest, cost, capacity, flow, NETXPERT_CNFG.ArcsGeomColumnName,
@@ -2095,170 +2975,51 @@ void InternalNet::saveMCFResultsMem(const std::string orig, const std::string de
             }
             else
             {
-                //put all geometries in routeParts into one (perhaps disconnected) Multilinestring
-                //MultilineString could also contain only one Linestring
-                unique_ptr<MultiLineString> mLine ( DBHELPER::GEO_FACTORY->createMultiLineString( routeParts ));
-
-                unique_ptr<MultiLineString> mLineDB;
-                //LOGGER::LogDebug("# "+ to_string(omp_get_thread_num()) +" : saveResults() - load from DB");
-
-                //load geometry from db
-                //TODO: 0,5 bis 1 sec per load from db
-                //Stopwatch<> sw;
-                //sw.start();
-
-//                LOGGER::LogDebug("ArcIDS: "+arcIDs);
-
-                if (arcIDs.size() > 0)
-                    mLineDB = move( DBHELPER::GetArcGeometriesFromMem(arcIDs) );
-                //sw.stop();
-                //LOGGER::LogDebug("DBHELPER::TEST_GetArcGeometriesFromRAM() took " + to_string(sw.elapsed()/1000)+" ms");
-                //LOGGER::LogDebug("# "+ to_string(omp_get_thread_num()) +" : saveResults() - merge");
-                //merge routeParts with original arcs
-                //sw.start();
-                LineMerger lm;
-
-                if (! (mLine->isEmpty()) )
-                    lm.add(mLine.get());
-
-                if (mLineDB)
-                    lm.add(mLineDB.get());
-
-                std::unique_ptr< vector<LineString *> > mls ( lm.getMergedLineStrings() );
-                vector<Geometry*> mls2;
-                for (auto& l : *mls)
-                {
-                    //if (!l->isEmpty())
-                    mls2.push_back(dynamic_cast<Geometry*>(l));
-                }
-
-                unique_ptr<MultiLineString> route (DBHELPER::GEO_FACTORY->createMultiLineString( mls2 ) );
-
-                //sw.stop();
-                //LOGGER::LogDebug("Merging Geometry with Geos took " + to_string(sw.elapsed())+" mcs");
-
-                //LOGGER::LogDebug("# "+ to_string(omp_get_thread_num()) +" : saveResults() - save to DB");
-
-                //sw.start();
-                #pragma omp critical
-                {
+                RouteGeometryBuilder route;
+                buildRouteGeometry(routeNodeArcRep, route);
+                ResultRow row;
+                row.orig     = orig;
+                row.dest     = dest;
+                row.cost     = cost;
+                row.capacity = capacity;
+                row.flow     = flow;
+                row.geomWKB  = route.ToWKB();
                 auto& sldb = dynamic_cast<SpatiaLiteWriter&>(writer);
-                //save merged route geometry to db
-
-                sldb.SaveResultArc(orig, dest, cost, capacity, flow, *route, resultTableName, qry);
-                //sw.stop();
-                //LOGGER::LogDebug("SaveResultArc() took " + to_string(sw.elapsed())+" mcs");
-                }
+                //save route geometry to db
+                sldb.SaveResultRow(std::move(row), resultTableName, NetXpertSolver::MinCostFlowSolver);
             }
         }
             break;
 
         case RESULT_DB_TYPE::ESRI_FileGDB:
         {
-            /*
-                Get all geometries from Spatialite DB (per arcIDs) of one route and merge them with
-                all the segments of routeParts;
-                Save the geometry with SaveSolveQueryToDB()
-            */
-            unique_ptr<MultiLineString> mLine ( DBHELPER::GEO_FACTORY->createMultiLineString( routeParts ));
-
-            unique_ptr<MultiLineString> mLineDB;
-            //Stopwatch<> sw;
-            //sw.start();
-            if (arcIDs.size() > 0)
-                mLineDB = move( DBHELPER::GetArcGeometriesFromMem(arcIDs) );
-            //sw.stop();
-            //LOGGER::LogDebug("DBHELPER::TEST_GetArcGeometriesFromRAM() took " + to_string(sw.elapsed()/1000)+" ms");
-
-            //merge
-            //sw.start();
-            LineMerger lm;
-            if (! (mLine->isEmpty()) )
-                lm.add(mLine.get());
-
-            if (mLineDB)
-                lm.add(mLineDB.get());
-
-            std::unique_ptr< vector<LineString *> > mls ( lm.getMergedLineStrings() );
-            vector<Geometry*> mls2;
-            for (auto& l : *mls)
-            {
-                //if (!l->isEmpty())
-                mls2.push_back(dynamic_cast<Geometry*>(l));
-            }
+            RouteGeometryBuilder route;
+            buildRouteGeometry(routeNodeArcRep, route);
+            unique_ptr<MultiLineString> mLine = route.ToMultiLineString(*DBHELPER::GEO_FACTORY);
 
-            unique_ptr<MultiLineString> route (DBHELPER::GEO_FACTORY->createMultiLineString( mls2 ) );
-            //sw.stop();
-            //LOGGER::LogDebug("Merging Geometry with Geos took " + to_string(sw.elapsed())+" mcs");
             auto& fgdb = dynamic_cast<FGDBWriter&>(writer);
-            //LOGGER::LogDebug("# "+ to_string(omp_get_thread_num()) +" : saveResults() - save to DB");
             #pragma omp critical
             {
-            //sw.start();
             fgdb.SaveResultArc(orig, dest, cost, capacity, flow,
-                                *route, resultTableName);
-            //sw.stop();
-            //LOGGER::LogDebug("SaveResultArc() took " + to_string(sw.elapsed())+" mcs");
+                                *mLine, resultTableName);
             }
         }
             break;
     }
-    //cout << "nexpert::Network - saved" <<endl;
 }
 
 //MCF
 void InternalNet::saveMCFResultsMemS(const std::string orig, const std::string dest, const netxpert::data::cost_t cost,
                                  const netxpert::data::capacity_t capacity, const netxpert::data::flow_t flow,
-                                 const std::string& arcIDs, std::vector<geos::geom::Geometry*> routeParts,
+                                 const std::vector<netxpert::data::arc_t>& routeNodeArcRep,
                                  std::ostringstream& outStream) {
 
     using namespace std;
-    using namespace geos::geom;
-    using namespace geos::operation::linemerge;
-    using namespace netxpert::cnfg;
-    using namespace netxpert::io;
-    using namespace netxpert::utils;
-
-    //put all geometries in routeParts into one (perhaps disconnected) Multilinestring
-    //MultilineString could also contain only one Linestring
-    unique_ptr<MultiLineString> mLine ( DBHELPER::GEO_FACTORY->createMultiLineString( routeParts ));
-
-    unique_ptr<MultiLineString> mLineDB;
-    //LOGGER::LogDebug("# "+ to_string(omp_get_thread_num()) +" : saveResults() - load from DB");
-
-    //load geometry from db
-    //TODO: 0,5 bis 1 sec per load from db
-    //Stopwatch<> sw;
-    //sw.start();
 
-    //LOGGER::LogDebug("ArcIDS: "+arcIDs);
+    RouteGeometryBuilder route;
+    buildRouteGeometry(routeNodeArcRep, route);
 
-    if (arcIDs.size() > 0)
-        mLineDB = move( DBHELPER::GetArcGeometriesFromMem(arcIDs) );
-    //sw.stop();
-    //LOGGER::LogDebug("DBHELPER::TEST_GetArcGeometriesFromRAM() took " + to_string(sw.elapsed()/1000)+" ms");
-    //LOGGER::LogDebug("# "+ to_string(omp_get_thread_num()) +" : saveResults() - merge");
-    //merge routeParts with original arcs
-    //sw.start();
-    LineMerger lm;
-
-    if (! (mLine->isEmpty()) )
-        lm.add(mLine.get());
-
-    if (mLineDB)
-        lm.add(mLineDB.get());
-
-    std::unique_ptr< vector<LineString *> > mls ( lm.getMergedLineStrings() );
-    vector<Geometry*> mls2;
-    for (auto& l : *mls)
-    {
-        //if (!l->isEmpty())
-        mls2.push_back(dynamic_cast<Geometry*>(l));
-    }
-
-    unique_ptr<MultiLineString> route (DBHELPER::GEO_FACTORY->createMultiLineString( mls2 ) );
-
-    std::string coordStr = convertRouteToCoordList(route);
+    std::string coordStr = route.ToJSON();
 
     /**
     {"orig" : orig, "dest" : dest, "cost" : cost, "capacity": capacity, "flow" : flow, "geom" : coordinateList }
@@ -2270,18 +3031,11 @@ void InternalNet::saveMCFResultsMemS(const std::string orig, const std::string d
         << "\", \"flow\" : " << flow
         << ", \"geom\" : " << coordStr << "} " << endl;
 
-    //sw.stop();
-    //LOGGER::LogDebug("Merging Geometry with Geos took " + to_string(sw.elapsed())+" mcs");
-    //LOGGER::LogDebug("# "+ to_string(omp_get_thread_num()) +" : saveResults() - save to DB");
-    //sw.start();
     #pragma omp critical
     {
     //save data to stream
     outStream << row.str() << endl;
     }
-
-    //sw.stop();
-    //LOGGER::LogDebug("SaveResultArc() took " + to_string(sw.elapsed())+" mcs");
 }
 
 /**
@@ -2334,7 +3088,7 @@ void
                     double cost = 0;
                     for (string& s : tokens)
                     {
-                        arc = DBHELPER::GetArcGeometriesFromDB(NETXPERT_CNFG.ArcsTableName, NETXPERT_CNFG.ArcIDColumnName,
+                        arc = this->dbHelper->GetArcGeometriesFromDB(NETXPERT_CNFG.ArcsTableName, NETXPERT_CNFG.ArcIDColumnName,
                                                      NETXPERT_CNFG.ArcsGeomColumnName, ArcIDColumnDataType::Number,
                                                      s);
                         //TODO: cost
@@ -2359,7 +3113,7 @@ void
                 double cost = 0;
                 for (string& s : tokens)
                 {
-                    arc = DBHELPER::GetArcGeometriesFromDB(NETXPERT_CNFG.ArcsTableName,
+                    arc = this->dbHelper->GetArcGeometriesFromDB(NETXPERT_CNFG.ArcsTableName,
                                                                 NETXPERT_CNFG.ArcIDColumnName,
                                                                 NETXPERT_CNFG.ArcsGeomColumnName,
                                                             ArcIDColumnDataType::Number, s);
@@ -2592,6 +3346,50 @@ std::pair<std::shared_ptr<geos::geom::Geometry>, std::shared_ptr<geos::geom::Geo
     return result;
 }
 
+/**
+* Splits the line at all given positions (length index, ascending, between start and end) at once.
+* Works on the coordinates only and creates no geometries, so it may be called from several threads.
+*/
+std::vector<std::vector<geos::geom::Coordinate>>
+ InternalNet::splitLine(const std::vector<double>& positions,
+                        const geos::geom::LineString& line) {
+
+    using namespace std;
+    using namespace geos::geom;
+
+    const CoordinateSequence* coords = line.getCoordinatesRO();
+    const size_t coordCount = coords->getSize();
+
+    vector<vector<Coordinate>> pieces (1);
+    pieces.reserve(positions.size() + 1);
+    pieces.back().push_back(coords->getAt(0));
+
+    double segStart = 0;
+    size_t k = 0;
+    for (size_t i = 1; i < coordCount; i++) {
+        const Coordinate& c0 = coords->getAt(i - 1);
+        const Coordinate& c1 = coords->getAt(i);
+        const double segLength = c0.distance(c1);
+
+        while (k < positions.size() && (positions[k] <= segStart + segLength || i == coordCount - 1)) {
+            const double frac = segLength > 0 ? std::min(1.0, (positions[k] - segStart) / segLength) : 0;
+            const Coordinate cut (c0.x + frac * (c1.x - c0.x), c0.y + frac * (c1.y - c0.y));
+            pieces.back().push_back(cut);
+            pieces.push_back( vector<Coordinate> {cut} );
+            k++;
+        }
+        if (!pieces.back().back().equals2D(c1))
+            pieces.back().push_back(c1);
+        segStart += segLength;
+    }
+    //a line needs two coordinates, even if the piece has no length
+    for (auto& piece : pieces)
+        if (piece.size() < 2)
+            piece.push_back(piece.back());
+
+    return pieces;
+}
+
 std::vector<std::shared_ptr<geos::geom::Geometry>>
  InternalNet::clipLine(const geos::geom::Geometry& polyGeom,
                          const geos::geom::Geometry& lineGeom) {
@@ -2786,7 +3584,7 @@ void
     {
         LOGGER::LogInfo("Processing barrier polygons from "+NETXPERT_CNFG.BarrierPolyTableName + "..");
 
-        std::unordered_set<extarcid_t> arcIDs = DBHELPER::GetIntersectingArcs(NETXPERT_CNFG.BarrierPolyTableName,
+        std::unordered_set<extarcid_t> arcIDs = this->dbHelper->GetIntersectingArcs(NETXPERT_CNFG.BarrierPolyTableName,
                                       NETXPERT_CNFG.BarrierPolyGeomColumnName,
                                       NETXPERT_CNFG.ArcsTableName,
                                       NETXPERT_CNFG.ArcIDColumnName,
@@ -2806,14 +3604,14 @@ void
         // clip network with polygon geometry for each arc geom that intersect with the barrier geometry
 
         //get geoms from barriers
-        auto barrierGeoms = DBHELPER::GetBarrierGeometriesFromDB(NETXPERT_CNFG.BarrierPolyTableName,
+        auto barrierGeoms = this->dbHelper->GetBarrierGeometriesFromDB(NETXPERT_CNFG.BarrierPolyTableName,
                                       NETXPERT_CNFG.BarrierPolyGeomColumnName);
 
         for (const auto& barrierGeom : barrierGeoms) {
 
             for (auto& arcID : arcIDs)  {
                 //get line geom from network
-                auto lineGeom = DBHELPER::GetArcGeometryFromDB(NETXPERT_CNFG.ArcsTableName,
+                auto lineGeom = this->dbHelper->GetArcGeometryFromDB(NETXPERT_CNFG.ArcsTableName,
                                           NETXPERT_CNFG.ArcIDColumnName,
                                           NETXPERT_CNFG.ArcsGeomColumnName,
                                           netxpert::data::ArcIDColumnDataType::Number,
@@ -2842,10 +3640,31 @@ void
 
     //size_t m = arcsTbl.size();
     this->g->reserveArc(arcsTbl.size());
+    this->arcIDTable.Reset(arcsTbl.empty() ? ExternalIDTable::Mode::Text
+                                           : ExternalIDTable::ModeOf(arcsTbl.front().extArcID));
+    this->arcIDTable.Reserve(2 * arcsTbl.size());
 
-    for (InputArcs::const_iterator it = arcsTbl.begin(); it != arcsTbl.end(); ++it)
+    //arcs are added in the order of the input table
+    //or - with renumbered nodes - grouped by their internal start node
+    std::vector<size_t> arcOrder(arcsTbl.size());
+    for (size_t i = 0; i < arcOrder.size(); i++)
+        arcOrder[i] = i;
+
+    if (this->NETXPERT_CNFG.NodeOrder == netxpert::cnfg::NODE_ORDER::BreadthFirst)
+    {
+        std::vector<int> fromNodeIDs(arcsTbl.size());
+        for (size_t i = 0; i < arcsTbl.size(); i++)
+            fromNodeIDs[i] = this->g->id( this->GetNodeFromOrigID(arcsTbl[i].extFromNode) );
+
+        std::stable_sort(arcOrder.begin(), arcOrder.end(),
+                         [&fromNodeIDs](const size_t a, const size_t b) {
+                            return fromNodeIDs[a] < fromNodeIDs[b];
+                         });
+    }
+
+    for (const size_t arcIdx : arcOrder)
     {
-        InputArc arc = *it;
+        const InputArc& arc = arcsTbl[arcIdx];
 //        extarcid_t externalArcID = std::stoul( arc.extArcID ) ;
         extarcid_t externalArcID = arc.extArcID;
         // String -> so content of nodeID fields could be string, int or double
@@ -2919,12 +3738,69 @@ void
             processArc(arc, internalEndNode, internalStartNode);
         }
     }
+    this->arcIDTable.BuildIndex();
 
-    DBHELPER::EliminatedArcs = this->eliminatedArcs;
-    /*for (auto& s : DBHELPER::EliminatedArcs)
+    this->dbHelper->EliminatedArcs = this->eliminatedArcs;
+    /*for (auto& s : this->dbHelper->EliminatedArcs)
         cout << s << endl;*/
 }
 
+/** @brief reads the network arcs from the columnar input arcs and transforms it to the internal network data.
+*
+* Arcs are added grouped by their internal start node (stable counting sort), like the sorted input of readNetwork().
+*/
+void
+ InternalNet::readNetwork(const netxpert::data::InputArcColumns& arcCols,
+                          const std::vector<netxpert::data::node_t>& nodes,
+                          const bool autoClean,
+                          const bool isDirected)
+{
+    using namespace netxpert::data;
+    using namespace std;
+
+    const bool oneWay = this->NETXPERT_CNFG.IsDirected;
+    const bool hasOnewayCol = !this->NETXPERT_CNFG.OnewayColumnName.empty();
+    const size_t m = arcCols.Size();
+    const size_t n = nodes.size();
+
+    this->arcIDTable.Reset(arcCols.intArcIDs.empty() ? ExternalIDTable::Mode::Text : ExternalIDTable::Mode::Integer);
+    this->arcIDTable.Reserve(2 * m);
+
+    vector<size_t> offsets(n + 1, 0);
+    size_t arcCount = 0;
+    for (size_t i = 0; i < m; i++)
+    {
+        offsets[this->g->id(nodes[arcCols.fromNodes[i]]) + 1] += 1;
+        arcCount += (oneWay && hasOnewayCol && arcCols.oneway[i]) ? 1 : 2;
+    }
+    for (size_t i = 0; i < n; i++)
+        offsets[i + 1] += offsets[i];
+
+    vector<size_t> arcOrder(m);
+    for (size_t i = 0; i < m; i++)
+        arcOrder[ offsets[this->g->id(nodes[arcCols.fromNodes[i]])]++ ] = i;
+
+    this->g->reserveArc(arcCount);
+
+    for (const size_t i : arcOrder)
+    {
+        const node_t internalStartNode = nodes[arcCols.fromNodes[i]];
+        const node_t internalEndNode   = nodes[arcCols.toNodes[i]];
+
+        if (arcCols.fromNodes[i] == arcCols.toNodes[i])
+            LOGGER::LogWarning("Loop at "+arcCols.NodeID(arcCols.fromNodes[i])+ " - " +
+                                          arcCols.NodeID(arcCols.toNodes[i])+ "!");
+
+        processArc(arcCols, i, internalStartNode, internalEndNode);
+        //arc level oneway Y or N
+        if (!oneWay || !hasOnewayCol || !arcCols.oneway[i])
+            processArc(arcCols, i, internalEndNode, internalStartNode);
+    }
+    this->arcIDTable.BuildIndex();
+
+    this->dbHelper->EliminatedArcs = this->eliminatedArcs;
+}
+
 void
  InternalNet::readNodes(const InputArcs& arcsTbl, const InputNodes& nodesTbl,
                         const std::map<std::string, netxpert::data::IntNodeID>& extIntNodeMap) {
@@ -2933,8 +3809,14 @@ void
 
     //get distinct nodes
     auto distinctNodes = getDistinctOrigNodes(arcsTbl);
+    //locality preserving order of the internal node IDs
+    if (this->NETXPERT_CNFG.NodeOrder == netxpert::cnfg::NODE_ORDER::BreadthFirst)
+        distinctNodes = orderNodesBreadthFirst(arcsTbl, distinctNodes);
     //reserve memory
     this->g->reserveNode(distinctNodes.size());
+    this->nodeIDTable.Reset(distinctNodes.empty() ? ExternalIDTable::Mode::Text
+                                                  : ExternalIDTable::ModeOf(distinctNodes.front()));
+    this->nodeIDTable.Reserve(distinctNodes.size());
     //add them to the graph and save original node ID
     for (vector<string>::const_iterator it = distinctNodes.begin(); it != distinctNodes.end(); ++it)
     {
@@ -2943,6 +3825,82 @@ void
 //        this->nodeIDMap.insert( make_pair(*it, lemNode) );
         this->RegisterNodeID(*it, lemNode);
     }
+    this->nodeIDTable.BuildIndex();
+
+    readNodeSupplies(nodesTbl);
+}
+
+/**
+* Internal node IDs are assigned in ascending order of the original node IDs (like getDistinctOrigNodes())
+* or in breadth first order; only the distinct nodes are sorted, not the arcs.
+* Returns the internal node per index of arcCols.nodeIDs.
+*/
+std::vector<netxpert::data::node_t>
+ InternalNet::readNodes(const netxpert::data::InputArcColumns& arcCols,
+                        const netxpert::data::InputNodes& nodesTbl) {
+
+    using namespace std;
+
+    const uint32_t n = arcCols.NodeCount();
+    const bool intIDs = !arcCols.intNodeIDs.empty();
+
+    //order[rank] = index in arcCols.nodeIDs
+    vector<uint32_t> order(n);
+    for (uint32_t i = 0; i < n; i++)
+        order[i] = i;
+    if (intIDs)
+        std::sort(order.begin(), order.end(),
+                  [&arcCols](const uint32_t a, const uint32_t b) {
+                    return decimalLess(arcCols.intNodeIDs[a], arcCols.intNodeIDs[b]);
+                  });
+    else
+        std::sort(order.begin(), order.end(),
+                  [&arcCols](const uint32_t a, const uint32_t b) {
+                    return arcCols.nodeIDs[a] < arcCols.nodeIDs[b];
+                  });
+
+    if (this->NETXPERT_CNFG.NodeOrder == netxpert::cnfg::NODE_ORDER::BreadthFirst)
+    {
+        vector<uint32_t> rank(n);
+        for (uint32_t r = 0; r < n; r++)
+            rank[order[r]] = r;
+
+        vector<uint32_t> fromRanks(arcCols.Size());
+        vector<uint32_t> toRanks(arcCols.Size());
+        for (size_t i = 0; i < arcCols.Size(); i++) {
+            fromRanks[i] = rank[arcCols.fromNodes[i]];
+            toRanks[i]   = rank[arcCols.toNodes[i]];
+        }
+        const auto bfsRanks = orderNodesBreadthFirst(fromRanks, toRanks, n);
+        vector<uint32_t> bfsOrder(n);
+        for (uint32_t r = 0; r < n; r++)
+            bfsOrder[r] = order[bfsRanks[r]];
+        order.swap(bfsOrder);
+    }
+
+    this->g->reserveNode(n);
+    this->nodeIDTable.Reset(intIDs ? ExternalIDTable::Mode::Integer : ExternalIDTable::Mode::Text);
+    this->nodeIDTable.Reserve(n);
+    vector<node_t> nodes(n);
+    for (const uint32_t i : order)
+    {
+        nodes[i] = this->g->addNode();
+        if (intIDs)
+            this->RegisterNodeID(arcCols.intNodeIDs[i], nodes[i]);
+        else
+            this->RegisterNodeID(arcCols.nodeIDs[i], nodes[i]);
+    }
+    this->nodeIDTable.BuildIndex();
+
+    readNodeSupplies(nodesTbl);
+
+    return nodes;
+}
+
+void
+ InternalNet::readNodeSupplies(const InputNodes& nodesTbl) {
+
+    using namespace std;
 
     // We have to care for the nodes and their supply values also if they are present
     if (nodesTbl.size() > 0)
@@ -2955,10 +3913,10 @@ void
             //Get internal node ID from dictionary:
             //add values to NodeSupply
             //throws an exception if not found!
-            try {
-                internalNode = this->nodeIDMap.at(extNodeID);
-            }
-            catch (exception& ex)
+            uint32_t nodeIdx;
+            if (this->nodeIDTable.Find(extNodeID, nodeIdx))
+                internalNode = this->g->nodeFromId(nodeIdx);
+            else
             {
                 LOGGER::LogError("Original node ID " +extNodeID +" from nodes table not found in arcs!");
                 LOGGER::LogError("-->Node ID "+ extNodeID + " will be ignored.");
@@ -3014,17 +3972,141 @@ std::vector<std::string>
     return sortedDistinctNodes;
 }
 
+/**
+* Orders the distinct nodes by a breadth first search over the (undirected) arcs, so that adjacent nodes
+* get close internal node IDs and the search space of a shortest path search stays compact in memory.
+* Every connected component is searched from its node with the lowest original node ID;
+* neighbours are visited in ascending order of the original node ID (deterministic order).
+*/
+std::vector<std::string>
+ InternalNet::orderNodesBreadthFirst(const InputArcs& arcsTbl,
+                                     const std::vector<std::string>& distinctNodes) {
+
+    using namespace std;
+
+    const size_t n = distinctNodes.size();
+
+    //distinctNodes are sorted: index in this vector is the rank of the original node ID
+    unordered_map<string, uint32_t> nodeIdx;
+    nodeIdx.reserve(n);
+    for (size_t i = 0; i < n; i++)
+        nodeIdx.insert( make_pair(distinctNodes[i], i) );
+
+    vector<uint32_t> fromNodes;
+    vector<uint32_t> toNodes;
+    fromNodes.reserve(arcsTbl.size());
+    toNodes.reserve(arcsTbl.size());
+    for (const auto& arc : arcsTbl) {
+        fromNodes.push_back( nodeIdx.at(arc.extFromNode) );
+        toNodes.push_back( nodeIdx.at(arc.extToNode) );
+    }
+
+    vector<string> result;
+    result.reserve(n);
+    for (const uint32_t u : orderNodesBreadthFirst(fromNodes, toNodes, n))
+        result.push_back(distinctNodes[u]);
+
+    return result;
+}
+
+/**
+* Nodes are given by their rank of the original node ID (0 .. nodeCount-1); returns the ranks in breadth first order.
+*/
+std::vector<uint32_t>
+ InternalNet::orderNodesBreadthFirst(const std::vector<uint32_t>& fromNodes,
+                                     const std::vector<uint32_t>& toNodes,
+                                     const uint32_t nodeCount) {
+
+    using namespace std;
+
+    const size_t n = nodeCount;
+
+    //undirected adjacency in compressed form
+    vector<pair<uint32_t, uint32_t> > edges;
+    edges.reserve(fromNodes.size() * 2);
+    for (size_t i = 0; i < fromNodes.size(); i++) {
+        const uint32_t u = fromNodes[i];
+        const uint32_t v = toNodes[i];
+        edges.push_back( make_pair(u, v) );
+        edges.push_back( make_pair(v, u) );
+    }
+    std::sort(edges.begin(), edges.end());
+
+    vector<uint32_t> offsets(n + 1, 0);
+    for (const auto& e : edges)
+        offsets[e.first + 1] += 1;
+    for (size_t i = 0; i < n; i++)
+        offsets[i + 1] += offsets[i];
+
+    vector<char> visited(n, 0);
+    vector<uint32_t> queue;
+    queue.reserve(n);
+
+    for (uint32_t seed = 0; seed < n; seed++)
+    {
+        if (visited[seed])
+            continue;
+
+        visited[seed] = 1;
+        queue.push_back(seed);
+
+        for (size_t head = queue.size() - 1; head < queue.size(); head++)
+        {
+            const uint32_t u = queue[head];
+
+            for (uint32_t pos = offsets[u]; pos < offsets[u + 1]; pos++)
+            {
+                const uint32_t v = edges[pos].second;
+                if (!visited[v]) {
+                    visited[v] = 1;
+                    queue.push_back(v);
+                }
+            }
+        }
+    }
+    LOGGER::LogDebug("Nodes renumbered in breadth first order.");
+
+    return queue;
+}
+
 void
  InternalNet::processArc(const InputArc& _arc,
                          const node_t internalStartNode,
                          const node_t internalEndNode) {
 
+//    this->SetArcData(arc, ArcData { std::stoul(_arc.extArcID),
+    processArc(_arc.extArcID, _arc.cost, _arc.capacity, internalStartNode, internalEndNode);
+}
+
+void
+ InternalNet::processArc(const netxpert::data::extarcid_t& extArcID,
+                         const netxpert::data::cost_t cost,
+                         const netxpert::data::capacity_t capacity,
+                         const node_t internalStartNode,
+                         const node_t internalEndNode) {
+
     auto arc = this->g->addArc(internalStartNode, internalEndNode);
 
-//    this->SetArcData(arc, ArcData { std::stoul(_arc.extArcID),
-    this->SetArcData(arc, ArcData { _arc.extArcID,
-                                        _arc.cost,
-                                        _arc.capacity} );
+    this->SetArcData(arc, ArcData { extArcID,
+                                        cost,
+                                        capacity} );
+    (*this->arcFilterMap)[arc] = true;
+}
+
+void
+ InternalNet::processArc(const netxpert::data::InputArcColumns& arcCols,
+                         const size_t arcIdx,
+                         const node_t internalStartNode,
+                         const node_t internalEndNode) {
+
+    auto arc = this->g->addArc(internalStartNode, internalEndNode);
+
+    if (arcCols.intArcIDs.empty())
+        this->arcIDTable.Set(this->g->id(arc), arcCols.arcIDs[arcIdx]);
+    else
+        this->arcIDTable.Set(this->g->id(arc), arcCols.intArcIDs[arcIdx]);
+    (*this->costMap)[arc] = arcCols.costs[arcIdx];
+    (*this->capMap)[arc]  = arcCols.capacities[arcIdx];
     (*this->arcFilterMap)[arc] = true;
 }
 //--|Region Network core functions
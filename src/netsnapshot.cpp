@@ -0,0 +1,343 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include "netsnapshot.hpp"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+using namespace std;
+using namespace netxpert::data;
+using namespace netxpert::io;
+
+namespace {
+
+    const char MAGIC[8] = {'N','E','T','X','S','N','A','P'};
+    //read back as 0x04030201 on a machine with the other byte order
+    const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    struct SectionEntry
+    {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    struct Header
+    {
+        char     magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint64_t fileSize;
+        uint64_t nodeCount;
+        uint64_t arcCount;
+        uint64_t spanCount;
+        uint32_t nodeIDMode;
+        uint32_t arcIDMode;
+        SectionEntry sections[NetworkSnapshot::SectionCount];
+    };
+
+    class SectionWriter
+    {
+        public:
+            SectionWriter(ofstream& os, Header& header) : os(os), header(header), pos(sizeof(Header)) {}
+
+            template<typename T>
+            void Write(const NetworkSnapshot::Section s, const vector<T>& values) {
+                begin(s);
+                append(values.data(), values.size() * sizeof(T));
+                end(s);
+            }
+
+            void WriteStrings(const NetworkSnapshot::Section offsetSection, const NetworkSnapshot::Section charSection,
+                              const vector<string>& strings) {
+                vector<uint64_t> offsets;
+                offsets.reserve(strings.size() + 1);
+                offsets.push_back(0);
+                for (const auto& s : strings)
+                    offsets.push_back(offsets.back() + s.size());
+                Write(offsetSection, offsets);
+
+                begin(charSection);
+                for (const auto& s : strings)
+                    append(s.data(), s.size());
+                end(charSection);
+            }
+
+            uint64_t Position() const {
+                return pos;
+            }
+
+        private:
+            void begin(const NetworkSnapshot::Section s) {
+                static const char zeros[8] = {0};
+                const uint64_t padding = (8 - pos % 8) % 8;
+                append(zeros, padding);
+                header.sections[s].offset = pos;
+            }
+            void end(const NetworkSnapshot::Section s) {
+                header.sections[s].size = pos - header.sections[s].offset;
+            }
+            void append(const void* data, const uint64_t bytes) {
+                if (bytes == 0)
+                    return;
+                os.write(static_cast<const char*>(data), bytes);
+                pos += bytes;
+            }
+
+            ofstream& os;
+            Header&   header;
+            uint64_t  pos;
+    };
+}
+
+void
+ NetworkSnapshot::Write(const std::string& path, const NetworkSnapshotData& data) {
+
+    const uint64_t n = data.nodeSupplies.size();
+    const uint64_t m = data.arcSources.size();
+    const uint64_t spans = data.spanArcIDs.size();
+    const bool intNodeIDs = data.nodeIDMode == ExternalIDTable::Mode::Integer;
+    const bool intArcIDs = data.arcIDMode == ExternalIDTable::Mode::Integer;
+
+    if (data.arcTargets.size() != m || data.arcCosts.size() != m || data.arcCapacities.size() != m)
+        throw std::invalid_argument("NetworkSnapshot::Write(): sizes of node or arc arrays differ!");
+    if (intNodeIDs ? (data.nodeIDValues.size() != n || data.nodeIDKinds.size() != n) : data.nodeIDs.size() != n)
+        throw std::invalid_argument("NetworkSnapshot::Write(): sizes of node ID arrays differ!");
+    if (intArcIDs ? (data.arcIDValues.size() != m || data.arcIDKinds.size() != m) : data.arcIDs.size() != m)
+        throw std::invalid_argument("NetworkSnapshot::Write(): sizes of arc ID arrays differ!");
+    if (spans > 0 && (data.spanOfArc.size() != m || data.reversedArc.size() != m ||
+                      data.spanOffsets.size() != spans + 1 || data.coords.size() != 2 * data.spanOffsets.back()))
+        throw std::invalid_argument("NetworkSnapshot::Write(): sizes of geometry arrays differ!");
+
+    ofstream os (path, ios::out | ios::binary | ios::trunc);
+    if (!os)
+        throw std::runtime_error("Could not open network snapshot " + path + " for writing!");
+
+    Header header;
+    std::memset(&header, 0, sizeof(Header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version   = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.nodeCount = n;
+    header.arcCount  = m;
+    header.spanCount = spans;
+    header.nodeIDMode = intNodeIDs ? 1 : 0;
+    header.arcIDMode  = intArcIDs ? 1 : 0;
+    //placeholder; rewritten with the section table at the end
+    os.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+    SectionWriter w (os, header);
+    w.WriteStrings(NodeIDOffsetSection, NodeIDCharSection, data.nodeIDs);
+    if (intNodeIDs) {
+        w.Write(NodeIDValueSection, data.nodeIDValues);
+        w.Write(NodeIDKindSection, data.nodeIDKinds);
+    }
+    w.Write(NodeSupplySection, data.nodeSupplies);
+    w.Write(ArcSourceSection, data.arcSources);
+    w.Write(ArcTargetSection, data.arcTargets);
+    w.Write(ArcCostSection, data.arcCosts);
+    w.Write(ArcCapacitySection, data.arcCapacities);
+    w.WriteStrings(ArcIDOffsetSection, ArcIDCharSection, data.arcIDs);
+    if (intArcIDs) {
+        w.Write(ArcIDValueSection, data.arcIDValues);
+        w.Write(ArcIDKindSection, data.arcIDKinds);
+    }
+    w.WriteStrings(EliminatedArcIDOffsetSection, EliminatedArcIDCharSection, data.eliminatedArcIDs);
+    if (spans > 0) {
+        w.Write(SpanOfArcSection, data.spanOfArc);
+        w.Write(ReversedArcSection, data.reversedArc);
+        w.Write(SpanOffsetSection, data.spanOffsets);
+        w.Write(CoordSection, data.coords);
+        w.WriteStrings(SpanArcIDOffsetSection, SpanArcIDCharSection, data.spanArcIDs);
+    }
+    header.fileSize = w.Position();
+
+    os.seekp(0);
+    os.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    os.close();
+    if (!os)
+        throw std::runtime_error("Error writing network snapshot " + path + "!");
+}
+
+NetworkSnapshot::NetworkSnapshot(const std::string& path)
+    : base(nullptr), size(0), nodeCount(0), arcCount(0), spanCount(0),
+      nodeIDMode(ExternalIDTable::Mode::Text), arcIDMode(ExternalIDTable::Mode::Text) {
+
+    #ifdef _WIN32
+    fileHandle = INVALID_HANDLE_VALUE;
+    mappingHandle = nullptr;
+
+    fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Could not open network snapshot " + path + "!");
+
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(fileHandle, &fileSize))
+        size = static_cast<size_t>(fileSize.QuadPart);
+    if (size >= sizeof(Header)) {
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mappingHandle)
+            base = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    }
+    #else
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Could not open network snapshot " + path + "!");
+
+    struct stat st;
+    if (fstat(fd, &st) == 0)
+        size = static_cast<size_t>(st.st_size);
+    if (size >= sizeof(Header)) {
+        void* p = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (p != MAP_FAILED)
+            base = static_cast<const char*>(p);
+    }
+    //the mapping stays valid without the descriptor
+    close(fd);
+    #endif
+
+    try {
+        if (!base)
+            throw std::runtime_error("Could not map network snapshot " + path + "!");
+        validate(path);
+    }
+    catch (...) {
+        unmap();
+        throw;
+    }
+}
+
+NetworkSnapshot::~NetworkSnapshot() {
+    unmap();
+}
+
+void
+ NetworkSnapshot::unmap() {
+
+    #ifdef _WIN32
+    if (base)
+        UnmapViewOfFile(base);
+    if (mappingHandle)
+        CloseHandle(mappingHandle);
+    if (fileHandle != INVALID_HANDLE_VALUE)
+        CloseHandle(fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+    #else
+    if (base)
+        munmap(const_cast<char*>(base), size);
+    #endif
+    base = nullptr;
+}
+
+/**
+* Checks only the header, the section table and the end of every string table, so opening does not touch the
+* pages of the arrays.
+*/
+void
+ NetworkSnapshot::validate(const std::string& path) {
+
+    Header header;
+    std::memcpy(&header, base, sizeof(Header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+        throw std::runtime_error(path + " is not a netXpert network snapshot!");
+    if (header.byteOrder != BYTE_ORDER_MARK)
+        throw std::runtime_error("Network snapshot " + path + " has been written with another byte order!");
+    if (header.version != VERSION)
+        throw std::runtime_error("Network snapshot " + path + " has version " + to_string(header.version) +
+                                 "; expected version " + to_string(VERSION) + "!");
+    if (header.fileSize != size)
+        throw std::runtime_error("Network snapshot " + path + " is truncated!");
+    if (header.nodeCount > UINT32_MAX || header.arcCount > UINT32_MAX || header.spanCount > UINT32_MAX)
+        throw std::runtime_error("Network snapshot " + path + " is too large!");
+    if (header.nodeIDMode > 1 || header.arcIDMode > 1)
+        throw std::runtime_error("Network snapshot " + path + " is corrupt (ID mode)!");
+
+    for (int s = 0; s < SectionCount; s++) {
+        const SectionEntry& e = header.sections[s];
+        if (e.offset % 8 != 0 || e.offset > size || e.size > size - e.offset)
+            throw std::runtime_error("Network snapshot " + path + " is corrupt (section " + to_string(s) + ")!");
+        sectionOffsets[s] = e.offset;
+        sectionSizes[s]   = e.size;
+    }
+
+    nodeCount = header.nodeCount;
+    arcCount  = header.arcCount;
+    spanCount = header.spanCount;
+    nodeIDMode = header.nodeIDMode == 1 ? ExternalIDTable::Mode::Integer : ExternalIDTable::Mode::Text;
+    arcIDMode  = header.arcIDMode == 1 ? ExternalIDTable::Mode::Integer : ExternalIDTable::Mode::Text;
+
+    auto expect = [&](const Section s, const uint64_t bytes) {
+        if (sectionSizes[s] != bytes)
+            throw std::runtime_error("Network snapshot " + path + " is corrupt (size of section " +
+                                     to_string(s) + ")!");
+    };
+    if (nodeIDMode == ExternalIDTable::Mode::Integer) {
+        expect(NodeIDValueSection, nodeCount * sizeof(int64_t));
+        expect(NodeIDKindSection, nodeCount * sizeof(uint8_t));
+    }
+    else
+        expect(NodeIDOffsetSection, (nodeCount + 1) * sizeof(uint64_t));
+    expect(NodeSupplySection, nodeCount * sizeof(supply_t));
+    expect(ArcSourceSection, arcCount * sizeof(uint32_t));
+    expect(ArcTargetSection, arcCount * sizeof(uint32_t));
+    expect(ArcCostSection, arcCount * sizeof(cost_t));
+    expect(ArcCapacitySection, arcCount * sizeof(capacity_t));
+    if (arcIDMode == ExternalIDTable::Mode::Integer) {
+        expect(ArcIDValueSection, arcCount * sizeof(int64_t));
+        expect(ArcIDKindSection, arcCount * sizeof(uint8_t));
+    }
+    else
+        expect(ArcIDOffsetSection, (arcCount + 1) * sizeof(uint64_t));
+    if (spanCount > 0) {
+        expect(SpanOfArcSection, arcCount * sizeof(int32_t));
+        expect(ReversedArcSection, arcCount * sizeof(uint8_t));
+        expect(SpanOffsetSection, (spanCount + 1) * sizeof(uint32_t));
+        expect(CoordSection, 2 * SpanOffsets()[spanCount] * sizeof(double));
+        expect(SpanArcIDOffsetSection, (spanCount + 1) * sizeof(uint64_t));
+    }
+
+    nodeIDs          = stringTable(NodeIDOffsetSection, NodeIDCharSection);
+    arcIDs           = stringTable(ArcIDOffsetSection, ArcIDCharSection);
+    eliminatedArcIDs = stringTable(EliminatedArcIDOffsetSection, EliminatedArcIDCharSection);
+    spanArcIDs       = stringTable(SpanArcIDOffsetSection, SpanArcIDCharSection);
+}
+
+NetworkSnapshot::StringTable
+ NetworkSnapshot::stringTable(const Section offsetSection, const Section charSection) const {
+
+    const uint64_t entries = sectionSizes[offsetSection] / sizeof(uint64_t);
+    if (entries == 0)
+        return StringTable();
+
+    const uint64_t* offsets = section<uint64_t>(offsetSection);
+    //offsets are ascending; the last one is the total length of the characters
+    if (offsets[0] != 0 || offsets[entries - 1] != sectionSizes[charSection])
+        throw std::runtime_error("Network snapshot is corrupt (string table " + to_string(offsetSection) + ")!");
+
+    return StringTable(offsets, section<char>(charSection), entries - 1);
+}
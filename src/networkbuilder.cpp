@@ -41,9 +41,6 @@ NetworkBuilder::NetworkBuilder(Config& cnfg)
     GEO_FACTORY = geos::geom::GeometryFactory::create(pm.get(), -1);
 
     NETXPERT_CNFG = cnfg;
-
-    if (!DBHELPER::IsInitialized)
-      DBHELPER::Initialize(NETXPERT_CNFG);
 }
 
 void NetworkBuilder::LoadData()
@@ -55,12 +52,13 @@ void NetworkBuilder::LoadData()
                                 NETXPERT_CNFG.CapColumnName,    NETXPERT_CNFG.OnewayColumnName,
                                 NETXPERT_CNFG.NodeIDColumnName, NETXPERT_CNFG.NodeSupplyColumnName };
 
-    DBHELPER::OpenNewTransaction();
+    DBHELPER dbHelper (NETXPERT_CNFG);
+    dbHelper.OpenNewTransaction();
 
-    this->inputArcs = DBHELPER::LoadNetworkToBuildFromDB(NETXPERT_CNFG.ArcsTableName, cmap);
+    this->inputArcs = dbHelper.LoadNetworkToBuildFromDB(NETXPERT_CNFG.ArcsTableName, cmap);
 
-    DBHELPER::CommitCurrentTransaction();
-    DBHELPER::CloseConnection();
+    dbHelper.CommitCurrentTransaction();
+    dbHelper.CloseConnection();
 
     LOGGER::LogInfo("Done!");
 
@@ -88,7 +88,8 @@ def read_config(path_to_cnfg):
 def test_mcf(cnfg, cmap):
 
     atblname = cnfg.ArcsTableName
-    arcsTable = netx.DBHELPER.LoadNetworkFromDB(atblname, cmap)
+    db = netx.DBHELPER(cnfg)
+    arcsTable = db.LoadNetworkFromDB(atblname, cmap)
 
     net = netx.Network(arcsTable, cmap, cnfg)
 
@@ -135,9 +136,10 @@ def test_mcf(cnfg, cmap):
 def test_mcf_load_nodes(cnfg, cmap):
 
     atblname = cnfg.ArcsTableName
-    arcsTable = netx.DBHELPER.LoadNetworkFromDB(atblname, cmap)
+    db = netx.DBHELPER(cnfg)
+    arcsTable = db.LoadNetworkFromDB(atblname, cmap)
     ntblname = cnfg.NodesTableName
-    nodesTable = netx.DBHELPER.LoadNodesFromDB(ntblname, cnfg.NodesGeomColumnName, cmap)
+    nodesTable = db.LoadNodesFromDB(ntblname, cnfg.NodesGeomColumnName, cmap)
     withCapacity = True
 
     net = netx.Network(arcsTable, cmap, cnfg)
@@ -181,7 +183,6 @@ if __name__ == "__main__":
     print cnfg.SpatiaLiteHome
 
     netx.LOGGER.Initialize(cnfg)
-    netx.DBHELPER.Initialize(cnfg)
 
     alg_dict = {
         0: "NetworkSimplex_MCF",
@@ -88,7 +88,8 @@ def read_config(path_to_cnfg):
 def test_mst(cnfg, cmap):
 
     atblname = cnfg.ArcsTableName
-    arcsTable = netx.DBHELPER.LoadNetworkFromDB(atblname, cmap)
+    db = netx.DBHELPER(cnfg)
+    arcsTable = db.LoadNetworkFromDB(atblname, cmap)
 
     net = netx.Network(arcsTable, cmap, cnfg)
 
@@ -105,9 +106,10 @@ def test_mst(cnfg, cmap):
 def test_mst_load_nodes(cnfg, cmap):
 
     atblname = cnfg.ArcsTableName
-    arcsTable = netx.DBHELPER.LoadNetworkFromDB(atblname, cmap)
+    db = netx.DBHELPER(cnfg)
+    arcsTable = db.LoadNetworkFromDB(atblname, cmap)
     ntblname = cnfg.NodesTableName
-    nodesTable = netx.DBHELPER.LoadNodesFromDB(ntblname, cnfg.NodesGeomColumnName, cmap)
+    nodesTable = db.LoadNodesFromDB(ntblname, cnfg.NodesGeomColumnName, cmap)
 
     net = netx.Network(arcsTable, cmap, cnfg)
 
@@ -147,7 +149,6 @@ if __name__ == "__main__":
     print cnfg.SpatiaLiteHome
 
     netx.LOGGER.Initialize(cnfg)
-    netx.DBHELPER.Initialize(cnfg)
 
     alg_dict = {
         0: "",
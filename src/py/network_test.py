@@ -85,7 +85,8 @@ def build_network(cnfg, cmap):
 def test_add_nodes(cnfg, cmap):
 
     atblname = cnfg.ArcsTableName
-    arcsTable = netx.DBHELPER.LoadNetworkFromDB(atblname, cmap)
+    db = netx.DBHELPER(cnfg)
+    arcsTable = db.LoadNetworkFromDB(atblname, cmap)
 
     net = netx.Network(arcsTable, cmap, cnfg)
 
@@ -111,8 +112,9 @@ def test_load_nodes(cnfg, cmap):
     atblname = cnfg.ArcsTableName
     ntblname = cnfg.NodesTableName
 
-    arcsTable = netx.DBHELPER.LoadNetworkFromDB(atblname, cmap)
-    nodesTable = netx.DBHELPER.LoadNodesFromDB(ntblname,
+    db = netx.DBHELPER(cnfg)
+    arcsTable = db.LoadNetworkFromDB(atblname, cmap)
+    nodesTable = db.LoadNodesFromDB(ntblname,
                                                 cnfg.NodesGeomColumnName,
                                                 cmap)
     # NewNode to InputNode
@@ -131,9 +133,10 @@ def test_load_nodes(cnfg, cmap):
 def test_load_nodes_2(cnfg, cmap):
 
     atblname = cnfg.ArcsTableName
-    arcsTable = netx.DBHELPER.LoadNetworkFromDB(atblname, cmap)
+    db = netx.DBHELPER(cnfg)
+    arcsTable = db.LoadNetworkFromDB(atblname, cmap)
     ntblname = cnfg.NodesTableName
-    nodesTable = netx.DBHELPER.LoadNodesFromDB(ntblname, cnfg.NodesGeomColumnName, cmap)
+    nodesTable = db.LoadNodesFromDB(ntblname, cnfg.NodesGeomColumnName, cmap)
     withCapacity = False
 
     net = netx.Network(arcsTable, cmap, cnfg)
@@ -147,7 +150,8 @@ def test_load_nodes_2(cnfg, cmap):
 def test_add_nodes_reset(cnfg, cmap):
 
     atblname = cnfg.ArcsTableName
-    arcsTable = netx.DBHELPER.LoadNetworkFromDB(atblname, cmap)
+    db = netx.DBHELPER(cnfg)
+    arcsTable = db.LoadNetworkFromDB(atblname, cmap)
 
     net = netx.Network(arcsTable, cmap, cnfg)
 
@@ -185,7 +189,6 @@ if __name__ == "__main__":
     cnfg, cmap = read_config(path_to_cnfg)
 
     netx.LOGGER.Initialize(cnfg)
-    netx.DBHELPER.Initialize(cnfg)
 
     active_tests = ["build network",
                     "add nodes",
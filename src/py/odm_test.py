@@ -89,7 +89,8 @@ def read_config(path_to_cnfg):
 def test_odm_add_nodes(cnfg, cmap):
 
     atblname = cnfg.ArcsTableName
-    arcsTable = netx.DBHELPER.LoadNetworkFromDB(atblname, cmap)
+    db = netx.DBHELPER(cnfg)
+    arcsTable = db.LoadNetworkFromDB(atblname, cmap)
 
     net = netx.Network(arcsTable, cmap, cnfg)
 
@@ -148,9 +149,10 @@ def test_odm_add_nodes(cnfg, cmap):
 def test_odm_load_nodes(cnfg, cmap):
 
     atblname = cnfg.ArcsTableName
-    arcsTable = netx.DBHELPER.LoadNetworkFromDB(atblname, cmap)
+    db = netx.DBHELPER(cnfg)
+    arcsTable = db.LoadNetworkFromDB(atblname, cmap)
     ntblname = cnfg.NodesTableName
-    nodesTable = netx.DBHELPER.LoadNodesFromDB(ntblname, cnfg.NodesGeomColumnName, cmap)
+    nodesTable = db.LoadNodesFromDB(ntblname, cnfg.NodesGeomColumnName, cmap)
     withCapacity = False
 
     net = netx.Network(arcsTable, cmap, cnfg)
@@ -207,7 +209,6 @@ if __name__ == "__main__":
     print cnfg.SpatiaLiteHome
 
     netx.LOGGER.Initialize(cnfg)
-    netx.DBHELPER.Initialize(cnfg)
 
     alg_dict = {
         0: "Dijkstra_MCFClass",
@@ -31,6 +31,7 @@
 #include "stdint.h"
 #include "lemon-net.hpp"
 #include "dbhelper.hpp"
+#include "netsnapshot.hpp"
 #include "isolver.hpp"
 #include "sptree.hpp"
 #include "odmatrix.hpp"
@@ -61,6 +62,8 @@ namespace std
     %template(ExtNodeSupplies) std::vector<netxpert::data::ExtNodeSupply>;
     %template(ExtDistribution) std::vector<netxpert::data::ExtDistributionArc>;
     %template(FlowCosts) std::vector<netxpert::data::FlowCost>;
+    %template(TransportationCells) std::vector<netxpert::data::TransportationCell>;
+    %template(ODCells) std::vector<netxpert::data::ODCell>;
 
     /* netxpert::data::node_t does not work here */
     %template(Nodes) std::vector<uint32_t>;
@@ -177,6 +180,20 @@ namespace netxpert
         double cost;
     };
 
+    struct ODCell
+    {
+        uint32_t origIdx;
+        uint32_t destIdx;
+        double cost;
+    };
+
+    struct TransportationCell
+    {
+        uint32_t origIdx;
+        uint32_t destIdx;
+        double flow;
+    };
+
     struct NetworkBuilderResultArc
     {
         netxpert::data::ExtArcID extArcID;
@@ -259,7 +276,9 @@ namespace netxpert
         TestAddNodes = 10,
         TestCreateRouteGeometries = 11,
         MCFCOM = 12,
-        TransportationCOMExt = 13
+        TransportationCOMExt = 13,
+        BenchMCFAlgorithms = 15,
+        TransportationDegenerate = 16
     };
 
     enum RESULT_DB_TYPE : int16_t {
@@ -278,14 +297,33 @@ namespace netxpert
            LogFatal = 4,
            LogQuiet = 5   };
 
+    enum NODE_ORDER : int16_t {
+        SortedNodeIDs = 0,
+        BreadthFirst = 1
+    };
+
     enum SPTAlgorithm : int16_t {
         Dijkstra_2Heap_LEMON = 4,
         Bijkstra_2Heap_LEMON = 5,
-        Dijkstra_dheap_BOOST = 6
+        Dijkstra_dheap_BOOST = 6,
+        Dijkstra_2Heap_CSR = 7,
+        ContractionHierarchies = 8,
+        ContractionHierarchies_ManyToMany = 9
     } ;
 
     enum MCFAlgorithm : int16_t {
-        NetworkSimplex_LEMON = 1
+        MCFAutomatic = 0,
+        NetworkSimplex_LEMON = 1,
+        CostScaling_LEMON = 2,
+        CapacityScaling_LEMON = 3
+    } ;
+
+    enum MCFPivotRule : int16_t {
+        FirstEligible = 0,
+        BestEligible = 1,
+        BlockSearch = 2,
+        CandidateList = 3,
+        AlteringList = 4
     } ;
 
     enum MSTAlgorithm : int16_t {
@@ -336,6 +374,17 @@ namespace netxpert
         netxpert::cnfg::LOG_LEVEL LogLevel;
         bool CleanNetwork;//!< Member variable "cleanNetwork"
         std::string LogFileFullPath;
+        bool ODMCostsOnly;
+        bool CSRSinglePrecision;
+        netxpert::cnfg::NODE_ORDER NodeOrder;
+        bool IsolinesTreeBased;
+        bool IsolinesBands;
+        bool IsolinesPolygons;
+        double IsolinesPolygonAlpha;
+        netxpert::cnfg::MCFPivotRule McfPivotRule;
+        int McfIntegerPrecision;
+        bool TransportationDense;
+        int TransportationCandidates;
     };
 
     class ConfigReader {
@@ -368,6 +417,19 @@ namespace netxpert
             std::unordered_map<uint32_t, netxpert::data::NetworkBuilderResultArc> GetBuiltNetwork();
     };
 
+    namespace io {
+
+    class NetworkSnapshot
+    {
+        public:
+            NetworkSnapshot(const std::string& path);
+            ~NetworkSnapshot();
+            uint32_t NodeCount() const;
+            uint32_t ArcCount() const;
+            bool HasGeometries() const;
+    };
+    }
+
     /* Not that not all of the InternalNet functionality is exposed through SWIG */
     namespace data {
 
@@ -381,6 +443,12 @@ namespace netxpert
                         const netxpert::data::InputNodes& nodesTbl = netxpert::data::InputNodes(),
                         const bool autoClean = true);
 
+            InternalNet(const std::string& snapshotPath,
+                        const netxpert::cnfg::Config& cnfg = netxpert::cnfg::Config());
+
+            void
+             SaveSnapshot(const std::string& path, const bool withGeometries = false);
+
             const uint32_t
              AddStartNode(std::string extArcID,
                                       double x, double y, netxpert::data::supply_t supply,
@@ -445,17 +513,14 @@ namespace netxpert
 
     class DBHELPER
     {
-        protected:
-             DBHELPER(){}
         public:
-            static void Initialize(netxpert::cnfg::Config& cnfg);
-            static bool IsInitialized;
-            static void CommitCurrentTransaction();
-            static void OpenNewTransaction();
-            static netxpert::data::InputArcs LoadNetworkFromDB(std::string _tableName, netxpert::data::ColumnMap _map);
-            static netxpert::data::NewNodes LoadNodesFromDB(std::string _tableName, std::string geomColName, const netxpert::data::ColumnMap& _map);
+            DBHELPER(const netxpert::cnfg::Config& cnfg);
+            void CommitCurrentTransaction();
+            void OpenNewTransaction();
+            netxpert::data::InputArcs LoadNetworkFromDB(std::string _tableName, netxpert::data::ColumnMap _map);
+            netxpert::data::NewNodes LoadNodesFromDB(std::string _tableName, std::string geomColName, const netxpert::data::ColumnMap& _map);
 
-            static void CloseConnection();
+            void CloseConnection();
             ~DBHELPER();
     };
     }
@@ -537,8 +602,15 @@ namespace netxpert
             std::vector<uint32_t> GetReachedDestIDs() const;
 
             std::map<netxpert::data::ODPair, netxpert::data::CompressedPath> GetShortestPaths() const;
+            std::map<netxpert::data::ODPair, netxpert::data::CompressedPath> GetShortestPaths(const std::vector<netxpert::data::ODPair>& odPairs);
+            std::vector<netxpert::data::ODCell> SolveSparse(netxpert::data::InternalNet& net,
+                                                            const size_t destLimit,
+                                                            const std::vector<double>& thresholds);
             std::map<netxpert::data::ODPair, double> GetODMatrix() const;
 
+            bool GetCostsOnly() const;
+            void SetCostsOnly(const bool costsOnly);
+
             const double GetOptimum() const;
 
             void SaveResults(const std::string& resultTableName,
@@ -627,6 +699,12 @@ namespace netxpert
 
             void Solve();
             void Solve(netxpert::data::InternalNet& net);
+            void Solve(const std::vector<double>& costs,
+                       const std::vector<double>& supplies,
+                       const std::vector<double>& demands);
+            void Resolve(const std::vector<netxpert::data::ExtNodeSupply>& supplyChanges,
+                         const std::vector<netxpert::data::ExtSPTreeArc>& costChanges);
+            std::vector<netxpert::data::TransportationCell> GetDenseFlows() const;
 
             std::vector<uint32_t> GetOriginIDs() const;
             void SetOrigins(std::vector<uint32_t>  origs);
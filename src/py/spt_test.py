@@ -87,7 +87,8 @@ def read_config(path_to_cnfg):
 def test_spt_add_nodes_1_1(cnfg, cmap, save=False):
 
     atblname = cnfg.ArcsTableName
-    arcsTable = netx.DBHELPER.LoadNetworkFromDB(atblname, cmap)
+    db = netx.DBHELPER(cnfg)
+    arcsTable = db.LoadNetworkFromDB(atblname, cmap)
 
     net = netx.Network(arcsTable, cmap, cnfg)
     solver = netx.ShortestPathTree(cnfg)
@@ -139,7 +140,8 @@ def test_spt_add_nodes_1_1(cnfg, cmap, save=False):
 def test_spt_add_nodes_1_1_germany_s_t(cnfg, cmap):
 
     atblname = cnfg.ArcsTableName
-    arcsTable = netx.DBHELPER.LoadNetworkFromDB(atblname, cmap)
+    db = netx.DBHELPER(cnfg)
+    arcsTable = db.LoadNetworkFromDB(atblname, cmap)
 
     net = netx.Network(arcsTable, cmap, cnfg)
 
@@ -174,7 +176,8 @@ def test_spt_add_nodes_1_1_germany_s_t(cnfg, cmap):
 def test_spt_add_nodes_1_n(cnfg, cmap):
 
     atblname = cnfg.ArcsTableName
-    arcsTable = netx.DBHELPER.LoadNetworkFromDB(atblname, cmap)
+    db = netx.DBHELPER(cnfg)
+    arcsTable = db.LoadNetworkFromDB(atblname, cmap)
 
     net = netx.Network(arcsTable, cmap, cnfg)
 
@@ -217,10 +220,10 @@ def test_spt_add_nodes_1_n(cnfg, cmap):
 def test_spt_add_nodes_1_all(cnfg, cmap):
 
     # netx.LOGGER.Initialize(cnfg)
-    # netx.DBHELPER.Initialize(cnfg)
 
     atblname = cnfg.ArcsTableName
-    arcsTable = netx.DBHELPER.LoadNetworkFromDB(atblname, cmap)
+    db = netx.DBHELPER(cnfg)
+    arcsTable = db.LoadNetworkFromDB(atblname, cmap)
 
     net = netx.Network(arcsTable, cmap, cnfg)
 
@@ -245,9 +248,10 @@ def test_spt_add_nodes_1_all(cnfg, cmap):
 def test_spt_load_nodes_1_n(cnfg, cmap):
 
     atblname = cnfg.ArcsTableName
-    arcsTable = netx.DBHELPER.LoadNetworkFromDB(atblname, cmap)
+    db = netx.DBHELPER(cnfg)
+    arcsTable = db.LoadNetworkFromDB(atblname, cmap)
     ntblname = cnfg.NodesTableName
-    nodesTable = netx.DBHELPER.LoadNodesFromDB(ntblname, cnfg.NodesGeomColumnName, cmap)
+    nodesTable = db.LoadNodesFromDB(ntblname, cnfg.NodesGeomColumnName, cmap)
     withCapacity = False
 
     net = netx.Network(arcsTable, cmap, cnfg)
@@ -275,7 +279,8 @@ def test_spt_load_nodes_1_n(cnfg, cmap):
 def test_spt_add_nodes_1_1_germany_s_t_ch(cnfg, cmap):
 
     atblname = cnfg.ArcsTableName
-    arcsTable = netx.DBHELPER.LoadNetworkFromDB(atblname, cmap)
+    db = netx.DBHELPER(cnfg)
+    arcsTable = db.LoadNetworkFromDB(atblname, cmap)
 
     net = netx.Network(arcsTable, cmap, cnfg)
 
@@ -341,7 +346,6 @@ if __name__ == "__main__":
     cnfg.LogLevel = -1
 
     netx.LOGGER.Initialize(cnfg)
-    netx.DBHELPER.Initialize(cnfg)
 
     alg_dict = {
         0: "Dijkstra_MCFClass",
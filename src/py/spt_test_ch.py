@@ -84,7 +84,8 @@ def read_config(path_to_cnfg):
 def test_contraction(cnfg, cmap):
 
     atblname = cnfg.ArcsTableName
-    arcsTable = netx.DBHELPER.LoadNetworkFromDB(atblname, cmap)
+    db = netx.DBHELPER(cnfg)
+    arcsTable = db.LoadNetworkFromDB(atblname, cmap)
 
     net = netx.Network(arcsTable, cmap, cnfg)
 
@@ -110,7 +111,8 @@ def test_contraction(cnfg, cmap):
 def test_spt_add_nodes_1_1_ch(cnfg, cmap):
 
     atblname = cnfg.ArcsTableName
-    arcsTable = netx.DBHELPER.LoadNetworkFromDB(atblname, cmap)
+    db = netx.DBHELPER(cnfg)
+    arcsTable = db.LoadNetworkFromDB(atblname, cmap)
 
     net = netx.Network(arcsTable, cmap, cnfg)
 
@@ -207,7 +209,6 @@ if __name__ == "__main__":
     print cnfg.SpatiaLiteHome
 
     netx.LOGGER.Initialize(cnfg)
-    netx.DBHELPER.Initialize(cnfg)
 
     active_tests =  ["ch only",
                      "1-1 | add nodes",
@@ -0,0 +1,251 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include "routegeometry.hpp"
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+#include "geos/geom/CoordinateSequenceFactory.h"
+#include "geos/geom/LineString.h"
+
+using namespace std;
+using namespace netxpert::data;
+
+namespace {
+
+    inline double dist2(const double x1, const double y1, const double x2, const double y2) {
+        return (x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2);
+    }
+
+    template<typename T>
+    inline void putValue(std::string& out, const T value) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.append(bytes, sizeof(T));
+    }
+
+    inline void putPolylineValue(std::string& out, const int64_t value) {
+        //zig zag: sign in the lowest bit
+        uint64_t v = static_cast<uint64_t>(value) << 1;
+        if (value < 0)
+            v = ~v;
+        while (v >= 0x20) {
+            out.push_back( static_cast<char>((0x20 | (v & 0x1f)) + 63) );
+            v >>= 5;
+        }
+        out.push_back( static_cast<char>(v + 63) );
+    }
+}
+
+void
+ RouteGeometryBuilder::Clear() {
+
+    this->xy.clear();
+    this->lineOffsets.clear();
+}
+
+void
+ RouteGeometryBuilder::NewPart() {
+
+    if (Size() > lineBegin(this->lineOffsets.size()))
+        this->lineOffsets.push_back(Size());
+}
+
+size_t
+ RouteGeometryBuilder::lineBegin(const size_t line) const {
+
+    if (line == 0)
+        return 0;
+    if (line > this->lineOffsets.size())
+        return Size();
+    return this->lineOffsets[line - 1];
+}
+
+size_t
+ RouteGeometryBuilder::LineCount() const {
+
+    size_t count = 0;
+    for (size_t line = 0; line <= this->lineOffsets.size(); line++) {
+        if (lineBegin(line + 1) - lineBegin(line) > 1)
+            count++;
+    }
+    return count;
+}
+
+void
+ RouteGeometryBuilder::reverse(const size_t from) {
+
+    size_t i = from;
+    size_t j = this->xy.size() - 2;
+    while (i < j) {
+        std::swap(this->xy[i], this->xy[j]);
+        std::swap(this->xy[i + 1], this->xy[j + 1]);
+        i += 2;
+        j -= 2;
+    }
+}
+
+void
+ RouteGeometryBuilder::Append(const double* coords, const uint32_t size, const bool reversed) {
+
+    if (size == 0)
+        return;
+
+    const size_t begin = 2 * lineBegin(this->lineOffsets.size());
+    const size_t from = this->xy.size();
+    this->xy.insert(this->xy.end(), coords, coords + 2 * size);
+    if (reversed)
+        reverse(from);
+    //shared coordinate of two consecutive arcs only once
+    if (from > begin && this->xy[from] == this->xy[from - 2] && this->xy[from + 1] == this->xy[from - 1])
+        this->xy.erase(this->xy.begin() + from, this->xy.begin() + from + 2);
+}
+
+void
+ RouteGeometryBuilder::AppendSection(const double* coords, const uint32_t size, const double from, const double to) {
+
+    NewPart();
+    if (size < 2)
+        return;
+
+    const size_t begin = this->xy.size();
+    const double lo = std::max(0.0, std::min(from, to));
+    const double hi = std::min(1.0, std::max(from, to));
+
+    double length = 0;
+    for (uint32_t i = 1; i < size; i++)
+        length += std::sqrt(dist2(coords[2 * i - 2], coords[2 * i - 1], coords[2 * i], coords[2 * i + 1]));
+    const double loPos = lo * length;
+    const double hiPos = hi * length;
+
+    //walk the segments and keep the part between loPos and hiPos
+    double pos = 0;
+    for (uint32_t i = 1; i < size; i++) {
+        const double x1 = coords[2 * i - 2];
+        const double y1 = coords[2 * i - 1];
+        const double x2 = coords[2 * i];
+        const double y2 = coords[2 * i + 1];
+        const double segLength = std::sqrt(dist2(x1, y1, x2, y2));
+        const double next = pos + segLength;
+
+        if (next >= loPos && this->xy.size() == begin) {
+            const double t = segLength > 0 ? (loPos - pos) / segLength : 0;
+            this->xy.push_back(x1 + t * (x2 - x1));
+            this->xy.push_back(y1 + t * (y2 - y1));
+        }
+        if (this->xy.size() > begin) {
+            if (next >= hiPos || i == size - 1) {
+                const double t = segLength > 0 ? std::min(1.0, (hiPos - pos) / segLength) : 1;
+                this->xy.push_back(t == 1.0 ? x2 : x1 + t * (x2 - x1));
+                this->xy.push_back(t == 1.0 ? y2 : y1 + t * (y2 - y1));
+                break;
+            }
+            this->xy.push_back(x2);
+            this->xy.push_back(y2);
+        }
+        pos = next;
+    }
+
+    if (from > to)
+        reverse(begin);
+}
+
+std::string
+ RouteGeometryBuilder::ToJSON(const int decimals) const {
+
+    std::ostringstream coordStr;
+    coordStr << std::fixed << std::setprecision(decimals) << "[";
+    for (size_t i = 0; i < this->xy.size(); i += 2) {
+        if (i > 0)
+            coordStr << ",";
+        coordStr << "[" << this->xy[i] << "," << this->xy[i + 1] << "]";
+    }
+    coordStr << "]";
+    return coordStr.str();
+}
+
+std::string
+ RouteGeometryBuilder::ToWKB() const {
+
+    const uint16_t one = 1;
+    const unsigned char byteOrder = *reinterpret_cast<const unsigned char*>(&one) == 1 ? 1 : 0;
+    const uint32_t numLines = static_cast<uint32_t>(LineCount());
+
+    std::string wkb;
+    wkb.reserve(9 + numLines * 9 + 8 * this->xy.size());
+    //MultiLineString
+    wkb.push_back( static_cast<char>(byteOrder) );
+    putValue<uint32_t>(wkb, 5);
+    putValue<uint32_t>(wkb, numLines);
+    //LineStrings
+    for (size_t line = 0; line <= this->lineOffsets.size(); line++) {
+        const size_t first = lineBegin(line);
+        const size_t last = lineBegin(line + 1);
+        if (last - first < 2)
+            continue;
+        wkb.push_back( static_cast<char>(byteOrder) );
+        putValue<uint32_t>(wkb, 2);
+        putValue<uint32_t>(wkb, static_cast<uint32_t>(last - first));
+        for (size_t i = 2 * first; i < 2 * last; i++)
+            putValue<double>(wkb, this->xy[i]);
+    }
+    return wkb;
+}
+
+std::string
+ RouteGeometryBuilder::ToPolyline(const int precision) const {
+
+    const double factor = std::pow(10.0, precision);
+    std::string result;
+    result.reserve(this->xy.size() * 4);
+    int64_t prevX = 0;
+    int64_t prevY = 0;
+    for (size_t i = 0; i < this->xy.size(); i += 2) {
+        const int64_t x = std::llround(this->xy[i] * factor);
+        const int64_t y = std::llround(this->xy[i + 1] * factor);
+        putPolylineValue(result, y - prevY);
+        putPolylineValue(result, x - prevX);
+        prevX = x;
+        prevY = y;
+    }
+    return result;
+}
+
+std::unique_ptr<geos::geom::MultiLineString>
+ RouteGeometryBuilder::ToMultiLineString(const geos::geom::GeometryFactory& factory) const {
+
+    using namespace geos::geom;
+
+    if (LineCount() == 0)
+        return std::unique_ptr<MultiLineString>( factory.createMultiLineString() );
+
+    //the sequences, the lines and the multilinestring take the ownership
+    std::vector<Geometry*>* lines = new std::vector<Geometry*>();
+    for (size_t line = 0; line <= this->lineOffsets.size(); line++) {
+        const size_t first = lineBegin(line);
+        const size_t last = lineBegin(line + 1);
+        if (last - first < 2)
+            continue;
+        std::vector<Coordinate>* coords = new std::vector<Coordinate>();
+        coords->reserve(last - first);
+        for (size_t i = first; i < last; i++)
+            coords->push_back( Coordinate(this->xy[2 * i], this->xy[2 * i + 1]) );
+        lines->push_back( factory.createLineString( factory.getCoordinateSequenceFactory()->create(coords) ) );
+    }
+    return std::unique_ptr<MultiLineString>( factory.createMultiLineString(lines) );
+}
@@ -59,11 +59,6 @@ int netxpert::simple::Isolines::Solve()
         Config cnfg = NETXPERT_CNFG;
 
         //1. Config
-        if (!DBHELPER::IsInitialized)
-        {
-            DBHELPER::Initialize(cnfg);
-        }
-
         try
         {
             if (!LOGGER::IsInitialized)
@@ -77,7 +72,7 @@ int netxpert::simple::Isolines::Solve()
             cout << ex.what() << endl;
         }
 
-        InputArcs arcsTable;
+        InputArcColumns arcsTable;
         vector<NewNode> nodesTable;
         string arcsGeomColumnName = cnfg.ArcsGeomColumnName;
 
@@ -101,23 +96,24 @@ int netxpert::simple::Isolines::Solve()
 //		LOGGER::LogInfo("Using # " + to_string(LOCAL_NUM_THREADS) + " threads.");
 
         //2. Load Network
-        DBHELPER::OpenNewTransaction();
+        auto dbHelper = make_shared<DBHELPER>(cnfg);
+        dbHelper->OpenNewTransaction();
         LOGGER::LogInfo("Loading Data from DB..!");
-        arcsTable = DBHELPER::LoadNetworkFromDB(arcsTableName, cmap);
-        nodesTable = DBHELPER::LoadNodesFromDB(nodesTableName, cnfg.NodesGeomColumnName, cmap);
+        arcsTable = dbHelper->LoadNetworkColumnsFromDB(arcsTableName, cmap);
+        nodesTable = dbHelper->LoadNodesFromDB(nodesTableName, cnfg.NodesGeomColumnName, cmap);
 
         LOGGER::LogInfo("Done!");
 
         LOGGER::LogInfo("Converting Data into internal network..");
-        InternalNet net (arcsTable, cmap, cnfg);
+        InternalNet net (arcsTable, cmap, cnfg, netxpert::data::InputNodes{}, true, dbHelper);
         LOGGER::LogInfo("Done!");
 
         LOGGER::LogInfo("Loading Start nodes..");
         vector<pair<uint32_t, string>> startNodes = net.LoadStartNodes(nodesTable, cnfg.Threshold, arcsTableName,
                                                                         cnfg.ArcsGeomColumnName, cmap, withCapacity);
 
-        DBHELPER::CommitCurrentTransaction();
-        DBHELPER::CloseConnection();
+        dbHelper->CommitCurrentTransaction();
+        dbHelper->CloseConnection();
 
         //solve
         this->solver = unique_ptr<netxpert::ShortestPathTree> (new netxpert::ShortestPathTree(cnfg));
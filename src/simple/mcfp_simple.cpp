@@ -38,11 +38,6 @@ int netxpert::simple::MinCostFlow::Solve()
         Config cnfg = NETXPERT_CNFG;
 
         //1. Config
-        if (!DBHELPER::IsInitialized)
-        {
-            DBHELPER::Initialize(cnfg);
-        }
-
         try
         {
             if (!LOGGER::IsInitialized)
@@ -56,7 +51,7 @@ int netxpert::simple::MinCostFlow::Solve()
             cout << ex.what() << endl;
         }
 
-        InputArcs arcsTable;
+        InputArcColumns arcsTable;
         vector<NewNode> nodesTable;
         string arcsGeomColumnName = cnfg.ArcsGeomColumnName;
 
@@ -81,14 +76,15 @@ int netxpert::simple::MinCostFlow::Solve()
             withCapacity = true;
 
         //2. Load Network
-        DBHELPER::OpenNewTransaction();
+        auto dbHelper = make_shared<DBHELPER>(cnfg);
+        dbHelper->OpenNewTransaction();
         LOGGER::LogInfo("Loading Data from DB..!");
-        arcsTable = DBHELPER::LoadNetworkFromDB(arcsTableName, cmap);
-        nodesTable = DBHELPER::LoadNodesFromDB(nodesTableName, cnfg.NodesGeomColumnName, cmap);
+        arcsTable = dbHelper->LoadNetworkColumnsFromDB(arcsTableName, cmap);
+        nodesTable = dbHelper->LoadNodesFromDB(nodesTableName, cnfg.NodesGeomColumnName, cmap);
         LOGGER::LogInfo("Done!");
 
         LOGGER::LogInfo("Converting Data into internal network..");
-        InternalNet net (arcsTable, cmap, cnfg);
+        InternalNet net (arcsTable, cmap, cnfg, netxpert::data::InputNodes{}, true, dbHelper);
         LOGGER::LogInfo("Done!");
 
         LOGGER::LogInfo("Loading Start nodes..");
@@ -100,8 +96,8 @@ int netxpert::simple::MinCostFlow::Solve()
 
         LOGGER::LogInfo("Done!");
 
-        DBHELPER::CommitCurrentTransaction();
-        DBHELPER::CloseConnection();
+        dbHelper->CommitCurrentTransaction();
+        dbHelper->CloseConnection();
         LOGGER::LogInfo("Done!");
 
         //MCF Solver
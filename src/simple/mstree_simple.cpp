@@ -38,11 +38,6 @@ int netxpert::simple::MinimumSpanningTree::Solve()
         Config cnfg = NETXPERT_CNFG;
 
         //1. Config
-        if (!DBHELPER::IsInitialized)
-        {
-            DBHELPER::Initialize(cnfg);
-        }
-
         try
         {
             if (!LOGGER::IsInitialized)
@@ -56,7 +51,7 @@ int netxpert::simple::MinimumSpanningTree::Solve()
             cout << ex.what() << endl;
         }
 
-        InputArcs arcsTable;
+        InputArcColumns arcsTable;
         string arcsGeomColumnName = cnfg.ArcsGeomColumnName;
 
         string pathToSpatiaLiteDB = cnfg.NetXDBPath;
@@ -74,16 +69,17 @@ int netxpert::simple::MinimumSpanningTree::Solve()
                         cnfg.NodeIDColumnName, cnfg.NodeSupplyColumnName };
 
         //2. Load Network
-        DBHELPER::OpenNewTransaction();
+        auto dbHelper = make_shared<DBHELPER>(cnfg);
+        dbHelper->OpenNewTransaction();
         LOGGER::LogInfo("Loading Data from DB..!");
-        arcsTable = DBHELPER::LoadNetworkFromDB(arcsTableName, cmap);
+        arcsTable = dbHelper->LoadNetworkColumnsFromDB(arcsTableName, cmap);
         LOGGER::LogInfo("Done!");
 
         LOGGER::LogInfo("Converting Data into internal network..");
-        InternalNet net (arcsTable, cmap, cnfg);
+        InternalNet net (arcsTable, cmap, cnfg, netxpert::data::InputNodes{}, true, dbHelper);
 
-        DBHELPER::CommitCurrentTransaction();
-        DBHELPER::CloseConnection();
+        dbHelper->CommitCurrentTransaction();
+        dbHelper->CloseConnection();
         LOGGER::LogInfo("Done!");
 
         //MST Solver
@@ -46,11 +46,6 @@ int netxpert::simple::NetworkBuilder::Build()
 		Config cnfg = this->NETXPERT_CNFG;
 
 		//1. Config
-		if (!DBHELPER::IsInitialized)
-		{
-			DBHELPER::Initialize(cnfg);
-		}
-
 		try
 		{
 			if (!LOGGER::IsInitialized)
@@ -37,11 +37,6 @@ int netxpert::simple::OriginDestinationMatrix::Solve()
         Config cnfg = NETXPERT_CNFG;
 
         //1. Config
-        if (!DBHELPER::IsInitialized)
-        {
-            DBHELPER::Initialize(cnfg);
-        }
-
         try
         {
             if (!LOGGER::IsInitialized)
@@ -55,7 +50,7 @@ int netxpert::simple::OriginDestinationMatrix::Solve()
             std::cout << ex.what() << std::endl;
         }
 
-        InputArcs arcsTable;
+        InputArcColumns arcsTable;
         std::vector<NewNode> nodesTable;
 
         std::string arcsGeomColumnName = cnfg.ArcsGeomColumnName;
@@ -77,15 +72,16 @@ int netxpert::simple::OriginDestinationMatrix::Solve()
             withCapacity = true;
 
         //2. Load Network
-        DBHELPER::OpenNewTransaction();
+        auto dbHelper = make_shared<DBHELPER>(cnfg);
+        dbHelper->OpenNewTransaction();
         LOGGER::LogInfo("Loading Data from DB..!");
-        arcsTable = DBHELPER::LoadNetworkFromDB(arcsTableName, cmap);
-        nodesTable = DBHELPER::LoadNodesFromDB(nodesTableName, cnfg.NodesGeomColumnName, cmap);
+        arcsTable = dbHelper->LoadNetworkColumnsFromDB(arcsTableName, cmap);
+        nodesTable = dbHelper->LoadNodesFromDB(nodesTableName, cnfg.NodesGeomColumnName, cmap);
 
         LOGGER::LogInfo("Done!");
 
         LOGGER::LogInfo("Converting Data into internal network..");
-        InternalNet net (arcsTable, cmap, cnfg);
+        InternalNet net (arcsTable, cmap, cnfg, netxpert::data::InputNodes{}, true, dbHelper);
         LOGGER::LogInfo("Done!");
 
         LOGGER::LogInfo("Loading Start nodes..");
@@ -95,8 +91,8 @@ int netxpert::simple::OriginDestinationMatrix::Solve()
         std::vector<std::pair<uint32_t, std::string>> endNodes = net.LoadEndNodes(nodesTable, cnfg.Threshold, arcsTableName,
                                                                         cnfg.ArcsGeomColumnName, cmap, withCapacity);
 
-        DBHELPER::CommitCurrentTransaction();
-        DBHELPER::CloseConnection();
+        dbHelper->CommitCurrentTransaction();
+        dbHelper->CloseConnection();
 
         // Solver
         solver = std::unique_ptr<netxpert::OriginDestinationMatrix> (new netxpert::OriginDestinationMatrix(cnfg));
@@ -112,6 +108,7 @@ int netxpert::simple::OriginDestinationMatrix::Solve()
             dests.push_back(net.GetNodeFromID(e.first));
 
         odm.SetDestinations( dests );
+        odm.SetCostsOnly( cnfg.ODMCostsOnly );
 
         odm.Solve(net);
 
@@ -143,11 +140,6 @@ int netxpert::simple::OriginDestinationMatrix::Solve(bool doParallel)
         Config cnfg = NETXPERT_CNFG;
 
         //1. Config
-        if (!DBHELPER::IsInitialized)
-        {
-            DBHELPER::Initialize(cnfg);
-        }
-
         try
         {
             if (!LOGGER::IsInitialized)
@@ -161,7 +153,7 @@ int netxpert::simple::OriginDestinationMatrix::Solve(bool doParallel)
             std::cout << ex.what() << std::endl;
         }
 
-        InputArcs arcsTable;
+        InputArcColumns arcsTable;
         std::vector<NewNode> nodesTable;
 
         std::string arcsGeomColumnName = cnfg.ArcsGeomColumnName;
@@ -185,14 +177,15 @@ int netxpert::simple::OriginDestinationMatrix::Solve(bool doParallel)
 //		LOGGER::LogInfo("Using # " + to_string(LOCAL_NUM_THREADS) + " threads.");
 
         //2. Load Network
-        DBHELPER::OpenNewTransaction();
+        auto dbHelper = make_shared<DBHELPER>(cnfg);
+        dbHelper->OpenNewTransaction();
         LOGGER::LogInfo("Loading Data from DB..!");
-        arcsTable = DBHELPER::LoadNetworkFromDB(arcsTableName, cmap);
-        nodesTable = DBHELPER::LoadNodesFromDB(nodesTableName, cnfg.NodesGeomColumnName, cmap);
+        arcsTable = dbHelper->LoadNetworkColumnsFromDB(arcsTableName, cmap);
+        nodesTable = dbHelper->LoadNodesFromDB(nodesTableName, cnfg.NodesGeomColumnName, cmap);
         LOGGER::LogInfo("Done!");
 
         LOGGER::LogInfo("Converting Data into internal network..");
-        InternalNet net (arcsTable, cmap, cnfg);
+        InternalNet net (arcsTable, cmap, cnfg, netxpert::data::InputNodes{}, true, dbHelper);
         LOGGER::LogInfo("Done!");
 
         LOGGER::LogInfo("Loading Start nodes..");
@@ -202,8 +195,8 @@ int netxpert::simple::OriginDestinationMatrix::Solve(bool doParallel)
         std::vector<std::pair<uint32_t, std::string>> endNodes = net.LoadEndNodes(nodesTable, cnfg.Threshold, arcsTableName,
                                                                         cnfg.ArcsGeomColumnName, cmap, withCapacity);
 
-        DBHELPER::CommitCurrentTransaction();
-        DBHELPER::CloseConnection();
+        dbHelper->CommitCurrentTransaction();
+        dbHelper->CloseConnection();
 
 
         solver = std::unique_ptr<netxpert::OriginDestinationMatrix> (new netxpert::OriginDestinationMatrix(cnfg));
@@ -220,6 +213,7 @@ int netxpert::simple::OriginDestinationMatrix::Solve(bool doParallel)
             dests.push_back(net.GetNodeFromID(e.first));
 
         odm.SetDestinations( dests );
+        odm.SetCostsOnly( cnfg.ODMCostsOnly );
 
         odm.Solve(net);
 
@@ -38,11 +38,6 @@ int netxpert::simple::ShortestPathTree::Solve()
         Config cnfg = NETXPERT_CNFG;
 
         //1. Config
-        if (!DBHELPER::IsInitialized)
-        {
-            DBHELPER::Initialize(cnfg);
-        }
-
         try
         {
             if (!LOGGER::IsInitialized)
@@ -56,7 +51,7 @@ int netxpert::simple::ShortestPathTree::Solve()
             cout << ex.what() << endl;
         }
 
-        InputArcs arcsTable;
+        InputArcColumns arcsTable;
         vector<NewNode> nodesTable;
         string arcsGeomColumnName = cnfg.ArcsGeomColumnName;
 
@@ -80,15 +75,16 @@ int netxpert::simple::ShortestPathTree::Solve()
 //      LOGGER::LogInfo("Using # " + to_string(LOCAL_NUM_THREADS) + " threads.");
 
         //2. Load Network
-        DBHELPER::OpenNewTransaction();
+        auto dbHelper = make_shared<DBHELPER>(cnfg);
+        dbHelper->OpenNewTransaction();
         LOGGER::LogInfo("Loading Data from DB..!");
-        arcsTable = DBHELPER::LoadNetworkFromDB(arcsTableName, cmap);
-        nodesTable = DBHELPER::LoadNodesFromDB(nodesTableName, cnfg.NodesGeomColumnName, cmap);
+        arcsTable = dbHelper->LoadNetworkColumnsFromDB(arcsTableName, cmap);
+        nodesTable = dbHelper->LoadNodesFromDB(nodesTableName, cnfg.NodesGeomColumnName, cmap);
 
         LOGGER::LogInfo("Done!");
 
         LOGGER::LogInfo("Converting Data into internal network..");
-        InternalNet net (arcsTable, cmap, cnfg, netxpert::data::InputNodes{}, autoCleanNetwork);
+        InternalNet net (arcsTable, cmap, cnfg, netxpert::data::InputNodes{}, autoCleanNetwork, dbHelper);
         LOGGER::LogInfo("Done!");
 
 //        net.PrintGraph();
@@ -106,8 +102,8 @@ int netxpert::simple::ShortestPathTree::Solve()
         }
 //        net.PrintGraph();
 
-        DBHELPER::CommitCurrentTransaction();
-        DBHELPER::CloseConnection();
+        dbHelper->CommitCurrentTransaction();
+        dbHelper->CloseConnection();
 
         //solve
         this->solver = unique_ptr<netxpert::ShortestPathTree> (new netxpert::ShortestPathTree(cnfg));
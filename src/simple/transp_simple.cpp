@@ -36,11 +36,6 @@ int netxpert::simple::Transportation::Solve()
     {
         Config cnfg = NETXPERT_CNFG;
         //1. Config
-        if (!DBHELPER::IsInitialized)
-        {
-            DBHELPER::Initialize(cnfg);
-        }
-
         try
         {
             if (!LOGGER::IsInitialized)
@@ -54,7 +49,7 @@ int netxpert::simple::Transportation::Solve()
             cout << ex.what() << endl;
         }
 
-        InputArcs arcsTable;
+        InputArcColumns arcsTable;
         vector<NewNode> nodesTable;
 
         string arcsGeomColumnName = cnfg.ArcsGeomColumnName;
@@ -80,14 +75,15 @@ int netxpert::simple::Transportation::Solve()
 //		LOGGER::LogInfo("Using # " + to_string(LOCAL_NUM_THREADS) + " threads.");
 
         //2. Load Network
-        DBHELPER::OpenNewTransaction();
+        auto dbHelper = make_shared<DBHELPER>(cnfg);
+        dbHelper->OpenNewTransaction();
         LOGGER::LogInfo("Loading Data from DB..!");
-        arcsTable = DBHELPER::LoadNetworkFromDB(arcsTableName, cmap);
-        nodesTable = DBHELPER::LoadNodesFromDB(nodesTableName, cnfg.NodesGeomColumnName, cmap);
+        arcsTable = dbHelper->LoadNetworkColumnsFromDB(arcsTableName, cmap);
+        nodesTable = dbHelper->LoadNodesFromDB(nodesTableName, cnfg.NodesGeomColumnName, cmap);
         LOGGER::LogInfo("Done!");
 
         LOGGER::LogInfo("Converting Data into internal network..");
-        InternalNet net (arcsTable, cmap, cnfg);
+        InternalNet net (arcsTable, cmap, cnfg, netxpert::data::InputNodes{}, true, dbHelper);
         LOGGER::LogInfo("Done!");
 
         LOGGER::LogInfo("Loading Start nodes..");
@@ -98,8 +94,8 @@ int netxpert::simple::Transportation::Solve()
                                                                         cnfg.ArcsGeomColumnName, cmap, withCapacity);
 
         LOGGER::LogInfo("Done!");
-        DBHELPER::CommitCurrentTransaction();
-        DBHELPER::CloseConnection();
+        dbHelper->CommitCurrentTransaction();
+        dbHelper->CloseConnection();
 
         //Transportation Solver
         solver = unique_ptr<netxpert::Transportation> (new netxpert::Transportation(cnfg));
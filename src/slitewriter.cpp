@@ -15,6 +15,7 @@
  */
 
 #include "slitewriter.hpp"
+#include <chrono>
 
 #ifdef SQLITECPP_ENABLE_ASSERT_HANDLER
  namespace SQLite
@@ -70,6 +71,7 @@ SpatiaLiteWriter::SpatiaLiteWriter(Config& cnfg, std::string dbPath)
 SpatiaLiteWriter::~SpatiaLiteWriter()
 {
     //dtor
+    FinishResultPipeline();
     /*if (connPtr)
         delete connPtr;
     if (currentTransactionPtr)
@@ -206,6 +208,9 @@ void SpatiaLiteWriter::CreateSolverResultTable(const string& _tableName, const N
         case NetXpertSolver::NetworkBuilderResult:
             recoverGeometryColumn(_tableName, "geometry", "LINESTRING");
             break;
+        case NetXpertSolver::IsolinesPolygonSolver:
+            recoverGeometryColumn(_tableName, "geometry", "MULTIPOLYGON");
+            break;
         default:
             recoverGeometryColumn(_tableName, "geometry", "MULTILINESTRING");
             break;
@@ -363,6 +368,16 @@ void SpatiaLiteWriter::createTable (const string& _tableName, const NetXpertSolv
                             "geometry MULTILINESTRING)";
             break;
         }
+        case NetXpertSolver::IsolinesPolygonSolver:
+        {
+            strSQL = "CREATE TABLE "+_tableName +
+                           " (PK_UID INTEGER PRIMARY KEY AUTOINCREMENT,"+
+                            "fromNode TEXT,"+
+                            "cost DOUBLE,"+
+                            "cutoff DOUBLE,"+
+                            "geometry MULTIPOLYGON)";
+            break;
+        }
         default: //MCF, TPs
         {
             strSQL = "CREATE TABLE "+_tableName +
@@ -453,6 +468,7 @@ std::unique_ptr<SQLite::Statement> SpatiaLiteWriter::PrepareSaveResultArc(const
                                            "(@orig,@dest,@cost,GeomFromWKB(@geom))";
             break;
         case NetXpertSolver::IsolinesSolver:
+        case NetXpertSolver::IsolinesPolygonSolver:
             sqlStr = "INSERT INTO "+_tableName +"(fromNode,cost,cutoff,geometry) VALUES " +
                                            "(@orig,@cost,@cutoff,GeomFromWKB(@geom))";
             break;
@@ -848,7 +864,7 @@ void SpatiaLiteWriter::CloseConnection()
 {
     try
     {
-
+        FinishResultPipeline();
     }
     catch (std::exception& ex)
     {
@@ -856,3 +872,228 @@ void SpatiaLiteWriter::CloseConnection()
         LOGGER::LogError( ex.what() );
     }
 }
+
+//Result pipeline
+std::unique_ptr<SQLite::Statement> SpatiaLiteWriter::prepareResultRows(const std::string& _tableName,
+                                                                       const NetXpertSolver solverType,
+                                                                       const size_t rowCount)
+{
+    string columns;
+    string values;
+    switch (solverType)
+    {
+    case NetXpertSolver::ShortestPathTreeSolver:
+    case NetXpertSolver::ODMatrixSolver:
+        columns = "fromNode,toNode,cost,geometry";
+        values = "(?,?,?,GeomFromWKB(?))";
+        break;
+    case NetXpertSolver::IsolinesSolver:
+    case NetXpertSolver::IsolinesPolygonSolver:
+        columns = "fromNode,cost,cutoff,geometry";
+        values = "(?,?,?,GeomFromWKB(?))";
+        break;
+    case NetXpertSolver::MinCostFlowSolver:
+    case NetXpertSolver::TransportationSolver:
+    case NetXpertSolver::TransshipmentSolver:
+        columns = "fromNode,toNode,cost,capacity,flow,geometry";
+        values = "(?,?,?,?,?,GeomFromWKB(?))";
+        break;
+    default:
+        throw std::invalid_argument("Result rows are not supported for solver type "+ to_string(solverType) +"!");
+    }
+
+    string sqlStr = "INSERT INTO "+ _tableName +"("+ columns +") VALUES "+ values;
+    for (size_t i = 1; i < rowCount; i++)
+        sqlStr += ","+ values;
+
+    if (!isConnected)
+        connect();
+    SQLite::Database& db = *connPtr;
+    return unique_ptr<SQLite::Statement>(new SQLite::Statement(db, sqlStr));
+}
+
+void SpatiaLiteWriter::bindResultRow(SQLite::Statement& query, int& index, const ResultRow& row,
+                                     const NetXpertSolver solverType)
+{
+    query.bind(index++, row.orig);
+    switch (solverType)
+    {
+    case NetXpertSolver::IsolinesSolver:
+    case NetXpertSolver::IsolinesPolygonSolver:
+        query.bind(index++, row.cost);
+        query.bind(index++, row.cutoff);
+        break;
+    case NetXpertSolver::ShortestPathTreeSolver:
+    case NetXpertSolver::ODMatrixSolver:
+        query.bind(index++, row.dest);
+        query.bind(index++, row.cost);
+        break;
+    default: //MCF, TP
+        query.bind(index++, row.dest);
+        query.bind(index++, row.cost);
+        query.bind(index++, row.capacity);
+        query.bind(index++, row.flow);
+        break;
+    }
+    query.bind(index++, row.geomWKB.data(), static_cast<int>(row.geomWKB.size()));
+}
+
+/**
+* Writes and removes the first count rows: full batches with the multi-row insert, the rest row by row.
+*/
+void SpatiaLiteWriter::writeResultRows(std::vector<ResultRow>& rows, const size_t count)
+{
+    size_t i = 0;
+    for ( ; i + RESULT_BATCH_ROWS <= count; i += RESULT_BATCH_ROWS)
+    {
+        int index = 1;
+        for (size_t r = i; r < i + RESULT_BATCH_ROWS; r++)
+            bindResultRow(*resultBatchQuery, index, rows[r], resultSolverType);
+        resultBatchQuery->exec();
+        resultBatchQuery->reset();
+    }
+    for ( ; i < count; i++)
+    {
+        int index = 1;
+        bindResultRow(*resultRowQuery, index, rows[i], resultSolverType);
+        resultRowQuery->exec();
+        resultRowQuery->reset();
+    }
+    rows.erase(rows.begin(), rows.begin() + count);
+
+    resultRowsInTransaction += count;
+    if (resultRowsInTransaction >= RESULT_COMMIT_ROWS && currentTransactionPtr)
+    {
+        CommitCurrentTransaction();
+        OpenNewTransaction();
+        resultRowsInTransaction = 0;
+    }
+}
+
+/**
+* Writer thread: drains the queue in batches. Partial batches are written only when the pipeline stops,
+* so every insert but the last few uses the multi-row statement.
+*/
+void SpatiaLiteWriter::runResultPipeline()
+{
+    vector<ResultRow> rows;
+    rows.reserve(RESULT_BATCH_ROWS);
+    ResultRow row;
+    bool failed = false;
+    size_t droppedRows = 0;
+    int idleRounds = 0;
+
+    for (;;)
+    {
+        const bool stops = resultPipelineStops.load(std::memory_order_acquire);
+        bool popped = false;
+        while (rows.size() < RESULT_BATCH_ROWS && resultQueue->TryPop(row)) {
+            rows.push_back(std::move(row));
+            popped = true;
+        }
+        //the producers are done, if the queue is empty after the stop flag was seen
+        const bool drained = stops && !popped;
+
+        if (rows.size() == RESULT_BATCH_ROWS || (drained && !rows.empty()))
+        {
+            try
+            {
+                if (!failed)
+                    writeResultRows(rows, rows.size());
+                else {
+                    droppedRows += rows.size();
+                    rows.clear();
+                }
+            }
+            catch (std::exception& ex)
+            {
+                //keep draining the queue: the producers must not wait for a stopped writer
+                LOGGER::LogError( "Error saving results to NetXpert SpatiaLite DB!" );
+                LOGGER::LogError( ex.what() );
+                failed = true;
+                droppedRows += rows.size();
+                rows.clear();
+            }
+            idleRounds = 0;
+            continue;
+        }
+        if (drained)
+            break;
+        if (popped) {
+            idleRounds = 0;
+            continue;
+        }
+        //empty queue: spin shortly, then sleep
+        if (++idleRounds < 64)
+            std::this_thread::yield();
+        else
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    if (droppedRows > 0)
+        LOGGER::LogError( to_string(droppedRows) + " result rows of table "+ resultTableName +" were not saved!" );
+}
+
+void SpatiaLiteWriter::StartResultPipeline(const std::string& _tableName, const NetXpertSolver solverType)
+{
+    FinishResultPipeline();
+
+    resultTableName = _tableName;
+    resultSolverType = solverType;
+    resultRowQuery = prepareResultRows(_tableName, solverType, 1);
+    resultBatchQuery = prepareResultRows(_tableName, solverType, RESULT_BATCH_ROWS);
+    resultRowsInTransaction = 0;
+    resultQueue = unique_ptr<BoundedQueue<ResultRow> >(new BoundedQueue<ResultRow>(RESULT_QUEUE_ROWS));
+
+    resultPipelineStops.store(false);
+    resultThread = std::thread(&SpatiaLiteWriter::runResultPipeline, this);
+    resultPipelineRuns.store(true, std::memory_order_release);
+
+    LOGGER::LogDebug("Result pipeline for "+ _tableName +" started.");
+}
+
+void SpatiaLiteWriter::FinishResultPipeline()
+{
+    if (!resultPipelineRuns.load(std::memory_order_acquire))
+        return;
+
+    resultPipelineStops.store(true, std::memory_order_release);
+    resultThread.join();
+    resultPipelineRuns.store(false);
+    resultQueue.reset();
+    resultBatchQuery.reset();
+    resultRowQuery.reset();
+
+    LOGGER::LogDebug("Result pipeline for "+ resultTableName +" finished.");
+}
+
+void SpatiaLiteWriter::SaveResultRow(ResultRow&& row, const std::string& _tableName,
+                                     const NetXpertSolver solverType)
+{
+    if (resultPipelineRuns.load(std::memory_order_acquire) &&
+        _tableName == resultTableName)
+    {
+        //back pressure: wait for the writer thread if the queue is full
+        while (!resultQueue->TryPush(std::move(row)))
+            std::this_thread::yield();
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock (resultMutex);
+    try
+    {
+        if (!syncRowQuery || _tableName != syncTableName || solverType != syncSolverType) {
+            syncRowQuery = prepareResultRows(_tableName, solverType, 1);
+            syncTableName = _tableName;
+            syncSolverType = solverType;
+        }
+        int index = 1;
+        bindResultRow(*syncRowQuery, index, row, solverType);
+        syncRowQuery->exec();
+        syncRowQuery->reset();
+    }
+    catch (std::exception& ex)
+    {
+        LOGGER::LogError( "Error saving result row to table "+ _tableName +" of NetXpert SpatiaLite DB!" );
+        LOGGER::LogError( ex.what() );
+    }
+}
@@ -139,12 +139,19 @@ void Isolines::solve (netxpert::data::InternalNet& net, std::vector<netxpert::da
     int counter = 0;
     auto origsSize = origs.size();
 
+    //freeze the network once; the snapshot is shared read only by all threads
+    std::shared_ptr<const netxpert::data::CSRGraph> csr;
+    if (algorithm == SPTAlgorithm::Dijkstra_2Heap_CSR)
+        csr = net.FreezeToCSR(this->NETXPERT_CNFG.CSRSinglePrecision);
+
     //#pragma omp parallel for shared(origs)
     //make spt local to be copied for parallel proc
     //no class member variables can be parallized
 	#pragma omp parallel default(shared) num_threads(LOCAL_NUM_THREADS)
     {
     shared_ptr<ISPTree> lspt;
+    //Read the network
+    auto sg = convertInternalNetworkToSolverData(net);
     switch (algorithm)
     {
         /*case SPTAlgorithm::Dijkstra_2Heap_LEMON:
@@ -155,15 +162,18 @@ void Isolines::solve (netxpert::data::InternalNet& net, std::vector<netxpert::da
             lspt = shared_ptr<ISPTree>(new SPT_LEM_Bijkstra_2Heap(net.GetMaxNodeCount(), net.GetMaxArcCount(),
                                     isDirected));
             break;*/
+        case SPTAlgorithm::Dijkstra_2Heap_CSR: {
+            auto cspt = shared_ptr<SPT_CSR>(new SPT_CSR(isDirected));
+            cspt->LoadCSR(csr);
+            lspt = cspt;
+            break;
+        }
         default:
             lspt = shared_ptr<ISPTree>(new SPT_LEM(isDirected));
+            lspt->LoadNet(net.GetNodeCount(), net.GetArcCount(), &sg, net.GetCostMap());
             break;
     }
 
-    //Read the network
-    auto sg = convertInternalNetworkToSolverData(net);
-    lspt->LoadNet(net.GetNodeCount(), net.GetArcCount(), &sg, net.GetCostMap());
-
     vector<netxpert::data::node_t>::iterator origIt;
 
     for (origIt = origs.begin(); origIt!=origs.end(); origIt++)
@@ -186,6 +196,28 @@ void Isolines::solve (netxpert::data::InternalNet& net, std::vector<netxpert::da
         lspt->SolveSPT(maxCut, false);
         //LOGGER::LogDebug("SPT solved! ");
 
+        if (this->NETXPERT_CNFG.IsolinesTreeBased || this->NETXPERT_CNFG.IsolinesBands ||
+            this->NETXPERT_CNFG.IsolinesPolygons)
+        {
+            //distance labels of the shortest path tree only (incl. the origin): the settled nodes of the search
+            const auto settled = lspt->GetSettledNodes();
+            DistLabels labels;
+            labels.reserve(settled.size());
+            for (const auto& node : settled)
+            {
+                const cost_t dist = lspt->GetDist(node);
+                if (dist <= maxCut) {
+                    labels.push_back( make_pair(node, dist) );
+                    totalCost = totalCost + dist;
+                }
+            }
+            #pragma omp critical
+            {
+            this->treeLabels.push_back( make_pair(orig, std::move(labels)) );
+            }
+        }
+        else
+        {
         // Get all routes from orig to dest in nodes-List
         auto nodesIter = this->net->GetNodesIter();
         //auto* g = this->net->GetGraph();
@@ -208,6 +240,7 @@ void Isolines::solve (netxpert::data::InternalNet& net, std::vector<netxpert::da
                 }
             }
         }
+        }
         optimum = totalCost; //totalCost wird immer weiter aufsummiert für jedes neues OD-Paar
         counter += 1;
 
@@ -271,6 +304,8 @@ void
     try
     {
         Config cnfg = this->NETXPERT_CNFG;
+        const NetXpertSolver solverType = cnfg.IsolinesPolygons ? NetXpertSolver::IsolinesPolygonSolver
+                                                                 : NetXpertSolver::IsolinesSolver;
         unique_ptr<DBWriter> writer;
         unique_ptr<SQLite::Statement> qry; //is null in case of ESRI FileGDB
         switch (cnfg.ResultDBType)
@@ -288,12 +323,12 @@ void
                 }
                 writer->CreateNetXpertDB(); //create before preparing query
                 writer->OpenNewTransaction();
-                writer->CreateSolverResultTable(resultTableName, NetXpertSolver::IsolinesSolver, true);
+                writer->CreateSolverResultTable(resultTableName, solverType, true);
                 writer->CommitCurrentTransaction();
                 /*if (cnfg.GeometryHandling != GEOMETRY_HANDLING::RealGeometry)
                 {*/
                 auto& sldbWriter = dynamic_cast<SpatiaLiteWriter&>(*writer);
-                qry = unique_ptr<SQLite::Statement> (sldbWriter.PrepareSaveResultArc(resultTableName, NetXpertSolver::IsolinesSolver));
+                qry = unique_ptr<SQLite::Statement> (sldbWriter.PrepareSaveResultArc(resultTableName, solverType));
                 //}
             }
             break;
@@ -302,7 +337,7 @@ void
                 writer = unique_ptr<DBWriter> (new FGDBWriter(cnfg)) ;
                 writer->CreateNetXpertDB();
                 writer->OpenNewTransaction();
-                writer->CreateSolverResultTable(resultTableName, NetXpertSolver::IsolinesSolver, true);
+                writer->CreateSolverResultTable(resultTableName, solverType, true);
                 writer->CommitCurrentTransaction();
             }
             break;
@@ -310,58 +345,55 @@ void
 
         LOGGER::LogDebug("Writing Geometries..");
         writer->OpenNewTransaction();
+        if (cnfg.ResultDBType == RESULT_DB_TYPE::SpatiaLiteDB)
+          dynamic_cast<SpatiaLiteWriter&>(*writer).StartResultPipeline(resultTableName, solverType);
 
         //Processing and Saving Results are handled within net.ProcessResultArcs()
-        std::string arcIDs = "";
-        std::unordered_set<string> totalArcIDs;
         std::map<ODPair, CompressedPath>::const_iterator it; //const_iterator wegen Zugriff auf this->shortestPath
 
 		if (cnfg.GeometryHandling == GEOMETRY_HANDLING::RealGeometry)
 		{
-			LOGGER::LogDebug("Preloading relevant geometries into Memory..");
-
-			#pragma omp parallel default(shared) private(it) num_threads(LOCAL_NUM_THREADS)
-			{
-				//populate arcIDs
-				for (it = this->shortestPaths.begin(); it != this->shortestPaths.end(); ++it)
-				{
-					#pragma omp single nowait
-					{
-						auto kv = *it;
-//						ODPair key = kv.first;
-						CompressedPath value = kv.second;
-						/* resolve pred path to arcids */
-						/* ArcLookup vs AllArcLookup vs saving the path of the route, not only the preds ?*/
-						auto path = value.first;
-
-						std::unordered_set<std::string> arcIDlist = this->net->GetOrigArcIDs(path);
-
-						if (arcIDlist.size() > 0)
-						{
-							#pragma omp critical
-							{
-								for (std::string id : arcIDlist){
-								  totalArcIDs.insert(id);
-								}
-							}
-						}
-					}//omp single
-				}
-			}//omp parallel
-
-			for (string id : totalArcIDs) {
-				arcIDs += id += ",";
-            }
-
-			if (arcIDs.size() > 0)
-			{
-				arcIDs.pop_back(); //trim last comma
-				DBHELPER::LoadGeometryToMem(cnfg.ArcsTableName, cmap, cnfg.ArcsGeomColumnName, arcIDs);
-			}
+			LOGGER::LogDebug("Preloading geometries into Memory..");
+			this->net->LoadArcGeometries(cnfg.ArcsTableName, cnfg.ArcsGeomColumnName, cmap);
 			LOGGER::LogDebug("Done!");
 		}
         int counter = 0;
 
+        if (cnfg.IsolinesPolygons)
+        {
+            #pragma omp parallel for schedule(dynamic) num_threads(LOCAL_NUM_THREADS)
+            for (size_t i = 0; i < this->treeLabels.size(); i++)
+            {
+                string orig = this->net->GetOrigNodeID(this->treeLabels[i].first);
+                if (this->cutOffs.count(orig) > 0)
+                    this->net->ProcessIsoPolygonResultsMem(orig, this->treeLabels[i].second, this->cutOffs.at(orig),
+                                                           resultTableName, *writer, *qry);
+            }
+        }
+        else if (cnfg.IsolinesBands)
+        {
+            #pragma omp parallel for schedule(dynamic) num_threads(LOCAL_NUM_THREADS)
+            for (size_t i = 0; i < this->treeLabels.size(); i++)
+            {
+                string orig = this->net->GetOrigNodeID(this->treeLabels[i].first);
+                if (this->cutOffs.count(orig) > 0)
+                    this->net->ProcessIsoBandResultArcsMem(orig, this->treeLabels[i].second, this->cutOffs.at(orig),
+                                                           resultTableName, *writer, *qry);
+            }
+        }
+        else if (cnfg.IsolinesTreeBased)
+        {
+            #pragma omp parallel for schedule(dynamic) num_threads(LOCAL_NUM_THREADS)
+            for (size_t i = 0; i < this->treeLabels.size(); i++)
+            {
+                string orig = this->net->GetOrigNodeID(this->treeLabels[i].first);
+                if (this->cutOffs.count(orig) > 0)
+                    this->net->ProcessIsoTreeResultArcsMem(orig, this->treeLabels[i].second, this->cutOffs.at(orig),
+                                                           resultTableName, *writer, *qry);
+            }
+        }
+        else
+        {
 		#pragma omp parallel shared(counter) private(it) num_threads(LOCAL_NUM_THREADS)
         {
 
@@ -378,34 +410,25 @@ void
             if (counter % 2500 == 0)
                 LOGGER::LogInfo("Processed #" + to_string(counter) + " geometries.");
 
-            string arcIDs = "";
             ODPair key = kv.first;
             CompressedPath value = kv.second;
-            /* resolve pred path to arcids */
-            /* ArcLookup vs AllArcLookup vs saving the path of the route, not only the preds ?*/
             auto path = value.first;
-            std::unordered_set<std::string> arcIDlist = this->net->GetOrigArcIDs(path);
             double costPerPath = value.second;
 
-            if (arcIDlist.size() > 0)
-            {
-                for (string id : arcIDlist) {
-                    arcIDs += id += ",";
-                }
-                arcIDs.pop_back(); //trim last comma
-            }
-
             string orig = this->net->GetOrigNodeID(key.origin);
 //            std::cout << "orig " << orig << std::endl;
 
-            this->net->ProcessIsoResultArcsMem(orig, costPerPath, arcIDs, path,
+            this->net->ProcessIsoResultArcsMem(orig, costPerPath, path,
                                                resultTableName, *writer, *qry, this->cutOffs);
             }//omp single
         }
 
         LOGGER::LogDebug("AVG Geo Proc Time: "+ to_string(avgGeoProcTime/counter));
         }//omp paralell
+        }
         LOGGER::LogDebug("Committing..");
+        if (cnfg.ResultDBType == RESULT_DB_TYPE::SpatiaLiteDB)
+          dynamic_cast<SpatiaLiteWriter&>(*writer).FinishResultPipeline();
         writer->CommitCurrentTransaction();
         writer->CloseConnection();
         LOGGER::LogDebug("Done!");
@@ -47,8 +47,12 @@ void
     LOGGER::LogInfo("Type of Min Cost Flow Instance: "+ to_string(type));
 
     //And transform the instance if needed
+    const int maxNodeID = net.GetGraph()->maxNodeId();
     net.TransformUnbalancedMCF(type);
     LOGGER::LogInfo("Transformed Min Cost Flow Problem done.");
+    //the dummy node is the last node, if one was added
+    this->dummyNode = net.GetGraph()->maxNodeId() > maxNodeID ? net.GetGraph()->nodeFromId(net.GetGraph()->maxNodeId())
+                                                               : lemon::INVALID;
 
     this->net->ExportToDIMACS("./mcfp.dmx");
 
@@ -74,20 +78,13 @@ const std::string
 
   if (NETXPERT_CNFG.GeometryHandling == GEOMETRY_HANDLING::RealGeometry)
   {
-//    //check if already loaded to mem through SaveResults()
-//    if (DBHELPER::KV_Network.size() < 1) {
-       std::string arcIDs = processTotalArcIDs();
+    LOGGER::LogDebug("Preloading geometries into Memory..");
 
-      LOGGER::LogDebug("Preloading relevant geometries into Memory..");
+    ColumnMap cmap { NETXPERT_CNFG.ArcIDColumnName, NETXPERT_CNFG.FromNodeColumnName, NETXPERT_CNFG.ToNodeColumnName,
+                    NETXPERT_CNFG.CostColumnName, NETXPERT_CNFG.CapColumnName, NETXPERT_CNFG.OnewayColumnName};
 
-      ColumnMap cmap { NETXPERT_CNFG.ArcIDColumnName, NETXPERT_CNFG.FromNodeColumnName, NETXPERT_CNFG.ToNodeColumnName,
-                      NETXPERT_CNFG.CostColumnName, NETXPERT_CNFG.CapColumnName, NETXPERT_CNFG.OnewayColumnName};
-
-      if (arcIDs.size() > 0) {
-        DBHELPER::LoadGeometryToMem(NETXPERT_CNFG.ArcsTableName, cmap, NETXPERT_CNFG.ArcsGeomColumnName, arcIDs);
-      }
-      LOGGER::LogDebug("Done!");
-//    }
+    this->net->LoadArcGeometries(NETXPERT_CNFG.ArcsTableName, NETXPERT_CNFG.ArcsGeomColumnName, cmap);
+    LOGGER::LogDebug("Done!");
   }
 
   int counter = 0;
@@ -104,7 +101,6 @@ const std::string
     if (counter % 2500 == 0)
         LOGGER::LogInfo("Processed #" + to_string(counter) + " geometries.");
 
-    std::string arcIDs  = "";
     auto arc            = arcFlow.intArc;
     cost_t cost         = arcFlow.cost;
     flow_t flow         = arcFlow.flow;
@@ -114,7 +110,6 @@ const std::string
     //be added through InternalNet::addRouteGeomParts()
     const netxpert::data::ArcData arcData = this->net->GetArcData(arc);
 
-    arcIDs  = arcData.extArcID;
     cap     = arcData.capacity;
 
     string orig = this->net->GetOrigNodeID(this->net->GetSourceNode(arc));
@@ -123,8 +118,7 @@ const std::string
     std::vector<netxpert::data::arc_t> arcs {arc};
 
     if (orig != "dummy" && dest != "dummy")
-      this->net->ProcessMCFResultArcsMemS(orig, dest, cost, cap, flow, arcIDs,
-                                                arcs, outStream);
+      this->net->ProcessMCFResultArcsMemS(orig, dest, cost, cap, flow, arcs, outStream);
     else
       LOGGER::LogInfo("Dummy! orig: "+orig+", dest: "+ dest+", cost: "+to_string(cost)+ ", cap: "+
                                         to_string(cap) + ", flow: " +to_string(flow));
@@ -141,52 +135,6 @@ const std::string
   return outStream.str();
 }
 
-std::string
- MinCostFlow::processTotalArcIDs() {
-
-  std::string arcIDs = "";
-  std::unordered_set<string> totalArcIDs;
-  std::vector<netxpert::data::FlowCost>::const_iterator it; //const_iterator wegen Zugriff auf this->flowCost
-
-  #pragma omp parallel default(shared) private(it) num_threads(LOCAL_NUM_THREADS)
-  {
-    //populate arcIDs
-    for (it = this->flowCost.begin(); it != this->flowCost.end(); ++it)
-    {
-      #pragma omp single nowait
-      {
-        auto arcFlow = *it;
-        auto arc = arcFlow.intArc;
-  //    double cost = arcFlow.cost;
-  //    double flow = arcFlow.flow;
-        //only one arc
-        auto arcIDlist = this->net->GetOrigArcIDs(std::vector<arc_t>{arc});
-        std::unordered_set<string>::const_iterator it;
-        it = arcIDlist.begin();
-
-        if (arcIDlist.size() > 0)
-        {
-          std::string id = *it;
-
-          #pragma omp critical
-          {
-            if (id != "dummy")
-              totalArcIDs.insert(id);
-          }
-        }
-      }//omp single
-    }//for
-  }//omp parallel
-
-  for (std::string id : totalArcIDs) {
-    arcIDs += id += ",";
-  }
-  if (arcIDs.size() > 0)
-    arcIDs.pop_back();
-
-  return arcIDs;
-}
-
 void
  MinCostFlow::SaveResults(const std::string& resultTableName,
                           const ColumnMap& cmap) {
@@ -245,21 +193,17 @@ void
     if (cnfg.ResultDBType == RESULT_DB_TYPE::ESRI_FileGDB | cnfg.ResultDBType == RESULT_DB_TYPE::SpatiaLiteDB) {
       LOGGER::LogDebug("Writing Geometries..");
       writer->OpenNewTransaction();
+      if (cnfg.ResultDBType == RESULT_DB_TYPE::SpatiaLiteDB)
+        dynamic_cast<SpatiaLiteWriter&>(*writer).StartResultPipeline(resultTableName, NetXpertSolver::MinCostFlowSolver);
     }
 
     //Processing and Saving Results are handled within net.ProcessResultArcs()
-    std::string arcIDs = "";
     std::vector<FlowCost>::const_iterator it;
 
     if (cnfg.GeometryHandling == GEOMETRY_HANDLING::RealGeometry)
     {
-      arcIDs = processTotalArcIDs();
-
-      LOGGER::LogDebug("Preloading relevant geometries into Memory..");
-
-      if (arcIDs.size() > 0) {
-        DBHELPER::LoadGeometryToMem(cnfg.ArcsTableName, cmap, cnfg.ArcsGeomColumnName, arcIDs);
-      }
+      LOGGER::LogDebug("Preloading geometries into Memory..");
+      this->net->LoadArcGeometries(cnfg.ArcsTableName, cnfg.ArcsGeomColumnName, cmap);
       LOGGER::LogDebug("Done!");
     }
 
@@ -277,7 +221,6 @@ void
       if (counter % 2500 == 0)
           LOGGER::LogInfo("Processed #" + to_string(counter) + " geometries.");
 
-      std::string arcIDs  = "";
       auto arc            = arcFlow.intArc;
       cost_t cost         = arcFlow.cost;
       flow_t flow         = arcFlow.flow;
@@ -287,7 +230,6 @@ void
       //be added through InternalNet::addRouteGeomParts()
       const netxpert::data::ArcData arcData = this->net->GetArcData(arc);
 
-      arcIDs  = arcData.extArcID;
       cap     = arcData.capacity;
 
       string orig = this->net->GetOrigNodeID(this->net->GetSourceNode(arc));
@@ -296,8 +238,7 @@ void
       std::vector<netxpert::data::arc_t> arcs {arc};
 
       if (orig != "dummy" && dest != "dummy")
-          this->net->ProcessMCFResultArcsMem(orig, dest, cost, cap, flow, arcIDs,
-                                                  arcs,
+          this->net->ProcessMCFResultArcsMem(orig, dest, cost, cap, flow, arcs,
                                                   resultTableName, *writer, *qry);
       else
           LOGGER::LogInfo("Dummy! orig: "+orig+", dest: "+ dest+", cost: "+to_string(cost)+ ", cap: "+
@@ -308,6 +249,8 @@ void
 
     if (cnfg.ResultDBType == RESULT_DB_TYPE::ESRI_FileGDB | cnfg.ResultDBType == RESULT_DB_TYPE::SpatiaLiteDB) {
       LOGGER::LogDebug("Committing..");
+      if (cnfg.ResultDBType == RESULT_DB_TYPE::SpatiaLiteDB)
+        dynamic_cast<SpatiaLiteWriter&>(*writer).FinishResultPipeline();
       writer->CommitCurrentTransaction();
       writer->CloseConnection();
       LOGGER::LogDebug("Done!");
@@ -327,6 +270,83 @@ void
   }
 }
 
+void
+ MinCostFlow::Resolve(const std::vector<NodeSupplyChange>& supplyChanges,
+                      const std::vector<ArcCostChange>& costChanges) {
+
+    if (!this->net)
+        throw std::runtime_error("MinCostFlow::Resolve() needs a solved instance!");
+
+    auto* supplyMap = this->net->GetSupplyMap();
+    auto* costMap   = this->net->GetCostMap();
+    bool warmStart  = this->reoptimizer != nullptr;
+
+    for (const auto& change : supplyChanges) {
+        if (change.node == this->dummyNode)
+            continue;
+        //the dummy node has no arc to nodes without supply or demand
+        if (this->dummyNode != lemon::INVALID && (*supplyMap)[change.node] == 0 && change.supply != 0)
+            warmStart = false;
+        if (warmStart)
+            this->reoptimizer->SetNodeSupply(change.node, change.supply);
+        else
+            (*supplyMap)[change.node] = change.supply;
+    }
+    for (const auto& change : costChanges) {
+        if (warmStart)
+            this->reoptimizer->SetArcCost(change.arc, change.cost);
+        else
+            (*costMap)[change.arc] = change.cost;
+    }
+
+    //balance the instance with the existing dummy node
+    supply_t difference = 0;
+    auto nodesIter = this->net->GetNodesIter();
+    for (; nodesIter != lemon::INVALID; ++nodesIter) {
+        if (nodesIter != this->dummyNode)
+            difference -= (*supplyMap)[nodesIter];
+    }
+    if (this->dummyNode == lemon::INVALID) {
+        if (difference != 0)
+            warmStart = false;
+    }
+    else {
+        //arcs of the dummy node point away from it, if it has supply
+        const bool dummyIsSource = graph_t::OutArcIt(*this->net->GetGraph(), this->dummyNode) != lemon::INVALID;
+        if ((dummyIsSource && difference < 0) || (!dummyIsSource && difference > 0))
+            warmStart = false;
+        else if (warmStart)
+            this->reoptimizer->SetNodeSupply(this->dummyNode, difference);
+    }
+
+    if (warmStart && this->reoptimizer->Reoptimize()) {
+        LOGGER::LogInfo("MCF re-solved from last solution with " +
+                        to_string(this->reoptimizer->GetAugmentationCount()) + " augmenting paths.");
+        this->solverStatus = MCFSolverStatus::MCFOK;
+        this->optimum = this->reoptimizer->GetOptimum();
+
+        vector<FlowCost> result;
+        auto arcIter = this->net->GetArcsIter();
+        for ( ; arcIter != lemon::INVALID; ++arcIter) {
+            flow_t flow = this->reoptimizer->GetFlow(arcIter);
+            if (flow > 0) {
+                FlowCost fc{ arcIter, flow, (*costMap)[arcIter]};
+                result.push_back(fc);
+            }
+        }
+        this->flowCost = result;
+        return;
+    }
+
+    LOGGER::LogInfo("MCF re-solve from scratch..");
+    //balancing is done again in Solve(); the old dummy node keeps its arcs, but gets no supply
+    if (this->dummyNode != lemon::INVALID)
+        (*supplyMap)[this->dummyNode] = 0;
+    this->reoptimizer.reset();
+    //not virtual: the network is the MCF network also for derived solvers
+    MinCostFlow::Solve(*this->net);
+}
+
 const MCFAlgorithm
  MinCostFlow::GetAlgorithm() const {
     return algorithm;
@@ -355,24 +375,32 @@ void
     auto* costMap = net.GetCostMap();
     auto* supplyMap = net.GetSupplyMap();
 
-    switch (algorithm)
-    {
-        case MCFAlgorithm::NetworkSimplex_LEMON:
-            mcf = shared_ptr<IMinCostFlow>(new NS_LEM());
-            break;
-        default:
-            mcf = shared_ptr<IMinCostFlow>(new NS_LEM());
-            break;
-    }
-
     if (!validateNetworkData( net ))
         throw;
 
     LOGGER::LogDebug("Arcs: " + to_string(net.GetArcCount() ));
     LOGGER::LogDebug("Nodes: "+ to_string(net.GetNodeCount() ));
 
-    //Read the network
-    auto sg = convertInternalNetworkToSolverData(net);
+    //Read the network (kept for Resolve())
+    this->reoptimizer.reset();
+    this->mcfGraph = std::unique_ptr<filtered_graph_t>(new filtered_graph_t(convertInternalNetworkToSolverData(net)));
+    auto& sg = *this->mcfGraph;
+
+    //shape after balancing: includes the supply of the dummy node
+    MCFAlgorithm mcfAlgorithm = algorithm;
+    auto shape = GetInstanceShape(sg, *costMap, *net.GetCapMap(), *supplyMap, NETXPERT_CNFG.McfIntegerPrecision);
+    if (mcfAlgorithm == MCFAlgorithm::MCFAutomatic) {
+        mcfAlgorithm = SelectAlgorithm(shape);
+        LOGGER::LogInfo("MCF algorithm chosen automatically: " + to_string(mcfAlgorithm) +
+                        " (sources: " + to_string(shape.SourceCount) + ", sinks: " + to_string(shape.SinkCount) +
+                        ", tight arcs: " + to_string(shape.TightArcCount) + ")");
+    }
+    if (!IsExact(mcfAlgorithm, shape)) {
+        LOGGER::LogWarning("MCF algorithm " + to_string(mcfAlgorithm) + " needs integral values with precision " +
+                           to_string(NETXPERT_CNFG.McfIntegerPrecision) + " - solving with the NetworkSimplex!");
+        mcfAlgorithm = MCFAlgorithm::NetworkSimplex_LEMON;
+    }
+    mcf = CreateCoreSolver(mcfAlgorithm, NETXPERT_CNFG.McfPivotRule, NETXPERT_CNFG.McfIntegerPrecision);
     mcf->LoadNet(net.GetNodeCount(), net.GetArcCount(), &sg, costMap, net.GetCapMap(), supplyMap);
 
     int srcCount = 0;
@@ -396,6 +424,10 @@ void
         this->optimum = mcf->GetOptimum();
 
         auto* flowMap = mcf->GetMCFFlow();
+
+        this->reoptimizer = std::unique_ptr<MCFReoptimizer>(
+                                new MCFReoptimizer(sg, *costMap, *net.GetCapMap(), *supplyMap));
+        this->reoptimizer->LoadSolution(*flowMap, *mcf->GetMCFPotential());
 //        costMap = mcf->GetMCFCost();
 
         //loop over all arcs
@@ -422,6 +454,83 @@ void
     this->flowCost = result;
 }
 
+MCFInstanceShape
+ MinCostFlow::GetInstanceShape(filtered_graph_t& sg,
+                               graph_t::ArcMap<cost_t>& costMap,
+                               graph_t::ArcMap<capacity_t>& capMap,
+                               graph_t::NodeMap<supply_t>& supplyMap,
+                               const int integerPrecision) {
+
+    MCFInstanceShape shape {0, 0, 0, 0, 0, false, false};
+    supply_t maxSupply = 0;
+    for (filtered_graph_t::NodeIt n(sg); n != lemon::INVALID; ++n) {
+        const supply_t supply = supplyMap[n];
+        shape.NodeCount += 1;
+        if (supply > 0)
+            shape.SourceCount += 1;
+        if (supply < 0)
+            shape.SinkCount += 1;
+        maxSupply = std::max(maxSupply, std::abs(supply));
+    }
+    //an arc is tight, if not even one node can send all of its supply over it
+    for (filtered_graph_t::ArcIt a(sg); a != lemon::INVALID; ++a) {
+        shape.ArcCount += 1;
+        if (capMap[a] < maxSupply)
+            shape.TightArcCount += 1;
+    }
+    const double scale = MCFScaling::GetScale(integerPrecision);
+    shape.IntegralFlows = MCFScaling::HasIntegralFlows(sg, capMap, supplyMap, scale);
+    shape.IntegralCosts = MCFScaling::HasIntegralCosts(sg, costMap, scale);
+    return shape;
+}
+
+MCFAlgorithm
+ MinCostFlow::SelectAlgorithm(const MCFInstanceShape& shape) {
+
+    //BenchMCFAlgorithms: CapacityScaling needs one shortest path search per augmentation, so it wins
+    //on few terminals (up to 20x faster than NetworkSimplex), but loses badly on many terminals or
+    //tight capacities (many small augmentations); NetworkSimplex is robust in both cases.
+    const uint64_t terminals = (uint64_t) shape.SourceCount + shape.SinkCount;
+    const bool fewTerminals = terminals * 50 <= shape.NodeCount;
+    const bool fewTightArcs = (uint64_t) shape.TightArcCount * 20 <= shape.ArcCount;
+
+    //CapacityScaling leaves fractional supplies and capacities unrouted
+    if (fewTerminals && fewTightArcs && shape.IntegralFlows)
+        return MCFAlgorithm::CapacityScaling_LEMON;
+    return MCFAlgorithm::NetworkSimplex_LEMON;
+}
+
+bool
+ MinCostFlow::IsExact(const MCFAlgorithm mcfAlgorithm, const MCFInstanceShape& shape) {
+
+    switch (mcfAlgorithm)
+    {
+        case MCFAlgorithm::CapacityScaling_LEMON:
+            return shape.IntegralFlows;
+        case MCFAlgorithm::CostScaling_LEMON:
+            return shape.IntegralFlows && shape.IntegralCosts;
+        default:
+            return true;
+    }
+}
+
+std::shared_ptr<IMinCostFlow>
+ MinCostFlow::CreateCoreSolver(const MCFAlgorithm mcfAlgorithm, const MCFPivotRule pivotRule,
+                               const int integerPrecision) {
+
+    switch (mcfAlgorithm)
+    {
+        case MCFAlgorithm::CostScaling_LEMON:
+            return shared_ptr<IMinCostFlow>(new CS_LEM(integerPrecision));
+        case MCFAlgorithm::CapacityScaling_LEMON:
+            return shared_ptr<IMinCostFlow>(new CAS_LEM(4, integerPrecision));
+        case MCFAlgorithm::NetworkSimplex_LEMON:
+            return shared_ptr<IMinCostFlow>(new NS_LEM(pivotRule, integerPrecision));
+        default:
+            return shared_ptr<IMinCostFlow>(new NS_LEM(pivotRule, integerPrecision));
+    }
+}
+
 void
  MinCostFlow::getSupplyNodesTypeCount(int& srcNodeCount, int& transshipNodeCount, int& sinkNodeCount ) {
 
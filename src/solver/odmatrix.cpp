@@ -32,6 +32,7 @@ OriginDestinationMatrix::OriginDestinationMatrix(Config& cnfg)
     isDirected = cnfg.IsDirected;
     sptHeapCard = cnfg.SPTHeapCard;
     geometryHandling = cnfg.GeometryHandling;
+    costsOnly = cnfg.ODMCostsOnly;
     this->NETXPERT_CNFG = cnfg;
 }
 
@@ -108,109 +109,96 @@ void
     netxpert::data::cost_t totalCost = 0;
 
     //Main loop for calculating the ODMatrix
-    int counter = 0;
-    auto origsSize = origs.size();
+    const size_t origsSize = origs.size();
+    const size_t destsSize = dests.size();
+
+    //dense result store: one row per origin, written only by the thread that solves the origin
+    //-> no critical sections in the main loop
+    //costs only: no paths at all, they are rebuilt on demand
+    this->odResults.Init(origs, dests, !costsOnly);
+    this->reachedDests.clear();
 
     //for (auto orig : origs)
     /* OpenMP only wants iterator style in for-loops - no auto for loops
-       The loop for the ODMatrix Calculation is being computed paralell with the critical keyword.
+       The loop for the ODMatrix Calculation is being computed in parallel; every thread writes
+       only into the rows of its own origins and sums up its costs locally (reduction).
     */
 
-    //shared(shortestPaths, odMatrix, reachedDests, origs)
+    //freeze the network once; snapshot and hierarchy are shared read only by all threads
+    this->csr.reset();
+    this->ch.reset();
+    prepareCoreSolvers(net);
+
+    //bucket based many-to-many search for the costs; with paths every origin is solved with SPT_CH
+    if (algorithm == SPTAlgorithm::ContractionHierarchies_ManyToMany && costsOnly) {
+        auto sg = convertInternalNetworkToSolverData(net);
+        ODM_CH odm;
+        odm.LoadNet(&sg, net.GetCostMap());
+        odm.LoadCH(this->ch);
+        odm.Solve(origs, dests, this->odResults, LOCAL_NUM_THREADS);
+        LOGGER::LogDebug("Bucket entries: " + to_string(odm.GetBucketEntryCount()));
+        totalCost = this->odResults.SumCosts();
+    }
+    else {
 
-    //#pragma omp parallel for shared(origs)
     //make spt local to be copied for parallel proc
     //no class member variables can be parallized
-    #pragma omp parallel default(shared) num_threads(LOCAL_NUM_THREADS)
-    {
-    shared_ptr<ISPTree> lspt;
-    switch (algorithm)
+    #pragma omp parallel default(shared) reduction(+:totalCost) num_threads(LOCAL_NUM_THREADS)
     {
-        /*case SPTAlgorithm::Dijkstra_2Heap_LEMON:
-            lspt = shared_ptr<ISPTree>(new SPT_LEM(net.GetMaxNodeCount(), net.GetMaxArcCount(),
-                                        isDirected));
-            break;
-        case SPTAlgorithm::Bijkstra_2Heap_LEMON:
-            lspt = shared_ptr<ISPTree>(new SPT_LEM_Bijkstra_2Heap(net.GetMaxNodeCount(), net.GetMaxArcCount(),
-                                    isDirected));
-            break;*/
-        default:
-            lspt = shared_ptr<ISPTree>(new SPT_LEM(isDirected));
-            break;
-    }
-
     //Read the network
     auto sg = convertInternalNetworkToSolverData(net);
-    lspt->LoadNet(net.GetNodeCount(), net.GetArcCount(), &sg, net.GetCostMap());
-
-    vector<netxpert::data::node_t>::iterator origIt;
+    shared_ptr<ISPTree> lspt = newCoreSolver(net, sg);
 
-    for (origIt = origs.begin(); origIt!=origs.end(); origIt++)
+    for (size_t origIdx = 0; origIdx < origsSize; origIdx++)
     {
         #pragma omp single nowait
         {
-        netxpert::data::node_t orig = *origIt;
-        set< netxpert::data::node_t > intReachedDests;
+        const netxpert::data::node_t orig = origs[origIdx];
 
         lspt->SetOrigin(orig);
 
-        int routesLeft = origsSize - counter;
         LOGGER::LogDebug("# "+ to_string(omp_get_thread_num())  +": Calculating routes from " + to_string(net.GetNodeID(orig)) + ", # "+
-                            to_string(routesLeft) +" left..");
-        // Set dests to lemon::INVALID --> no dest setting at all!
-        lspt->SetDest(lemon::INVALID);
+                            to_string(origsSize - origIdx) +" left..");
+        // one-to-many search: stops as soon as all reachable dests are settled
+        lspt->SetDests(dests);
 
         lspt->SolveSPT();
         //LOGGER::LogDebug("SPT solved! ");
 
-        //omp: local intReachedDests --> no concurrent writes per thread
-        for (auto dest : dests) {
-            if (lspt->Reached(dest))
-                intReachedDests.insert(dest);
-        }
-
         // Get all routes from orig to dest in nodes-List
-        vector<netxpert::data::node_t>::iterator destIt;
-        for (destIt=dests.begin(); destIt!=dests.end(); destIt++)
+        for (size_t destIdx = 0; destIdx < destsSize; destIdx++)
         {
-            auto dest = *destIt;
-            bool isDestReached;
-            if ( intReachedDests.count(dest) > 0 )
-                isDestReached = true;
-            else
-                isDestReached = false;
-
-            if (orig != dest && isDestReached)
-            {
+            const netxpert::data::node_t dest = dests[destIdx];
 
-                const double costPerRoute = lspt->GetDist(dest);
-                const auto path = lspt->GetPath(dest);
-
-                #pragma omp critical
-                {
+            if (orig != dest && lspt->Reached(dest))
+            {
+                const netxpert::data::cost_t costPerRoute = lspt->GetDist(dest);
                 totalCost += costPerRoute;
-
-                shortestPaths.insert( make_pair( ODPair {orig, dest},
-                                      make_pair( path, costPerRoute ) ));//vector<uint32_t> (route),
-                                                 //   costPerRoute)) );
-                odMatrix.insert( make_pair( ODPair {orig, dest},
-                                    costPerRoute));
-
-                reachedDests.push_back(dest);
-                }
-
+                //omp: row origIdx belongs to this thread only --> no concurrent writes
+                if (costsOnly)
+                    this->odResults.Set(origIdx, destIdx, costPerRoute);
+                else
+                    this->odResults.Set(origIdx, destIdx, costPerRoute, lspt->GetPath(dest));
             }
-            if (!isDestReached)
+            /*else
             {
-                //LOGGER::LogError("Destination "+ net.GetOriginalStartOrEndNodeID(dest) +" unreachable!");
-            }
+                LOGGER::LogError("Destination "+ net.GetOriginalStartOrEndNodeID(dest) +" unreachable!");
+            }*/
         }
-        optimum = totalCost; //totalCost wird immer weiter aufsummiert für jedes neues OD-Paar
-        counter += 1;
-
     }//omp single
     }
     }//omp parallel
+    }
+
+    //reached destinations per od pair in row order (origin by origin)
+    for (size_t origIdx = 0; origIdx < origsSize; origIdx++) {
+        for (size_t destIdx = 0; destIdx < destsSize; destIdx++) {
+            if (this->odResults.IsReached(origIdx, destIdx))
+                this->reachedDests.push_back(dests[destIdx]);
+        }
+    }
+
+    this->optimum = totalCost;
 }
 
 const SPTAlgorithm
@@ -289,12 +277,301 @@ vector<uint32_t>
 
 map<ODPair, CompressedPath>
  OriginDestinationMatrix::GetShortestPaths() const {
-    return this->shortestPaths;
+    return this->odResults.ToShortestPaths();
 }
 
 map<ODPair, double>
  OriginDestinationMatrix::GetODMatrix() const {
-    return this->odMatrix;
+    return this->odResults.ToODMatrix();
+}
+
+std::vector<ODCell>
+ OriginDestinationMatrix::SolveSparse(netxpert::data::InternalNet& net, const size_t destLimit,
+                                      const std::vector<cost_t>& thresholds) {
+
+    if (this->net != &net) {
+        this->csr.reset();
+        this->ch.reset();
+    }
+    this->net = &net;
+
+    if (destinationNodes.size() == 0 || originNodes.size() == 0)
+        throw std::runtime_error("Origin Nodes or Destination nodes in ODMatrix Solver must not be null!");
+    if (thresholds.size() > 0 && thresholds.size() != originNodes.size())
+        throw std::runtime_error("ODMatrix Solver needs one threshold per origin!");
+
+    //sparse mode: no dense result store; snapshot and hierarchy are kept across the calls on the same network
+    this->odResults.Clear();
+    this->reachedDests.clear();
+    prepareCoreSolvers(net);
+
+    const auto& origs = this->originNodes;
+    const auto& dests = this->destinationNodes;
+    const size_t origsSize = origs.size();
+    vector<ODCell> cells;
+
+    #pragma omp parallel default(shared) num_threads(LOCAL_NUM_THREADS)
+    {
+    auto sg = convertInternalNetworkToSolverData(net);
+    shared_ptr<ISPTree> lspt = newCoreSolver(net, sg);
+    lspt->SetDests(dests);
+    lspt->SetDestLimit(destLimit);
+    vector<ODCell> localCells;
+
+    for (size_t origIdx = 0; origIdx < origsSize; origIdx++)
+    {
+        #pragma omp single nowait
+        {
+        const cost_t threshold = thresholds.size() > 0 ? thresholds[origIdx] : -1;
+        if (thresholds.size() == 0 || threshold > 0)
+        {
+            const netxpert::data::node_t orig = origs[origIdx];
+            lspt->SetOrigin(orig);
+            lspt->SolveSPT(threshold);
+
+            for (size_t destIdx = 0; destIdx < dests.size(); destIdx++)
+            {
+                const netxpert::data::node_t dest = dests[destIdx];
+                if (orig != dest && lspt->Reached(dest))
+                    localCells.push_back( ODCell {(uint32_t) origIdx, (uint32_t) destIdx, lspt->GetDist(dest)} );
+            }
+        }
+        }//omp single
+    }
+    #pragma omp critical
+    {
+    cells.insert(cells.end(), localCells.begin(), localCells.end());
+    }
+    }//omp parallel
+
+    std::sort(cells.begin(), cells.end(), [] (const ODCell& a, const ODCell& b) {
+        return a.origIdx < b.origIdx || (a.origIdx == b.origIdx && a.destIdx < b.destIdx);
+    });
+    return cells;
+}
+
+map<ODPair, CompressedPath>
+ OriginDestinationMatrix::GetShortestPaths(const vector<ODPair>& odPairs) {
+
+    const auto& res = this->odResults;
+    //sparse mode (SolveSparse()): there is no result store to look up
+    if (res.origins.size() == 0)
+        return computeShortestPaths(odPairs);
+    //first index of every origin and dest node in the result store
+    unordered_map<int, size_t> origIdxs;
+    unordered_map<int, size_t> destIdxs;
+    for (size_t i = 0; i < res.origins.size(); i++)
+        origIdxs.insert( make_pair(graph_t::id(res.origins[i]), i) );
+    for (size_t i = 0; i < res.dests.size(); i++)
+        destIdxs.insert( make_pair(graph_t::id(res.dests[i]), i) );
+
+    vector<size_t> cells;
+    for (const auto& p : odPairs) {
+        auto oIt = origIdxs.find(graph_t::id(p.origin));
+        auto dIt = destIdxs.find(graph_t::id(p.dest));
+        if (oIt == origIdxs.end() || dIt == destIdxs.end())
+            continue;
+        if (res.IsReached(oIt->second, dIt->second))
+            cells.push_back(res.Index(oIt->second, dIt->second));
+    }
+
+    materializePaths(cells);
+
+    map<ODPair, CompressedPath> result;
+    const size_t destsSize = res.dests.size();
+    for (const size_t cell : cells) {
+        result.insert( make_pair( ODPair {res.origins[cell / destsSize], res.dests[cell % destsSize]},
+                                  make_pair( res.GetPath(cell), res.costs[cell] ) ) );
+    }
+    return result;
+}
+
+/**
+* Shortest paths of the given od pairs without the result store: one one-to-many search per distinct origin.
+*/
+map<ODPair, CompressedPath>
+ OriginDestinationMatrix::computeShortestPaths(const vector<ODPair>& odPairs) {
+
+    map<ODPair, CompressedPath> result;
+    if (!this->net || odPairs.size() == 0)
+        return result;
+
+    //group the dests by origin
+    map<int, pair<netxpert::data::node_t, vector<netxpert::data::node_t> > > perOrigin;
+    for (const auto& p : odPairs) {
+        auto& job = perOrigin[graph_t::id(p.origin)];
+        job.first = p.origin;
+        job.second.push_back(p.dest);
+    }
+    vector<pair<netxpert::data::node_t, vector<netxpert::data::node_t> > > jobs;
+    for (auto& kv : perOrigin)
+        jobs.push_back(std::move(kv.second));
+
+    auto& net = *this->net;
+    prepareCoreSolvers(net);
+
+    #pragma omp parallel default(shared) num_threads(LOCAL_NUM_THREADS)
+    {
+    auto sg = convertInternalNetworkToSolverData(net);
+    shared_ptr<ISPTree> lspt = newCoreSolver(net, sg);
+
+    for (size_t j = 0; j < jobs.size(); j++)
+    {
+        #pragma omp single nowait
+        {
+        const auto& job = jobs[j];
+        lspt->SetOrigin(job.first);
+        lspt->SetDests(job.second);
+        lspt->SolveSPT();
+
+        vector<pair<ODPair, CompressedPath> > localPaths;
+        for (const auto& dest : job.second) {
+            if (lspt->Reached(dest))
+                localPaths.push_back( make_pair( ODPair {job.first, dest},
+                                                 make_pair(lspt->GetPath(dest), lspt->GetDist(dest)) ) );
+        }
+        #pragma omp critical
+        {
+        for (auto& lp : localPaths)
+            result.insert(std::move(lp));
+        }
+        }//omp single
+    }
+    }//omp parallel
+
+    return result;
+}
+
+/**
+* Snapshot (csr) or hierarchy (ch) of the network for the core solvers; only built if not there yet.
+*/
+void
+ OriginDestinationMatrix::prepareCoreSolvers(netxpert::data::InternalNet& net) {
+
+    if (algorithm == SPTAlgorithm::Dijkstra_2Heap_CSR && !this->csr)
+        this->csr = net.FreezeToCSR(this->NETXPERT_CNFG.CSRSinglePrecision);
+    if ((algorithm == SPTAlgorithm::ContractionHierarchies ||
+         algorithm == SPTAlgorithm::ContractionHierarchies_ManyToMany) && !this->ch)
+        this->ch = net.GetContractionHierarchy();
+}
+
+/**
+* Core solver of a thread; snapshot (csr) and hierarchy (ch) must have been prepared in solve().
+*/
+shared_ptr<ISPTree>
+ OriginDestinationMatrix::newCoreSolver(netxpert::data::InternalNet& net, netxpert::data::filtered_graph_t& sg) {
+
+    shared_ptr<ISPTree> lspt;
+    switch (algorithm)
+    {
+        /*case SPTAlgorithm::Dijkstra_2Heap_LEMON:
+            lspt = shared_ptr<ISPTree>(new SPT_LEM(net.GetMaxNodeCount(), net.GetMaxArcCount(),
+                                        isDirected));
+            break;
+        case SPTAlgorithm::Bijkstra_2Heap_LEMON:
+            lspt = shared_ptr<ISPTree>(new SPT_LEM_Bijkstra_2Heap(net.GetMaxNodeCount(), net.GetMaxArcCount(),
+                                    isDirected));
+            break;*/
+        case SPTAlgorithm::Dijkstra_2Heap_CSR: {
+            auto cspt = shared_ptr<SPT_CSR>(new SPT_CSR(isDirected));
+            cspt->LoadCSR(this->csr);
+            lspt = cspt;
+            break;
+        }
+        case SPTAlgorithm::ContractionHierarchies_ManyToMany:
+        case SPTAlgorithm::ContractionHierarchies: {
+            auto chspt = shared_ptr<SPT_CH>(new SPT_CH(isDirected));
+            chspt->LoadCH(this->ch);
+            chspt->LoadNet(net.GetNodeCount(), net.GetArcCount(), &sg, net.GetCostMap());
+            lspt = chspt;
+            break;
+        }
+        default:
+            lspt = shared_ptr<ISPTree>(new SPT_LEM(isDirected));
+            lspt->LoadNet(net.GetNodeCount(), net.GetArcCount(), &sg, net.GetCostMap());
+            break;
+    }
+    return lspt;
+}
+
+/**
+* Rebuilds the paths of the given cells of the result store, if they are not stored already (costs only mode).
+* One shortest path tree is computed per distinct origin.
+*/
+void
+ OriginDestinationMatrix::materializePaths(const vector<size_t>& cells) {
+
+    if (this->odResults.dests.size() == 0)
+        return;
+
+    const size_t destsSize = this->odResults.dests.size();
+
+    //group the missing paths by origin
+    map<size_t, vector<size_t> > missingPerOrigin;
+    for (const size_t cell : cells) {
+        if (!this->odResults.HasPath(cell))
+            missingPerOrigin[cell / destsSize].push_back(cell);
+    }
+    if (missingPerOrigin.size() == 0)
+        return;
+
+    LOGGER::LogDebug("Rebuilding paths for " + to_string(missingPerOrigin.size()) + " origins..");
+
+    vector<pair<size_t, vector<size_t> > > jobs (missingPerOrigin.begin(), missingPerOrigin.end());
+    auto& net = *this->net;
+
+    #pragma omp parallel default(shared) num_threads(LOCAL_NUM_THREADS)
+    {
+    //same snapshot or hierarchy as in solve()
+    auto sg = convertInternalNetworkToSolverData(net);
+    shared_ptr<ISPTree> lspt = newCoreSolver(net, sg);
+
+    for (size_t j = 0; j < jobs.size(); j++)
+    {
+        #pragma omp single nowait
+        {
+        const auto& job = jobs[j];
+        vector<netxpert::data::node_t> jobDests;
+        for (const size_t cell : job.second)
+            jobDests.push_back(this->odResults.dests[cell % destsSize]);
+
+        lspt->SetOrigin(this->odResults.origins[job.first]);
+        lspt->SetDests(jobDests);
+        lspt->SolveSPT();
+
+        vector<pair<size_t, vector<arc_t> > > localPaths;
+        for (size_t k = 0; k < job.second.size(); k++)
+            localPaths.push_back( make_pair(job.second[k], lspt->GetPath(jobDests[k])) );
+
+        #pragma omp critical
+        {
+        for (auto& lp : localPaths)
+            this->odResults.lazyPaths[lp.first] = std::move(lp.second);
+        }
+        }//omp single
+    }
+    }//omp parallel
+}
+
+const bool
+ OriginDestinationMatrix::GetCostsOnly() const {
+    return this->costsOnly;
+}
+
+void
+ OriginDestinationMatrix::SetCostsOnly(const bool costsOnly) {
+    this->costsOnly = costsOnly;
+}
+
+vector<size_t>
+ OriginDestinationMatrix::getReachedCells() const {
+    vector<size_t> cells;
+    const auto& res = this->odResults;
+    for (size_t i = 0; i < res.reached.size(); i++) {
+        if (res.reached[i])
+            cells.push_back(i);
+    }
+    return cells;
 }
 
 inline const double
@@ -311,62 +588,46 @@ const std::string
   outStream << "{ \"result\" : [ " << endl;
 
   //Processing and Saving Results are handled within net.ProcessResultArcs()
-  std::map<ODPair, CompressedPath>::const_iterator it; //const_iterator wegen Zugriff auf this->shortestPath
+  const vector<size_t> cells = getReachedCells();
+  const size_t destsSize = this->odResults.dests.size();
 
   if (NETXPERT_CNFG.GeometryHandling == GEOMETRY_HANDLING::RealGeometry)
   {
-//    //check if already loaded to mem through SaveResults()
-//    if (DBHELPER::KV_Network.size() < 1) {
-       std::string arcIDs = processTotalArcIDs();
+    //costs only: rebuild the paths of the exported pairs
+    materializePaths(cells);
 
-      LOGGER::LogDebug("Preloading relevant geometries into Memory..");
+    LOGGER::LogDebug("Preloading geometries into Memory..");
 
-      ColumnMap cmap { NETXPERT_CNFG.ArcIDColumnName, NETXPERT_CNFG.FromNodeColumnName, NETXPERT_CNFG.ToNodeColumnName,
-                      NETXPERT_CNFG.CostColumnName, NETXPERT_CNFG.CapColumnName, NETXPERT_CNFG.OnewayColumnName};
+    ColumnMap cmap { NETXPERT_CNFG.ArcIDColumnName, NETXPERT_CNFG.FromNodeColumnName, NETXPERT_CNFG.ToNodeColumnName,
+                    NETXPERT_CNFG.CostColumnName, NETXPERT_CNFG.CapColumnName, NETXPERT_CNFG.OnewayColumnName};
 
-      if (arcIDs.size() > 0) {
-        DBHELPER::LoadGeometryToMem(NETXPERT_CNFG.ArcsTableName, cmap, NETXPERT_CNFG.ArcsGeomColumnName, arcIDs);
-      }
-      LOGGER::LogDebug("Done!");
-//    }
+    this->net->LoadArcGeometries(NETXPERT_CNFG.ArcsTableName, NETXPERT_CNFG.ArcsGeomColumnName, cmap);
+    LOGGER::LogDebug("Done!");
   }
 
-  int counter = 0;
+  size_t counter = 0;
 
-  #pragma omp parallel shared(counter) private(it) num_threads(LOCAL_NUM_THREADS)
+  #pragma omp parallel shared(counter) num_threads(LOCAL_NUM_THREADS)
   {
-  for (it = this->shortestPaths.begin(); it != this->shortestPaths.end(); ++it)
+  for (size_t c = 0; c < cells.size(); c++)
   {
     #pragma omp single nowait
     {
-    auto kv = *it;
+    const size_t cell = cells[c];
     counter += 1;
     LOGGER::LogDebug("shortestPaths: "+to_string(counter));
     if (counter % 2500 == 0)
         LOGGER::LogInfo("Processed #" + to_string(counter) + " geometries.");
 
-    string arcIDsPerPath = "";
-    ODPair key = kv.first;
-    CompressedPath value = kv.second;
-    /* resolve pred path to arcids */
-    auto path = value.first;
-    std::unordered_set<std::string> arcIDSetPerPath = this->net->GetOrigArcIDs(path);
-    double costPerPath = value.second;
-
-    if (arcIDSetPerPath.size() > 0)
-    {
-      for (string id : arcIDSetPerPath) {
-          arcIDsPerPath += id += ",";
-      }
-      arcIDsPerPath.pop_back(); //trim last comma
-    }
+    const auto& path = this->odResults.GetPath(cell);
+    double costPerPath = this->odResults.costs[cell];
 
-    string orig = this->net->GetOrigNodeID(key.origin);
-    string dest = this->net->GetOrigNodeID(key.dest);
+    string orig = this->net->GetOrigNodeID(this->odResults.origins[cell / destsSize]);
+    string dest = this->net->GetOrigNodeID(this->odResults.dests[cell % destsSize]);
 
-    this->net->ProcessSPTResultArcsMemS(orig, dest, costPerPath, arcIDsPerPath, path, outStream);
+    this->net->ProcessSPTResultArcsMemS(orig, dest, costPerPath, path, outStream);
 
-    if (counter < this->shortestPaths.size())
+    if (counter < cells.size())
       outStream << ",";
 
     } //omp single nowait
@@ -378,50 +639,6 @@ const std::string
   return outStream.str();
 }
 
-std::string
- OriginDestinationMatrix::processTotalArcIDs() {
-
-  std::string arcIDs = "";
-  std::unordered_set<string> totalArcIDs;
-  std::map<ODPair, CompressedPath>::const_iterator it; //const_iterator wegen Zugriff auf this->shortestPath
-
-  #pragma omp parallel default(shared) private(it) num_threads(LOCAL_NUM_THREADS)
-  {
-    //populate arcIDs
-    for (it = this->shortestPaths.begin(); it != this->shortestPaths.end(); ++it)
-    {
-      #pragma omp single nowait
-      {
-        auto kv = *it;
-        CompressedPath value = kv.second;
-        /* TODO resolve pred path to arcids */
-        /* ArcLookup vs AllArcLookup vs saving the path of the route, not only the preds ?*/
-        auto path = value.first;
-
-        std::unordered_set<std::string> arcIDlist = this->net->GetOrigArcIDs(path);
-
-        if (arcIDlist.size() > 0)
-        {
-          #pragma omp critical
-          {
-            for (std::string id : arcIDlist){
-              totalArcIDs.insert(id);
-            }
-          }
-        }
-      }//omp single
-    }
-  }//omp parallel
-
-  for (std::string id : totalArcIDs) {
-    arcIDs += id += ",";
-  }
-  if (arcIDs.size() > 0)
-    arcIDs.pop_back();
-
-  return arcIDs;
-}
-
 void
  OriginDestinationMatrix::SaveResults(const std::string& resultTableName,
                                       const ColumnMap& cmap) {
@@ -467,6 +684,7 @@ void
       }
       break;
       case RESULT_DB_TYPE::JSON:
+      case RESULT_DB_TYPE::GooglePolyLine:
       {
           //init file
           LOGGER::LogDebug("Writing Geometries..");
@@ -479,70 +697,56 @@ void
     if (cnfg.ResultDBType == RESULT_DB_TYPE::ESRI_FileGDB | cnfg.ResultDBType == RESULT_DB_TYPE::SpatiaLiteDB) {
       LOGGER::LogDebug("Writing Geometries..");
       writer->OpenNewTransaction();
+      if (cnfg.ResultDBType == RESULT_DB_TYPE::SpatiaLiteDB)
+        dynamic_cast<SpatiaLiteWriter&>(*writer).StartResultPipeline(resultTableName, NetXpertSolver::ODMatrixSolver);
     }
 
     //Processing and Saving Results are handled within net.ProcessResultArcs()
-    std::string arcIDs = "";
-    std::map<ODPair, CompressedPath>::const_iterator it; //const_iterator wegen Zugriff auf this->shortestPath
+    const vector<size_t> cells = getReachedCells();
+    const size_t destsSize = this->odResults.dests.size();
 
     if (cnfg.GeometryHandling == GEOMETRY_HANDLING::RealGeometry)
     {
-      arcIDs = processTotalArcIDs();
-
-      LOGGER::LogDebug("Preloading relevant geometries into Memory..");
+      //costs only: rebuild the paths of the exported pairs
+      materializePaths(cells);
 
-      if (arcIDs.size() > 0) {
-        DBHELPER::LoadGeometryToMem(cnfg.ArcsTableName, cmap, cnfg.ArcsGeomColumnName, arcIDs);
-      }
+      LOGGER::LogDebug("Preloading geometries into Memory..");
+      this->net->LoadArcGeometries(cnfg.ArcsTableName, cnfg.ArcsGeomColumnName, cmap);
       LOGGER::LogDebug("Done!");
     }
 
-    int counter = 0;
+    size_t counter = 0;
 
-    #pragma omp parallel shared(counter) private(it) num_threads(LOCAL_NUM_THREADS)
+    #pragma omp parallel shared(counter) num_threads(LOCAL_NUM_THREADS)
     {
 
     Stopwatch<> sw;
     double avgGeoProcTime = 0;
 
-    for (it = this->shortestPaths.begin(); it != this->shortestPaths.end(); ++it)
+    for (size_t c = 0; c < cells.size(); c++)
     {
       #pragma omp single nowait
       {
-      auto kv = *it;
+      const size_t cell = cells[c];
 
       counter += 1;
       if (counter % 2500 == 0)
           LOGGER::LogInfo("Processed #" + to_string(counter) + " geometries.");
 
-      string arcIDsPerPath = "";
-      ODPair key = kv.first;
-      CompressedPath value = kv.second;
-      /* resolve pred path to arcids */
-      /* ArcLookup vs AllArcLookup vs saving the path of the route, not only the preds ?*/
-      auto path = value.first;
-      std::unordered_set<std::string> arcIDSetPerPath = this->net->GetOrigArcIDs(path);
-      double costPerPath = value.second;
-
-      if (arcIDSetPerPath.size() > 0)
-      {
-        for (string id : arcIDSetPerPath) {
-            arcIDsPerPath += id += ",";
-        }
-        arcIDsPerPath.pop_back(); //trim last comma
-      }
+      const auto& path = this->odResults.GetPath(cell);
+      double costPerPath = this->odResults.costs[cell];
 
-      string orig = this->net->GetOrigNodeID(key.origin);
-      string dest = this->net->GetOrigNodeID(key.dest);
+      string orig = this->net->GetOrigNodeID(this->odResults.origins[cell / destsSize]);
+      string dest = this->net->GetOrigNodeID(this->odResults.dests[cell % destsSize]);
 
       if (cnfg.ResultDBType == RESULT_DB_TYPE::ESRI_FileGDB | cnfg.ResultDBType == RESULT_DB_TYPE::SpatiaLiteDB) {
-        this->net->ProcessSPTResultArcsMem(orig, dest, costPerPath, arcIDsPerPath, path, resultTableName, *writer, *qry);
+        this->net->ProcessSPTResultArcsMem(orig, dest, costPerPath, path, resultTableName, *writer, *qry);
       }
-      if (cnfg.ResultDBType == RESULT_DB_TYPE::JSON) {
-        this->net->ProcessSPTResultArcsMemS(orig, dest, costPerPath, arcIDsPerPath, path, outStream);
+      if (cnfg.ResultDBType == RESULT_DB_TYPE::JSON || cnfg.ResultDBType == RESULT_DB_TYPE::GooglePolyLine) {
+        this->net->ProcessSPTResultArcsMemS(orig, dest, costPerPath, path, outStream);
         //write string stream to file stream
         outfile << outStream.str();
-        if (counter < this->shortestPaths.size())
+        if (counter < cells.size())
             outfile << ",";
         //reset stream
         outStream.str(std::string());
@@ -555,11 +759,13 @@ void
 
     if (cnfg.ResultDBType == RESULT_DB_TYPE::ESRI_FileGDB | cnfg.ResultDBType == RESULT_DB_TYPE::SpatiaLiteDB) {
       LOGGER::LogDebug("Committing..");
+      if (cnfg.ResultDBType == RESULT_DB_TYPE::SpatiaLiteDB)
+        dynamic_cast<SpatiaLiteWriter&>(*writer).FinishResultPipeline();
       writer->CommitCurrentTransaction();
       writer->CloseConnection();
       LOGGER::LogDebug("Done!");
     }
-    if (cnfg.ResultDBType == RESULT_DB_TYPE::JSON) {
+    if (cnfg.ResultDBType == RESULT_DB_TYPE::JSON || cnfg.ResultDBType == RESULT_DB_TYPE::GooglePolyLine) {
       LOGGER::LogDebug("Writing to disk..");
       outfile << " ] }" << endl;
       outfile.flush();
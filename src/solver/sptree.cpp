@@ -120,8 +120,21 @@ void
                 spt = unique_ptr<ISPTree>(new SPT_BGL_Dijkstra(net.GetNodeCount(), net.GetArcCount(),
                                         isDirected));
                 break;*/
+            case SPTAlgorithm::Dijkstra_2Heap_CSR:
+                //LoadNet() freezes the current network into a CSR snapshot
+                if (!spt)
+                    spt = unique_ptr<ISPTree>(new SPT_CSR(isDirected, this->NETXPERT_CNFG.CSRSinglePrecision));
+                break;
+            case SPTAlgorithm::ContractionHierarchies:
+            case SPTAlgorithm::ContractionHierarchies_ManyToMany:
+                //hierarchy of the base network is loaded after LoadNet()
+                if (!spt)
+                    spt = unique_ptr<ISPTree>(new SPT_CH(isDirected));
+                break;
             default:
-                spt = unique_ptr<ISPTree>(new SPT_LEM(isDirected));
+                //keep the core solver (and its search workspace) across solve calls
+                if (!spt)
+                    spt = unique_ptr<ISPTree>(new SPT_LEM(isDirected));
                 break;
         }
     }
@@ -141,6 +154,8 @@ void
     //Read the network
     auto sg = convertInternalNetworkToSolverData(net);
     spt->LoadNet(net.GetNodeCount(), net.GetArcCount(), &sg, net.GetCostMap());
+    if (auto* chspt = dynamic_cast<SPT_CH*>(spt.get()))
+        chspt->LoadCH(net.GetContractionHierarchy());
 
     netxpert::data::cost_t totalCost = 0;
     spt->SetOrigin(orig);
@@ -212,8 +227,21 @@ void
                 spt = unique_ptr<ISPTree>(new SPT_BGL_Dijkstra(net.GetNodeCount(), net.GetArcCount(),
                                         isDirected));
                 break;*/
+            case SPTAlgorithm::Dijkstra_2Heap_CSR:
+                //LoadNet() freezes the current network into a CSR snapshot
+                if (!spt)
+                    spt = unique_ptr<ISPTree>(new SPT_CSR(isDirected, this->NETXPERT_CNFG.CSRSinglePrecision));
+                break;
+            case SPTAlgorithm::ContractionHierarchies:
+            case SPTAlgorithm::ContractionHierarchies_ManyToMany:
+                //hierarchy of the base network is loaded after LoadNet()
+                if (!spt)
+                    spt = unique_ptr<ISPTree>(new SPT_CH(isDirected));
+                break;
             default:
-                spt = unique_ptr<ISPTree>(new SPT_LEM(isDirected));
+                //keep the core solver (and its search workspace) across solve calls
+                if (!spt)
+                    spt = unique_ptr<ISPTree>(new SPT_LEM(isDirected));
                 break;
         }
     }
@@ -247,6 +275,8 @@ void
       }*/
 
       spt->LoadNet(net.GetNodeCount(), net.GetArcCount(), &sg, net.GetCostMap());
+      if (auto* chspt = dynamic_cast<SPT_CH*>(spt.get()))
+          chspt->LoadCH(net.GetContractionHierarchy());
 
       orig = net.GetNodeFromID(net.GetNodeID(orig));
       dest = net.GetNodeFromID(net.GetNodeID(dest));
@@ -404,8 +434,21 @@ void
                 spt = unique_ptr<ISPTree>(new SPT_BGL_Dijkstra(net.GetNodeCount(), net.GetArcCount(),
                                         isDirected));
                 break;*/
+            case SPTAlgorithm::Dijkstra_2Heap_CSR:
+                //LoadNet() freezes the current network into a CSR snapshot
+                if (!spt)
+                    spt = unique_ptr<ISPTree>(new SPT_CSR(isDirected, this->NETXPERT_CNFG.CSRSinglePrecision));
+                break;
+            case SPTAlgorithm::ContractionHierarchies:
+            case SPTAlgorithm::ContractionHierarchies_ManyToMany:
+                //hierarchy of the base network is loaded after LoadNet()
+                if (!spt)
+                    spt = unique_ptr<ISPTree>(new SPT_CH(isDirected));
+                break;
             default:
-                spt = unique_ptr<ISPTree>(new SPT_LEM(isDirected));
+                //keep the core solver (and its search workspace) across solve calls
+                if (!spt)
+                    spt = unique_ptr<ISPTree>(new SPT_LEM(isDirected));
                 break;
         }
     }
@@ -426,6 +469,8 @@ void
     //Filter arcs out and read the network
     auto sg = convertInternalNetworkToSolverData(net);
     spt->LoadNet(net.GetNodeCount(), net.GetArcCount(), &sg, net.GetCostMap());
+    if (auto* chspt = dynamic_cast<SPT_CH*>(spt.get()))
+        chspt->LoadCH(net.GetContractionHierarchy());
 
     netxpert::data::cost_t totalCost = 0;
     spt->SetOrigin(orig);
@@ -477,6 +522,9 @@ const SPTAlgorithm
 
 void
  ShortestPathTree::SetAlgorithm(SPTAlgorithm sptAlgorithm) {
+    //the core solver is kept across solve calls; rebuild it for the new algorithm
+    if (this->algorithm != sptAlgorithm)
+        this->spt.reset();
     this->algorithm = sptAlgorithm;
 }
 
@@ -574,20 +622,13 @@ const std::string
 
   if (NETXPERT_CNFG.GeometryHandling == GEOMETRY_HANDLING::RealGeometry)
   {
-//    //check if already loaded to mem through SaveResults()
-//    if (DBHELPER::KV_Network.size() < 1) {
-       std::string arcIDs = processTotalArcIDs();
-
-      LOGGER::LogDebug("Preloading relevant geometries into Memory..");
+    LOGGER::LogDebug("Preloading geometries into Memory..");
 
-      ColumnMap cmap { NETXPERT_CNFG.ArcIDColumnName, NETXPERT_CNFG.FromNodeColumnName, NETXPERT_CNFG.ToNodeColumnName,
-                      NETXPERT_CNFG.CostColumnName, NETXPERT_CNFG.CapColumnName, NETXPERT_CNFG.OnewayColumnName};
+    ColumnMap cmap { NETXPERT_CNFG.ArcIDColumnName, NETXPERT_CNFG.FromNodeColumnName, NETXPERT_CNFG.ToNodeColumnName,
+                    NETXPERT_CNFG.CostColumnName, NETXPERT_CNFG.CapColumnName, NETXPERT_CNFG.OnewayColumnName};
 
-      if (arcIDs.size() > 0) {
-        DBHELPER::LoadGeometryToMem(NETXPERT_CNFG.ArcsTableName, cmap, NETXPERT_CNFG.ArcsGeomColumnName, arcIDs);
-      }
-      LOGGER::LogDebug("Done!");
-//    }
+    this->net->LoadArcGeometries(NETXPERT_CNFG.ArcsTableName, NETXPERT_CNFG.ArcsGeomColumnName, cmap);
+    LOGGER::LogDebug("Done!");
   }
 
   int counter = 0;
@@ -604,26 +645,15 @@ const std::string
     if (counter % 2500 == 0)
         LOGGER::LogInfo("Processed #" + to_string(counter) + " geometries.");
 
-    string arcIDsPerPath = "";
     ODPair key = kv.first;
     CompressedPath value = kv.second;
-    /* resolve pred path to arcids */
     auto path = value.first;
-    std::unordered_set<std::string> arcIDSetPerPath = this->net->GetOrigArcIDs(path);
     double costPerPath = value.second;
 
-    if (arcIDSetPerPath.size() > 0)
-    {
-      for (string id : arcIDSetPerPath) {
-          arcIDsPerPath += id += ",";
-      }
-      arcIDsPerPath.pop_back(); //trim last comma
-    }
-
     string orig = this->net->GetOrigNodeID(key.origin);
     string dest = this->net->GetOrigNodeID(key.dest);
 
-    this->net->ProcessSPTResultArcsMemS(orig, dest, costPerPath, arcIDsPerPath, path, outStream);
+    this->net->ProcessSPTResultArcsMemS(orig, dest, costPerPath, path, outStream);
 
     if (counter < this->shortestPaths.size())
       outStream << ",";
@@ -637,50 +667,6 @@ const std::string
   return outStream.str();
 }
 
-std::string
- ShortestPathTree::processTotalArcIDs() {
-
-  std::string arcIDs = "";
-  std::unordered_set<string> totalArcIDs;
-  std::map<ODPair, CompressedPath>::const_iterator it; //const_iterator wegen Zugriff auf this->shortestPath
-
-  #pragma omp parallel default(shared) private(it) num_threads(LOCAL_NUM_THREADS)
-  {
-    //populate arcIDs
-    for (it = this->shortestPaths.begin(); it != this->shortestPaths.end(); ++it)
-    {
-      #pragma omp single nowait
-      {
-        auto kv = *it;
-        CompressedPath value = kv.second;
-        /* TODO resolve pred path to arcids */
-        /* ArcLookup vs AllArcLookup vs saving the path of the route, not only the preds ?*/
-        auto path = value.first;
-
-        std::unordered_set<std::string> arcIDlist = this->net->GetOrigArcIDs(path);
-
-        if (arcIDlist.size() > 0)
-        {
-          #pragma omp critical
-          {
-            for (std::string id : arcIDlist){
-              totalArcIDs.insert(id);
-            }
-          }
-        }
-      }//omp single
-    }
-  }//omp parallel
-
-  for (std::string id : totalArcIDs) {
-    arcIDs += id += ",";
-  }
-  if (arcIDs.size() > 0)
-    arcIDs.pop_back();
-
-  return arcIDs;
-}
-
 void
  ShortestPathTree::SaveResults(const std::string& resultTableName,
                                const ColumnMap& cmap ) {
@@ -726,6 +712,7 @@ void
       }
       break;
       case RESULT_DB_TYPE::JSON:
+      case RESULT_DB_TYPE::GooglePolyLine:
       {
           //init file
           LOGGER::LogDebug("Writing Geometries..");
@@ -738,21 +725,17 @@ void
     if (cnfg.ResultDBType == RESULT_DB_TYPE::ESRI_FileGDB | cnfg.ResultDBType == RESULT_DB_TYPE::SpatiaLiteDB) {
       LOGGER::LogDebug("Writing Geometries..");
       writer->OpenNewTransaction();
+      if (cnfg.ResultDBType == RESULT_DB_TYPE::SpatiaLiteDB)
+        dynamic_cast<SpatiaLiteWriter&>(*writer).StartResultPipeline(resultTableName, NetXpertSolver::ShortestPathTreeSolver);
     }
 
     //Processing and Saving Results are handled within net.ProcessResultArcs()
-    std::string arcIDs = "";
     std::map<ODPair, CompressedPath>::const_iterator it; //const_iterator wegen Zugriff auf this->shortestPath
 
 		if (cnfg.GeometryHandling == GEOMETRY_HANDLING::RealGeometry)
 		{
-		  arcIDs = processTotalArcIDs();
-
-			LOGGER::LogDebug("Preloading relevant geometries into Memory..");
-
-			if (arcIDs.size() > 0) {
-				DBHELPER::LoadGeometryToMem(cnfg.ArcsTableName, cmap, cnfg.ArcsGeomColumnName, arcIDs);
-			}
+			LOGGER::LogDebug("Preloading geometries into Memory..");
+			this->net->LoadArcGeometries(cnfg.ArcsTableName, cnfg.ArcsGeomColumnName, cmap);
 			LOGGER::LogDebug("Done!");
 		}
 
@@ -770,31 +753,19 @@ void
       if (counter % 2500 == 0)
           LOGGER::LogInfo("Processed #" + to_string(counter) + " geometries.");
 
-      string arcIDsPerPath = "";
       ODPair key = kv.first;
       CompressedPath value = kv.second;
-      /* resolve pred path to arcids */
-      /* ArcLookup vs AllArcLookup vs saving the path of the route, not only the preds ?*/
       auto path = value.first;
-      std::unordered_set<std::string> arcIDSetPerPath = this->net->GetOrigArcIDs(path);
       double costPerPath = value.second;
 
-      if (arcIDSetPerPath.size() > 0)
-      {
-        for (string id : arcIDSetPerPath) {
-            arcIDsPerPath += id += ",";
-        }
-        arcIDsPerPath.pop_back(); //trim last comma
-      }
-
       string orig = this->net->GetOrigNodeID(key.origin);
       string dest = this->net->GetOrigNodeID(key.dest);
 
       if (cnfg.ResultDBType == RESULT_DB_TYPE::ESRI_FileGDB | cnfg.ResultDBType == RESULT_DB_TYPE::SpatiaLiteDB) {
-        this->net->ProcessSPTResultArcsMem(orig, dest, costPerPath, arcIDsPerPath, path, resultTableName, *writer, *qry);
+        this->net->ProcessSPTResultArcsMem(orig, dest, costPerPath, path, resultTableName, *writer, *qry);
       }
-      if (cnfg.ResultDBType == RESULT_DB_TYPE::JSON) {
-        this->net->ProcessSPTResultArcsMemS(orig, dest, costPerPath, arcIDsPerPath, path, outStream);
+      if (cnfg.ResultDBType == RESULT_DB_TYPE::JSON || cnfg.ResultDBType == RESULT_DB_TYPE::GooglePolyLine) {
+        this->net->ProcessSPTResultArcsMemS(orig, dest, costPerPath, path, outStream);
         //write string stream to file stream
         outfile << outStream.str();
         if (counter < this->shortestPaths.size())
@@ -809,11 +780,13 @@ void
 
     if (cnfg.ResultDBType == RESULT_DB_TYPE::ESRI_FileGDB | cnfg.ResultDBType == RESULT_DB_TYPE::SpatiaLiteDB) {
       LOGGER::LogDebug("Committing..");
+      if (cnfg.ResultDBType == RESULT_DB_TYPE::SpatiaLiteDB)
+        dynamic_cast<SpatiaLiteWriter&>(*writer).FinishResultPipeline();
       writer->CommitCurrentTransaction();
       writer->CloseConnection();
       LOGGER::LogDebug("Done!");
     }
-    if (cnfg.ResultDBType == RESULT_DB_TYPE::JSON) {
+    if (cnfg.ResultDBType == RESULT_DB_TYPE::JSON || cnfg.ResultDBType == RESULT_DB_TYPE::GooglePolyLine) {
       LOGGER::LogDebug("Writing to disk..");
       outfile << " ] }" << endl;
       outfile.flush();
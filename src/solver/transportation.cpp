@@ -50,6 +50,12 @@ void
     if (this->extODMatrix.size() == 0 || this->extNodeSupply.size() == 0)
         throw std::runtime_error("OD-Matrix and node supply must be filled in Transportation Solver!");
 
+    this->distribution.clear();
+    this->mcfNet.reset();
+    this->odSolver.reset();
+    this->isDense = false;
+    this->isSparse = false;
+
     //arcData from ODMatrix
     InputArcs arcs;
     for (ExtSPTreeArc& v : extODMatrix)
@@ -90,45 +96,7 @@ void
     //Call MCF Solver of parent class
     MinCostFlow::Solve(*this->net);
 
-    //2. Search for the ODpairs in ODMatrix Solver result with the original IDs of the
-    // Min Cost Flow Solver result
-    vector<FlowCost> flowCost = MinCostFlow::GetMinCostFlow();
-    for (auto& fc : flowCost)
-    {
-        string oldStartNodeID;
-        string oldEndNodeID;
-
-        auto oldStartNode   = this->net->GetSourceNode(fc.intArc);
-        auto oldEndNode     = this->net->GetTargetNode(fc.intArc);
-
-        try
-        {
-            oldStartNodeID = this->net->GetOrigNodeID(oldStartNode);
-            oldEndNodeID   = this->net->GetOrigNodeID(oldEndNode);
-
-            if (oldStartNodeID != "dummy" && oldEndNodeID != "dummy")
-            {
-                //build key for result map
-                ODPair resultKey { oldStartNode, oldEndNode };
-
-                // there is no path, because we do not have the values from the OD solver
-                DistributionArc resultVal { CompressedPath { make_pair(vector<arc_t> {}, fc.cost) }, fc.flow };
-
-                this->distribution.insert(make_pair(resultKey, resultVal));
-            }
-            else
-            {
-                LOGGER::LogWarning("Dummy: FromTo "+
-                                    oldStartNodeID + " - "+ oldEndNodeID+
-                                    " could not be looked up!");
-            }
-        }
-        catch (exception& ex)
-        {
-            LOGGER::LogError("Something strange happened - maybe a key error. ");
-            LOGGER::LogError(ex.what());
-        }
-    }
+    buildExtDistribution();
 }
 
 void
@@ -139,13 +107,48 @@ void
     if (this->originNodes.size() == 0 || this->destinationNodes.size() == 0)
         throw std::runtime_error("Origin nodes and destination nodes must be filled in Transportation Solver!");
 
-    //Call the ODMatrixSolver
-    OriginDestinationMatrix ODsolver(this->NETXPERT_CNFG);
+    this->distribution.clear();
+
+    //Call the ODMatrixSolver (kept for Resolve())
+    this->odSolver = std::unique_ptr<OriginDestinationMatrix>(new OriginDestinationMatrix(this->NETXPERT_CNFG));
+    auto& ODsolver = *this->odSolver;
     //Precondition: Starts and Ends has been filled and thus
     // they were already converted to ascending ints
     ODsolver.SetOrigins(this->originNodes);
     ODsolver.SetDestinations(this->destinationNodes);
+    //only costs are needed for the transportation problem; paths are rebuilt for the pairs with flow
+    ODsolver.SetCostsOnly(true);
+
+    this->isSparse = false;
+    if (this->NETXPERT_CNFG.TransportationCandidates > 0)
+    {
+        //no full OD matrix: candidate OD pairs are priced in on demand
+        this->mcfNet.reset();
+        this->isDense = false;
+        solveCandidates(net);
+        return;
+    }
     ODsolver.Solve(net);
+
+    if (this->NETXPERT_CNFG.TransportationDense)
+    {
+        //the dense cost matrix of the OD solver is the instance; no network and no string IDs in between
+        this->mcfNet.reset();
+        const auto& odResults = ODsolver.GetODResults();
+        this->denseCosts   = odResults.costs;
+        this->denseAllowed = odResults.reached;
+        this->denseSupplies.clear();
+        this->denseDemands.clear();
+        for (const auto& orig : odResults.origins)
+            this->denseSupplies.push_back( std::max(net.GetNodeSupply(orig), 0.0) );
+        for (const auto& dest : odResults.dests)
+            this->denseDemands.push_back( std::max(-net.GetNodeSupply(dest), 0.0) );
+
+        solveDense();
+        buildDenseDistribution();
+        return;
+    }
+    this->isDense = false;
     this->odMatrix = ODsolver.GetODMatrix();
 
     std::set<netxpert::data::node_t> odKeys;
@@ -198,7 +201,8 @@ void
 //    std::map<std::string, IntNodeID> extIntNodeMap;
     // construct network from ODMatrix; the original nodes persist,
     // but the internal nodes will be computed new
-    InternalNet mcfNet(arcs, cmap, cnfg, nodes);
+    this->mcfNet = std::unique_ptr<InternalNet>(new InternalNet(arcs, cmap, cnfg, nodes));
+    auto& mcfNet = *this->mcfNet;
 
 //    nodesIter = net.GetNodesIter();
 //    std::cout << " Net nodes " << std::endl;
@@ -223,6 +227,388 @@ void
     //Call MCF Solver of parent class
     MinCostFlow::Solve(mcfNet);
 
+    buildDistribution();
+}
+
+void
+ Transportation::Solve(const std::vector<cost_t>& costs,
+                       const std::vector<supply_t>& supplies,
+                       const std::vector<supply_t>& demands) {
+
+    this->distribution.clear();
+    this->mcfNet.reset();
+    this->odSolver.reset();
+    this->isSparse = false;
+
+    this->denseCosts    = costs;
+    this->denseSupplies = supplies;
+    this->denseDemands  = demands;
+    this->denseAllowed.clear();
+
+    solveDense();
+}
+
+void
+ Transportation::solveDense() {
+
+    this->isDense = true;
+    this->denseFlows.clear();
+
+    LOGGER::LogDebug("Origins: "+ to_string(this->denseSupplies.size()));
+    LOGGER::LogDebug("Destinations: "+ to_string(this->denseDemands.size()));
+    LOGGER::LogDebug("Solving..");
+
+    TransportationSimplex tp;
+    tp.LoadMatrix(this->denseCosts, this->denseSupplies, this->denseDemands,
+                  this->denseAllowed.empty() ? nullptr : &this->denseAllowed);
+    tp.Solve();
+
+    this->solverStatus = static_cast<MCFSolverStatus>(tp.GetStatus());
+    LOGGER::LogDebug("Transportation Simplex Status: " + to_string(tp.GetStatus()) +
+                     ", pivots: " + to_string(tp.GetIterationCount()));
+
+    if (this->solverStatus != MCFSolverStatus::MCFOK) {
+        string ex = "Transportation Simplex Status not OK! Solverstatus: " + to_string(this->solverStatus);
+        LOGGER::LogError(ex);
+        throw std::runtime_error(ex);
+    }
+    this->optimum    = tp.GetOptimum();
+    this->denseFlows = tp.GetFlows();
+}
+
+void
+ Transportation::buildDenseDistribution() {
+
+    const auto& odResults = this->odSolver->GetODResults();
+
+    //rebuild the shortest paths only for the od pairs that carry flow
+    vector<ODPair> flowPairs;
+    for (const auto& cell : this->denseFlows)
+        flowPairs.push_back( ODPair {odResults.origins[cell.origIdx], odResults.dests[cell.destIdx]} );
+
+    map<ODPair, CompressedPath> shortestPaths = this->odSolver->GetShortestPaths(flowPairs);
+
+    for (size_t i = 0; i < flowPairs.size(); i++)
+    {
+        const auto& cell = this->denseFlows[i];
+        auto it = shortestPaths.find(flowPairs[i]);
+        if (it == shortestPaths.end()) {
+            LOGGER::LogError("Pair of shortest path "+
+                             this->net->GetOrigNodeID(flowPairs[i].origin) + " - "+
+                             this->net->GetOrigNodeID(flowPairs[i].dest) + " could not be looked up!");
+            continue;
+        }
+        auto path = it->second;
+        //cost of the matrix cell (may differ from the path after Resolve())
+        path.second = this->denseCosts[odResults.Index(cell.origIdx, cell.destIdx)];
+        this->distribution.insert(make_pair(flowPairs[i], DistributionArc {path, cell.flow}));
+    }
+}
+
+/**
+* Column generation over the OD matrix: the restricted problem holds the OD pairs found so far and is solved as
+* Minimum Cost Flow problem. An artificial node with the cost M per unit keeps every restricted problem feasible.
+* With the potentials pi of its solution an OD pair (i,j) improves the solution, if c(i,j) + pi(i) - pi(j) < 0;
+* so the search of origin i can stop at max_j pi(j) - pi(i). If no pair is left, the solution is optimal - unless
+* the artificial node still carries flow: then M is increased until it exceeds any possible path length.
+*/
+void
+ Transportation::solveCandidates(netxpert::data::InternalNet& net) {
+
+    auto& ODsolver = *this->odSolver;
+    const auto& origs = this->originNodes;
+    const auto& dests = this->destinationNodes;
+    const size_t origCount = origs.size();
+    const size_t destCount = dests.size();
+    const cost_t eps = 1e-7;
+
+    //initial candidates: k nearest destinations per origin
+    vector<ODCell> columns = ODsolver.SolveSparse(net, this->NETXPERT_CNFG.TransportationCandidates, {});
+    std::unordered_set<uint64_t> columnKeys;
+    cost_t maxCost = 0;
+    for (const auto& c : columns) {
+        columnKeys.insert( (uint64_t) c.origIdx * destCount + c.destIdx );
+        maxCost = std::max(maxCost, c.cost);
+    }
+
+    supply_t totalSupply = 0;
+    supply_t totalDemand = 0;
+    vector<supply_t> supplies;
+    vector<supply_t> demands;
+    for (const auto& orig : origs) {
+        supplies.push_back( std::max(net.GetNodeSupply(orig), 0.0) );
+        totalSupply += supplies.back();
+    }
+    for (const auto& dest : dests) {
+        demands.push_back( std::max(-net.GetNodeSupply(dest), 0.0) );
+        totalDemand += demands.back();
+    }
+
+    //no path is longer than all arcs of the network together
+    cost_t sumCosts = 0;
+    auto* netCostMap = net.GetCostMap();
+    for (auto arcIter = net.GetArcsIter(); arcIter != lemon::INVALID; ++arcIter)
+        sumCosts += std::abs((*netCostMap)[arcIter]);
+    const cost_t maxArtificialCost = (sumCosts + 1) * (origCount + destCount);
+    cost_t artificialCost = 2 * (maxCost + 1);
+
+    vector<flow_t> columnFlows;
+    uint32_t round = 0;
+    while (true)
+    {
+        round += 1;
+        //restricted problem: origins, destinations, artificial node and dummy node for unbalanced instances
+        graph_t g;
+        vector<node_t> origNodes;
+        vector<node_t> destNodes;
+        for (size_t i = 0; i < origCount; i++)
+            origNodes.push_back(g.addNode());
+        for (size_t j = 0; j < destCount; j++)
+            destNodes.push_back(g.addNode());
+        const node_t artificial = g.addNode();
+        const node_t dummy = g.addNode();
+
+        vector<arc_t> columnArcs;
+        for (const auto& c : columns)
+            columnArcs.push_back(g.addArc(origNodes[c.origIdx], destNodes[c.destIdx]));
+        vector<arc_t> artificialArcs;
+        for (size_t i = 0; i < origCount; i++)
+            artificialArcs.push_back(g.addArc(origNodes[i], artificial));
+        vector<arc_t> otherArcs;
+        for (size_t j = 0; j < destCount; j++)
+            otherArcs.push_back(g.addArc(artificial, destNodes[j]));
+        if (totalSupply > totalDemand) {
+            for (size_t i = 0; i < origCount; i++)
+                otherArcs.push_back(g.addArc(origNodes[i], dummy));
+        }
+        else if (totalDemand > totalSupply) {
+            for (size_t j = 0; j < destCount; j++)
+                otherArcs.push_back(g.addArc(dummy, destNodes[j]));
+        }
+
+        graph_t::ArcMap<bool> arcFilter(g, true);
+        graph_t::ArcMap<cost_t> costMap(g, 0);
+        graph_t::ArcMap<capacity_t> capMap(g, DOUBLE_INFINITY);
+        graph_t::NodeMap<supply_t> supplyMap(g, 0);
+        for (size_t c = 0; c < columns.size(); c++)
+            costMap[columnArcs[c]] = columns[c].cost;
+        for (const auto& a : artificialArcs)
+            costMap[a] = artificialCost;
+        for (size_t i = 0; i < origCount; i++)
+            supplyMap[origNodes[i]] = supplies[i];
+        for (size_t j = 0; j < destCount; j++)
+            supplyMap[destNodes[j]] = -demands[j];
+        supplyMap[dummy] = totalDemand - totalSupply;
+
+        filtered_graph_t sg(g, arcFilter);
+        auto mcf = MinCostFlow::CreateCoreSolver(MCFAlgorithm::NetworkSimplex_LEMON, this->NETXPERT_CNFG.McfPivotRule,
+                                                 this->NETXPERT_CNFG.McfIntegerPrecision);
+        mcf->LoadNet(countNodes(g), countArcs(g), &sg, &costMap, &capMap, &supplyMap);
+        mcf->SolveMCF();
+
+        this->solverStatus = static_cast<MCFSolverStatus>(mcf->GetMCFStatus());
+        if (this->solverStatus != MCFSolverStatus::MCFOK) {
+            string ex = "MCF Solver Status not OK! Solverstatus: " + to_string(this->solverStatus);
+            LOGGER::LogError(ex);
+            throw std::runtime_error(ex);
+        }
+        auto* flowMap = mcf->GetMCFFlow();
+        auto* potentialMap = mcf->GetMCFPotential();
+
+        flow_t artificialFlow = 0;
+        for (const auto& a : artificialArcs)
+            artificialFlow += (*flowMap)[a];
+        columnFlows.clear();
+        for (const auto& a : columnArcs)
+            columnFlows.push_back((*flowMap)[a]);
+
+        //pricing: reduced cost c(i,j) + pi(i) - pi(j) of the missing OD pairs
+        vector<cost_t> origPotentials;
+        vector<cost_t> destPotentials;
+        cost_t maxDestPotential = -std::numeric_limits<cost_t>::max();
+        for (const auto& n : origNodes)
+            origPotentials.push_back((*potentialMap)[n]);
+        for (const auto& n : destNodes) {
+            destPotentials.push_back((*potentialMap)[n]);
+            maxDestPotential = std::max(maxDestPotential, destPotentials.back());
+        }
+        vector<cost_t> thresholds;
+        for (size_t i = 0; i < origCount; i++)
+            thresholds.push_back(maxDestPotential - origPotentials[i] + eps);
+
+        size_t added = 0;
+        for (const auto& c : ODsolver.SolveSparse(net, 0, thresholds))
+        {
+            const uint64_t key = (uint64_t) c.origIdx * destCount + c.destIdx;
+            if (c.cost + origPotentials[c.origIdx] - destPotentials[c.destIdx] < -eps &&
+                columnKeys.count(key) == 0)
+            {
+                columnKeys.insert(key);
+                columns.push_back(c);
+                added += 1;
+            }
+        }
+        LOGGER::LogDebug("Column generation round " + to_string(round) + ": OD pairs: " + to_string(columns.size()) +
+                         ", added: " + to_string(added) + ", artificial flow: " + to_string(artificialFlow));
+
+        if (added > 0)
+            continue;
+        if (artificialFlow <= eps)
+            break;
+
+        //no improving OD pair, but artificial flow left: M was too small or the instance is unfeasible
+        artificialCost *= 10;
+        if (artificialCost > maxArtificialCost) {
+            this->solverStatus = MCFSolverStatus::MCFUnfeasible;
+            string ex = "MCF Solver Status not OK! Solverstatus: " + to_string(this->solverStatus);
+            LOGGER::LogError(ex);
+            throw std::runtime_error(ex);
+        }
+    }
+    this->isSparse = true;
+
+    //optimum and distribution of the OD pairs with flow; the paths are rebuilt for these pairs only
+    this->optimum = 0;
+    vector<ODPair> flowPairs;
+    vector<size_t> flowColumns;
+    for (size_t c = 0; c < columns.size(); c++) {
+        if (columnFlows[c] > 0) {
+            this->optimum += columns[c].cost * columnFlows[c];
+            flowPairs.push_back( ODPair {origs[columns[c].origIdx], dests[columns[c].destIdx]} );
+            flowColumns.push_back(c);
+        }
+    }
+    map<ODPair, CompressedPath> shortestPaths = ODsolver.GetShortestPaths(flowPairs);
+
+    for (size_t i = 0; i < flowPairs.size(); i++)
+    {
+        auto it = shortestPaths.find(flowPairs[i]);
+        if (it == shortestPaths.end()) {
+            LOGGER::LogError("Pair of shortest path "+
+                             net.GetOrigNodeID(flowPairs[i].origin) + " - "+
+                             net.GetOrigNodeID(flowPairs[i].dest) + " could not be looked up!");
+            continue;
+        }
+        auto path = it->second;
+        path.second = columns[flowColumns[i]].cost;
+        this->distribution.insert(make_pair(flowPairs[i], DistributionArc {path, columnFlows[flowColumns[i]]}));
+    }
+}
+
+std::vector<TransportationCell>
+ Transportation::GetDenseFlows() const {
+    return this->denseFlows;
+}
+
+void
+ Transportation::Resolve(const std::vector<ExtNodeSupply>& supplyChanges,
+                         const std::vector<ExtSPTreeArc>& costChanges) {
+
+    if (this->isSparse)
+        throw std::runtime_error("Transportation::Resolve() is not supported for instances of TransportationCandidates!");
+
+    if (this->isDense)
+    {
+        if (!this->odSolver)
+            throw std::runtime_error("Transportation::Resolve() needs a dense instance that was solved on a network!");
+
+        //rows and columns of the nodes in the dense matrix
+        const auto& odResults = this->odSolver->GetODResults();
+        std::unordered_map<string, size_t> origIdx;
+        std::unordered_map<string, size_t> destIdx;
+        for (size_t i = 0; i < odResults.origins.size(); i++)
+            origIdx.insert( make_pair(this->net->GetOrigNodeID(odResults.origins[i]), i) );
+        for (size_t j = 0; j < odResults.dests.size(); j++)
+            destIdx.insert( make_pair(this->net->GetOrigNodeID(odResults.dests[j]), j) );
+
+        for (const auto& change : supplyChanges)
+        {
+            auto orig = origIdx.find(change.extNodeID);
+            auto dest = destIdx.find(change.extNodeID);
+            if (orig == origIdx.end() && dest == destIdx.end()) {
+                LOGGER::LogWarning("Supply of node "+ change.extNodeID + " could not be changed!");
+                continue;
+            }
+            if (orig != origIdx.end())
+                this->denseSupplies[orig->second] = std::max(change.supply, 0.0);
+            if (dest != destIdx.end())
+                this->denseDemands[dest->second] = std::max(-change.supply, 0.0);
+        }
+        for (const auto& change : costChanges)
+        {
+            auto orig = origIdx.find(change.extArc.extFromNode);
+            auto dest = destIdx.find(change.extArc.extToNode);
+            if (orig == origIdx.end() || dest == destIdx.end()) {
+                LOGGER::LogWarning("Cost of OD pair "+ change.extArc.extFromNode + " - "+ change.extArc.extToNode +
+                                   " could not be changed!");
+                continue;
+            }
+            const size_t idx = odResults.Index(orig->second, dest->second);
+            this->denseCosts[idx] = change.cost;
+            //a given cost makes a pair usable that was not reached by the OD matrix solver
+            this->denseAllowed[idx] = 1;
+        }
+
+        this->distribution.clear();
+        solveDense();
+        buildDenseDistribution();
+        return;
+    }
+
+    //network of the MCF solver: built from the OD matrix of the network in Solve(net), or the network itself in Solve()
+    InternalNet* mcfNetPtr = this->mcfNet ? this->mcfNet.get() : this->net;
+    if (!mcfNetPtr)
+        throw std::runtime_error("Transportation::Resolve() needs a solved instance!");
+    auto& mcfNet = *mcfNetPtr;
+
+    vector<NodeSupplyChange> mcfSupplyChanges;
+    for (const auto& change : supplyChanges)
+    {
+        auto node = mcfNet.GetNodeFromOrigID(change.extNodeID);
+        if (node == lemon::INVALID) {
+            LOGGER::LogWarning("Supply of node "+ change.extNodeID + " could not be changed!");
+            continue;
+        }
+        mcfSupplyChanges.push_back( NodeSupplyChange {node, change.supply} );
+    }
+
+    //the OD matrix is kept; changed costs replace the costs of the OD pairs
+    vector<ArcCostChange> mcfCostChanges;
+    for (const auto& change : costChanges)
+    {
+        auto orig = mcfNet.GetNodeFromOrigID(change.extArc.extFromNode);
+        auto dest = mcfNet.GetNodeFromOrigID(change.extArc.extToNode);
+        auto arc  = (orig != lemon::INVALID && dest != lemon::INVALID) ? mcfNet.GetArcFromNodes(orig, dest)
+                                                                      : lemon::INVALID;
+        if (arc == lemon::INVALID) {
+            LOGGER::LogWarning("Cost of OD pair "+ change.extArc.extFromNode + " - "+ change.extArc.extToNode +
+                               " could not be changed!");
+            continue;
+        }
+        mcfCostChanges.push_back( ArcCostChange {arc, change.cost} );
+        if (this->mcfNet) {
+            ODPair key {this->net->GetNodeFromOrigID(change.extArc.extFromNode),
+                        this->net->GetNodeFromOrigID(change.extArc.extToNode)};
+            this->odMatrix[key] = change.cost;
+        }
+    }
+
+    MinCostFlow::Resolve(mcfSupplyChanges, mcfCostChanges);
+
+    this->distribution.clear();
+    if (this->mcfNet)
+        buildDistribution();
+    else
+        buildExtDistribution();
+}
+
+void
+ Transportation::buildDistribution() {
+
+    auto& net       = *this->net;
+    auto& mcfNet    = *this->mcfNet;
+    auto& ODsolver  = *this->odSolver;
+
     //Go back from Origin->Dest: flow,cost to real path with a list of start and end nodes of the ODMatrix
     //1. Translate back to original node ids
 
@@ -230,7 +616,23 @@ void
     //2. Search for the ODpairs in ODMatrix Solver result with the original IDs of the
     // Min Cost Flow Solver result
     vector<FlowCost> flowCost                   = MinCostFlow::GetMinCostFlow(); //was run with mcfNet
-    map<ODPair, CompressedPath> shortestPaths   = ODsolver.GetShortestPaths(); //was run with ODnet
+
+    //rebuild the shortest paths only for the od pairs that carry flow
+    vector<ODPair> flowPairs;
+    for (const auto& fc : flowCost)
+    {
+        string mcfStartNodeID = mcfNet.GetOrigNodeID( mcfNet.GetSourceNode(fc.intArc) );
+        string mcfEndNodeID   = mcfNet.GetOrigNodeID( mcfNet.GetTargetNode(fc.intArc) );
+        if (mcfStartNodeID == "dummy" || mcfEndNodeID == "dummy")
+            continue;
+        try {
+            flowPairs.push_back( ODPair {net.GetNodeFromOrigID(mcfStartNodeID), net.GetNodeFromOrigID(mcfEndNodeID)} );
+        }
+        catch (std::out_of_range& ex) {
+            //reported in the lookup below
+        }
+    }
+    map<ODPair, CompressedPath> shortestPaths   = ODsolver.GetShortestPaths(flowPairs); //was run with ODnet
 
 //    std::cout << "ODMatrix result (int node ids): " <<std::endl;
 //
@@ -286,6 +688,8 @@ void
                         ODPair resultKey {odStartNode, odEndNode} ;
 
                         auto path = shortestPaths.at(resultKey);
+                        //cost of the MCF arc (may differ from the path after Resolve())
+                        path.second = fc.cost;
 
                         DistributionArc resultVal { path, fc.flow};
 
@@ -321,8 +725,49 @@ void
     }//omp parallel
 }
 
+void
+ Transportation::buildExtDistribution() {
 
+    //2. Search for the ODpairs in ODMatrix Solver result with the original IDs of the
+    // Min Cost Flow Solver result
+    vector<FlowCost> flowCost = MinCostFlow::GetMinCostFlow();
+    for (auto& fc : flowCost)
+    {
+        string oldStartNodeID;
+        string oldEndNodeID;
 
+        auto oldStartNode   = this->net->GetSourceNode(fc.intArc);
+        auto oldEndNode     = this->net->GetTargetNode(fc.intArc);
+
+        try
+        {
+            oldStartNodeID = this->net->GetOrigNodeID(oldStartNode);
+            oldEndNodeID   = this->net->GetOrigNodeID(oldEndNode);
+
+            if (oldStartNodeID != "dummy" && oldEndNodeID != "dummy")
+            {
+                //build key for result map
+                ODPair resultKey { oldStartNode, oldEndNode };
+
+                // there is no path, because we do not have the values from the OD solver
+                DistributionArc resultVal { CompressedPath { make_pair(vector<arc_t> {}, fc.cost) }, fc.flow };
+
+                this->distribution.insert(make_pair(resultKey, resultVal));
+            }
+            else
+            {
+                LOGGER::LogWarning("Dummy: FromTo "+
+                                    oldStartNodeID + " - "+ oldEndNodeID+
+                                    " could not be looked up!");
+            }
+        }
+        catch (exception& ex)
+        {
+            LOGGER::LogError("Something strange happened - maybe a key error. ");
+            LOGGER::LogError(ex.what());
+        }
+    }
+}
 
 std::vector<netxpert::data::node_t>
  Transportation::GetOrigins() const {
@@ -473,54 +918,15 @@ void
 
     LOGGER::LogDebug("Writing Geometries..");
     writer->OpenNewTransaction();
+    if (cnfg.ResultDBType == RESULT_DB_TYPE::SpatiaLiteDB)
+      dynamic_cast<SpatiaLiteWriter&>(*writer).StartResultPipeline(resultTableName, NetXpertSolver::TransportationSolver);
 
-		std::string arcIDs = "";
-		std::unordered_set<string> totalArcIDs;
 		std::map<ODPair, DistributionArc>::const_iterator it;
 
 		if (cnfg.GeometryHandling == GEOMETRY_HANDLING::RealGeometry)
 		{
-			LOGGER::LogDebug("Preloading relevant geometries into Memory..");
-
-			#pragma omp parallel default(shared) private(it) num_threads(LOCAL_NUM_THREADS)
-			{
-				//populate arcIDs
-				for (it = this->distribution.begin(); it != this->distribution.end(); ++it)
-				{
-					#pragma omp single nowait
-					{
-						auto kv = *it;
-//						ODPair key = kv.first;
-						DistributionArc value = kv.second;
-						auto route = value.path.first;
-						std::unordered_set<std::string> arcIDlist;
-
-						arcIDlist = this->net->GetOrigArcIDs(route);
-
-						if (arcIDlist.size() > 0)
-						{
-							#pragma omp critical
-							{
-								for (std::string id : arcIDlist)
-								{
-									if (id != "dummy")
-										totalArcIDs.insert(id);
-								}
-							}
-						}
-					}//omp single
-				}
-			}//omp parallel
-
-			for (string id : totalArcIDs)
-				arcIDs += id += ",";
-
-			if (arcIDs.size() > 0)
-			{
-				arcIDs.pop_back(); //trim last comma
-//		  cout << "arcIDs: " << arcIDs << endl;
-				DBHELPER::LoadGeometryToMem(cnfg.ArcsTableName, cmap, cnfg.ArcsGeomColumnName, arcIDs);
-			}
+			LOGGER::LogDebug("Preloading geometries into Memory..");
+			this->net->LoadArcGeometries(cnfg.ArcsTableName, cnfg.ArcsGeomColumnName, cmap);
 			LOGGER::LogDebug("Done!");
       }
 
@@ -541,27 +947,12 @@ void
         ODPair key = dist.first;
         DistributionArc val = dist.second;
 
-        string arcIDs = "";
         auto arcs = val.path.first;
         auto cost = val.path.second;
         auto flow = val.flow;
         //TODO: get capacity per arc
         auto cap = -1;
 
-        vector<ArcData> arcData;
-        for (const auto& arc : arcs)
-            arcData.push_back( this->net->GetArcData(arc) );
-
-        for (ArcData& arcD : arcData)
-        {
-            if (arcD.extArcID.size() > 0)
-                arcIDs += arcD.extArcID += ",";
-            //TODO: get capacity per arc
-            //cap = arcD.capacity;
-        }
-        if (arcIDs.size() > 0)
-            arcIDs.pop_back(); //trim last comma
-
         string orig = "";
         string dest = "";
         try{
@@ -579,12 +970,13 @@ void
         }
 
   //    std::cout << orig<< " " << dest<< " " << cost<< " " << cap<< " " << flow<< " " << std::endl;
-  //    std::cout << "arcIDs: " << arcIDs << endl;
-        this->net->ProcessMCFResultArcsMem(orig, dest, cost, cap, flow, arcIDs, arcs, resultTableName, *writer, *qry);
+        this->net->ProcessMCFResultArcsMem(orig, dest, cost, cap, flow, arcs, resultTableName, *writer, *qry);
         }//omp single
       } // for loop
       }//omp paralell
 
+      if (cnfg.ResultDBType == RESULT_DB_TYPE::SpatiaLiteDB)
+        dynamic_cast<SpatiaLiteWriter&>(*writer).FinishResultPipeline();
       writer->CommitCurrentTransaction();
       writer->CloseConnection();
       LOGGER::LogDebug("Done!");
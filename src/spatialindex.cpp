@@ -0,0 +1,201 @@
+/*
+ * This file is a part of netxpert.
+ *
+ * Copyright (C) 2013-2017
+ * Johannes Sommer, Christopher Koller
+ *
+ * Permission to use, modify and distribute this software is granted
+ * provided that this copyright notice appears in all copies. For
+ * precise terms see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any kind,
+ * express or implied, and with no claim as to its suitability for any
+ * purpose.
+ *
+ */
+
+#include "spatialindex.hpp"
+#include <cmath>
+#include <queue>
+#include <limits>
+#include "geos/geom/LineString.h"
+#include "geos/geom/CoordinateSequence.h"
+
+using namespace std;
+using namespace netxpert::data;
+
+namespace {
+
+    template<typename B>
+    inline double minDist2(const B& b, const double x, const double y) {
+        const double dx = x < b.minX ? b.minX - x : (x > b.maxX ? x - b.maxX : 0);
+        const double dy = y < b.minY ? b.minY - y : (y > b.maxY ? y - b.maxY : 0);
+        return dx * dx + dy * dy;
+    }
+}
+
+void
+ ArcSpatialIndex::Build(std::vector<netxpert::data::ExtArcWithGeom> _arcs) {
+
+    using namespace geos::geom;
+
+    this->arcs = std::move(_arcs);
+    this->segments.clear();
+    this->boxes.clear();
+    this->levelOffsets.clear();
+
+    for (uint32_t a = 0; a < this->arcs.size(); a++) {
+        const Geometry* geom = this->arcs[a].arcGeom.get();
+        if (!geom)
+            continue;
+        //LineString or MultiLineString: no segments between the parts
+        for (size_t n = 0; n < geom->getNumGeometries(); n++) {
+            const LineString* line = dynamic_cast<const LineString*>(geom->getGeometryN(n));
+            if (!line || line->getNumPoints() < 2)
+                continue;
+            const CoordinateSequence* coords = line->getCoordinatesRO();
+            for (size_t i = 1; i < coords->getSize(); i++) {
+                const Coordinate& c1 = coords->getAt(i - 1);
+                const Coordinate& c2 = coords->getAt(i);
+                this->segments.push_back( Segment {c1.x, c1.y, c2.x, c2.y, a} );
+            }
+        }
+    }
+    if (this->segments.empty())
+        return;
+
+    //Sort-Tile-Recursive: vertical slices by x, then by y within each slice
+    auto centerX = [](const Segment& s) { return s.x1 + s.x2; };
+    auto centerY = [](const Segment& s) { return s.y1 + s.y2; };
+
+    const size_t count = this->segments.size();
+    const size_t pages = (count + NODE_CAPACITY - 1) / NODE_CAPACITY;
+    const size_t slices = (size_t) std::ceil(std::sqrt((double) pages));
+    const size_t sliceSize = slices * NODE_CAPACITY;
+
+    std::sort(this->segments.begin(), this->segments.end(),
+              [&](const Segment& a, const Segment& b) { return centerX(a) < centerX(b); });
+    for (size_t begin = 0; begin < count; begin += sliceSize) {
+        const size_t end = std::min(count, begin + sliceSize);
+        std::sort(this->segments.begin() + begin, this->segments.begin() + end,
+                  [&](const Segment& a, const Segment& b) { return centerY(a) < centerY(b); });
+    }
+
+    //tree levels from the bottom up until there is a single root
+    uint32_t level = 0;
+    do {
+        const uint32_t children = levelSize(level);
+        const uint32_t childOffset = level == 0 ? 0 : this->levelOffsets[level - 1];
+        this->levelOffsets.push_back(this->boxes.size());
+
+        for (uint32_t first = 0; first < children; first += NODE_CAPACITY) {
+            Box box { std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                      std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest() };
+            const uint32_t last = std::min(children, first + NODE_CAPACITY);
+            for (uint32_t c = first; c < last; c++) {
+                if (level == 0) {
+                    const Segment& s = this->segments[c];
+                    box.minX = std::min(box.minX, std::min(s.x1, s.x2));
+                    box.minY = std::min(box.minY, std::min(s.y1, s.y2));
+                    box.maxX = std::max(box.maxX, std::max(s.x1, s.x2));
+                    box.maxY = std::max(box.maxY, std::max(s.y1, s.y2));
+                }
+                else {
+                    const Box b = this->boxes[childOffset + c];
+                    box.minX = std::min(box.minX, b.minX);
+                    box.minY = std::min(box.minY, b.minY);
+                    box.maxX = std::max(box.maxX, b.maxX);
+                    box.maxY = std::max(box.maxY, b.maxY);
+                }
+            }
+            this->boxes.push_back(box);
+        }
+        level++;
+    }
+    while (levelSize(level) > 1);
+}
+
+uint32_t
+ ArcSpatialIndex::levelSize(const uint32_t level) const {
+
+    if (level == 0)
+        return this->segments.size();
+    const uint32_t end = level < this->levelOffsets.size() ? this->levelOffsets[level] : this->boxes.size();
+    return end - this->levelOffsets[level - 1];
+}
+
+double
+ ArcSpatialIndex::distanceToSegment(const Segment& s, const double x, const double y,
+                                    double& closestX, double& closestY) const {
+
+    const double dx = s.x2 - s.x1;
+    const double dy = s.y2 - s.y1;
+    const double len2 = dx * dx + dy * dy;
+    double t = 0;
+    if (len2 > 0)
+        t = std::max(0.0, std::min(1.0, ((x - s.x1) * dx + (y - s.y1) * dy) / len2));
+    //exact end points of the segment for t = 0 or t = 1
+    closestX = t == 1.0 ? s.x2 : s.x1 + t * dx;
+    closestY = t == 1.0 ? s.y2 : s.y1 + t * dy;
+    return (x - closestX) * (x - closestX) + (y - closestY) * (y - closestY);
+}
+
+bool
+ ArcSpatialIndex::GetClosestArc(const geos::geom::Coordinate& coord, const double threshold,
+                                netxpert::data::ExtClosestArcAndPoint& result) const {
+
+    if (this->segments.empty() || threshold <= 0)
+        return false;
+
+    struct Entry
+    {
+        double dist2;
+        uint32_t level;
+        uint32_t idx;
+        bool operator>(const Entry& other) const { return dist2 > other.dist2; }
+    };
+    priority_queue<Entry, vector<Entry>, greater<Entry> > queue;
+
+    const double x = coord.x;
+    const double y = coord.y;
+    const double maxDist2 = threshold * threshold;
+    double cx, cy;
+
+    const uint32_t top = this->levelOffsets.size();
+    queue.push( Entry {minDist2(this->boxes[this->levelOffsets[top - 1]], x, y), top, 0} );
+
+    while (!queue.empty()) {
+        const Entry e = queue.top();
+        queue.pop();
+        if (e.dist2 >= maxDist2)
+            break;
+
+        if (e.level == 0) {
+            //closest segment: all other entries are not closer
+            const Segment& s = this->segments[e.idx];
+            distanceToSegment(s, x, y, cx, cy);
+            const ExtArcWithGeom& arc = this->arcs[s.arcIdx];
+            result = ExtClosestArcAndPoint {arc.extArcID, arc.extFromNode, arc.extToNode, arc.cost, arc.capacity,
+                                            geos::geom::Coordinate(cx, cy), arc.arcGeom};
+            return true;
+        }
+
+        const uint32_t childLevel = e.level - 1;
+        const uint32_t first = e.idx * NODE_CAPACITY;
+        const uint32_t last = std::min(levelSize(childLevel), first + NODE_CAPACITY);
+        for (uint32_t c = first; c < last; c++) {
+            const double d2 = childLevel == 0 ? distanceToSegment(this->segments[c], x, y, cx, cy)
+                                              : minDist2(this->boxes[this->levelOffsets[childLevel - 1] + c], x, y);
+            if (d2 < maxDist2)
+                queue.push( Entry {d2, childLevel, c} );
+        }
+    }
+    return false;
+}
+
+size_t
+ ArcSpatialIndex::MemoryUsage() const {
+
+    return this->segments.capacity() * sizeof(Segment) + this->boxes.capacity() * sizeof(Box) +
+           this->levelOffsets.capacity() * sizeof(uint32_t) + this->arcs.capacity() * sizeof(ExtArcWithGeom);
+}
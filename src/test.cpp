@@ -15,6 +15,7 @@
  */
 
 #include "test.hpp"
+#include <random>
 
 using namespace std;
 using namespace netxpert;
@@ -63,10 +64,7 @@ void netxpert::test::LemonNetworkConvert(Config& cnfg)
     try
     {
         //1. Config
-        if (!DBHELPER::IsInitialized)
-        {
-            DBHELPER::Initialize(cnfg);
-        }
+        auto dbHelper = std::make_shared<DBHELPER>(cnfg);
 
         try
         {
@@ -98,11 +96,12 @@ void netxpert::test::LemonNetworkConvert(Config& cnfg)
                         cnfg.NodeIDColumnName, cnfg.NodeSupplyColumnName };
 
         //2. Load Network
-        DBHELPER::OpenNewTransaction();
-        arcsTable = DBHELPER::LoadNetworkFromDB(arcsTableName, cmap);
-        nodesTable = DBHELPER::LoadNodesFromDB(nodesTableName, nodesGeomColName, cmap);
+        dbHelper->OpenNewTransaction();
+        arcsTable = dbHelper->LoadNetworkFromDB(arcsTableName, cmap);
+        nodesTable = dbHelper->LoadNodesFromDB(nodesTableName, nodesGeomColName, cmap);
         LOGGER::LogInfo("Converting Data into internal network..");
-        netxpert::data::InternalNet net (arcsTable, cmap, cnfg);
+        netxpert::data::InternalNet net (arcsTable, cmap, cnfg, netxpert::data::InputNodes{}, true,
+                                         std::map<std::string, netxpert::data::IntNodeID>{}, dbHelper);
         LOGGER::LogInfo("Done!");
 
         loadNodes(net, arcsGeomColumnName, arcsTableName, cmap);
@@ -115,8 +114,8 @@ void netxpert::test::LemonNetworkConvert(Config& cnfg)
         loadNodes(net, arcsGeomColumnName, arcsTableName, cmap);
         LOGGER::LogDebug("Done!");
 
-        DBHELPER::CommitCurrentTransaction();
-        DBHELPER::CloseConnection();
+        dbHelper->CommitCurrentTransaction();
+        dbHelper->CloseConnection();
     }
     catch (exception& ex)
     {
@@ -424,6 +423,285 @@ void netxpert::test::TestMCF(Config& cnfg)
 	simpleSolver.Solve();
 }
 
+namespace netxpert {
+  namespace test {
+
+    ///\brief Synthetic Minimum Cost Flow instance: bidirectional k x k grid with random costs (1..100)
+    ///and terminal pairs with a supply of 20 each.
+    struct MCFBenchInstance
+    {
+        int GridSize;
+        int TerminalPairs;
+        int MinCapacity; //0: uncapacitated
+        int MaxCapacity;
+        double PairSupply; //supply of a terminal pair; fractional values are not exact in CapacityScaling and CostScaling
+    };
+
+    static void
+     buildMCFBenchInstance(const MCFBenchInstance& inst,
+                           netxpert::data::graph_t& g,
+                           netxpert::data::graph_t::ArcMap<netxpert::data::cost_t>& costMap,
+                           netxpert::data::graph_t::ArcMap<netxpert::data::capacity_t>& capMap,
+                           netxpert::data::graph_t::NodeMap<netxpert::data::supply_t>& supplyMap) {
+
+      const int k = inst.GridSize;
+      std::mt19937 rng(42);
+      std::uniform_int_distribution<int> costDist(1, 100);
+      std::uniform_int_distribution<int> capDist(inst.MinCapacity, inst.MaxCapacity);
+      std::uniform_int_distribution<int> nodeDist(0, k * k - 1);
+
+      std::vector<netxpert::data::node_t> nodes;
+      nodes.reserve(k * k);
+      for (int i = 0; i < k * k; i++) {
+        nodes.push_back(g.addNode());
+        supplyMap[nodes.back()] = 0;
+      }
+      auto addArcs = [&] (int from, int to) {
+        const cost_t cost = costDist(rng);
+        const capacity_t cap = inst.MinCapacity > 0 ? capDist(rng) : DOUBLE_INFINITY;
+        auto a = g.addArc(nodes[from], nodes[to]);
+        costMap[a] = cost;
+        capMap[a] = cap;
+        auto b = g.addArc(nodes[to], nodes[from]);
+        costMap[b] = cost;
+        capMap[b] = cap;
+      };
+      for (int r = 0; r < k; r++) {
+        for (int c = 0; c < k; c++) {
+          const int i = r * k + c;
+          if (c + 1 < k)
+            addArcs(i, i + 1);
+          if (r + 1 < k)
+            addArcs(i, i + k);
+        }
+      }
+      for (int t = 0; t < inst.TerminalPairs; t++) {
+        supplyMap[nodes[nodeDist(rng)]] += inst.PairSupply;
+        supplyMap[nodes[nodeDist(rng)]] -= inst.PairSupply;
+      }
+    }
+
+    //true if the flow leaves every node with its supply
+    static bool
+     isMCFFlowBalanced(const netxpert::data::filtered_graph_t& sg,
+                       const netxpert::data::graph_t::ArcMap<netxpert::data::flow_t>& flowMap,
+                       const netxpert::data::graph_t::NodeMap<netxpert::data::supply_t>& supplyMap) {
+
+      for (netxpert::data::filtered_graph_t::NodeIt n(sg); n != lemon::INVALID; ++n) {
+        double excess = supplyMap[n];
+        for (netxpert::data::filtered_graph_t::OutArcIt a(sg, n); a != lemon::INVALID; ++a)
+          excess -= flowMap[a];
+        for (netxpert::data::filtered_graph_t::InArcIt a(sg, n); a != lemon::INVALID; ++a)
+          excess += flowMap[a];
+        if (std::abs(excess) > 1e-6)
+          return false;
+      }
+      return true;
+    }
+  }
+}
+
+void netxpert::test::BenchMCFAlgorithms(Config& cnfg)
+{
+    //The instances that the thresholds of MinCostFlow::SelectAlgorithm() are based on.
+    //Grid sizes of 100, 300 and 600 give 10k, 90k and 360k nodes (about 4 arcs per node).
+    //The instances with fractional supplies must not be given to CapacityScaling or CostScaling.
+    const std::vector<MCFBenchInstance> instances {
+        {100,    5,   0,    0,   20},
+        {100,  500,   0,    0,   20},
+        {100,  500,   5,   30,   20},
+        {300,    5,   0,    0,   20},
+        {300,   50,   0,    0,   20},
+        {300,   50, 200, 2000,   20},
+        {300,  500,   0,    0,   20},
+        {300, 5000,   0,    0,   20},
+        {300,   20,   5,   30,   20},
+        {600,    5,   0,    0,   20},
+        {600,   50,   0,    0,   20},
+        {600,   50, 200, 2000,   20},
+        {600, 2000,   0,    0,   20},
+        {300,    5,   0,    0, 20.5},
+        {300,   50, 200, 2000, 20.5}
+    };
+    const std::vector<MCFAlgorithm> algorithms {
+        MCFAlgorithm::NetworkSimplex_LEMON, MCFAlgorithm::CostScaling_LEMON, MCFAlgorithm::CapacityScaling_LEMON
+    };
+
+    //integer mode of the NetworkSimplex (not part of the selection)
+    const int integerPrecision = std::max(cnfg.McfIntegerPrecision, 0);
+
+    //n/a: not solved (e.g. fractional values for CapacityScaling); unbalanced: solved, but the flow does not
+    //meet the supplies
+    cout << "nodes;arcs;sources;sinks;tight arcs;integral flows;NetworkSimplex [s];CostScaling [s];CapacityScaling [s];"
+         << "NetworkSimplex integer [s];optimum;selected;fastest" << endl;
+
+    for (const auto& inst : instances)
+    {
+        graph_t g;
+        graph_t::ArcMap<cost_t> costMap(g);
+        graph_t::ArcMap<capacity_t> capMap(g);
+        graph_t::NodeMap<supply_t> supplyMap(g);
+        buildMCFBenchInstance(inst, g, costMap, capMap, supplyMap);
+        //filter map must be created after the arcs
+        graph_t::ArcMap<bool> arcFilter(g, true);
+        filtered_graph_t sg(g, arcFilter);
+
+        auto shape = netxpert::MinCostFlow::GetInstanceShape(sg, costMap, capMap, supplyMap);
+        cout << shape.NodeCount << ";" << shape.ArcCount << ";" << shape.SourceCount << ";"
+             << shape.SinkCount << ";" << shape.TightArcCount << ";" << shape.IntegralFlows << ";";
+
+        double optimum = 0;
+        double fastestTime = -1;
+        MCFAlgorithm fastest = MCFAlgorithm::MCFAutomatic;
+        for (auto algorithm : algorithms)
+        {
+            auto mcf = netxpert::MinCostFlow::CreateCoreSolver(algorithm, cnfg.McfPivotRule);
+            lemon::Timer t;
+            mcf->LoadNet(shape.NodeCount, shape.ArcCount, &sg, &costMap, &capMap, &supplyMap);
+            mcf->SolveMCF();
+            const double time = t.realTime();
+
+            if (mcf->GetMCFStatus() != MCFSolverStatus::MCFOK) {
+                cout << "n/a;";
+                continue;
+            }
+            if (!isMCFFlowBalanced(sg, *mcf->GetMCFFlow(), supplyMap)) {
+                cout << "unbalanced;";
+                continue;
+            }
+            cout << std::fixed << std::setprecision(3) << time << ";";
+            optimum = mcf->GetOptimum();
+            if (fastestTime < 0 || time < fastestTime) {
+                fastestTime = time;
+                fastest = algorithm;
+            }
+        }
+        {
+            auto mcf = netxpert::MinCostFlow::CreateCoreSolver(MCFAlgorithm::NetworkSimplex_LEMON, cnfg.McfPivotRule,
+                                                               integerPrecision);
+            lemon::Timer t;
+            mcf->LoadNet(shape.NodeCount, shape.ArcCount, &sg, &costMap, &capMap, &supplyMap);
+            mcf->SolveMCF();
+            cout << std::fixed << std::setprecision(3) << t.realTime() << ";";
+        }
+        cout << std::setprecision(0) << optimum << ";"
+             << netxpert::MinCostFlow::SelectAlgorithm(shape) << ";" << fastest << endl;
+    }
+}
+
+namespace netxpert {
+  namespace test {
+
+    ///\brief Dense transportation instance (row-major costs) for TestTransportationDegenerate()
+    struct TPDegenerateInstance
+    {
+        std::string Name;
+        std::vector<cost_t> Costs;
+        std::vector<supply_t> Supplies;
+        std::vector<supply_t> Demands;
+        std::vector<char> Allowed; //empty: all cells allowed
+    };
+
+    //optimum of the instance with LEMON's NetworkSimplex (excess supply or demand to a zero cost slack node);
+    //-1 if the instance is infeasible
+    static double
+     solveTransportationLEMON(const TPDegenerateInstance& inst) {
+
+      lemon::SmartDigraph g;
+      lemon::SmartDigraph::ArcMap<double> costMap(g);
+      lemon::SmartDigraph::NodeMap<double> supplyMap(g);
+      const size_t R = inst.Supplies.size();
+      const size_t C = inst.Demands.size();
+      std::vector<lemon::SmartDigraph::Node> rows, cols;
+      double totalSupply = 0;
+      double totalDemand = 0;
+      for (size_t i = 0; i < R; i++) {
+        rows.push_back(g.addNode());
+        supplyMap[rows.back()] = inst.Supplies[i];
+        totalSupply += inst.Supplies[i];
+      }
+      for (size_t j = 0; j < C; j++) {
+        cols.push_back(g.addNode());
+        supplyMap[cols.back()] = -inst.Demands[j];
+        totalDemand += inst.Demands[j];
+      }
+      for (size_t i = 0; i < R; i++) {
+        for (size_t j = 0; j < C; j++) {
+          if (inst.Allowed.empty() || inst.Allowed[i * C + j])
+            costMap[g.addArc(rows[i], cols[j])] = inst.Costs[i * C + j];
+        }
+      }
+      const auto slack = g.addNode();
+      supplyMap[slack] = totalDemand - totalSupply;
+      for (size_t i = 0; i < R && totalSupply > totalDemand; i++)
+        costMap[g.addArc(rows[i], slack)] = 0;
+      for (size_t j = 0; j < C && totalDemand > totalSupply; j++)
+        costMap[g.addArc(slack, cols[j])] = 0;
+
+      lemon::NetworkSimplex<lemon::SmartDigraph, double, double> ns(g);
+      ns.costMap(costMap).supplyMap(supplyMap);
+      if (ns.run() != lemon::NetworkSimplex<lemon::SmartDigraph, double, double>::OPTIMAL)
+        return -1;
+      return ns.totalCost();
+    }
+  }
+}
+
+void netxpert::test::TestTransportationDegenerate(Config& cnfg)
+{
+    //Degenerate instances for the pivots of TransportationSimplex: unit supplies and demands (assignment) and
+    //supplies that are sums of demands give many basic cells without flow in the Vogel basis; few distinct
+    //costs give ties of the reduced costs. Every instance must be solved optimal without reaching the
+    //iteration limit of the solver (status MCFStopped).
+    std::vector<TPDegenerateInstance> instances;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> tieCost(1, 5);
+    auto randomCosts = [&] (size_t cells) {
+        std::vector<cost_t> costs(cells);
+        for (auto& c : costs)
+            c = tieCost(rng);
+        return costs;
+    };
+    for (size_t n : {5, 20, 60}) {
+        instances.push_back( TPDegenerateInstance {"assignment " + std::to_string(n) + "x" + std::to_string(n),
+                                                   randomCosts(n * n), std::vector<supply_t>(n, 1),
+                                                   std::vector<supply_t>(n, 1), {}} );
+    }
+    //every supply is met by exactly two demands
+    instances.push_back( TPDegenerateInstance {"paired 10x20", randomCosts(200), std::vector<supply_t>(10, 2),
+                                               std::vector<supply_t>(20, 1), {}} );
+    //extra supply (slack column) and masked cells
+    {
+        TPDegenerateInstance inst {"masked 30x25", randomCosts(750), std::vector<supply_t>(30, 1),
+                                   std::vector<supply_t>(25, 1), std::vector<char>(750, 1)};
+        for (auto& a : inst.Allowed)
+            a = rng() % 4 != 0;
+        instances.push_back(inst);
+    }
+    //all costs equal: every basis is optimal
+    instances.push_back( TPDegenerateInstance {"equal costs 15x15", std::vector<cost_t>(225, 1),
+                                               std::vector<supply_t>(15, 1), std::vector<supply_t>(15, 1), {}} );
+
+    cout << "instance;status;pivots;optimum;NetworkSimplex;result" << endl;
+    int failed = 0;
+    for (const auto& inst : instances)
+    {
+        netxpert::core::TransportationSimplex tp;
+        tp.LoadMatrix(inst.Costs, inst.Supplies, inst.Demands, inst.Allowed.empty() ? nullptr : &inst.Allowed);
+        tp.Solve();
+        const double reference = solveTransportationLEMON(inst);
+        const bool ok = reference < 0 ? tp.GetStatus() == MCFSolverStatus::MCFUnfeasible
+                                      : tp.GetStatus() == MCFSolverStatus::MCFOK &&
+                                        std::abs(tp.GetOptimum() - reference) < 1e-6;
+        if (!ok)
+            failed++;
+        cout << inst.Name << ";" << tp.GetStatus() << ";" << tp.GetIterationCount() << ";" << tp.GetOptimum() << ";"
+             << reference << ";" << (ok ? "OK" : "FAILED") << endl;
+    }
+    if (failed > 0)
+        LOGGER::LogError("TestTransportationDegenerate: " + to_string(failed) + " instances failed!");
+}
+
 //void netxpert::test::TestTransportationExt(Config& cnfg)
 //{
 //    try
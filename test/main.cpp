@@ -160,9 +160,15 @@ int main(int argc, char** argv)
         case TESTCASE::MCFCOM:
             netxpert::test::TestMCF(cnfg);
             break;
+        case TESTCASE::BenchMCFAlgorithms:
+            netxpert::test::BenchMCFAlgorithms(cnfg);
+            break;
         case TESTCASE::TransportationCOM:
             netxpert::test::TestTransportation(cnfg);
             break;
+        case TESTCASE::TransportationDegenerate:
+            netxpert::test::TestTransportationDegenerate(cnfg);
+            break;
 //        case TESTCASE::TransportationCOMExt:
 //            netxpert::test::TestTransportationExt(cnfg);
 //            break;
@@ -173,13 +179,10 @@ int main(int argc, char** argv)
 
         /*
                         //only test connection to sqlite
-                        if (!DBHELPER::IsInitialized)
-                        {
-                            DBHELPER::Initialize(cnfg);
-                        }
-                        DBHELPER::OpenNewTransaction();
-                        DBHELPER::CommitCurrentTransaction();
-                        DBHELPER::CloseConnection();
+                        DBHELPER dbHelper (cnfg);
+                        dbHelper.OpenNewTransaction();
+                        dbHelper.CommitCurrentTransaction();
+                        dbHelper.CloseConnection();
         */
 
     }